@@ -120,7 +120,6 @@ nonunified_source_files = [
   "HLSLCompiler.cpp",
   # generated parsers
   "glslang_tab.cpp",
-  "glslang_lex.cpp",
   "SwapChain11.cpp"
 ]
 
@@ -48,7 +48,7 @@ typedef unsigned int GLenum;
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 132
+#define ANGLE_SH_VERSION 143
 
 typedef enum {
   SH_GLES2_SPEC = 0x8B40,
@@ -172,6 +172,23 @@ typedef enum {
   // It is intended as a workaround for drivers that do not handle
   // struct scopes correctly, including all Mac drivers and Linux AMD.
   SH_REGENERATE_STRUCT_NAMES = 0x80000,
+
+  // This flag removes the functions, struct declarations and global
+  // variables that main() doesn't reach from the translated code. Uniforms,
+  // attributes, varyings and outputs are kept, and the variables collected
+  // with SH_VARIABLES still count the removed code as static use.
+  SH_PRUNE_UNUSED_DECLARATIONS = 0x100000,
+
+  // This flag makes the GLSL and ESSL output as short as it can be: no
+  // whitespace or parentheses that aren't needed, and short names for the
+  // user functions and the variables that aren't part of the interface.
+  // The short names are recorded in the name map like hashed names.
+  SH_MINIFY_OUTPUT = 0x200000,
+
+  // This flag records the time spent in each phase of the compile, and
+  // the size of the tree, the symbol count and the pool allocator use.
+  // They can be queried by calling ShGetCompileStatistics().
+  SH_COMPILE_STATISTICS = 0x400000,
 } ShCompileOptions;
 
 // Defines alternate strategies for implementing array index clamping.
@@ -183,6 +200,14 @@ typedef enum {
   SH_CLAMP_WITH_USER_DEFINED_INT_CLAMP_FUNCTION
 } ShArrayIndexClampingStrategy;
 
+//
+// Thread safety:
+// ShInitialize and ShFinalize may be called from any thread. Between them,
+// different handles may be constructed, used to compile and destroyed
+// concurrently on different threads. A single handle must not be used by
+// more than one thread at a time.
+//
+
 //
 // Driver must call this first, once, before doing any other
 // compiler operations.
@@ -190,7 +215,7 @@ typedef enum {
 //
 COMPILER_EXPORT bool ShInitialize();
 //
-// Driver should call this at shutdown.
+// Driver should call this at shutdown, after all compiles have finished.
 // If the function succeeds, the return value is true, else false.
 //
 COMPILER_EXPORT bool ShFinalize();
@@ -254,6 +279,13 @@ typedef struct
 
     // The maximum depth a call stack can be.
     int MaxCallStackDepth;
+
+    // The maximum number of nodes that unrolling the loops flagged by
+    // SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX and
+    // SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX may add to a shader.
+    // The compile fails if they need more. Default is 0, which means no
+    // limit. The loops that never end fail the compile either way.
+    int MaxUnrolledLoopSize;
 } ShBuiltInResources;
 
 //
@@ -329,6 +361,83 @@ COMPILER_EXPORT bool ShCompile(
     size_t numStrings,
     int compileOptions);
 
+// Runs only the preprocessor over the given shader source, and writes it
+// to output in a canonical form: the tokens that would reach the parser,
+// after macro expansion and without comments, whitespace or inactive #if
+// groups, with the #version, #extension and #pragma directives where they
+// appear. Sources with the same canonical form compile to the same results,
+// so it can be hashed as the key of a cache in front of ShCompile, together
+// with the handle's type, spec, output and ShGetBuiltInResourcesString, and
+// the compile options. Line numbers are left out unless SH_LINE_DIRECTIVES
+// is given, so the info log of a cached result may point at the lines of
+// another source; the path given with SH_SOURCE_PATH is never included.
+// Replaces the results of the last compile on the handle.
+// If the function succeeds, the return value is true, else false, and the
+// info log has the preprocessor errors.
+// Parameters:
+// handle: Specifies the handle of compiler to be used.
+// shaderStrings: Specifies an array of pointers to null-terminated strings
+//                containing the shader source code.
+// numStrings: Specifies the number of elements in shaderStrings array.
+// compileOptions: The options of ShCompile. Only SH_SOURCE_PATH and
+//                 SH_LINE_DIRECTIVES change the output.
+// output: Receives the canonical form of the source.
+COMPILER_EXPORT bool ShPreprocess(
+    const ShHandle handle,
+    const char * const shaderStrings[],
+    size_t numStrings,
+    int compileOptions,
+    std::string *output);
+
+// A compile for ShCompileBatch. The first fields are the parameters of
+// ShCompile, and success receives its result.
+typedef struct
+{
+    ShHandle handle;
+    const char * const *shaderStrings;
+    size_t numStrings;
+    int compileOptions;
+
+    bool success;
+} ShCompileJob;
+
+// A program for ShCompileBatch to check once its shaders have compiled.
+// vertexJob and fragmentJob are indices in the array of jobs, and both jobs
+// must include SH_VARIABLES. The varyings that the fragment shader
+// statically uses must be declared by the vertex shader, the varyings
+// declared by both must match, and the ones the fragment shader uses must
+// pack in maxVaryingVectors. A maxVaryingVectors of 0 skips the packing
+// check. success receives the result, and infoLog the reasons it failed.
+typedef struct
+{
+    size_t vertexJob;
+    size_t fragmentJob;
+    int maxVaryingVectors;
+
+    bool success;
+    std::string infoLog;
+} ShProgramJob;
+
+// Compiles a batch of shaders on up to numWorkers threads, the calling
+// thread included, and then checks the programs, if any. The jobs that
+// use the same handle run one after the other in array order, so that the
+// results are those of calling ShCompile for each job in turn. A program
+// whose shaders' handles are compiled again later in the batch is checked
+// against their last compile.
+// Returns true if every job compiled and every program passed its checks.
+// Parameters:
+// jobs: Specifies the array of compiles, and receives their results.
+// numJobs: Specifies the number of elements in jobs.
+// programs: Specifies an array of programs to check, or NULL.
+// numPrograms: Specifies the number of elements in programs.
+// numWorkers: Specifies the maximum number of threads to compile on.
+COMPILER_EXPORT bool ShCompileBatch(
+    ShCompileJob *jobs,
+    size_t numJobs,
+    ShProgramJob *programs,
+    size_t numPrograms,
+    unsigned int numWorkers);
+
 // Return the version of the shader language.
 COMPILER_EXPORT int ShGetShaderVersion(const ShHandle handle);
 
@@ -346,6 +455,15 @@ COMPILER_EXPORT const std::string &ShGetInfoLog(const ShHandle handle);
 // handle: Specifies the compiler
 COMPILER_EXPORT const std::string &ShGetObjectCode(const ShHandle handle);
 
+// Moves the object code for a compiled shader into objectCode without
+// copying it. The previous contents of objectCode are discarded, and its
+// storage is kept by the compiler for the next compile. Afterwards
+// ShGetObjectCode returns an empty string until the next compile.
+// Parameters:
+// handle: Specifies the compiler
+// objectCode: Receives the object code
+COMPILER_EXPORT void ShTakeObjectCode(const ShHandle handle, std::string *objectCode);
+
 // Returns a (original_name, hash) map containing all the user defined
 // names in the shader, including variable names, function names, struct
 // names, and struct field names.
@@ -385,6 +503,29 @@ COMPILER_EXPORT bool ShCheckVariablesWithinPackingLimits(
     ShVariableInfo *varInfoArray,
     size_t varInfoArraySize);
 
+// Where ShPackVariables placed a variable: the row of its first element, and
+// its leftmost column. The elements of an array take consecutive rows.
+typedef struct
+{
+    int row;
+    int column;
+} ShVariablePlacement;
+
+// Packs the passed in variables like ShCheckVariablesWithinPackingLimits,
+// and if they fit, gives the placement of each one.
+// Returns false if they don't fit, and then leaves placements unchanged.
+// Parameters:
+// maxVectors: the available rows of registers.
+// varInfoArray: an array of variable info (types and sizes).
+// varInfoArraySize: the size of the variable array.
+// placements: an array of varInfoArraySize elements that receives the
+//             placement of each variable.
+COMPILER_EXPORT bool ShPackVariables(
+    int maxVectors,
+    ShVariableInfo *varInfoArray,
+    size_t varInfoArraySize,
+    ShVariablePlacement *placements);
+
 // Gives the compiler-assigned register for an interface block.
 // The method writes the value to the output variable "indexOut".
 // Returns true if it found a valid interface block, false otherwise.
@@ -408,4 +549,162 @@ COMPILER_EXPORT bool ShGetUniformRegister(const ShHandle handle,
                                           const std::string &uniformName,
                                           unsigned int *indexOut);
 
+//
+// Translation cache.
+//
+// When enabled, ShCompile looks the compile up in a process-wide cache
+// before parsing. The key covers the shader strings, the compile options,
+// the shader type, spec and output, and the built-in resources of the
+// handle. On a hit, the stored object code, info log, name hashing map,
+// variables and HLSL registers are returned without translating again.
+// Entries are evicted least recently used first.
+//
+
+// Callbacks of an optional persistent store behind the cache, for example
+// an on-disk cache of the embedder. Keys are strings of hexadecimal digits;
+// values are opaque. The get callback returns true and fills |value| if the
+// store has an entry for |key|. Both may be called from any thread that
+// calls ShCompile. Entries of compilers with a HashFunction are never
+// passed to the store.
+typedef bool (*ShTranslationCacheGetFunction)(void *userData,
+                                              const std::string &key,
+                                              std::string *value);
+typedef void (*ShTranslationCachePutFunction)(void *userData,
+                                              const std::string &key,
+                                              const std::string &value);
+
+typedef struct
+{
+    // Compiles served from memory.
+    size_t hits;
+    // Compiles served from the backing store.
+    size_t backingStoreHits;
+    // Compiles that had to be translated.
+    size_t misses;
+    // Entries dropped to stay within maxSize.
+    size_t evictions;
+    size_t entries;
+    // Approximate memory used by the entries, in bytes.
+    size_t size;
+    size_t maxSize;
+} ShTranslationCacheStatistics;
+
+// Enables the translation cache, bounding its approximate memory use to
+// maxSize bytes. A maxSize of 0 disables it, which is the default.
+COMPILER_EXPORT void ShSetTranslationCacheSize(size_t maxSize);
+
+// Sets the persistent store consulted on a miss and filled on insertion.
+// Pass NULL callbacks to remove it.
+COMPILER_EXPORT void ShSetTranslationCacheBackingStore(ShTranslationCacheGetFunction getFunction,
+                                                       ShTranslationCachePutFunction putFunction,
+                                                       void *userData);
+
+// Drops every entry and resets the counters. The backing store is not
+// touched.
+COMPILER_EXPORT void ShClearTranslationCache();
+
+COMPILER_EXPORT void ShGetTranslationCacheStatistics(ShTranslationCacheStatistics *statistics);
+
+//
+// Pool allocator.
+//
+// Each compiler allocates the data of a compile from its own pool, which
+// gets memory from the OS in pages and frees all of it at the end of the
+// compile. Freed pages are kept for the next compiles on the same handle.
+//
+
+typedef struct
+{
+    // Size of the pages obtained from the OS, at least 4096 bytes.
+    size_t pageSize;
+    // Once a compile uses more than a page, new pages are as large as the
+    // memory in use, doubling up to maxPageSize. Large compiles then call
+    // into the OS less often. Equal to pageSize, pages never grow.
+    size_t maxPageSize;
+    // Bytes of freed pages kept for later compiles; the rest are returned
+    // to the OS.
+    size_t maxRetainedBytes;
+} ShPoolAllocatorOptions;
+
+typedef struct
+{
+    // Allocations since the handle was constructed, and bytes requested.
+    size_t allocations;
+    size_t bytesAllocated;
+    // Pages holding live allocations, and their size in bytes.
+    size_t pagesInUse;
+    size_t bytesInUse;
+    size_t peakBytesInUse;
+    // Freed pages kept for re-use, and their size in bytes.
+    size_t pagesRetained;
+    size_t bytesRetained;
+    // Pages obtained from the OS since the handle was constructed.
+    size_t osAllocations;
+} ShPoolAllocatorStatistics;
+
+// Initialize options with the defaults: 8 KB pages that never grow, and
+// every freed page kept.
+COMPILER_EXPORT void ShInitPoolAllocatorOptions(ShPoolAllocatorOptions *options);
+
+// Applies the options to the pool of the compiler. A new page size only
+// affects the pages obtained afterwards; pages kept for re-use are freed.
+COMPILER_EXPORT void ShSetPoolAllocatorOptions(const ShHandle handle,
+                                               const ShPoolAllocatorOptions *options);
+
+COMPILER_EXPORT void ShGetPoolAllocatorStatistics(const ShHandle handle,
+                                                  ShPoolAllocatorStatistics *statistics);
+
+//
+// Compile statistics.
+//
+// The phases of a compile timed with SH_COMPILE_STATISTICS. A phase whose
+// option wasn't given takes no time.
+//
+
+typedef enum {
+  // The preprocessor runs as the parser pulls tokens from it, so these
+  // two split the time of the parse.
+  SH_COMPILE_PHASE_PREPROCESS,
+  SH_COMPILE_PHASE_PARSE,
+  SH_COMPILE_PHASE_POST_PROCESS,
+  // The validation passes run together in a single walk of the tree:
+  // expression complexity, call stack depth, fragment outputs and the
+  // GLSL ES 1.00 Appendix A limitations.
+  SH_COMPILE_PHASE_VALIDATE,
+  SH_COMPILE_PHASE_TIMING_RESTRICTIONS,
+  SH_COMPILE_PHASE_UNROLL_LOOPS,
+  SH_COMPILE_PHASE_FOLD_CONSTANTS,
+  SH_COMPILE_PHASE_EMULATE_BUILT_IN_FUNCTIONS,
+  SH_COMPILE_PHASE_CLAMP_INDIRECT_ARRAY_BOUNDS,
+  SH_COMPILE_PHASE_UNFOLD_SHORT_CIRCUIT,
+  SH_COMPILE_PHASE_COLLECT_VARIABLES,
+  SH_COMPILE_PHASE_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS,
+  SH_COMPILE_PHASE_REGENERATE_STRUCT_NAMES,
+  SH_COMPILE_PHASE_PRUNE_UNUSED_DECLARATIONS,
+  SH_COMPILE_PHASE_OUTPUT,
+  SH_COMPILE_PHASE_COUNT
+} ShCompilePhase;
+
+typedef struct
+{
+    // Wall time of the whole compile and of each of its phases, in
+    // nanoseconds. The phases don't add up to the total: setting up the
+    // compile and the smaller passes aren't counted in any of them.
+    khronos_uint64_t totalTime;
+    khronos_uint64_t phaseTimes[SH_COMPILE_PHASE_COUNT];
+    // Nodes of the tree as the validation passes see it.
+    size_t treeNodes;
+    // User-defined symbols: variables, parameters, functions and structs.
+    size_t symbols;
+    // Allocations from the pool allocator, and bytes requested.
+    size_t poolAllocations;
+    size_t poolBytesAllocated;
+} ShCompileStatistics;
+
+// Returns the statistics of the last compile of the handle. Returns false
+// if it wasn't given SH_COMPILE_STATISTICS, or if its results came from
+// the translation cache.
+COMPILER_EXPORT bool ShGetCompileStatistics(const ShHandle handle,
+                                            ShCompileStatistics *statistics);
+
 #endif // _COMPILER_INTERFACE_INCLUDED_
@@ -174,12 +174,12 @@ class DefinedParser : public Lexer
         if (token->type != Token::IDENTIFIER)
         {
             mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                 token->location, token->text);
+                                 token->location, token->text.str());
             skipUntilEOD(mLexer, token);
             return;
         }
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        std::string expression = iter != mMacroSet->end() ? "1" : "0";
+        MacroSet::const_iterator iter = mMacroSet->find(token->text.str());
+        const char *expression = iter != mMacroSet->end() ? "1" : "0";
 
         if (paren)
         {
@@ -187,7 +187,7 @@ class DefinedParser : public Lexer
             if (token->type != ')')
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 skipUntilEOD(mLexer, token);
                 return;
             }
@@ -196,7 +196,7 @@ class DefinedParser : public Lexer
         // We have a valid defined operator.
         // Convert the current token into a CONST_INT token.
         token->type = Token::CONST_INT;
-        token->text = expression;
+        token->text.setView(expression, 1);
     }
 
   private:
@@ -271,7 +271,7 @@ void DirectiveParser::parseDirective(Token *token)
     {
       case DIRECTIVE_NONE:
         mDiagnostics->report(Diagnostics::PP_DIRECTIVE_INVALID_NAME,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         break;
       case DIRECTIVE_DEFINE:
@@ -322,7 +322,7 @@ void DirectiveParser::parseDirective(Token *token)
     if (token->type == Token::LAST)
     {
         mDiagnostics->report(Diagnostics::PP_EOF_IN_DIRECTIVE,
-                             token->location, token->text);
+                             token->location, token->text.str());
     }
 }
 
@@ -334,25 +334,25 @@ void DirectiveParser::parseDefine(Token *token)
     if (token->type != Token::IDENTIFIER)
     {
         mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         return;
     }
-    if (isMacroPredefined(token->text, *mMacroSet))
+    if (isMacroPredefined(token->text.str(), *mMacroSet))
     {
         mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_REDEFINED,
-                             token->location, token->text);
+                             token->location, token->text.str());
         return;
     }
-    if (isMacroNameReserved(token->text))
+    if (isMacroNameReserved(token->text.str()))
     {
         mDiagnostics->report(Diagnostics::PP_MACRO_NAME_RESERVED,
-                             token->location, token->text);
+                             token->location, token->text.str());
         return;
     }
 
     Macro macro;
     macro.type = Macro::kTypeObj;
-    macro.name = token->text;
+    macro.name = token->text.str();
 
     mTokenizer->lex(token);
     if (token->type == '(' && !token->hasLeadingSpace())
@@ -364,7 +364,7 @@ void DirectiveParser::parseDefine(Token *token)
             mTokenizer->lex(token);
             if (token->type != Token::IDENTIFIER)
                 break;
-            macro.parameters.push_back(token->text);
+            macro.parameters.push_back(token->text.str());
 
             mTokenizer->lex(token);  // Get ','.
         }
@@ -374,7 +374,7 @@ void DirectiveParser::parseDefine(Token *token)
         {
             mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
                                  token->location,
-                                 token->text);
+                                 token->text.str());
             return;
         }
         mTokenizer->lex(token);  // Get ')'.
@@ -416,17 +416,17 @@ void DirectiveParser::parseUndef(Token *token)
     if (token->type != Token::IDENTIFIER)
     {
         mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         return;
     }
 
-    MacroSet::iterator iter = mMacroSet->find(token->text);
+    MacroSet::iterator iter = mMacroSet->find(token->text.str());
     if (iter != mMacroSet->end())
     {
         if (iter->second.predefined)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_UNDEFINED,
-                                 token->location, token->text);
+                                 token->location, token->text.str());
         }
         else
         {
@@ -462,7 +462,7 @@ void DirectiveParser::parseElse(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELSE_WITHOUT_IF,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -477,7 +477,7 @@ void DirectiveParser::parseElse(Token *token)
     if (block.foundElseGroup)
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELSE_AFTER_ELSE,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -491,7 +491,7 @@ void DirectiveParser::parseElse(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
     }
 }
@@ -503,7 +503,7 @@ void DirectiveParser::parseElif(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELIF_WITHOUT_IF,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -518,7 +518,7 @@ void DirectiveParser::parseElif(Token *token)
     if (block.foundElseGroup)
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELIF_AFTER_ELSE,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -543,7 +543,7 @@ void DirectiveParser::parseEndif(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ENDIF_WITHOUT_IF,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -555,7 +555,7 @@ void DirectiveParser::parseEndif(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
     }
 }
@@ -602,14 +602,14 @@ void DirectiveParser::parsePragma(Token *token)
         switch(state++)
         {
           case PRAGMA_NAME:
-            name = token->text;
+            name = token->text.str();
             valid = valid && (token->type == Token::IDENTIFIER);
             break;
           case LEFT_PAREN:
             valid = valid && (token->type == '(');
             break;
           case PRAGMA_VALUE:
-            value = token->text;
+            value = token->text.str();
             valid = valid && (token->type == Token::IDENTIFIER);
             break;
           case RIGHT_PAREN:
@@ -660,16 +660,16 @@ void DirectiveParser::parseExtension(Token *token)
             if (valid && (token->type != Token::IDENTIFIER))
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_NAME,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
-            if (valid) name = token->text;
+            if (valid) name = token->text.str();
             break;
           case COLON:
             if (valid && (token->type != ':'))
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             break;
@@ -677,16 +677,16 @@ void DirectiveParser::parseExtension(Token *token)
             if (valid && (token->type != Token::IDENTIFIER))
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_BEHAVIOR,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
-            if (valid) behavior = token->text;
+            if (valid) behavior = token->text.str();
             break;
           default:
             if (valid)
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             break;
@@ -696,7 +696,7 @@ void DirectiveParser::parseExtension(Token *token)
     if (valid && (state != EXT_BEHAVIOR + 1))
     {
         mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_DIRECTIVE,
-                             token->location, token->text);
+                             token->location, token->text.str());
         valid = false;
     }
     if (valid)
@@ -710,7 +710,7 @@ void DirectiveParser::parseVersion(Token *token)
     if (mPastFirstStatement)
     {
         mDiagnostics->report(Diagnostics::PP_VERSION_NOT_FIRST_STATEMENT,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -735,13 +735,13 @@ void DirectiveParser::parseVersion(Token *token)
             if (token->type != Token::CONST_INT)
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_NUMBER,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             if (valid && !token->iValue(&version))
             {
                 mDiagnostics->report(Diagnostics::PP_INTEGER_OVERFLOW,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             if (valid)
@@ -753,14 +753,14 @@ void DirectiveParser::parseVersion(Token *token)
             if (token->type != Token::IDENTIFIER || token->text != "es")
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_DIRECTIVE,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             state = VERSION_ENDLINE;
             break;
           default:
             mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                 token->location, token->text);
+                                 token->location, token->text.str());
             valid = false;
             break;
         }
@@ -771,7 +771,7 @@ void DirectiveParser::parseVersion(Token *token)
     if (valid && (state != VERSION_ENDLINE))
     {
         mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_DIRECTIVE,
-                             token->location, token->text);
+                             token->location, token->text.str());
         valid = false;
     }
 
@@ -805,13 +805,13 @@ void DirectiveParser::parseLine(Token *token)
             if (valid && (token->type != Token::CONST_INT))
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_LINE_NUMBER,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             if (valid && !token->iValue(&line))
             {
                 mDiagnostics->report(Diagnostics::PP_INTEGER_OVERFLOW,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             break;
@@ -819,13 +819,13 @@ void DirectiveParser::parseLine(Token *token)
             if (valid && (token->type != Token::CONST_INT))
             {
                 mDiagnostics->report(Diagnostics::PP_INVALID_FILE_NUMBER,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             if (valid && !token->iValue(&file))
             {
                 mDiagnostics->report(Diagnostics::PP_INTEGER_OVERFLOW,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             break;
@@ -833,7 +833,7 @@ void DirectiveParser::parseLine(Token *token)
             if (valid)
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                                     token->location, token->text);
+                                     token->location, token->text.str());
                 valid = false;
             }
             break;
@@ -844,7 +844,7 @@ void DirectiveParser::parseLine(Token *token)
     if (valid && (state != FILE_NUMBER) && (state != FILE_NUMBER + 1))
     {
         mDiagnostics->report(Diagnostics::PP_INVALID_LINE_DIRECTIVE,
-                             token->location, token->text);
+                             token->location, token->text.str());
         valid = false;
     }
     if (valid)
@@ -867,7 +867,7 @@ bool DirectiveParser::skipping() const
 void DirectiveParser::parseConditionalIf(Token *token)
 {
     ConditionalBlock block;
-    block.type = token->text;
+    block.type = token->text.str();
     block.location = token->location;
 
     if (skipping())
@@ -922,7 +922,7 @@ int DirectiveParser::parseExpressionIf(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
     }
 
@@ -938,12 +938,12 @@ int DirectiveParser::parseExpressionIfdef(Token *token)
     if (token->type != Token::IDENTIFIER)
     {
         mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
         return 0;
     }
 
-    MacroSet::const_iterator iter = mMacroSet->find(token->text);
+    MacroSet::const_iterator iter = mMacroSet->find(token->text.str());
     int expression = iter != mMacroSet->end() ? 1 : 0;
 
     // Warn if there are tokens after #ifdef expression.
@@ -951,7 +951,7 @@ int DirectiveParser::parseExpressionIfdef(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN,
-                             token->location, token->text);
+                             token->location, token->text.str());
         skipUntilEOD(mTokenizer, token);
     }
     return expression;
@@ -207,7 +207,7 @@ int yylex(YYSTYPE *lvalp, Context *context)
         if (!token->uValue(&val))
         {
             context->diagnostics->report(pp::Diagnostics::PP_INTEGER_OVERFLOW,
-                                         token->location, token->text);
+                                         token->location, token->text.str());
         }
         *lvalp = static_cast<YYSTYPE>(val);
         type = TOK_CONST_INT;
@@ -7,8 +7,8 @@
 #ifndef COMPILER_PREPROCESSOR_MACRO_H_
 #define COMPILER_PREPROCESSOR_MACRO_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pp
@@ -43,7 +43,7 @@ struct Macro
     Replacements replacements;
 };
 
-typedef std::map<std::string, Macro> MacroSet;
+typedef std::unordered_map<std::string, Macro> MacroSet;
 
 }  // namespace pp
 #endif  // COMPILER_PREPROCESSOR_MACRO_H_
@@ -20,15 +20,15 @@ class TokenLexer : public Lexer
  public:
     typedef std::vector<Token> TokenVector;
 
-    TokenLexer(TokenVector *tokens)
+    TokenLexer(TokenVector::const_iterator begin, TokenVector::const_iterator end)
+        : mIter(begin),
+          mEnd(end)
     {
-        tokens->swap(mTokens);
-        mIter = mTokens.begin();
     }
 
     virtual void lex(Token *token)
     {
-        if (mIter == mTokens.end())
+        if (mIter == mEnd)
         {
             token->reset();
             token->type = Token::LAST;
@@ -42,8 +42,8 @@ class TokenLexer : public Lexer
  private:
     PP_DISALLOW_COPY_AND_ASSIGN(TokenLexer);
 
-    TokenVector mTokens;
     TokenVector::const_iterator mIter;
+    TokenVector::const_iterator mEnd;
 };
 
 MacroExpander::MacroExpander(Lexer *lexer,
@@ -51,7 +51,21 @@ MacroExpander::MacroExpander(Lexer *lexer,
                              Diagnostics *diagnostics)
     : mLexer(lexer),
       mMacroSet(macroSet),
-      mDiagnostics(diagnostics)
+      mDiagnostics(diagnostics),
+      mHasReserveToken(false),
+      mScratch(&mOwnScratch)
+{
+}
+
+MacroExpander::MacroExpander(Lexer *lexer,
+                             MacroSet *macroSet,
+                             Diagnostics *diagnostics,
+                             Scratch *scratch)
+    : mLexer(lexer),
+      mMacroSet(macroSet),
+      mDiagnostics(diagnostics),
+      mHasReserveToken(false),
+      mScratch(scratch)
 {
 }
 
@@ -59,7 +73,19 @@ MacroExpander::~MacroExpander()
 {
     for (std::size_t i = 0; i < mContextStack.size(); ++i)
     {
-        delete mContextStack[i];
+        mScratch->contexts.push_back(mContextStack[i]);
+    }
+}
+
+MacroExpander::Scratch::~Scratch()
+{
+    for (std::size_t i = 0; i < contexts.size(); ++i)
+    {
+        delete contexts[i];
+    }
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        delete args[i];
     }
 }
 
@@ -75,34 +101,33 @@ void MacroExpander::lex(Token *token)
         if (token->expansionDisabled())
             break;
 
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        if (iter == mMacroSet->end())
+        const Macro *macro = findMacro(*token);
+        if (!macro)
             break;
 
-        const Macro& macro = iter->second;
-        if (macro.disabled)
+        if (macro->disabled)
         {
             // If a particular token is not expanded, it is never expanded.
             token->setExpansionDisabled(true);
             break;
         }
-        if ((macro.type == Macro::kTypeFunc) && !isNextTokenLeftParen())
+        if ((macro->type == Macro::kTypeFunc) && !isNextTokenLeftParen())
         {
             // If the token immediately after the macro name is not a '(',
             // this macro should not be expanded.
             break;
         }
 
-        pushMacro(macro, *token);
+        pushMacro(*macro, *token);
     }
 }
 
 void MacroExpander::getToken(Token *token)
 {
-    if (mReserveToken.get())
+    if (mHasReserveToken)
     {
-        *token = *mReserveToken;
-        mReserveToken.reset();
+        *token = mReserveToken;
+        mHasReserveToken = false;
         return;
     }
 
@@ -114,7 +139,7 @@ void MacroExpander::getToken(Token *token)
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        mContextStack.back()->get(token);
     }
     else
     {
@@ -128,12 +153,14 @@ void MacroExpander::ungetToken(const Token &token)
     {
         MacroContext *context = mContextStack.back();
         context->unget();
-        assert(context->replacements[context->index] == token);
+        assert((*context->replacements)[context->index].type == token.type);
+        assert((*context->replacements)[context->index].text == token.text);
     }
     else
     {
-        assert(!mReserveToken.get());
-        mReserveToken.reset(new Token(token));
+        assert(!mHasReserveToken);
+        mReserveToken = token;
+        mHasReserveToken = true;
     }
 }
 
@@ -148,6 +175,15 @@ bool MacroExpander::isNextTokenLeftParen()
     return lparen;
 }
 
+const Macro *MacroExpander::findMacro(const Token &identifier)
+{
+    // The name is copied into a buffer kept between lookups, so that
+    // looking up long identifiers doesn't allocate.
+    mScratch->name.assign(identifier.text.data(), identifier.text.size());
+    MacroSet::const_iterator iter = mMacroSet->find(mScratch->name);
+    return iter != mMacroSet->end() ? &iter->second : NULL;
+}
+
 bool MacroExpander::pushMacro(const Macro &macro, const Token &identifier)
 {
     assert(!macro.disabled);
@@ -155,16 +191,16 @@ bool MacroExpander::pushMacro(const Macro &macro, const Token &identifier)
     assert(identifier.type == Token::IDENTIFIER);
     assert(identifier.text == macro.name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(macro, identifier, &replacements))
+    MacroContext *context = newContext();
+    if (!expandMacro(macro, identifier, context))
+    {
+        mScratch->contexts.push_back(context);
         return false;
+    }
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro.disabled = true;
 
-    MacroContext *context = new MacroContext;
-    context->macro = &macro;
-    context->replacements.swap(replacements);
     mContextStack.push_back(context);
     return true;
 }
@@ -179,75 +215,96 @@ void MacroExpander::popMacro()
     assert(context->empty());
     assert(context->macro->disabled);
     context->macro->disabled = false;
-    delete context;
+    mScratch->contexts.push_back(context);
+}
+
+MacroExpander::MacroContext *MacroExpander::newContext()
+{
+    if (mScratch->contexts.empty())
+        return new MacroContext;
+
+    MacroContext *context = mScratch->contexts.back();
+    mScratch->contexts.pop_back();
+    return context;
+}
+
+MacroExpander::MacroArgs *MacroExpander::newArgs()
+{
+    if (mScratch->args.empty())
+        return new MacroArgs;
+
+    MacroArgs *args = mScratch->args.back();
+    mScratch->args.pop_back();
+    args->clear();
+    return args;
 }
 
 bool MacroExpander::expandMacro(const Macro &macro,
                                 const Token &identifier,
-                                std::vector<Token> *replacements)
+                                MacroContext *context)
 {
-    replacements->clear();
+    context->macro = &macro;
+    context->index = 0;
+    context->location = identifier.location;
+    context->atStartOfLine = identifier.atStartOfLine();
+    context->hasLeadingSpace = identifier.hasLeadingSpace();
+
     if (macro.type == Macro::kTypeObj)
     {
-        replacements->assign(macro.replacements.begin(),
-                             macro.replacements.end());
-
-        if (macro.predefined)
+        if (!macro.predefined)
         {
-            const char kLine[] = "__LINE__";
-            const char kFile[] = "__FILE__";
+            context->replacements = &macro.replacements;
+            return true;
+        }
 
-            assert(replacements->size() == 1);
-            Token& repl = replacements->front();
-            if (macro.name == kLine)
-            {
-                std::ostringstream stream;
-                stream << identifier.location.line;
-                repl.text = stream.str();
-            }
-            else if (macro.name == kFile)
-            {
-                std::ostringstream stream;
-                stream << identifier.location.file;
-                repl.text = stream.str();
-            }
+        context->expansion = macro.replacements;
+
+        const char kLine[] = "__LINE__";
+        const char kFile[] = "__FILE__";
+
+        assert(context->expansion.size() == 1);
+        Token& repl = context->expansion.front();
+        if (macro.name == kLine)
+        {
+            std::ostringstream stream;
+            stream << identifier.location.line;
+            repl.text = stream.str();
+        }
+        else if (macro.name == kFile)
+        {
+            std::ostringstream stream;
+            stream << identifier.location.file;
+            repl.text = stream.str();
         }
     }
     else
     {
         assert(macro.type == Macro::kTypeFunc);
-        std::vector<MacroArg> args;
-        args.reserve(macro.parameters.size());
-        if (!collectMacroArgs(macro, identifier, &args))
-            return false;
-
-        replaceMacroParams(macro, args, replacements);
-    }
-
-    for (std::size_t i = 0; i < replacements->size(); ++i)
-    {
-        Token& repl = replacements->at(i);
-        if (i == 0)
+        MacroArgs *args = newArgs();
+        bool collected = collectMacroArgs(macro, identifier, args);
+        if (collected)
         {
-            // The first token in the replacement list inherits the padding
-            // properties of the identifier token.
-            repl.setAtStartOfLine(identifier.atStartOfLine());
-            repl.setHasLeadingSpace(identifier.hasLeadingSpace());
+            context->expansion.clear();
+            replaceMacroParams(macro, *args, &context->expansion);
         }
-        repl.location = identifier.location;
+        mScratch->args.push_back(args);
+        if (!collected)
+            return false;
     }
+
+    context->replacements = &context->expansion;
     return true;
 }
 
 bool MacroExpander::collectMacroArgs(const Macro &macro,
                                      const Token &identifier,
-                                     std::vector<MacroArg> *args)
+                                     MacroArgs *args)
 {
     Token token;
     getToken(&token);
     assert(token.type == '(');
 
-    args->push_back(MacroArg());
+    MacroArgs &unexpanded = *newArgs();
     for (int openParens = 1; openParens != 0; )
     {
         getToken(&token);
@@ -255,9 +312,10 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         if (token.type == Token::LAST)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_UNTERMINATED_INVOCATION,
-                                 identifier.location, identifier.text);
+                                 identifier.location, identifier.text.str());
             // Do not lose EOF token.
             ungetToken(token);
+            mScratch->args.push_back(&unexpanded);
             return false;
         }
 
@@ -277,7 +335,7 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
             // the comma tokens between matching inner parentheses do not
             // seperate arguments.
             if (openParens == 1)
-                args->push_back(MacroArg());
+                unexpanded.ends.push_back(unexpanded.tokens.size());
             isArg = openParens != 1;
             break;
           default:
@@ -286,52 +344,78 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         }
         if (isArg)
         {
-            MacroArg &arg = args->back();
             // Initial whitespace is not part of the argument.
-            if (arg.empty())
+            if (unexpanded.tokens.size() == unexpanded.begin(unexpanded.count()))
                 token.setHasLeadingSpace(false);
-            arg.push_back(token);
+            unexpanded.tokens.push_back(token);
         }
     }
+    // The closing parenthesis ends the last argument.
+    unexpanded.ends.push_back(unexpanded.tokens.size());
 
     const Macro::Parameters &params = macro.parameters;
     // If there is only one empty argument, it is equivalent to no argument.
-    if (params.empty() && (args->size() == 1) && args->front().empty())
+    if (params.empty() && (unexpanded.count() == 1) && unexpanded.tokens.empty())
     {
-        args->clear();
+        unexpanded.clear();
     }
     // Validate the number of arguments.
-    if (args->size() != params.size())
+    if (unexpanded.count() != params.size())
     {
-        Diagnostics::ID id = args->size() < macro.parameters.size() ?
+        Diagnostics::ID id = unexpanded.count() < macro.parameters.size() ?
             Diagnostics::PP_MACRO_TOO_FEW_ARGS :
             Diagnostics::PP_MACRO_TOO_MANY_ARGS;
-        mDiagnostics->report(id, identifier.location, identifier.text);
+        mDiagnostics->report(id, identifier.location, identifier.text.str());
+        mScratch->args.push_back(&unexpanded);
         return false;
     }
 
     // Pre-expand each argument before substitution.
     // This step expands each argument individually before they are
-    // inserted into the macro body.
-    for (std::size_t i = 0; i < args->size(); ++i)
+    // inserted into the macro body. Arguments that name no macro expand
+    // to themselves, so they are copied as they are.
+    args->clear();
+    for (std::size_t i = 0; i < unexpanded.count(); ++i)
     {
-        MacroArg &arg = args->at(i);
-        TokenLexer lexer(&arg);
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics);
-
-        arg.clear();
-        expander.lex(&token);
-        while (token.type != Token::LAST)
+        std::vector<Token>::const_iterator begin = unexpanded.tokens.begin() + unexpanded.begin(i);
+        std::vector<Token>::const_iterator end = unexpanded.tokens.begin() + unexpanded.end(i);
+        if (!containsMacroName(begin, end))
         {
-            arg.push_back(token);
+            args->tokens.insert(args->tokens.end(), begin, end);
+        }
+        else
+        {
+            TokenLexer lexer(begin, end);
+            MacroExpander expander(&lexer, mMacroSet, mDiagnostics, mScratch);
+
             expander.lex(&token);
+            while (token.type != Token::LAST)
+            {
+                args->tokens.push_back(token);
+                expander.lex(&token);
+            }
         }
+        args->ends.push_back(args->tokens.size());
     }
+    mScratch->args.push_back(&unexpanded);
     return true;
 }
 
+bool MacroExpander::containsMacroName(std::vector<Token>::const_iterator begin,
+                                      std::vector<Token>::const_iterator end)
+{
+    for (std::vector<Token>::const_iterator iter = begin; iter != end; ++iter)
+    {
+        // Names of disabled macros count too: expanding marks them so that
+        // they are never expanded.
+        if (iter->type == Token::IDENTIFIER && !iter->expansionDisabled() && findMacro(*iter))
+            return true;
+    }
+    return false;
+}
+
 void MacroExpander::replaceMacroParams(const Macro &macro,
-                                       const std::vector<MacroArg> &args,
+                                       const MacroArgs &args,
                                        std::vector<Token> *replacements)
 {
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
@@ -355,13 +439,16 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
         }
 
         std::size_t iArg = std::distance(macro.parameters.begin(), iter);
-        const MacroArg &arg = args[iArg];
-        if (arg.empty())
+        std::size_t argBegin = args.begin(iArg);
+        std::size_t argEnd = args.end(iArg);
+        if (argBegin == argEnd)
         {
             continue;
         }
         std::size_t iRepl = replacements->size();
-        replacements->insert(replacements->end(), arg.begin(), arg.end());
+        replacements->insert(replacements->end(),
+                             args.tokens.begin() + argBegin,
+                             args.tokens.begin() + argEnd);
         // The replacement token inherits padding properties from
         // macro replacement token.
         replacements->at(iRepl).setHasLeadingSpace(repl.hasLeadingSpace());
@@ -8,11 +8,12 @@
 #define COMPILER_PREPROCESSOR_MACRO_EXPANDER_H_
 
 #include <cassert>
-#include <memory>
+#include <string>
 #include <vector>
 
 #include "Lexer.h"
 #include "Macro.h"
+#include "Token.h"
 #include "pp_utils.h"
 
 namespace pp
@@ -31,43 +32,104 @@ class MacroExpander : public Lexer
   private:
     PP_DISALLOW_COPY_AND_ASSIGN(MacroExpander);
 
+    struct MacroContext;
+    struct MacroArgs;
+
+    // Storage kept between macro invocations, so that expanding macros
+    // stops allocating once it has grown. The expanders that pre-expand
+    // macro arguments share the storage of the one that created them.
+    struct Scratch
+    {
+        ~Scratch();
+
+        std::string name;
+        std::vector<MacroContext *> contexts;
+        std::vector<MacroArgs *> args;
+    };
+
+    MacroExpander(Lexer *lexer, MacroSet *macroSet, Diagnostics *diagnostics, Scratch *scratch);
+
+    MacroContext *newContext();
+    MacroArgs *newArgs();
+
+    // The arguments of a macro invocation, laid end to end so that
+    // collecting them doesn't allocate once the vectors have grown.
+    // Argument i is tokens[begin(i)] up to tokens[end(i)].
+    struct MacroArgs
+    {
+        std::vector<Token> tokens;
+        std::vector<std::size_t> ends;
+
+        std::size_t count() const { return ends.size(); }
+        std::size_t begin(std::size_t i) const { return i == 0 ? 0 : ends[i - 1]; }
+        std::size_t end(std::size_t i) const { return ends[i]; }
+        void clear()
+        {
+            tokens.clear();
+            ends.clear();
+        }
+    };
+
     void getToken(Token *token);
     void ungetToken(const Token &token);
     bool isNextTokenLeftParen();
 
+    // Returns the macro named by the identifier, or NULL.
+    const Macro *findMacro(const Token &identifier);
+
     bool pushMacro(const Macro &macro, const Token &identifier);
     void popMacro();
 
     bool expandMacro(const Macro &macro,
                      const Token &identifier,
-                     std::vector<Token> *replacements);
+                     MacroContext *context);
 
-    typedef std::vector<Token> MacroArg;
     bool collectMacroArgs(const Macro &macro,
                           const Token &identifier,
-                          std::vector<MacroArg> *args);
+                          MacroArgs *args);
+    bool containsMacroName(std::vector<Token>::const_iterator begin,
+                           std::vector<Token>::const_iterator end);
     void replaceMacroParams(const Macro &macro,
-                            const std::vector<MacroArg> &args,
+                            const MacroArgs &args,
                             std::vector<Token> *replacements);
 
     struct MacroContext
     {
         const Macro *macro;
         std::size_t index;
-        std::vector<Token> replacements;
+        // The tokens the macro expands to. These are the replacement list
+        // of the macro itself unless arguments had to be substituted, so
+        // object-like macros are expanded without copying it.
+        const std::vector<Token> *replacements;
+        std::vector<Token> expansion;
+        // The replacements take the location of the macro name, and the
+        // first one takes its padding.
+        SourceLocation location;
+        bool atStartOfLine;
+        bool hasLeadingSpace;
 
         MacroContext()
             : macro(0),
-              index(0)
+              index(0),
+              replacements(0),
+              atStartOfLine(false),
+              hasLeadingSpace(false)
         {
         }
         bool empty() const
         {
-            return index == replacements.size();
+            return index == replacements->size();
         }
-        const Token &get()
+        void get(Token *token)
         {
-            return replacements[index++];
+            *token = (*replacements)[index];
+            if (index == 0)
+            {
+                token->setAtStartOfLine(atStartOfLine);
+                token->setHasLeadingSpace(hasLeadingSpace);
+            }
+            token->location = location;
+            ++index;
         }
         void unget()
         {
@@ -80,8 +142,12 @@ class MacroExpander : public Lexer
     MacroSet *mMacroSet;
     Diagnostics *mDiagnostics;
 
-    std::auto_ptr<Token> mReserveToken;
+    bool mHasReserveToken;
+    Token mReserveToken;
     std::vector<MacroContext *> mContextStack;
+
+    Scratch mOwnScratch;
+    Scratch *mScratch;
 };
 
 }  // namespace pp
@@ -97,11 +97,11 @@ void Preprocessor::lex(Token *token)
             break;
           case Token::PP_NUMBER:
             mImpl->diagnostics->report(Diagnostics::PP_INVALID_NUMBER,
-                                       token->location, token->text);
+                                       token->location, token->text.str());
             break;
           case Token::PP_OTHER:
             mImpl->diagnostics->report(Diagnostics::PP_INVALID_CHARACTER,
-                                       token->location, token->text);
+                                       token->location, token->text.str());
             break;
           default:
             validToken = true;
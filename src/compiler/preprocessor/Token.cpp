@@ -13,6 +13,42 @@
 namespace pp
 {
 
+TokenText::TokenText(const TokenText &other)
+    : mData(other.mData),
+      mSize(other.mSize)
+{
+    if (other.isOwned())
+        assign(other.mData, other.mSize);
+}
+
+TokenText &TokenText::operator=(const TokenText &other)
+{
+    if (this == &other)
+        return *this;
+    if (other.isOwned())
+        assign(other.mData, other.mSize);
+    else
+        setView(other.mData, other.mSize);
+    return *this;
+}
+
+void TokenText::assign(const char *data, size_t size)
+{
+    if (size == 0)
+    {
+        clear();
+        return;
+    }
+    mOwned.assign(data, size);
+    mData = mOwned.data();
+    mSize = size;
+}
+
+std::ostream &operator<<(std::ostream &out, const TokenText &text)
+{
+    return out.write(text.data(), text.size());
+}
+
 void Token::reset()
 {
     type = 0;
@@ -56,19 +92,19 @@ void Token::setExpansionDisabled(bool disable)
 bool Token::iValue(int *value) const
 {
     assert(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(text.str(), value);
 }
 
 bool Token::uValue(unsigned int *value) const
 {
     assert(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(text.str(), value);
 }
 
 bool Token::fValue(float *value) const
 {
     assert(type == CONST_FLOAT);
-    return numeric_lex_float(text, value);
+    return numeric_lex_float(text.str(), value);
 }
 
 std::ostream &operator<<(std::ostream &out, const Token &token)
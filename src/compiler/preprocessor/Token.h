@@ -7,6 +7,7 @@
 #ifndef COMPILER_PREPROCESSOR_TOKEN_H_
 #define COMPILER_PREPROCESSOR_TOKEN_H_
 
+#include <cstring>
 #include <ostream>
 #include <string>
 
@@ -15,6 +16,95 @@
 namespace pp
 {
 
+// The text of a token. It usually refers to characters that outlive the
+// token: the shader source read by the Tokenizer, or a string literal, so
+// that lexing and copying tokens doesn't allocate. Text that exists nowhere
+// else, like the value of __LINE__, is copied and owned by the token.
+class TokenText
+{
+  public:
+    TokenText()
+        : mData(""),
+          mSize(0)
+    {
+    }
+    TokenText(const TokenText &other);
+    TokenText &operator=(const TokenText &other);
+
+    // Refers to the size characters at data, which must outlive the text
+    // and all of its copies.
+    void setView(const char *data, size_t size)
+    {
+        mData = data;
+        mSize = size;
+    }
+
+    // Copies the characters.
+    void assign(const char *data, size_t size);
+    void assign(const char *str) { assign(str, std::strlen(str)); }
+    TokenText &operator=(const std::string &str)
+    {
+        assign(str.data(), str.size());
+        return *this;
+    }
+    TokenText &operator=(const char *str)
+    {
+        assign(str);
+        return *this;
+    }
+
+    void clear() { setView("", 0); }
+    // Keeps the first size characters.
+    void erase(size_t size)
+    {
+        if (size < mSize)
+            mSize = size;
+    }
+
+    // The characters aren't null-terminated.
+    const char *data() const { return mData; }
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    char operator[](size_t index) const { return mData[index]; }
+
+    std::string str() const { return std::string(mData, mSize); }
+
+    bool equals(const char *data, size_t size) const
+    {
+        return mSize == size && std::memcmp(mData, data, size) == 0;
+    }
+
+  private:
+    bool isOwned() const { return !mOwned.empty() && mData == mOwned.data(); }
+
+    const char *mData;
+    size_t mSize;
+    std::string mOwned;
+};
+
+inline bool operator==(const TokenText &lhs, const TokenText &rhs)
+{
+    return lhs.equals(rhs.data(), rhs.size());
+}
+inline bool operator==(const TokenText &lhs, const std::string &rhs)
+{
+    return lhs.equals(rhs.data(), rhs.size());
+}
+inline bool operator==(const TokenText &lhs, const char *rhs)
+{
+    return lhs.equals(rhs, std::strlen(rhs));
+}
+inline bool operator==(const std::string &lhs, const TokenText &rhs) { return rhs == lhs; }
+inline bool operator==(const char *lhs, const TokenText &rhs) { return rhs == lhs; }
+
+inline bool operator!=(const TokenText &lhs, const TokenText &rhs) { return !(lhs == rhs); }
+inline bool operator!=(const TokenText &lhs, const std::string &rhs) { return !(lhs == rhs); }
+inline bool operator!=(const TokenText &lhs, const char *rhs) { return !(lhs == rhs); }
+inline bool operator!=(const std::string &lhs, const TokenText &rhs) { return !(rhs == lhs); }
+inline bool operator!=(const char *lhs, const TokenText &rhs) { return !(rhs == lhs); }
+
+extern std::ostream &operator<<(std::ostream &out, const TokenText &text);
+
 struct Token
 {
     enum Type
@@ -100,7 +190,7 @@ struct Token
     int type;
     unsigned int flags;
     SourceLocation location;
-    std::string text;
+    TokenText text;
 };
 
 inline bool operator==(const Token &lhs, const Token &rhs)
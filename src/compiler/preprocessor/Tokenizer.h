@@ -7,6 +7,9 @@
 #ifndef COMPILER_PREPROCESSOR_TOKENIZER_H_
 #define COMPILER_PREPROCESSOR_TOKENIZER_H_
 
+#include <string>
+#include <vector>
+
 #include "Input.h"
 #include "Lexer.h"
 #include "pp_utils.h"
@@ -16,23 +19,13 @@ namespace pp
 
 class Diagnostics;
 
+// Splits the shader source into preprocessing tokens. A single string is
+// scanned in place; multiple strings are joined once, so that tokens can
+// span them. Token text refers to the caller's strings whenever the token
+// lies within one of them.
 class Tokenizer : public Lexer
 {
   public:
-    struct Context
-    {
-        Diagnostics *diagnostics;
-
-        Input input;
-        // The location where yytext points to. Token location should track
-        // scanLoc instead of Input::mReadLoc because they may not be the same
-        // if text is buffered up in the scanner input buffer.
-        Input::Location scanLoc;
-
-        bool leadingSpace;
-        bool lineStart;
-    };
-
     Tokenizer(Diagnostics *diagnostics);
     ~Tokenizer();
 
@@ -46,14 +39,42 @@ class Tokenizer : public Lexer
 
   private:
     PP_DISALLOW_COPY_AND_ASSIGN(Tokenizer);
-    bool initScanner();
-    void destroyScanner();
 
-    void *mHandle;  // Scanner handle.
-    Context mContext;  // Scanner extra.
+    int scan(Token *token);
+    void scanBlockComment();
+    void setTokenText(Token *token, const char *start, size_t length);
+
+    // Moves the string index past the strings that end before pos, like
+    // every match of the scanner used to. The file number increases and
+    // the line number restarts with every string.
+    void advanceString(const char *pos)
+    {
+        if (pos >= mStringEnd)
+            advanceStringSlow(pos);
+    }
+    void advanceStringSlow(const char *pos);
+    const char *stringStart(size_t index) const;
+    void reportEndOfInput(Token *token);
+
+    Diagnostics *mDiagnostics;
+    Input mInput;
+    std::string mJoined;  // The strings joined, when there is more than one.
+    std::vector<size_t> mOffsets;  // The offset of each string in mJoined.
+
+    const char *mBegin;  // The text being scanned.
+    const char *mEnd;
+    const char *mCurrent;
+
+    size_t mStringIndex;  // The string that the last match started in.
+    const char *mStringEnd;  // Its end, within the scanned text.
+    int mFileNumber;
+    int mLineNumber;
+    bool mInComment;
+
+    bool mLeadingSpace;
+    bool mLineStart;
     size_t mMaxTokenSize; // Maximum token size
 };
 
 }  // namespace pp
 #endif  // COMPILER_PREPROCESSOR_TOKENIZER_H_
-
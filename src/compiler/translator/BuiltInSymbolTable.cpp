@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/BuiltInSymbolTable.h"
+
+#include "compiler/translator/Initialize.h"
+#include "angle_gl.h"
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+
+typedef std::map<std::string, TBuiltInSymbolTable *> BuiltInSymbolTableMap;
+
+// Guards the cache and the reference counts of the tables in it. The cache
+// holds no references of its own: a table is in it while some compiler
+// uses it.
+std::mutex cacheMutex;
+BuiltInSymbolTableMap cache;
+
+// Only the resources that InsertBuiltInFunctions and IdentifyBuiltIns read
+// are part of the key, so that compilers which differ in limits that are
+// checked at compile time, like MaxExpressionComplexity, still share.
+std::string CacheKey(sh::GLenum type, ShShaderSpec spec, const ShBuiltInResources &resources)
+{
+    std::ostringstream key;
+    key << ":Type:" << type << ":Spec:" << spec
+        << ":MaxVertexAttribs:" << resources.MaxVertexAttribs
+        << ":MaxVertexUniformVectors:" << resources.MaxVertexUniformVectors
+        << ":MaxVaryingVectors:" << resources.MaxVaryingVectors
+        << ":MaxVertexTextureImageUnits:" << resources.MaxVertexTextureImageUnits
+        << ":MaxCombinedTextureImageUnits:" << resources.MaxCombinedTextureImageUnits
+        << ":MaxTextureImageUnits:" << resources.MaxTextureImageUnits
+        << ":MaxFragmentUniformVectors:" << resources.MaxFragmentUniformVectors
+        << ":MaxDrawBuffers:" << resources.MaxDrawBuffers
+        << ":OES_standard_derivatives:" << resources.OES_standard_derivatives
+        << ":OES_EGL_image_external:" << resources.OES_EGL_image_external
+        << ":ARB_texture_rectangle:" << resources.ARB_texture_rectangle
+        << ":FragmentPrecisionHigh:" << resources.FragmentPrecisionHigh
+        << ":EXT_frag_depth:" << resources.EXT_frag_depth
+        << ":EXT_shader_texture_lod:" << resources.EXT_shader_texture_lod
+        << ":MaxVertexOutputVectors:" << resources.MaxVertexOutputVectors
+        << ":MaxFragmentInputVectors:" << resources.MaxFragmentInputVectors
+        << ":MinProgramTexelOffset:" << resources.MinProgramTexelOffset
+        << ":MaxProgramTexelOffset:" << resources.MaxProgramTexelOffset;
+    return key.str();
+}
+
+}  // namespace
+
+TBuiltInSymbolTable::TBuiltInSymbolTable(sh::GLenum type,
+                                         ShShaderSpec spec,
+                                         const ShBuiltInResources &resources,
+                                         const std::string &key)
+    : mKey(key),
+      mRefCount(0)
+{
+    // Symbols are allocated from the global pool, which may belong to the
+    // compiler that triggered the build.
+    TPoolAllocator *previousAllocator = GetGlobalPoolAllocator();
+    mAllocator.push();
+    SetGlobalPoolAllocator(&mAllocator);
+
+    mSymbolTable.push();   // COMMON_BUILTINS
+    mSymbolTable.push();   // ESSL1_BUILTINS
+    mSymbolTable.push();   // ESSL3_BUILTINS
+
+    TPublicType integer;
+    integer.type = EbtInt;
+    integer.primarySize = 1;
+    integer.secondarySize = 1;
+    integer.array = false;
+
+    TPublicType floatingPoint;
+    floatingPoint.type = EbtFloat;
+    floatingPoint.primarySize = 1;
+    floatingPoint.secondarySize = 1;
+    floatingPoint.array = false;
+
+    TPublicType sampler;
+    sampler.primarySize = 1;
+    sampler.secondarySize = 1;
+    sampler.array = false;
+
+    switch(type)
+    {
+      case GL_FRAGMENT_SHADER:
+        mSymbolTable.setDefaultPrecision(integer, EbpMedium);
+        break;
+      case GL_VERTEX_SHADER:
+        mSymbolTable.setDefaultPrecision(integer, EbpHigh);
+        mSymbolTable.setDefaultPrecision(floatingPoint, EbpHigh);
+        break;
+      default:
+        assert(false && "Language not supported");
+    }
+    // We set defaults for all the sampler types, even those that are
+    // only available if an extension exists.
+    for (int samplerType = EbtGuardSamplerBegin + 1;
+         samplerType < EbtGuardSamplerEnd; ++samplerType)
+    {
+        sampler.type = static_cast<TBasicType>(samplerType);
+        mSymbolTable.setDefaultPrecision(sampler, EbpLow);
+    }
+
+    InsertBuiltInFunctions(type, spec, resources, mSymbolTable);
+
+    IdentifyBuiltIns(type, spec, resources, mSymbolTable);
+
+    // From here on the table is only read.
+    mSymbolTable.computeCachedData();
+
+    SetGlobalPoolAllocator(previousAllocator);
+}
+
+TBuiltInSymbolTable::~TBuiltInSymbolTable()
+{
+    // The symbols live in mAllocator, so deleting them must not reach
+    // whichever pool the calling thread happens to be using.
+    TPoolAllocator *previousAllocator = GetGlobalPoolAllocator();
+    SetGlobalPoolAllocator(&mAllocator);
+    while (!mSymbolTable.isEmpty())
+        mSymbolTable.pop();
+    SetGlobalPoolAllocator(previousAllocator);
+}
+
+TBuiltInSymbolTable *TBuiltInSymbolTable::Acquire(sh::GLenum type,
+                                                  ShShaderSpec spec,
+                                                  const ShBuiltInResources &resources)
+{
+    const std::string key = CacheKey(type, spec, resources);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    TBuiltInSymbolTable *&builtIns = cache[key];
+    if (!builtIns)
+        builtIns = new TBuiltInSymbolTable(type, spec, resources, key);
+
+    ++builtIns->mRefCount;
+    return builtIns;
+}
+
+void TBuiltInSymbolTable::release()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    ASSERT(mRefCount > 0);
+    if (--mRefCount == 0)
+    {
+        cache.erase(mKey);
+        delete this;
+    }
+}
+
+size_t TBuiltInSymbolTable::GetCachedTableCount()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache.size();
+}
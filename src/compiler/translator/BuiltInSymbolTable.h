@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+#define COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+
+#include "GLSLANG/ShaderLang.h"
+
+#include <string>
+
+//
+// The built-in levels (COMMON_BUILTINS, ESSL1_BUILTINS and ESSL3_BUILTINS)
+// of the symbol table for one shader type, spec and set of resources.
+//
+// The levels are built once, frozen, and shared read-only by the symbol
+// tables of every live compiler constructed with the same parameters.
+// The table keeps its own pool allocator, so it is independent of the
+// lifetime of any one compiler.
+//
+class TBuiltInSymbolTable
+{
+  public:
+    // Returns the table for the given parameters, building it on first use.
+    // The caller holds a reference to the table and must call release()
+    // when done with it. The table is freed with its last reference.
+    static TBuiltInSymbolTable *Acquire(sh::GLenum type,
+                                        ShShaderSpec spec,
+                                        const ShBuiltInResources &resources);
+    void release();
+
+    // The number of distinct tables in use in the process.
+    static size_t GetCachedTableCount();
+
+    const TSymbolTable &getSymbolTable() const { return mSymbolTable; }
+
+  private:
+    TBuiltInSymbolTable(sh::GLenum type,
+                        ShShaderSpec spec,
+                        const ShBuiltInResources &resources,
+                        const std::string &key);
+    ~TBuiltInSymbolTable();
+    DISALLOW_COPY_AND_ASSIGN(TBuiltInSymbolTable);
+
+    // Must be declared before mSymbolTable, whose symbols it owns.
+    TPoolAllocator mAllocator;
+    TSymbolTable mSymbolTable;
+
+    const std::string mKey;
+
+    // Guarded by the cache mutex.
+    int mRefCount;
+};
+
+#endif  // COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/CallDAG.h"
+
+#include <algorithm>
+
+const size_t CallDAG::InvalidIndex = static_cast<size_t>(-1);
+const int CallDAG::kInfiniteCallDepth;
+
+CallDAG::Builder::Builder(CallDAG *dag)
+    : mDag(dag),
+      mCurrentFunction(InvalidIndex),
+      mFunctionDepth(0)
+{
+    mDag->clear();
+}
+
+bool CallDAG::Builder::visitAggregate(Visit, TIntermAggregate *node)
+{
+    countNode();
+
+    switch (node->getOp())
+    {
+      case EOpFunction:
+        // Function definition.
+        mCurrentFunction = mDag->findOrAddRecord(node->getName());
+        mFunctionDepth = mDepth;
+        mDag->mRecords[mCurrentFunction].node = node;
+        mDag->mRecords[mCurrentFunction].nodeBegin = mNodeCount - 1;
+        break;
+      case EOpFunctionCall:
+        // Calls in the initializers of globals aren't made by any function.
+        if (mCurrentFunction != InvalidIndex)
+        {
+            size_t callee = mDag->findOrAddRecord(node->getName());
+            std::vector<size_t> &callees = mDag->mRecords[mCurrentFunction].callees;
+            if (std::find(callees.begin(), callees.end(), callee) == callees.end())
+                callees.push_back(callee);
+        }
+        break;
+      default:
+        // Prototypes are left out: their name is not mangled, and they say
+        // nothing about the calls.
+        break;
+    }
+    return true;
+}
+
+void CallDAG::Builder::endFunction()
+{
+    mDag->mRecords[mCurrentFunction].nodeEnd = mNodeCount;
+    mCurrentFunction = InvalidIndex;
+}
+
+CallDAG::InitResult CallDAG::Builder::finish()
+{
+    if (mCurrentFunction != InvalidIndex)
+        endFunction();
+    return mDag->orderRecords();
+}
+
+CallDAG::CallDAG()
+{
+}
+
+CallDAG::~CallDAG()
+{
+}
+
+CallDAG::InitResult CallDAG::init(TIntermNode *root)
+{
+    Builder builder(this);
+    root->traverse(&builder);
+    return builder.finish();
+}
+
+void CallDAG::clear()
+{
+    mRecords.clear();
+    mIndices.clear();
+}
+
+size_t CallDAG::findIndex(const TString &name) const
+{
+    IndexMap::const_iterator iter = mIndices.find(&name);
+    return (iter != mIndices.end() ? iter->second : InvalidIndex);
+}
+
+size_t CallDAG::findOrAddRecord(const TString &name)
+{
+    std::pair<IndexMap::iterator, bool> inserted =
+        mIndices.insert(std::make_pair(&name, mRecords.size()));
+    if (inserted.second)
+    {
+        Record record;
+        record.name = &name;
+        record.node = NULL;
+        record.nodeBegin = 0;
+        record.nodeEnd = 0;
+        record.depth = 0;
+        mRecords.push_back(record);
+    }
+    return inserted.first->second;
+}
+
+// Sorts the records in the order in which a depth-first search over the
+// calls finishes them, which puts the callees first, and computes the depths
+// on the way. The search keeps its own stack, since the chains of calls of a
+// shader can be longer than the native stack allows. A function that calls
+// one still being searched, or one that can reach a recursion, can reach a
+// recursion itself.
+CallDAG::InitResult CallDAG::orderRecords()
+{
+    mStates.assign(mRecords.size(), kUnvisited);
+    mOrder.clear();
+    mStack.clear();
+    bool recursion = false;
+
+    for (size_t start = 0; start < mRecords.size(); ++start)
+    {
+        if (mStates[start] != kUnvisited)
+            continue;
+        mStates[start] = kSearching;
+        mRecords[start].depth = 1;
+        mStack.push_back(std::make_pair(start, 0));
+
+        while (!mStack.empty())
+        {
+            size_t index = mStack.back().first;
+            Record &record = mRecords[index];
+            if (mStack.back().second < record.callees.size())
+            {
+                size_t callee = record.callees[mStack.back().second++];
+                if (mStates[callee] == kUnvisited)
+                {
+                    mStates[callee] = kSearching;
+                    mRecords[callee].depth = 1;
+                    mStack.push_back(std::make_pair(callee, 0));
+                }
+                else if (mStates[callee] == kSearching)
+                {
+                    record.depth = kInfiniteCallDepth;
+                    recursion = true;
+                }
+                else if (record.depth != kInfiniteCallDepth)
+                {
+                    int calleeDepth = mRecords[callee].depth;
+                    record.depth = (calleeDepth == kInfiniteCallDepth ?
+                                    kInfiniteCallDepth :
+                                    std::max(record.depth, calleeDepth + 1));
+                }
+                continue;
+            }
+
+            mStates[index] = kFinished;
+            mOrder.push_back(index);
+            mStack.pop_back();
+            if (!mStack.empty())
+            {
+                Record &caller = mRecords[mStack.back().first];
+                if (caller.depth != kInfiniteCallDepth)
+                {
+                    caller.depth = (record.depth == kInfiniteCallDepth ?
+                                    kInfiniteCallDepth :
+                                    std::max(caller.depth, record.depth + 1));
+                }
+            }
+        }
+    }
+
+    // The functions that can reach a recursion go last, in the order in
+    // which they finished.
+    mNewIndices.resize(mRecords.size());
+    size_t newIndex = 0;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        bool finite = (pass == 0);
+        for (size_t i = 0; i < mOrder.size(); ++i)
+        {
+            if ((mRecords[mOrder[i]].depth != kInfiniteCallDepth) == finite)
+                mNewIndices[mOrder[i]] = newIndex++;
+        }
+    }
+
+    mSortedRecords.resize(mRecords.size());
+    for (size_t i = 0; i < mRecords.size(); ++i)
+    {
+        Record &record = mSortedRecords[mNewIndices[i]];
+        std::swap(record, mRecords[i]);
+        for (size_t j = 0; j < record.callees.size(); ++j)
+            record.callees[j] = mNewIndices[record.callees[j]];
+    }
+    mRecords.swap(mSortedRecords);
+    mSortedRecords.clear();
+    for (IndexMap::iterator iter = mIndices.begin(); iter != mIndices.end(); ++iter)
+        iter->second = mNewIndices[iter->second];
+
+    return (recursion ? INITDAG_RECURSION : INITDAG_SUCCESS);
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CallDAG.h: The graph of the calls between the user-defined functions of a
+// shader. The compiler builds it once per compile, in the walk that validates
+// the tree, for the passes that need to know which function calls which.
+//
+
+#ifndef COMPILER_TRANSLATOR_CALL_DAG_H_
+#define COMPILER_TRANSLATOR_CALL_DAG_H_
+
+#include <limits.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "compiler/translator/IntermNode.h"
+
+class CallDAG
+{
+  public:
+    static const size_t InvalidIndex;
+    // The depth of the functions that can reach a recursion.
+    static const int kInfiniteCallDepth = INT_MAX;
+
+    // What the DAG knows of a function.
+    struct Record
+    {
+        // The mangled name, which is unique.
+        const TString *name;
+        // The definition, or NULL if the function is only called.
+        TIntermAggregate *node;
+        // The indices of the functions it calls, each once, in the order of
+        // their first call.
+        std::vector<size_t> callees;
+        // The preorder numbers of the nodes of the definition, the walk of
+        // the whole tree counting from 0, are in [nodeBegin, nodeEnd).
+        size_t nodeBegin;
+        size_t nodeEnd;
+        // The number of functions on the longest chain of calls starting
+        // here, this one included, or kInfiniteCallDepth.
+        int depth;
+    };
+
+    enum InitResult
+    {
+        INITDAG_SUCCESS,
+        INITDAG_RECURSION
+    };
+
+    // Collects the function definitions and calls of the tree it walks. It
+    // only reads the tree, so it can share a walk with other passes in a
+    // CompositeTraverser. The walk must start at the root. It numbers the
+    // nodes as it counts them, so it also gives the size of the tree.
+    class Builder : public TNodeCounter
+    {
+      public:
+        explicit Builder(CallDAG *dag);
+
+        virtual bool visitAggregate(Visit, TIntermAggregate *node);
+
+        // Builds the DAG from what the walk collected.
+        InitResult finish();
+
+      protected:
+        // Functions are only defined at global scope, so a definition ends
+        // where the next global starts, and there is no need for post-visits.
+        virtual void countNode()
+        {
+            if (mDepth <= mFunctionDepth && mCurrentFunction != InvalidIndex)
+                endFunction();
+            TNodeCounter::countNode();
+        }
+
+      private:
+        void endFunction();
+
+        CallDAG *mDag;
+        size_t mCurrentFunction;
+        // The depth of the definition, which is the root when it is the only
+        // global.
+        int mFunctionDepth;
+    };
+
+    CallDAG();
+    ~CallDAG();
+
+    // Builds the DAG of root in a walk of its own.
+    InitResult init(TIntermNode *root);
+    void clear();
+
+    // The records are in topological order: every function comes after the
+    // functions it calls. The ones that can reach a recursion come last.
+    size_t size() const { return mRecords.size(); }
+    const Record &getRecord(size_t index) const { return mRecords[index]; }
+    // Returns InvalidIndex if the function is neither defined nor called.
+    size_t findIndex(const TString &name) const;
+
+  private:
+    struct NameLess
+    {
+        bool operator()(const TString *a, const TString *b) const { return *a < *b; }
+    };
+    typedef std::map<const TString *, size_t, NameLess> IndexMap;
+
+    size_t findOrAddRecord(const TString &name);
+    InitResult orderRecords();
+
+    std::vector<Record> mRecords;
+    // The names point into the tree, so the DAG is cleared before the tree
+    // is freed.
+    IndexMap mIndices;
+
+    // Used by orderRecords, and kept from one compile to the next to reuse
+    // their storage.
+    enum SearchState
+    {
+        kUnvisited,
+        kSearching,
+        kFinished
+    };
+    std::vector<SearchState> mStates;
+    std::vector<size_t> mOrder;
+    // The functions being searched, with the position of their next callee.
+    std::vector<std::pair<size_t, size_t> > mStack;
+    std::vector<size_t> mNewIndices;
+    std::vector<Record> mSortedRecords;
+
+    CallDAG(const CallDAG &);
+    void operator=(const CallDAG &);
+};
+
+#endif  // COMPILER_TRANSLATOR_CALL_DAG_H_
@@ -49,6 +49,11 @@ inline TString* NewPoolTString(const char* s)
 	void* memory = GetGlobalPoolAllocator()->allocate(sizeof(TString));
 	return new(memory) TString(s);
 }
+inline TString* NewPoolTString(const char* s, size_t length)
+{
+	void* memory = GetGlobalPoolAllocator()->allocate(sizeof(TString));
+	return new(memory) TString(s, length);
+}
 
 //
 // Persistent string memory.  Should only be used for strings that survive
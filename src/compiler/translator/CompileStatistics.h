@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompileStatistics.h: Times the phases of a compile for
+// ShGetCompileStatistics.
+//
+
+#ifndef COMPILER_TRANSLATOR_COMPILE_STATISTICS_H_
+#define COMPILER_TRANSLATOR_COMPILE_STATISTICS_H_
+
+#include <chrono>
+
+#include "GLSLANG/ShaderLang.h"
+
+// Returns the time of a monotonic clock, in nanoseconds.
+inline khronos_uint64_t GetStatisticsTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//
+// Adds the time from its construction to its destruction to a phase of the
+// statistics. The statistics are NULL unless SH_COMPILE_STATISTICS is
+// given, and then the timer doesn't read the clock.
+//
+class TScopedPhaseTimer
+{
+  public:
+    TScopedPhaseTimer(ShCompileStatistics *statistics, ShCompilePhase phase)
+        : mStatistics(statistics),
+          mPhase(phase),
+          mStart(statistics ? GetStatisticsTime() : 0)
+    {
+    }
+    ~TScopedPhaseTimer()
+    {
+        if (mStatistics)
+            mStatistics->phaseTimes[mPhase] += GetStatisticsTime() - mStart;
+    }
+
+  private:
+    ShCompileStatistics *mStatistics;
+    ShCompilePhase mPhase;
+    khronos_uint64_t mStart;
+};
+
+#endif  // COMPILER_TRANSLATOR_COMPILE_STATISTICS_H_
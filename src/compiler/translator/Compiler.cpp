@@ -5,16 +5,24 @@
 //
 
 #include "compiler/translator/BuiltInFunctionEmulator.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
+#include "compiler/translator/CompileStatistics.h"
 #include "compiler/translator/Compiler.h"
+#include "compiler/translator/CompositeTraverser.h"
 #include "compiler/translator/DetectCallDepth.h"
+#include "compiler/translator/Diagnostics.h"
+#include "compiler/translator/FoldConstants.h"
 #include "compiler/translator/ForLoopUnroll.h"
 #include "compiler/translator/Initialize.h"
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/InitializeVariables.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/Preprocess.h"
+#include "compiler/translator/PruneUnusedDeclarations.h"
 #include "compiler/translator/RegenerateStructNames.h"
 #include "compiler/translator/RenameFunction.h"
 #include "compiler/translator/ScalarizeVecAndMatConstructorArgs.h"
+#include "compiler/translator/TranslationCache.h"
 #include "compiler/translator/UnfoldShortCircuitAST.h"
 #include "compiler/translator/ValidateLimitations.h"
 #include "compiler/translator/ValidateOutputs.h"
@@ -71,7 +79,9 @@ class TScopedPoolAllocator
 class TScopedSymbolTableLevel
 {
   public:
-    TScopedSymbolTableLevel(TSymbolTable* table) : mTable(table)
+    TScopedSymbolTableLevel(TSymbolTable* table)
+        : mTable(table),
+          mUniqueIdCounter(table->getUniqueIdCounter())
     {
         ASSERT(mTable->atBuiltInLevel());
         mTable->push();
@@ -80,10 +90,13 @@ class TScopedSymbolTableLevel
     {
         while (!mTable->atBuiltInLevel())
             mTable->pop();
+        // Hand out the same ids to user-defined symbols on every compile.
+        mTable->resetUniqueIdCounter(mUniqueIdCounter);
     }
 
   private:
     TSymbolTable* mTable;
+    int mUniqueIdCounter;
 };
 
 int MapSpecToShaderVersion(ShShaderSpec spec)
@@ -124,14 +137,22 @@ TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
       maxUniformVectors(0),
       maxExpressionComplexity(0),
       maxCallStackDepth(0),
+      maxUnrolledLoopSize(0),
+      builtInSymbolTable(NULL),
       fragmentPrecisionHigh(false),
+      dependencyGraph(NULL),
       clampingStrategy(SH_CLAMP_WITH_CLAMP_INTRINSIC),
-      builtInFunctionEmulator(type)
+      builtInFunctionEmulator(type),
+      objectCodeSizeHint(0),
+      hasStatistics(false)
 {
 }
 
 TCompiler::~TCompiler()
 {
+    clearDependencyGraph();
+    if (builtInSymbolTable)
+        builtInSymbolTable->release();
 }
 
 bool TCompiler::Init(const ShBuiltInResources& resources)
@@ -142,6 +163,7 @@ bool TCompiler::Init(const ShBuiltInResources& resources)
         resources.MaxFragmentUniformVectors;
     maxExpressionComplexity = resources.MaxExpressionComplexity;
     maxCallStackDepth = resources.MaxCallStackDepth;
+    maxUnrolledLoopSize = resources.MaxUnrolledLoopSize;
 
     SetGlobalPoolAllocator(&allocator);
 
@@ -166,6 +188,20 @@ bool TCompiler::compile(const char* const shaderStrings[],
     TScopedPoolAllocator scopedAlloc(&allocator);
     clearResults();
 
+    // The phase timers are given NULL statistics, and then don't read the
+    // clock, unless the statistics are asked for.
+    ShCompileStatistics *phaseStatistics = NULL;
+    khronos_uint64_t startTime = 0;
+    int startUniqueId = symbolTable.getUniqueIdCounter();
+    TPoolAllocator::Statistics startPoolStatistics = allocator.getStatistics();
+    if (compileOptions & SH_COMPILE_STATISTICS)
+    {
+        memset(&statistics, 0, sizeof(statistics));
+        hasStatistics = true;
+        phaseStatistics = &statistics;
+        startTime = GetStatisticsTime();
+    }
+
     if (numStrings == 0)
         return true;
 
@@ -182,11 +218,21 @@ bool TCompiler::compile(const char* const shaderStrings[],
         ++firstSource;
     }
 
+    // The output is usually somewhat longer than the source, so reserve
+    // half as much again to avoid growing the buffer while writing it.
+    size_t sourceSize = 0;
+    for (size_t i = firstSource; i < numStrings; ++i)
+        sourceSize += strlen(shaderStrings[i]);
+    objectCodeSizeHint = sourceSize + sourceSize / 2;
+    if (compileOptions & SH_OBJECT_CODE)
+        infoSink.obj.reserve(objectCodeSizeHint);
+
     TIntermediate intermediate(infoSink);
     TParseContext parseContext(symbolTable, extensionBehavior, intermediate,
                                shaderType, shaderSpec, compileOptions, true,
                                sourcePath, infoSink);
     parseContext.fragmentPrecisionHigh = fragmentPrecisionHigh;
+    parseContext.statistics = phaseStatistics;
     SetGlobalParseContext(&parseContext);
 
     // We preserve symbols at the built-in level from compile-to-compile.
@@ -194,9 +240,19 @@ bool TCompiler::compile(const char* const shaderStrings[],
     TScopedSymbolTableLevel scopedSymbolLevel(&symbolTable);
 
     // Parse shader.
-    bool success =
-        (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], NULL, &parseContext) == 0) &&
-        (parseContext.treeRoot != NULL);
+    bool success = false;
+    {
+        TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_PARSE);
+        success =
+            (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], NULL, &parseContext) == 0) &&
+            (parseContext.treeRoot != NULL);
+    }
+    // The preprocessor was timed within the parse.
+    if (phaseStatistics)
+    {
+        phaseStatistics->phaseTimes[SH_COMPILE_PHASE_PARSE] -=
+            phaseStatistics->phaseTimes[SH_COMPILE_PHASE_PREPROCESS];
+    }
 
     shaderVersion = parseContext.getShaderVersion();
     if (success && MapSpecToShaderVersion(shaderSpec) < shaderVersion)
@@ -215,35 +271,45 @@ bool TCompiler::compile(const char* const shaderStrings[],
         }
 
         TIntermNode* root = parseContext.treeRoot;
-        success = intermediate.postProcess(root);
-
-        // Disallow expressions deemed too complex.
-        if (success && (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY))
-            success = limitExpressionComplexity(root);
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_POST_PROCESS);
+            success = intermediate.postProcess(root);
+        }
 
         if (success)
-            success = detectCallDepth(root, infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0);
-
-        if (success && shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
-            success = validateOutputs(root);
-
-        if (success && (compileOptions & SH_VALIDATE_LOOP_INDEXING))
-            success = validateLimitations(root);
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_VALIDATE);
+            success = validateTree(root, compileOptions);
+        }
 
         if (success && (compileOptions & SH_TIMING_RESTRICTIONS))
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_TIMING_RESTRICTIONS);
             success = enforceTimingRestrictions(root, (compileOptions & SH_DEPENDENCY_GRAPH) != 0);
+        }
 
         if (success && shaderSpec == SH_CSS_SHADERS_SPEC)
             rewriteCSSShader(root);
 
+        // Constants are folded before unrolling, which folds the expressions
+        // of the loop indices as it copies the loop bodies.
+        if (success)
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_FOLD_CONSTANTS);
+            FoldConstants foldConstants;
+            root->traverse(&foldConstants);
+        }
+
         // Unroll for-loop markup needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX))
         {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_UNROLL_LOOPS);
             ForLoopUnrollMarker marker(ForLoopUnrollMarker::kIntegerIndex);
             root->traverse(&marker);
         }
         if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX))
         {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_UNROLL_LOOPS);
             ForLoopUnrollMarker marker(ForLoopUnrollMarker::kSamplerArrayIndex);
             root->traverse(&marker);
             if (marker.samplerArrayIndexIsFloatLoopIndex())
@@ -253,27 +319,54 @@ bool TCompiler::compile(const char* const shaderStrings[],
                 success = false;
             }
         }
+        if (success && (compileOptions & (SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX |
+                                          SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX)))
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_UNROLL_LOOPS);
+            ForLoopUnroller unroller(std::max(maxUnrolledLoopSize, 0));
+            root->traverse(&unroller);
+            if (unroller.maxUnrolledSizeExceeded())
+            {
+                infoSink.info.prefix(EPrefixError);
+                infoSink.info << "unrolled loops exceed the maximum size";
+                success = false;
+            }
+            else if (unroller.endlessLoopFound())
+            {
+                infoSink.info.prefix(EPrefixError);
+                infoSink.info << "unrolled loop never ends";
+                success = false;
+            }
+        }
 
         // Built-in function emulation needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_EMULATE_BUILT_IN_FUNCTIONS))
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_EMULATE_BUILT_IN_FUNCTIONS);
             builtInFunctionEmulator.MarkBuiltInFunctionsForEmulation(root);
+        }
 
         // Clamping uniform array bounds needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS))
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_CLAMP_INDIRECT_ARRAY_BOUNDS);
             arrayBoundsClamper.MarkIndirectArrayBoundsForClamping(root);
+        }
 
         if (success && shaderType == GL_VERTEX_SHADER && (compileOptions & SH_INIT_GL_POSITION))
             initializeGLPosition(root);
 
         if (success && (compileOptions & SH_UNFOLD_SHORT_CIRCUIT))
         {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_UNFOLD_SHORT_CIRCUIT);
             UnfoldShortCircuitAST unfoldShortCircuit;
             root->traverse(&unfoldShortCircuit);
             unfoldShortCircuit.updateTree();
         }
 
-        if (success && (compileOptions & SH_VARIABLES))
+        if (success && shouldCollectVariables(compileOptions))
         {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_COLLECT_VARIABLES);
             collectVariables(root);
             if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
             {
@@ -291,6 +384,8 @@ bool TCompiler::compile(const char* const shaderStrings[],
 
         if (success && (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS))
         {
+            TScopedPhaseTimer timer(phaseStatistics,
+                                    SH_COMPILE_PHASE_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS);
             ScalarizeVecAndMatConstructorArgs scalarizer(
                 shaderType, fragmentPrecisionHigh);
             root->traverse(&scalarizer);
@@ -298,20 +393,47 @@ bool TCompiler::compile(const char* const shaderStrings[],
 
         if (success && (compileOptions & SH_REGENERATE_STRUCT_NAMES))
         {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_REGENERATE_STRUCT_NAMES);
             RegenerateStructNames gen(symbolTable, shaderVersion);
             root->traverse(&gen);
         }
 
+        // Pruning happens after the variables are collected, so that static
+        // use is the same with and without it.
+        if (success && (compileOptions & SH_PRUNE_UNUSED_DECLARATIONS))
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_PRUNE_UNUSED_DECLARATIONS);
+            PruneUnusedDeclarations(root);
+        }
+
         if (success && (compileOptions & SH_INTERMEDIATE_TREE))
             intermediate.outputTree(root);
 
         if (success && (compileOptions & SH_OBJECT_CODE))
-            translate(root);
+        {
+            TScopedPhaseTimer timer(phaseStatistics, SH_COMPILE_PHASE_OUTPUT);
+            translate(root, compileOptions);
+        }
     }
 
-    // Cleanup memory.
-    intermediate.remove(parseContext.treeRoot);
+    // Cleanup memory. The tree is allocated from the pool, which frees it
+    // when the compile returns.
+    clearDependencyGraph();
+    callDag.clear();
     SetGlobalParseContext(NULL);
+
+    // The user-defined symbols are popped, and their ids handed out again,
+    // when the compile returns.
+    if (phaseStatistics)
+    {
+        const TPoolAllocator::Statistics &poolStatistics = allocator.getStatistics();
+        phaseStatistics->symbols = symbolTable.getUniqueIdCounter() - startUniqueId;
+        phaseStatistics->poolAllocations =
+            poolStatistics.allocations - startPoolStatistics.allocations;
+        phaseStatistics->poolBytesAllocated =
+            poolStatistics.bytesAllocated - startPoolStatistics.bytesAllocated;
+        phaseStatistics->totalTime = GetStatisticsTime() - startTime;
+    }
     return success;
 }
 
@@ -321,51 +443,9 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     setResourceString();
 
     assert(symbolTable.isEmpty());
-    symbolTable.push();   // COMMON_BUILTINS
-    symbolTable.push();   // ESSL1_BUILTINS
-    symbolTable.push();   // ESSL3_BUILTINS
-
-    TPublicType integer;
-    integer.type = EbtInt;
-    integer.primarySize = 1;
-    integer.secondarySize = 1;
-    integer.array = false;
-
-    TPublicType floatingPoint;
-    floatingPoint.type = EbtFloat;
-    floatingPoint.primarySize = 1;
-    floatingPoint.secondarySize = 1;
-    floatingPoint.array = false;
-
-    TPublicType sampler;
-    sampler.primarySize = 1;
-    sampler.secondarySize = 1;
-    sampler.array = false;
-
-    switch(shaderType)
-    {
-      case GL_FRAGMENT_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpMedium);
-        break;
-      case GL_VERTEX_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpHigh);
-        symbolTable.setDefaultPrecision(floatingPoint, EbpHigh);
-        break;
-      default:
-        assert(false && "Language not supported");
-    }
-    // We set defaults for all the sampler types, even those that are
-    // only available if an extension exists.
-    for (int samplerType = EbtGuardSamplerBegin + 1;
-         samplerType < EbtGuardSamplerEnd; ++samplerType)
-    {
-        sampler.type = static_cast<TBasicType>(samplerType);
-        symbolTable.setDefaultPrecision(sampler, EbpLow);
-    }
-
-    InsertBuiltInFunctions(shaderType, shaderSpec, resources, symbolTable);
-
-    IdentifyBuiltIns(shaderType, shaderSpec, resources, symbolTable);
+    assert(builtInSymbolTable == NULL);
+    builtInSymbolTable = TBuiltInSymbolTable::Acquire(shaderType, shaderSpec, resources);
+    symbolTable.shareBuiltInLevels(builtInSymbolTable->getSymbolTable());
 
     return true;
 }
@@ -388,6 +468,7 @@ void TCompiler::setResourceString()
               << ":FragmentPrecisionHigh:" << compileResources.FragmentPrecisionHigh
               << ":MaxExpressionComplexity:" << compileResources.MaxExpressionComplexity
               << ":MaxCallStackDepth:" << compileResources.MaxCallStackDepth
+              << ":MaxUnrolledLoopSize:" << compileResources.MaxUnrolledLoopSize
               << ":EXT_frag_depth:" << compileResources.EXT_frag_depth
               << ":EXT_shader_texture_lod:" << compileResources.EXT_shader_texture_lod
               << ":MaxVertexOutputVectors:" << compileResources.MaxVertexOutputVectors
@@ -399,6 +480,27 @@ void TCompiler::setResourceString()
     builtInResourcesString = strstream.str();
 }
 
+bool TCompiler::preprocess(const char* const shaderStrings[],
+                           size_t numStrings,
+                           int compileOptions,
+                           std::string* output)
+{
+    TScopedPoolAllocator scopedAlloc(&allocator);
+    clearResults();
+    output->clear();
+
+    // First string is path of source file if flag is set.
+    size_t firstSource = (compileOptions & SH_SOURCE_PATH) ? 1 : 0;
+    if (numStrings <= firstSource)
+        return true;
+
+    TDiagnostics diagnostics(infoSink);
+    return WriteCanonicalSource(&shaderStrings[firstSource], numStrings - firstSource,
+                                extensionBehavior, fragmentPrecisionHigh, shaderSpec,
+                                (compileOptions & SH_LINE_DIRECTIVES) != 0, diagnostics,
+                                output);
+}
+
 void TCompiler::clearResults()
 {
     arrayBoundsClamper.Cleanup();
@@ -409,20 +511,116 @@ void TCompiler::clearResults()
     attributes.clear();
     outputVariables.clear();
     uniforms.clear();
-    expandedUniforms.clear();
     varyings.clear();
     interfaceBlocks.clear();
 
     builtInFunctionEmulator.Cleanup();
 
     nameMap.clear();
+    hasStatistics = false;
+}
+
+void TCompiler::getResults(TCompileResults *results) const
+{
+    results->shaderVersion = shaderVersion;
+    results->objectCode = infoSink.obj.str();
+    results->infoLog = infoSink.info.str();
+    results->nameMap = nameMap;
+
+    results->attributes = attributes;
+    results->outputVariables = outputVariables;
+    results->uniforms = uniforms;
+    results->varyings = varyings;
+    results->interfaceBlocks = interfaceBlocks;
 }
 
-bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth)
+void TCompiler::setResults(const TCompileResults &results)
 {
-    DetectCallDepth detect(infoSink, limitCallStackDepth, maxCallStackDepth);
-    root->traverse(&detect);
-    switch (detect.detectCallDepth())
+    clearResults();
+
+    shaderVersion = results.shaderVersion;
+    infoSink.obj << results.objectCode;
+    infoSink.info << results.infoLog;
+    nameMap = results.nameMap;
+
+    attributes = results.attributes;
+    outputVariables = results.outputVariables;
+    uniforms = results.uniforms;
+    varyings = results.varyings;
+    interfaceBlocks = results.interfaceBlocks;
+}
+
+//
+// The validation passes only read the tree, so they share a single walk.
+// Their errors are reported in the order in which the passes would run one
+// after another, stopping at the first pass that fails.
+//
+bool TCompiler::validateTree(TIntermNode* root, int compileOptions)
+{
+    std::vector<TIntermTraverser *> passes;
+
+    // Disallow expressions deemed too complex.
+    bool limitComplexity = (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY) != 0;
+    TMaxDepthTraverser depthTraverser(maxExpressionComplexity + 1);
+    if (limitComplexity)
+        passes.push_back(&depthTraverser);
+
+    CallDAG::Builder callDagBuilder(&callDag);
+    passes.push_back(&callDagBuilder);
+
+    // These two report their errors while traversing; the errors are held
+    // back until the passes before them have succeeded.
+    bool checkOutputs = (shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER);
+    TInfoSinkBase outputErrors;
+    ValidateOutputs validateOutputs(outputErrors, compileResources.MaxDrawBuffers);
+    if (checkOutputs)
+        passes.push_back(&validateOutputs);
+
+    bool checkLimitations = (compileOptions & SH_VALIDATE_LOOP_INDEXING) != 0;
+    TInfoSinkBase limitationErrors;
+    ValidateLimitations validateLimitations(shaderType, limitationErrors);
+    if (checkLimitations)
+        passes.push_back(&validateLimitations);
+
+    CompositeTraverser validation(passes);
+    root->traverse(&validation);
+
+    // The call DAG builder counts the nodes of the whole tree.
+    if (hasStatistics)
+        statistics.treeNodes = callDagBuilder.getNodeCount();
+
+    // Recursion is reported by detectCallDepth, which tells the recursions
+    // that matter from the ones in functions main() never calls.
+    callDagBuilder.finish();
+
+    if (limitComplexity && !limitExpressionComplexity(depthTraverser))
+        return false;
+
+    if (!detectCallDepth(compileOptions))
+        return false;
+
+    if (checkOutputs)
+    {
+        infoSink.info << outputErrors.str();
+        if (validateOutputs.numErrors() > 0)
+            return false;
+    }
+
+    if (checkLimitations)
+    {
+        infoSink.info << limitationErrors.str();
+        if (validateLimitations.numErrors() > 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool TCompiler::detectCallDepth(int compileOptions)
+{
+    DetectCallDepth detect(infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0,
+                           maxCallStackDepth);
+    switch (detect.detectCallDepth(callDag))
     {
       case DetectCallDepth::kErrorNone:
         return true;
@@ -444,26 +642,12 @@ bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool lim
     }
 }
 
-bool TCompiler::validateOutputs(TIntermNode* root)
-{
-    ValidateOutputs validateOutputs(infoSink.info, compileResources.MaxDrawBuffers);
-    root->traverse(&validateOutputs);
-    return (validateOutputs.numErrors() == 0);
-}
-
 void TCompiler::rewriteCSSShader(TIntermNode* root)
 {
     RenameFunction renamer("main(", "css_main(");
     root->traverse(&renamer);
 }
 
-bool TCompiler::validateLimitations(TIntermNode* root)
-{
-    ValidateLimitations validate(shaderType, infoSink.info);
-    root->traverse(&validate);
-    return validate.numErrors() == 0;
-}
-
 bool TCompiler::enforceTimingRestrictions(TIntermNode* root, bool outputGraph)
 {
     if (shaderSpec != SH_WEBGL_SPEC)
@@ -474,7 +658,7 @@ bool TCompiler::enforceTimingRestrictions(TIntermNode* root, bool outputGraph)
 
     if (shaderType == GL_FRAGMENT_SHADER)
     {
-        TDependencyGraph graph(root);
+        TDependencyGraph& graph = getDependencyGraph(root);
 
         // Output any errors first.
         bool success = enforceFragmentShaderTimingRestrictions(graph);
@@ -494,29 +678,28 @@ bool TCompiler::enforceTimingRestrictions(TIntermNode* root, bool outputGraph)
     }
 }
 
-bool TCompiler::limitExpressionComplexity(TIntermNode* root)
+bool TCompiler::limitExpressionComplexity(const TMaxDepthTraverser& traverser)
 {
-    TMaxDepthTraverser traverser(maxExpressionComplexity+1);
-    root->traverse(&traverser);
-
     if (traverser.getMaxDepth() > maxExpressionComplexity)
     {
         infoSink.info << "Expression too complex.";
         return false;
     }
 
-    TDependencyGraph graph(root);
+    return true;
+}
 
-    for (TFunctionCallVector::const_iterator iter = graph.beginUserDefinedFunctionCalls();
-         iter != graph.endUserDefinedFunctionCalls();
-         ++iter)
-    {
-        TGraphFunctionCall* samplerSymbol = *iter;
-        TDependencyGraphTraverser graphTraverser;
-        samplerSymbol->traverse(&graphTraverser);
-    }
+TDependencyGraph& TCompiler::getDependencyGraph(TIntermNode* root)
+{
+    if (!dependencyGraph)
+        dependencyGraph = new TDependencyGraph(root);
+    return *dependencyGraph;
+}
 
-    return true;
+void TCompiler::clearDependencyGraph()
+{
+    delete dependencyGraph;
+    dependencyGraph = NULL;
 }
 
 bool TCompiler::enforceFragmentShaderTimingRestrictions(const TDependencyGraph& graph)
@@ -533,6 +716,11 @@ bool TCompiler::enforceVertexShaderTimingRestrictions(TIntermNode* root)
     return restrictor.numErrors() == 0;
 }
 
+bool TCompiler::shouldCollectVariables(int compileOptions)
+{
+    return (compileOptions & SH_VARIABLES) != 0;
+}
+
 void TCompiler::collectVariables(TIntermNode* root)
 {
     sh::CollectVariables collect(&attributes,
@@ -543,13 +731,14 @@ void TCompiler::collectVariables(TIntermNode* root)
                                  hashFunction,
                                  symbolTable);
     root->traverse(&collect);
-
-    // This is for enforcePackingRestriction().
-    sh::ExpandUniforms(uniforms, &expandedUniforms);
 }
 
 bool TCompiler::enforcePackingRestrictions()
 {
+    // The uniforms are only expanded for this check.
+    std::vector<sh::ShaderVariable> expandedUniforms;
+    sh::ExpandUniforms(uniforms, &expandedUniforms);
+
     VariablePacker packer;
     return packer.CheckVariablesWithinPackingLimits(maxUniformVectors, expandedUniforms);
 }
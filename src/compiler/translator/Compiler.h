@@ -15,6 +15,7 @@
 //
 
 #include "compiler/translator/BuiltInFunctionEmulator.h"
+#include "compiler/translator/CallDAG.h"
 #include "compiler/translator/ExtensionBehavior.h"
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/InfoSink.h"
@@ -23,8 +24,10 @@
 #include "compiler/translator/VariableInfo.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+class TBuiltInSymbolTable;
 class TCompiler;
 class TDependencyGraph;
+struct TCompileResults;
 class TranslatorHLSL;
 
 //
@@ -43,6 +46,8 @@ public:
     virtual TCompiler* getAsCompiler() { return 0; }
     virtual TranslatorHLSL* getAsTranslatorHLSL() { return 0; }
 
+    TPoolAllocator& getAllocator() { return allocator; }
+
 protected:
     // Memory allocator. Allocates and tracks memory required by the compiler.
     // Deallocates all memory when compiler is destructed.
@@ -64,10 +69,25 @@ class TCompiler : public TShHandleBase
     bool compile(const char* const shaderStrings[],
                  size_t numStrings,
                  int compileOptions);
+    // Runs only the preprocessor, and writes the canonical form of the
+    // source to output. Replaces the results of the last compilation.
+    bool preprocess(const char* const shaderStrings[],
+                    size_t numStrings,
+                    int compileOptions,
+                    std::string* output);
 
     // Get results of the last compilation.
     int getShaderVersion() const { return shaderVersion; }
     TInfoSink& getInfoSink() { return infoSink; }
+    // An estimate of the object code size, from the size of the source,
+    // used to reserve the output buffers.
+    size_t getObjectCodeSizeHint() const { return objectCodeSizeHint; }
+    // The statistics of the last compile, or NULL if it wasn't given
+    // SH_COMPILE_STATISTICS.
+    const ShCompileStatistics *getStatistics() const
+    {
+        return hasStatistics ? &statistics : NULL;
+    }
 
     const std::vector<sh::Attribute> &getAttributes() const { return attributes; }
     const std::vector<sh::Attribute> &getOutputVariables() const { return outputVariables; }
@@ -75,9 +95,15 @@ class TCompiler : public TShHandleBase
     const std::vector<sh::Varying> &getVaryings() const { return varyings; }
     const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const { return interfaceBlocks; }
 
+    // Copy the results of the last compilation out, or replace them with
+    // the results of an earlier one, as the translation cache does.
+    virtual void getResults(TCompileResults *results) const;
+    virtual void setResults(const TCompileResults &results);
+
     ShHashFunction64 getHashFunction() const { return hashFunction; }
     NameMap& getNameMap() { return nameMap; }
     TSymbolTable& getSymbolTable() { return symbolTable; }
+    sh::GLenum getShaderType() const { return shaderType; }
     ShShaderSpec getShaderSpec() const { return shaderSpec; }
     ShShaderOutput getOutputType() const { return outputType; }
     const std::string &getBuiltInResourcesString() const { return builtInResourcesString; }
@@ -86,26 +112,28 @@ class TCompiler : public TShHandleBase
     const ShBuiltInResources& getResources() const;
 
   protected:
-    sh::GLenum getShaderType() const { return shaderType; }
     // Initialize symbol-table with built-in symbols.
     bool InitBuiltInSymbolTable(const ShBuiltInResources& resources);
     // Compute the string representation of the built-in resources
     void setResourceString();
     // Clears the results from the previous compilation.
     void clearResults();
-    // Return true if function recursion is detected or call depth exceeded.
-    bool detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth);
-    // Returns true if a program has no conflicting or missing fragment outputs
-    bool validateOutputs(TIntermNode* root);
+    // Runs the validation passes enabled by compileOptions in a single walk:
+    // expression complexity, call depth, fragment outputs and the minimum
+    // functionality mandated in GLSL 1.0 spec Appendix A. Returns true if
+    // the shader passes all of them. The call DAG is built in the same walk.
+    bool validateTree(TIntermNode* root, int compileOptions);
+    // Return false if function recursion is detected or call depth exceeded,
+    // given the call DAG of the shader.
+    bool detectCallDepth(int compileOptions);
     // Rewrites a shader's intermediate tree according to the CSS Shaders spec.
     void rewriteCSSShader(TIntermNode* root);
-    // Returns true if the given shader does not exceed the minimum
-    // functionality mandated in GLSL 1.0 spec Appendix A.
-    bool validateLimitations(TIntermNode* root);
     // Collect info for all attribs, uniforms, varyings.
     void collectVariables(TIntermNode* root);
+    // Returns true if the variables are collected, which SH_VARIABLES asks for.
+    virtual bool shouldCollectVariables(int compileOptions);
     // Translate to object code.
-    virtual void translate(TIntermNode* root) = 0;
+    virtual void translate(TIntermNode* root, int compileOptions) = 0;
     // Returns true if, after applying the packing rules in the GLSL 1.017 spec
     // Appendix A, section 7, the shader does not use too many uniforms.
     bool enforcePackingRestrictions();
@@ -126,8 +154,14 @@ class TCompiler : public TShHandleBase
     // Returns true if the shader does not use sampler dependent values to affect control
     // flow or in operations whose time can depend on the input values.
     bool enforceFragmentShaderTimingRestrictions(const TDependencyGraph& graph);
-    // Return true if the maximum expression complexity is below the limit.
-    bool limitExpressionComplexity(TIntermNode* root);
+    // Return true if the maximum expression complexity is below the limit,
+    // given the traverser that has walked the tree.
+    bool limitExpressionComplexity(const TMaxDepthTraverser& traverser);
+    // Returns the dependency graph of root, building it on first use. The graph
+    // is shared by every pass of the compile that needs it and freed at its end.
+    TDependencyGraph& getDependencyGraph(TIntermNode* root);
+    // The calls between the functions of the shader, built by validateTree.
+    const CallDAG& getCallDAG() const { return callDag; }
     // Get built-in extensions with default behavior.
     const TExtensionBehavior& getExtensionBehavior() const;
     const TPragma& getPragma() const { return mPragma; }
@@ -140,11 +174,13 @@ class TCompiler : public TShHandleBase
     std::vector<sh::Attribute> attributes;
     std::vector<sh::Attribute> outputVariables;
     std::vector<sh::Uniform> uniforms;
-    std::vector<sh::ShaderVariable> expandedUniforms;
     std::vector<sh::Varying> varyings;
     std::vector<sh::InterfaceBlock> interfaceBlocks;
 
   private:
+    // Frees the dependency graph, if one was built.
+    void clearDependencyGraph();
+
     sh::GLenum shaderType;
     ShShaderSpec shaderSpec;
     ShShaderOutput outputType;
@@ -152,17 +188,27 @@ class TCompiler : public TShHandleBase
     int maxUniformVectors;
     int maxExpressionComplexity;
     int maxCallStackDepth;
+    int maxUnrolledLoopSize;
 
     ShBuiltInResources compileResources;
     std::string builtInResourcesString;
 
-    // Built-in symbol table for the given language, spec, and resources.
-    // It is preserved from compile-to-compile.
+    // Built-in levels for the given language, spec, and resources. They are
+    // shared with every other compiler constructed with the same parameters.
+    TBuiltInSymbolTable *builtInSymbolTable;
+    // Symbol table whose built-in levels are borrowed from
+    // builtInSymbolTable. It is preserved from compile-to-compile.
     TSymbolTable symbolTable;
     // Built-in extensions with default behavior.
     TExtensionBehavior extensionBehavior;
     bool fragmentPrecisionHigh;
 
+    // Dependency graph of the tree being compiled, NULL until a pass asks for it.
+    TDependencyGraph *dependencyGraph;
+    // Call DAG of the tree being compiled. It points into the tree, so it is
+    // cleared along with it.
+    CallDAG callDag;
+
     ArrayBoundsClamper arrayBoundsClamper;
     ShArrayIndexClampingStrategy clampingStrategy;
     BuiltInFunctionEmulator builtInFunctionEmulator;
@@ -170,6 +216,9 @@ class TCompiler : public TShHandleBase
     // Results of compilation.
     int shaderVersion;
     TInfoSink infoSink;  // Output sink.
+    size_t objectCodeSizeHint;
+    bool hasStatistics;
+    ShCompileStatistics statistics;
 
     // name hashing.
     ShHashFunction64 hashFunction;
@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/CompositeTraverser.h"
+
+#include "compiler/translator/compilerdebug.h"
+
+CompositeTraverser::CompositeTraverser(const std::vector<TIntermTraverser *> &traversers)
+    : TIntermTraverser(true, AnyInVisit(traversers), true, false),
+      mActiveCount(traversers.size())
+{
+    for (size_t i = 0; i < traversers.size(); ++i)
+    {
+        ASSERT(!traversers[i]->rightToLeft);
+        Member member;
+        member.traverser = traversers[i];
+        member.skipDepth = -1;
+        member.leaveSkipped = false;
+        mMembers.push_back(member);
+    }
+}
+
+bool CompositeTraverser::AnyInVisit(const std::vector<TIntermTraverser *> &traversers)
+{
+    for (size_t i = 0; i < traversers.size(); ++i)
+    {
+        if (traversers[i]->inVisit)
+            return true;
+    }
+    return false;
+}
+
+void CompositeTraverser::visitSymbol(TIntermSymbol *node)
+{
+    for (size_t i = 0; i < mMembers.size(); ++i)
+    {
+        if (mMembers[i].skipDepth < 0)
+            mMembers[i].traverser->visitSymbol(node);
+    }
+}
+
+void CompositeTraverser::visitRaw(TIntermRaw *node)
+{
+    for (size_t i = 0; i < mMembers.size(); ++i)
+    {
+        if (mMembers[i].skipDepth < 0)
+            mMembers[i].traverser->visitRaw(node);
+    }
+}
+
+void CompositeTraverser::visitConstantUnion(TIntermConstantUnion *node)
+{
+    for (size_t i = 0; i < mMembers.size(); ++i)
+    {
+        if (mMembers[i].skipDepth < 0)
+            mMembers[i].traverser->visitConstantUnion(node);
+    }
+}
+
+bool CompositeTraverser::visitBinary(Visit visit, TIntermBinary *node)
+{
+    return visitNode(&TIntermTraverser::visitBinary, visit, node, kSkipRemainingChildren);
+}
+
+bool CompositeTraverser::visitUnary(Visit visit, TIntermUnary *node)
+{
+    return visitNode(&TIntermTraverser::visitUnary, visit, node, kSkipRemainingChildren);
+}
+
+bool CompositeTraverser::visitSelection(Visit visit, TIntermSelection *node)
+{
+    return visitNode(&TIntermTraverser::visitSelection, visit, node, kSkipRemainingChildren);
+}
+
+bool CompositeTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    return visitNode(&TIntermTraverser::visitAggregate, visit, node, kVisitRemainingChildren);
+}
+
+bool CompositeTraverser::visitLoop(Visit visit, TIntermLoop *node)
+{
+    return visitNode(&TIntermTraverser::visitLoop, visit, node, kSkipRemainingChildren);
+}
+
+bool CompositeTraverser::visitBranch(Visit visit, TIntermBranch *node)
+{
+    // A branch only goes down a level for its expression, if it has one.
+    return visitNode(&TIntermTraverser::visitBranch, visit, node, kSkipRemainingChildren,
+                     node->getExpression() != NULL);
+}
+
+//
+// The nodes call incrementDepth() and decrementDepth() on this traverser
+// only, so the members are moved in and out of the children here: right
+// after their pre-visit and right before their post-visit. A node without
+// children doesn't change the depth.
+//
+template <typename NodeType>
+bool CompositeTraverser::visitNode(bool (TIntermTraverser::*visitFunction)(Visit, NodeType *),
+                                   Visit visit, NodeType *node, InVisitFalse inVisitFalse,
+                                   bool hasChildren)
+{
+    // The in-visit happens among the children of the node.
+    int depth = (visit == InVisit) ? mDepth - 1 : mDepth;
+    typedef std::vector<Member>::iterator MemberIterator;
+
+    switch (visit)
+    {
+      case PreVisit:
+        for (MemberIterator member = mMembers.begin(); member != mMembers.end(); ++member)
+        {
+            if (member->skipDepth >= 0)
+                continue;
+            TIntermTraverser *traverser = member->traverser;
+            if (!traverser->preVisit || (traverser->*visitFunction)(PreVisit, node))
+            {
+                if (hasChildren)
+                    traverser->incrementDepth(node);
+            }
+            else
+                skip(&*member, depth, false);
+        }
+        break;
+      case InVisit:
+        for (MemberIterator member = mMembers.begin(); member != mMembers.end(); ++member)
+        {
+            TIntermTraverser *traverser = member->traverser;
+            if (member->skipDepth >= 0 || !traverser->inVisit)
+                continue;
+            if (!member->mutedDepths.empty() && member->mutedDepths.back() == depth)
+                continue;
+            if ((traverser->*visitFunction)(InVisit, node))
+                continue;
+            if (inVisitFalse == kSkipRemainingChildren)
+                skip(&*member, depth, true);
+            else
+                member->mutedDepths.push_back(depth);
+        }
+        break;
+      case PostVisit:
+        for (MemberIterator member = mMembers.begin(); member != mMembers.end(); ++member)
+        {
+            TIntermTraverser *traverser = member->traverser;
+            if (member->skipDepth >= 0)
+            {
+                // The post-visit of a skipped node is the end of its subtree.
+                if (member->skipDepth == depth)
+                {
+                    if (member->leaveSkipped)
+                        traverser->decrementDepth();
+                    member->skipDepth = -1;
+                    ++mActiveCount;
+                }
+                continue;
+            }
+            if (hasChildren)
+                traverser->decrementDepth();
+            if (!member->mutedDepths.empty() && member->mutedDepths.back() == depth)
+                member->mutedDepths.pop_back();
+            else if (traverser->postVisit)
+                (traverser->*visitFunction)(PostVisit, node);
+        }
+        break;
+    }
+
+    // Nothing is left to visit the rest of the subtree: cut the walk short,
+    // which also skips the post-visit of the node.
+    if (mActiveCount == 0 &&
+        (visit == PreVisit || (visit == InVisit && inVisitFalse == kSkipRemainingChildren)))
+    {
+        resume(depth);
+        return false;
+    }
+    return true;
+}
+
+void CompositeTraverser::skip(Member *member, int depth, bool leave)
+{
+    member->skipDepth = depth;
+    member->leaveSkipped = leave;
+    --mActiveCount;
+}
+
+void CompositeTraverser::resume(int depth)
+{
+    for (size_t i = 0; i < mMembers.size(); ++i)
+    {
+        Member &member = mMembers[i];
+        if (member.skipDepth == depth)
+        {
+            if (member.leaveSkipped)
+                member.traverser->decrementDepth();
+            member.skipDepth = -1;
+            ++mActiveCount;
+        }
+    }
+}
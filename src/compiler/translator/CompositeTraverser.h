@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef COMPILER_TRANSLATOR_COMPOSITE_TRAVERSER_H_
+#define COMPILER_TRANSLATOR_COMPOSITE_TRAVERSER_H_
+
+#include "compiler/translator/IntermNode.h"
+
+#include <vector>
+
+//
+// Runs several traversers together in a single walk of the tree.
+//
+// Each traverser gets the same calls, in the same order and at the same
+// depth, as when it traverses the tree on its own. That includes skipping
+// the subtrees it returns false for. The traversers must visit left to
+// right and must not change the tree, which is shared by all of them.
+//
+class CompositeTraverser : public TIntermTraverser
+{
+  public:
+    // Runs the traversers in the order given. The composite only asks for
+    // in-visits if one of them does: an aggregate has one between every two
+    // of its children, and each costs a call per traverser.
+    explicit CompositeTraverser(const std::vector<TIntermTraverser *> &traversers);
+
+    virtual void visitSymbol(TIntermSymbol *node);
+    virtual void visitRaw(TIntermRaw *node);
+    virtual void visitConstantUnion(TIntermConstantUnion *node);
+    virtual bool visitBinary(Visit visit, TIntermBinary *node);
+    virtual bool visitUnary(Visit visit, TIntermUnary *node);
+    virtual bool visitSelection(Visit visit, TIntermSelection *node);
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node);
+    virtual bool visitLoop(Visit visit, TIntermLoop *node);
+    virtual bool visitBranch(Visit visit, TIntermBranch *node);
+
+  private:
+    static bool AnyInVisit(const std::vector<TIntermTraverser *> &traversers);
+
+    struct Member
+    {
+        TIntermTraverser *traverser;
+        // Depth of the node whose subtree the traverser skips, or -1.
+        int skipDepth;
+        // Whether the traverser entered the skipped node's children and
+        // has to leave them.
+        bool leaveSkipped;
+        // Depths of the aggregates whose in-visit returned false: their
+        // children are still visited, but not their in- and post-visits.
+        std::vector<int> mutedDepths;
+    };
+
+    // How a node reacts to an in-visit that returns false.
+    enum InVisitFalse
+    {
+        kSkipRemainingChildren,
+        kVisitRemainingChildren
+    };
+
+    template <typename NodeType>
+    bool visitNode(bool (TIntermTraverser::*visitFunction)(Visit, NodeType *),
+                   Visit visit, NodeType *node, InVisitFalse inVisitFalse,
+                   bool hasChildren = true);
+    void skip(Member *member, int depth, bool leave);
+    void resume(int depth);
+
+    std::vector<Member> mMembers;
+    size_t mActiveCount;
+};
+
+#endif  // COMPILER_TRANSLATOR_COMPOSITE_TRAVERSER_H_
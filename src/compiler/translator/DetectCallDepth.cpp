@@ -5,181 +5,61 @@
 //
 
 #include "compiler/translator/DetectCallDepth.h"
-#include "compiler/translator/InfoSink.h"
-
-DetectCallDepth::FunctionNode::FunctionNode(const TString& fname)
-    : name(fname),
-      visit(PreVisit)
-{
-}
-
-const TString& DetectCallDepth::FunctionNode::getName() const
-{
-    return name;
-}
 
-void DetectCallDepth::FunctionNode::addCallee(
-    DetectCallDepth::FunctionNode* callee)
-{
-    for (size_t i = 0; i < callees.size(); ++i) {
-        if (callees[i] == callee)
-            return;
-    }
-    callees.push_back(callee);
-}
-
-int DetectCallDepth::FunctionNode::detectCallDepth(DetectCallDepth* detectCallDepth, int depth)
-{
-    ASSERT(visit == PreVisit);
-    ASSERT(detectCallDepth);
-
-    int maxDepth = depth;
-    visit = InVisit;
-    for (size_t i = 0; i < callees.size(); ++i) {
-        switch (callees[i]->visit) {
-            case InVisit:
-                // cycle detected, i.e., recursion detected.
-                return kInfiniteCallDepth;
-            case PostVisit:
-                break;
-            case PreVisit: {
-                // Check before we recurse so we don't go too depth
-                if (detectCallDepth->checkExceedsMaxDepth(depth))
-                    return depth;
-                int callDepth = callees[i]->detectCallDepth(detectCallDepth, depth + 1);
-                // Check after we recurse so we can exit immediately and provide info.
-                if (detectCallDepth->checkExceedsMaxDepth(callDepth)) {
-                    detectCallDepth->getInfoSink().info << "<-" << callees[i]->getName();
-                    return callDepth;
-                }
-                maxDepth = std::max(callDepth, maxDepth);
-                break;
-            }
-            default:
-                UNREACHABLE();
-                break;
-        }
-    }
-    visit = PostVisit;
-    return maxDepth;
-}
+#include <vector>
 
-void DetectCallDepth::FunctionNode::reset()
-{
-    visit = PreVisit;
-}
+#include "compiler/translator/CallDAG.h"
+#include "compiler/translator/InfoSink.h"
 
 DetectCallDepth::DetectCallDepth(TInfoSink& infoSink, bool limitCallStackDepth, int maxCallStackDepth)
-    : TIntermTraverser(true, false, true, false),
-      currentFunction(NULL),
-      infoSink(infoSink),
-      maxDepth(limitCallStackDepth ? maxCallStackDepth : FunctionNode::kInfiniteCallDepth)
-{
-}
-
-DetectCallDepth::~DetectCallDepth()
-{
-    for (size_t i = 0; i < functions.size(); ++i)
-        delete functions[i];
-}
-
-bool DetectCallDepth::visitAggregate(Visit visit, TIntermAggregate* node)
-{
-    switch (node->getOp())
-    {
-        case EOpPrototype:
-            // Function declaration.
-            // Don't add FunctionNode here because node->getName() is the
-            // unmangled function name.
-            break;
-        case EOpFunction: {
-            // Function definition.
-            if (visit == PreVisit) {
-                currentFunction = findFunctionByName(node->getName());
-                if (currentFunction == NULL) {
-                    currentFunction = new FunctionNode(node->getName());
-                    functions.push_back(currentFunction);
-                }
-            } else if (visit == PostVisit) {
-                currentFunction = NULL;
-            }
-            break;
-        }
-        case EOpFunctionCall: {
-            // Function call.
-            if (visit == PreVisit) {
-                FunctionNode* func = findFunctionByName(node->getName());
-                if (func == NULL) {
-                    func = new FunctionNode(node->getName());
-                    functions.push_back(func);
-                }
-                if (currentFunction)
-                    currentFunction->addCallee(func);
-            }
-            break;
-        }
-        default:
-            break;
-    }
-    return true;
-}
-
-bool DetectCallDepth::checkExceedsMaxDepth(int depth)
-{
-    return depth >= maxDepth;
-}
-
-void DetectCallDepth::resetFunctionNodes()
-{
-    for (size_t i = 0; i < functions.size(); ++i) {
-        functions[i]->reset();
-    }
-}
-
-DetectCallDepth::ErrorCode DetectCallDepth::detectCallDepthForFunction(FunctionNode* func)
+    : infoSink(infoSink),
+      maxDepth(limitCallStackDepth ? maxCallStackDepth : CallDAG::kInfiniteCallDepth)
 {
-    currentFunction = NULL;
-    resetFunctionNodes();
-
-    int maxCallDepth = func->detectCallDepth(this, 1);
-
-    if (maxCallDepth == FunctionNode::kInfiniteCallDepth)
-        return kErrorRecursion;
-
-    if (maxCallDepth >= maxDepth)
-        return kErrorMaxDepthExceeded;
-
-    return kErrorNone;
 }
 
-DetectCallDepth::ErrorCode DetectCallDepth::detectCallDepth()
+DetectCallDepth::ErrorCode DetectCallDepth::detectCallDepth(const CallDAG& callDag)
 {
-    if (maxDepth != FunctionNode::kInfiniteCallDepth) {
+    if (maxDepth != CallDAG::kInfiniteCallDepth) {
         // Check all functions because the driver may fail on them
         // TODO: Before detectingRecursion, strip unused functions.
-        for (size_t i = 0; i < functions.size(); ++i) {
-            ErrorCode error = detectCallDepthForFunction(functions[i]);
-            if (error != kErrorNone)
-                return error;
+        for (size_t i = 0; i < callDag.size(); ++i) {
+            if (callDag.getRecord(i).depth == CallDAG::kInfiniteCallDepth)
+                return kErrorRecursion;
+        }
+        for (size_t i = 0; i < callDag.size(); ++i) {
+            if (callDag.getRecord(i).depth >= maxDepth) {
+                writeTooDeepChain(callDag, i);
+                return kErrorMaxDepthExceeded;
+            }
         }
     } else {
-        FunctionNode* main = findFunctionByName("main(");
-        if (main == NULL)
+        size_t main = callDag.findIndex("main(");
+        if (main == CallDAG::InvalidIndex)
             return kErrorMissingMain;
 
-        return detectCallDepthForFunction(main);
+        if (callDag.getRecord(main).depth == CallDAG::kInfiniteCallDepth)
+            return kErrorRecursion;
     }
 
     return kErrorNone;
 }
 
-DetectCallDepth::FunctionNode* DetectCallDepth::findFunctionByName(
-    const TString& name)
+void DetectCallDepth::writeTooDeepChain(const CallDAG& callDag, size_t index)
 {
-    for (size_t i = 0; i < functions.size(); ++i) {
-        if (functions[i]->getName() == name)
-            return functions[i];
+    // Follow the callees that are deep enough to keep the chain too deep,
+    // until the chain reaches the limit.
+    std::vector<size_t> chain;
+    for (int depth = 1; depth < maxDepth; ++depth) {
+        const CallDAG::Record& record = callDag.getRecord(index);
+        for (size_t i = 0; i < record.callees.size(); ++i) {
+            if (callDag.getRecord(record.callees[i]).depth >= maxDepth - depth) {
+                index = record.callees[i];
+                break;
+            }
+        }
+        chain.push_back(index);
     }
-    return NULL;
-}
 
+    for (size_t i = chain.size(); i > 0; --i)
+        infoSink.info << "<-" << *callDag.getRecord(chain[i - 1]).name;
+}
@@ -7,14 +7,14 @@
 #ifndef COMPILER_DETECT_RECURSION_H_
 #define COMPILER_DETECT_RECURSION_H_
 
-#include <limits.h>
-#include "compiler/translator/IntermNode.h"
-#include "compiler/translator/VariableInfo.h"
+#include <stddef.h>
 
+class CallDAG;
 class TInfoSink;
 
-// Traverses intermediate tree to detect function recursion.
-class DetectCallDepth : public TIntermTraverser {
+// Checks the call graph of a shader for function recursion, and for call
+// chains deeper than the limit.
+class DetectCallDepth {
 public:
     enum ErrorCode {
         kErrorMissingMain,
@@ -23,51 +23,16 @@ public:
         kErrorNone
     };
 
-    DetectCallDepth(TInfoSink& infoSync, bool limitCallStackDepth, int maxCallStackDepth);
-    ~DetectCallDepth();
+    DetectCallDepth(TInfoSink& infoSink, bool limitCallStackDepth, int maxCallStackDepth);
 
-    virtual bool visitAggregate(Visit, TIntermAggregate*);
-
-    bool checkExceedsMaxDepth(int depth);
-
-    ErrorCode detectCallDepth();
+    // Without a limit, only what main() calls is checked. With one, every
+    // function is, because the driver may fail on unused ones too.
+    ErrorCode detectCallDepth(const CallDAG& callDag);
 
 private:
-    class FunctionNode {
-    public:
-        static const int kInfiniteCallDepth = INT_MAX;
-
-        FunctionNode(const TString& fname);
-
-        const TString& getName() const;
-
-        // If a function is already in the callee list, this becomes a no-op.
-        void addCallee(FunctionNode* callee);
-
-        // Returns kInifinityCallDepth if recursive function calls are detected.
-        int detectCallDepth(DetectCallDepth* detectCallDepth, int depth);
-
-        // Reset state.
-        void reset();
-
-    private:
-        // mangled function name is unique.
-        TString name;
-
-        // functions that are directly called by this function.
-        TVector<FunctionNode*> callees;
-
-        Visit visit;
-    };
-
-    ErrorCode detectCallDepthForFunction(FunctionNode* func);
-    FunctionNode* findFunctionByName(const TString& name);
-    void resetFunctionNodes();
-
-    TInfoSink& getInfoSink() { return infoSink; }
+    // Writes the calls of a chain that is too deep, from the deepest one up.
+    void writeTooDeepChain(const CallDAG& callDag, size_t index);
 
-    TVector<FunctionNode*> functions;
-    FunctionNode* currentFunction;
     TInfoSink& infoSink;
     int maxDepth;
 
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/FoldConstants.h"
+
+#include "compiler/translator/Intermediate.h"
+
+namespace
+{
+
+bool IsFoldableBinaryOp(TOperator op)
+{
+    switch (op)
+    {
+      case EOpAdd:
+      case EOpSub:
+      case EOpMul:
+      case EOpDiv:
+      case EOpVectorTimesScalar:
+      case EOpVectorTimesMatrix:
+      case EOpMatrixTimesVector:
+      case EOpMatrixTimesScalar:
+      case EOpMatrixTimesMatrix:
+      case EOpEqual:
+      case EOpNotEqual:
+      case EOpLessThan:
+      case EOpGreaterThan:
+      case EOpLessThanEqual:
+      case EOpGreaterThanEqual:
+      case EOpLogicalAnd:
+      case EOpLogicalOr:
+      case EOpLogicalXor:
+        return true;
+      default:
+        return false;
+    }
+}
+
+bool AreAllChildrenConstant(TIntermAggregate *node)
+{
+    TIntermSequence *sequence = node->getSequence();
+    if (sequence->empty())
+        return false;
+    for (size_t i = 0; i < sequence->size(); ++i)
+    {
+        TIntermConstantUnion *constant = (*sequence)[i]->getAsConstantUnion();
+        if (!constant || !constant->getUnionArrayPointer())
+            return false;
+    }
+    return true;
+}
+
+}  // namespace anonymous
+
+bool FoldConstants::visitUnary(Visit visit, TIntermUnary *node)
+{
+    replace(node, fold(node));
+    return true;
+}
+
+bool FoldConstants::visitBinary(Visit visit, TIntermBinary *node)
+{
+    replace(node, fold(node));
+    return true;
+}
+
+bool FoldConstants::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    replace(node, fold(node));
+    return true;
+}
+
+bool FoldConstants::visitSelection(Visit visit, TIntermSelection *node)
+{
+    replace(node, fold(node));
+    return true;
+}
+
+TIntermTyped *FoldConstants::fold(TIntermNode *node)
+{
+    TIntermTyped *replacement = NULL;
+    switch (node->getNodeType())
+    {
+      case EIntermUnary:
+        replacement = foldUnary(static_cast<TIntermUnary *>(node));
+        break;
+      case EIntermBinary:
+        replacement = foldBinary(static_cast<TIntermBinary *>(node));
+        break;
+      case EIntermAggregate:
+        replacement = foldAggregate(static_cast<TIntermAggregate *>(node));
+        break;
+      case EIntermSelection:
+        replacement = foldSelection(static_cast<TIntermSelection *>(node));
+        break;
+      default:
+        break;
+    }
+
+    if (replacement && replacement->getAsConstantUnion())
+    {
+        TType type = node->getAsTyped()->getType();
+        type.setQualifier(EvqConst);
+        replacement->setType(type);
+        replacement->setLine(node->getLine());
+    }
+    return replacement;
+}
+
+TIntermTyped *FoldConstants::foldUnary(TIntermUnary *node)
+{
+    TIntermConstantUnion *operand = node->getOperand()->getAsConstantUnion();
+    if (!operand || node->isAssignment())
+        return NULL;
+    return operand->fold(node->getOp(), NULL, mInfoSink);
+}
+
+TIntermTyped *FoldConstants::foldBinary(TIntermBinary *node)
+{
+    TIntermConstantUnion *left = node->getLeft()->getAsConstantUnion();
+    TIntermConstantUnion *right = node->getRight()->getAsConstantUnion();
+    if (!left || !left->getUnionArrayPointer())
+        return NULL;
+
+    switch (node->getOp())
+    {
+      case EOpIndexDirect:
+      case EOpIndexDirectStruct:
+        return right ? foldIndex(node, left, right) : NULL;
+      case EOpVectorSwizzle:
+        return foldIndex(node, left, NULL);
+      default:
+        if (right && IsFoldableBinaryOp(node->getOp()))
+            return left->fold(node->getOp(), right, mInfoSink);
+        return NULL;
+    }
+}
+
+TIntermTyped *FoldConstants::foldAggregate(TIntermAggregate *node)
+{
+    if (!node->isConstructor())
+        return node->fold();
+    if (!AreAllChildrenConstant(node))
+        return NULL;
+
+    const TType &type = node->getType();
+    ConstantUnion *unionArray = new ConstantUnion[type.getObjectSize()];
+    TIntermediate intermediate(mInfoSink);
+    bool singleParam = node->getSequence()->size() == 1;
+    if (intermediate.parseConstTree(node->getLine(), node, unionArray,
+                                    node->getOp(), type, singleParam))
+    {
+        return NULL;
+    }
+    return new TIntermConstantUnion(unionArray, type);
+}
+
+TIntermTyped *FoldConstants::foldSelection(TIntermSelection *node)
+{
+    // Only the branch selected by a constant condition of "?:" is evaluated.
+    TIntermConstantUnion *condition = node->getCondition()->getAsConstantUnion();
+    if (!node->usesTernaryOperator() || !condition || !condition->getUnionArrayPointer())
+        return NULL;
+
+    TIntermNode *branch = condition->getBConst(0) ? node->getTrueBlock()
+                                                   : node->getFalseBlock();
+    return branch->getAsTyped();
+}
+
+bool FoldConstants::replace(TIntermTyped *node, TIntermTyped *replacement)
+{
+    TIntermNode *parent = getParentNode();
+    if (!replacement || !parent)
+        return false;
+    return parent->replaceChildNode(node, replacement);
+}
+
+//
+// Folds the selection of components of the constant on the left: a field
+// of a structure, an element of an array, a column of a matrix, or a
+// swizzle of a vector.
+//
+// Returns NULL if the selection can't be folded.
+//
+TIntermConstantUnion *FoldConstants::foldIndex(TIntermBinary *node,
+                                               TIntermConstantUnion *left,
+                                               TIntermConstantUnion *right)
+{
+    const ConstantUnion *source = left->getUnionArrayPointer();
+    size_t sourceSize = left->getType().getObjectSize();
+    size_t size = node->getType().getObjectSize();
+    ConstantUnion *unionArray = NULL;
+
+    if (node->getOp() == EOpVectorSwizzle)
+    {
+        TIntermAggregate *offsets = node->getRight()->getAsAggregate();
+        if (!offsets || offsets->getSequence()->size() != size)
+            return NULL;
+
+        unionArray = new ConstantUnion[size];
+        for (size_t i = 0; i < size; ++i)
+        {
+            TIntermConstantUnion *offset = (*offsets->getSequence())[i]->getAsConstantUnion();
+            if (!offset || offset->getIConst(0) < 0 ||
+                static_cast<size_t>(offset->getIConst(0)) >= sourceSize)
+            {
+                return NULL;
+            }
+            unionArray[i] = source[offset->getIConst(0)];
+        }
+    }
+    else
+    {
+        int index = right->getIConst(0);
+        if (index < 0)
+            return NULL;
+
+        size_t offset = 0;
+        if (node->getOp() == EOpIndexDirectStruct)
+        {
+            const TFieldList &fields = left->getType().getStruct()->fields();
+            if (static_cast<size_t>(index) >= fields.size())
+                return NULL;
+            for (int i = 0; i < index; ++i)
+                offset += fields[i]->type()->getObjectSize();
+        }
+        else
+        {
+            offset = index * size;
+        }
+        if (offset + size > sourceSize)
+            return NULL;
+
+        unionArray = new ConstantUnion[size];
+        for (size_t i = 0; i < size; ++i)
+            unionArray[i] = source[offset + i];
+    }
+
+    return new TIntermConstantUnion(unionArray, node->getType());
+}
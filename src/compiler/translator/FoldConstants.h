@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FoldConstants is an AST traverser that replaces the expressions whose
+// operands are all constant by their value: calls to built-in functions,
+// constructors, arithmetic, component selection and constant indexing.
+// The parser only folds some of them, and only when the operands are
+// constant where they're written.
+//
+
+#ifndef COMPILER_FOLD_CONSTANTS_H_
+#define COMPILER_FOLD_CONSTANTS_H_
+
+#include "common/angleutils.h"
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/IntermNode.h"
+
+class FoldConstants : public TIntermTraverser
+{
+  public:
+    FoldConstants()
+        : TIntermTraverser(false, false, true) {}
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node);
+    virtual bool visitBinary(Visit visit, TIntermBinary *node);
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node);
+    virtual bool visitSelection(Visit visit, TIntermSelection *node);
+
+    // Returns the value of a node whose children are already folded, or
+    // NULL if it can't be folded. The node itself is left as it is.
+    TIntermTyped *fold(TIntermNode *node);
+
+  private:
+    TIntermTyped *foldUnary(TIntermUnary *node);
+    TIntermTyped *foldBinary(TIntermBinary *node);
+    TIntermTyped *foldAggregate(TIntermAggregate *node);
+    TIntermTyped *foldSelection(TIntermSelection *node);
+
+    // Replaces the node being visited, and returns false if there's no
+    // replacement.
+    bool replace(TIntermTyped *node, TIntermTyped *replacement);
+    TIntermConstantUnion *foldIndex(TIntermBinary *node,
+                                    TIntermConstantUnion *left,
+                                    TIntermConstantUnion *right);
+
+    // Folding errors only mean that the expression is left as it is.
+    TInfoSink mInfoSink;
+
+    DISALLOW_COPY_AND_ASSIGN(FoldConstants);
+};
+
+#endif  // COMPILER_FOLD_CONSTANTS_H_
@@ -6,6 +6,268 @@
 
 #include "compiler/translator/ForLoopUnroll.h"
 
+#include "compiler/translator/FoldConstants.h"
+
+#include <limits>
+#include <utility>
+
+namespace
+{
+
+TIntermConstantUnion *CreateIntConstant(int value, TPrecision precision)
+{
+    ConstantUnion *unionArray = new ConstantUnion;
+    unionArray->setIConst(value);
+    return new TIntermConstantUnion(unionArray, TType(EbtInt, precision, EvqConst));
+}
+
+TIntermSymbol *CopySymbol(TIntermSymbol *symbol)
+{
+    TIntermSymbol *copy = new TIntermSymbol(symbol->getId(), symbol->getSymbol(), symbol->getType());
+    copy->setLine(symbol->getLine());
+    return copy;
+}
+
+// Copies a tree, unrolling the loops flagged for unrolling on the way:
+// the body of such a loop is copied once per iteration, with the symbols
+// of its index replaced by their value, and the expressions that this
+// makes constant are folded as they're copied. Each node of the unrolled
+// tree is copied once from the original, so nested loops don't copy the
+// unrolled copies of their inner loops again. The copies of the children
+// are built first, and popped from a stack by the post-visit of their
+// parent.
+class UnrollingCopier : public TIntermTraverser
+{
+  public:
+    UnrollingCopier(size_t maxCopiedSize)
+        : TIntermTraverser(true, false, true),
+          mMaxCopiedSize(maxCopiedSize),
+          mCopiedSize(0),
+          mMaxCopiedSizeExceeded(false),
+          mEndlessLoopFound(false)
+    {
+    }
+
+    TIntermNode *copy(TIntermNode *node)
+    {
+        node->traverse(this);
+        ASSERT(mCopies.size() == 1);
+        return pop();
+    }
+
+    size_t getCopiedSize() const { return mCopiedSize; }
+    bool maxCopiedSizeExceeded() const { return mMaxCopiedSizeExceeded; }
+    bool endlessLoopFound() const { return mEndlessLoopFound; }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        // The innermost loops are at the back.
+        for (size_t i = mIndexValues.size(); i > 0; --i)
+        {
+            if (mIndexValues[i - 1].first == node->getId())
+            {
+                push(node, CreateIntConstant(mIndexValues[i - 1].second, node->getPrecision()));
+                return;
+            }
+        }
+        push(node, CopySymbol(node));
+    }
+
+    virtual void visitRaw(TIntermRaw *node)
+    {
+        push(node, new TIntermRaw(node->getType(), node->getRawText()));
+    }
+
+    virtual void visitConstantUnion(TIntermConstantUnion *node)
+    {
+        // The values of the constants are never modified, so they're shared.
+        push(node, new TIntermConstantUnion(node->getUnionArrayPointer(), node->getType()));
+    }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        if (visit == PreVisit)
+            return true;
+        TIntermBinary *copy = new TIntermBinary(node->getOp());
+        copy->setType(node->getType());
+        copy->setRight(popTyped());
+        copy->setLeft(popTyped());
+        if (node->getAddIndexClamp())
+            copy->setAddIndexClamp();
+        pushFolded(node, copy);
+        return true;
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        if (visit == PreVisit)
+            return true;
+        TIntermUnary *copy = new TIntermUnary(node->getOp(), node->getType());
+        copy->setOperand(popTyped());
+        if (node->getUseEmulatedFunction())
+            copy->setUseEmulatedFunction();
+        pushFolded(node, copy);
+        return true;
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        if (visit == PreVisit)
+            return true;
+        TIntermNode *falseBlock = node->getFalseBlock() ? pop() : NULL;
+        TIntermNode *trueBlock = node->getTrueBlock() ? pop() : NULL;
+        TIntermTyped *condition = popTyped();
+        pushFolded(node, new TIntermSelection(condition, trueBlock, falseBlock, node->getType()));
+        return true;
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        if (visit == PreVisit)
+            return true;
+        TIntermAggregate *copy = new TIntermAggregate(node->getOp());
+        copy->setType(node->getType());
+        copy->setName(node->getName());
+        if (node->isUserDefined())
+            copy->setUserDefined();
+        if (node->getUseEmulatedFunction())
+            copy->setUseEmulatedFunction();
+
+        TIntermSequence *sequence = copy->getSequence();
+        sequence->resize(node->getSequence()->size());
+        for (size_t i = sequence->size(); i > 0; --i)
+            (*sequence)[i - 1] = pop();
+        pushFolded(node, copy);
+        return true;
+    }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        if (visit == PreVisit)
+        {
+            if (!node->getUnrollFlag())
+                return true;
+            push(node, unroll(node));
+            return false;
+        }
+
+        TIntermTyped *expression = node->getExpression() ? popTyped() : NULL;
+        TIntermNode *body = node->getBody() ? pop() : NULL;
+        TIntermTyped *condition = node->getCondition() ? popTyped() : NULL;
+        TIntermNode *init = node->getInit() ? pop() : NULL;
+        TIntermLoop *copy = new TIntermLoop(node->getType(), init, condition, expression, body);
+        copy->setUnrollFlag(node->getUnrollFlag());
+        push(node, copy);
+        return true;
+    }
+
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        if (visit == PreVisit)
+            return true;
+        TIntermTyped *expression = node->getExpression() ? popTyped() : NULL;
+        push(node, new TIntermBranch(node->getFlowOp(), expression));
+        return true;
+    }
+
+  private:
+    // Copies the body of the loop once per iteration, and wraps the copies
+    // in a loop with a single iteration.
+    TIntermLoop *unroll(TIntermLoop *node)
+    {
+        TLoopIndexInfo index;
+        index.fillInfo(node);
+        if (!index.hasFiniteIterations())
+            mEndlessLoopFound = true;
+
+        TIntermAggregate *body = new TIntermAggregate(EOpSequence);
+        body->setLine(node->getLine());
+        for (; !mEndlessLoopFound && index.satisfiesLoopCondition(); index.step())
+        {
+            // Each iteration adds a node, even if the body is empty.
+            ++mCopiedSize;
+            if (node->getBody())
+            {
+                mIndexValues.push_back(std::make_pair(index.getId(), index.getCurrentValue()));
+                node->getBody()->traverse(this);
+                mIndexValues.pop_back();
+                body->getSequence()->push_back(pop());
+            }
+            if (mCopiedSize > mMaxCopiedSize)
+            {
+                mMaxCopiedSizeExceeded = true;
+                break;
+            }
+        }
+
+        TIntermSequence *declSeq = node->getInit()->getAsAggregate()->getSequence();
+        TIntermSymbol *indexSymbol = (*declSeq)[0]->getAsBinaryNode()->getLeft()->getAsSymbolNode();
+        TPrecision precision = indexSymbol->getPrecision();
+
+        // for (int i = 0; i < 1; ++i)
+        TIntermBinary *init = new TIntermBinary(EOpInitialize);
+        init->setLeft(CopySymbol(indexSymbol));
+        init->setRight(CreateIntConstant(0, precision));
+        init->setType(indexSymbol->getType());
+        TIntermAggregate *declaration = new TIntermAggregate(EOpDeclaration);
+        declaration->getSequence()->push_back(init);
+
+        TIntermBinary *condition = new TIntermBinary(EOpLessThan);
+        condition->setLeft(CopySymbol(indexSymbol));
+        condition->setRight(CreateIntConstant(1, precision));
+        condition->setType(TType(EbtBool, EbpUndefined));
+
+        TIntermUnary *expression = new TIntermUnary(EOpPreIncrement, indexSymbol->getType());
+        expression->setOperand(CopySymbol(indexSymbol));
+
+        TIntermLoop *unrolled = new TIntermLoop(ELoopFor, declaration, condition, expression, body);
+        unrolled->setLine(node->getLine());
+        return unrolled;
+    }
+
+    void push(TIntermNode *original, TIntermNode *copy)
+    {
+        copy->setLine(original->getLine());
+        mCopies.push_back(copy);
+        ++mCopiedSize;
+    }
+
+    // Pushes the value of the copy instead, if substituting the indices
+    // made its operands constant.
+    void pushFolded(TIntermNode *original, TIntermTyped *copy)
+    {
+        copy->setLine(original->getLine());
+        TIntermTyped *folded = mFoldConstants.fold(copy);
+        mCopies.push_back(folded ? folded : copy);
+        ++mCopiedSize;
+    }
+
+    TIntermNode *pop()
+    {
+        ASSERT(!mCopies.empty());
+        TIntermNode *copy = mCopies.back();
+        mCopies.pop_back();
+        return copy;
+    }
+
+    TIntermTyped *popTyped()
+    {
+        return pop()->getAsTyped();
+    }
+
+    size_t mMaxCopiedSize;
+    size_t mCopiedSize;
+    bool mMaxCopiedSizeExceeded;
+    bool mEndlessLoopFound;
+
+    // The values of the indices of the loops being unrolled, by symbol id.
+    TVector<std::pair<int, int> > mIndexValues;
+    TVector<TIntermNode *> mCopies;
+    FoldConstants mFoldConstants;
+};
+
+}  // namespace anonymous
+
 bool ForLoopUnrollMarker::visitBinary(Visit, TIntermBinary *node)
 {
     if (mUnrollCondition != kSamplerArrayIndex)
@@ -80,3 +342,25 @@ void ForLoopUnrollMarker::visitSymbol(TIntermSymbol* symbol)
         }
     }
 }
+
+bool ForLoopUnroller::visitLoop(Visit, TIntermLoop *node)
+{
+    if (!node->getUnrollFlag())
+        return true;
+    if (mMaxUnrolledSizeExceeded || mEndlessLoopFound)
+        return false;
+
+    // The loops flagged inside this one are unrolled by the same copy.
+    size_t maxSize = mMaxUnrolledSize == 0 ? std::numeric_limits<size_t>::max()
+                                           : mMaxUnrolledSize - mUnrolledSize;
+    UnrollingCopier copier(maxSize);
+    TIntermNode *unrolled = copier.copy(node);
+    mUnrolledSize += copier.getCopiedSize();
+    mMaxUnrolledSizeExceeded = copier.maxCopiedSizeExceeded();
+    mEndlessLoopFound = copier.endlessLoopFound();
+
+    TIntermNode *parent = getParentNode();
+    ASSERT(parent);
+    parent->replaceChildNode(node, unrolled);
+    return false;
+}
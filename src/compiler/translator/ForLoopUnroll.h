@@ -47,4 +47,46 @@ class ForLoopUnrollMarker : public TIntermTraverser
     bool mVisitSamplerArrayIndexNodeInsideLoop;
 };
 
+// This class unrolls the for-loops marked by ForLoopUnrollMarker. The body
+// of a loop is copied once per iteration, with its index replaced by its
+// value, and the copies are wrapped in a loop with a single iteration to
+// handle break:
+//   for (int i = 0; i < 2; ++i) { body(i); }
+// becomes
+//   for (int i = 0; i < 1; ++i) { body(0); body(1); }
+// The marked loops nested in a marked loop are unrolled as its body is
+// copied, so every node of the result is copied once. Unrolling stops
+// once it would add more than |maxUnrolledSize| nodes to the tree, unless
+// that is 0, and at the first loop that never ends.
+class ForLoopUnroller : public TIntermTraverser
+{
+  public:
+    ForLoopUnroller(size_t maxUnrolledSize)
+        : TIntermTraverser(true, false, false),
+          mMaxUnrolledSize(maxUnrolledSize),
+          mUnrolledSize(0),
+          mMaxUnrolledSizeExceeded(false),
+          mEndlessLoopFound(false)
+    {
+    }
+
+    virtual bool visitLoop(Visit, TIntermLoop *node);
+
+    bool maxUnrolledSizeExceeded() const
+    {
+        return mMaxUnrolledSizeExceeded;
+    }
+
+    bool endlessLoopFound() const
+    {
+        return mEndlessLoopFound;
+    }
+
+  private:
+    size_t mMaxUnrolledSize;
+    size_t mUnrolledSize;
+    bool mMaxUnrolledSizeExceeded;
+    bool mEndlessLoopFound;
+};
+
 #endif
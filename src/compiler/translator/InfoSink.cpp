@@ -6,6 +6,8 @@
 
 #include "compiler/translator/InfoSink.h"
 
+#include <stdio.h>
+
 void TInfoSinkBase::prefix(TPrefixType p) {
     switch(p) {
         case EPrefixNone:
@@ -32,14 +34,11 @@ void TInfoSinkBase::prefix(TPrefixType p) {
 }
 
 void TInfoSinkBase::location(int file, int line) {
-    TPersistStringStream stream;
     if (line)
-        stream << file << ":" << line;
+        *this << file << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        *this << file << ":? ";
+    sink.append(": ");
 }
 
 void TInfoSinkBase::location(const TSourceLoc& loc) {
@@ -52,3 +51,44 @@ void TInfoSinkBase::message(TPrefixType p, const TSourceLoc& loc, const char* m)
     sink.append(m);
     sink.append("\n");
 }
+
+void TInfoSinkBase::appendSigned(long i) {
+    if (i < 0) {
+        sink.append(1, '-');
+        appendUnsigned(0ul - static_cast<unsigned long>(i));
+    } else {
+        appendUnsigned(static_cast<unsigned long>(i));
+    }
+}
+
+void TInfoSinkBase::appendUnsigned(unsigned long u) {
+    char buffer[3 * sizeof(unsigned long)];
+    char* end = buffer + sizeof(buffer);
+    char* start = end;
+    do {
+        *--start = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    sink.append(start, end);
+}
+
+// Make sure floats are written with correct precision.
+void TInfoSinkBase::appendFloat(float f) {
+    // Large enough for the digits of FLT_MAX written in full.
+    char buffer[64];
+    // Make sure that at least one decimal point is written. If a number
+    // does not have a fractional part, the default precision format does
+    // not write the decimal portion which gets interpreted as integer by
+    // the compiler.
+    if (fractionalPart(f) == 0.0f)
+        snprintf(buffer, sizeof(buffer), "%.1f", f);
+    else
+        snprintf(buffer, sizeof(buffer), "%.8g", f);
+
+    // The C locale may use a comma as the decimal point.
+    for (char* c = buffer; *c != '\0'; ++c) {
+        if (*c == ',')
+            *c = '.';
+    }
+    sink.append(buffer);
+}
@@ -65,23 +65,26 @@ public:
         sink.append(str.c_str());
         return *this;
     }
-    // Make sure floats are written with correct precision.
+    // Numbers are formatted in place, rather than through a temporary
+    // string stream, since the output writes a lot of them.
+    TInfoSinkBase& operator<<(int i) {
+        appendSigned(i);
+        return *this;
+    }
+    TInfoSinkBase& operator<<(unsigned int u) {
+        appendUnsigned(u);
+        return *this;
+    }
+    TInfoSinkBase& operator<<(long i) {
+        appendSigned(i);
+        return *this;
+    }
+    TInfoSinkBase& operator<<(unsigned long u) {
+        appendUnsigned(u);
+        return *this;
+    }
     TInfoSinkBase& operator<<(float f) {
-        // Make sure that at least one decimal point is written. If a number
-        // does not have a fractional part, the default precision format does
-        // not write the decimal portion which gets interpreted as integer by
-        // the compiler.
-        TPersistStringStream stream;
-        if (fractionalPart(f) == 0.0f) {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
-        } else {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
-        }
-        sink.append(stream.str());
+        appendFloat(f);
         return *this;
     }
     // Write boolean values as their names instead of integral value.
@@ -93,6 +96,14 @@ public:
 
     void erase() { sink.clear(); }
     int size() { return static_cast<int>(sink.size()); }
+    void reserve(size_t capacity) { sink.reserve(capacity); }
+
+    // Moves the contents into str without copying them, and empties the
+    // sink. The sink keeps the storage str had, for the next compile.
+    void take(TPersistString *str) {
+        sink.swap(*str);
+        sink.clear();
+    }
 
     const TPersistString& str() const { return sink; }
     const char* c_str() const { return sink.c_str(); }
@@ -103,6 +114,10 @@ public:
     void message(TPrefixType p, const TSourceLoc& loc, const char* m);
 
 private:
+    void appendSigned(long i);
+    void appendUnsigned(unsigned long u);
+    void appendFloat(float f);
+
     TPersistString sink;
 };
 
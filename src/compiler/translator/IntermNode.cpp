@@ -10,6 +10,7 @@
 
 #include <float.h>
 #include <limits.h>
+#include <math.h>
 #include <algorithm>
 
 #include "compiler/translator/HashNames.h"
@@ -124,6 +125,444 @@ bool CompareStructure(const TType &leftNodeType,
     return true;
 }
 
+// A constant argument of a built-in function call. A scalar argument of a
+// function that otherwise takes vectors stands for a vector of its value.
+struct BuiltInArgument
+{
+    const ConstantUnion &operator[](size_t i) const { return values[size == 1 ? 0 : i]; }
+    float f(size_t i) const { return (*this)[i].getFConst(); }
+
+    const ConstantUnion *values;
+    size_t size;
+};
+
+bool IsFinite(float value)
+{
+    return value == value && value >= -FLT_MAX && value <= FLT_MAX;
+}
+
+// Returns true if value is 2^exponent, with exponent in the range of
+// normalized floats.
+bool IsPowerOfTwo(float value, int *exponent)
+{
+    if (!(value > 0.0f) || !IsFinite(value))
+        return false;
+    int e;
+    if (frexpf(value, &e) != 0.5f)
+        return false;
+    *exponent = e - 1;
+    return *exponent >= FLT_MIN_EXP - 1;
+}
+
+// Computes 2^exponent, if it is an exactly representable normalized float.
+bool ExactPowerOfTwo(float exponent, float *result)
+{
+    if (floorf(exponent) != exponent ||
+        exponent < FLT_MIN_EXP - 1 || exponent > FLT_MAX_EXP - 1)
+    {
+        return false;
+    }
+    *result = ldexpf(1.0f, static_cast<int>(exponent));
+    return true;
+}
+
+float Dot(const BuiltInArgument &x, const BuiltInArgument &y)
+{
+    float dot = 0.0f;
+    for (size_t i = 0; i < x.size; ++i)
+        dot += x.f(i) * y.f(i);
+    return dot;
+}
+
+// Returns the number of arguments of a built-in function that works
+// component-wise on floats, or 0 for the other operators.
+size_t GetComponentWiseArgCount(TOperator op, size_t argCount)
+{
+    switch (op)
+    {
+      case EOpRadians:
+      case EOpDegrees:
+      case EOpSin:
+      case EOpCos:
+      case EOpTan:
+      case EOpAsin:
+      case EOpAcos:
+      case EOpExp:
+      case EOpLog:
+      case EOpExp2:
+      case EOpLog2:
+      case EOpSqrt:
+      case EOpInverseSqrt:
+      case EOpAbs:
+      case EOpSign:
+      case EOpFloor:
+      case EOpCeil:
+      case EOpFract:
+      case EOpDFdx:
+      case EOpDFdy:
+      case EOpFwidth:
+        return 1;
+      case EOpAtan:
+        // atan(y_over_x) or atan(y, x)
+        return argCount == 1 ? 1 : 2;
+      case EOpPow:
+      case EOpMod:
+      case EOpMin:
+      case EOpMax:
+      case EOpStep:
+      case EOpMul:
+        return 2;
+      case EOpClamp:
+      case EOpMix:
+      case EOpSmoothStep:
+        return 3;
+      default:
+        return 0;
+    }
+}
+
+// Computes a component of a built-in function that works component-wise
+// on floats. Returns false if the result is undefined for the arguments.
+//
+// The transcendental functions are only folded where their result is
+// exact, so that the folded value doesn't depend on the precision of the
+// C library: sin(0.0) is 0.0, but sin(1.0) is left to the GPU.
+bool FoldComponent(TOperator op, const BuiltInArgument *args, size_t argCount, size_t i,
+                   float *result)
+{
+    const float x = args[0].f(i);
+    int exponent;
+    switch (op)
+    {
+      case EOpAtan:
+        if (argCount == 1)
+        {
+            *result = x;
+            return x == 0.0f;
+        }
+        break;
+      case EOpRadians:     *result = x * 0.01745329251994329577f; return true;
+      case EOpDegrees:     *result = x * 57.29577951308232087680f; return true;
+      case EOpSin:         *result = x; return x == 0.0f;
+      case EOpCos:         *result = 1.0f; return x == 0.0f;
+      case EOpTan:         *result = x; return x == 0.0f;
+      case EOpAsin:        *result = x; return x == 0.0f;
+      case EOpAcos:        *result = 0.0f; return x == 1.0f;
+      case EOpExp:         *result = 1.0f; return x == 0.0f;
+      case EOpLog:         *result = 0.0f; return x == 1.0f;
+      case EOpExp2:        return ExactPowerOfTwo(x, result);
+      case EOpLog2:
+        if (!IsPowerOfTwo(x, &exponent))
+            return false;
+        *result = static_cast<float>(exponent);
+        return true;
+      case EOpSqrt:        *result = sqrtf(x); return x >= 0.0f;
+      case EOpInverseSqrt:
+        if (!IsPowerOfTwo(x, &exponent) || exponent % 2 != 0)
+            return false;
+        return ExactPowerOfTwo(static_cast<float>(-exponent / 2), result);
+      case EOpAbs:         *result = fabsf(x); return true;
+      case EOpSign:        *result = x > 0.0f ? 1.0f : (x < 0.0f ? -1.0f : 0.0f); return true;
+      case EOpFloor:       *result = floorf(x); return true;
+      case EOpCeil:        *result = ceilf(x); return true;
+      case EOpFract:       *result = x - floorf(x); return true;
+
+      // The derivatives of a constant are zero.
+      case EOpDFdx:
+      case EOpDFdy:
+      case EOpFwidth:
+        *result = 0.0f;
+        return true;
+
+      default:
+        break;
+    }
+
+    const float y = args[1].f(i);
+    switch (op)
+    {
+      case EOpAtan:
+        // atan(y, x): the first argument is y.
+        *result = x;
+        return x == 0.0f && y > 0.0f;
+      case EOpPow:
+        if (x > 0.0f && y == 0.0f)
+        {
+            *result = 1.0f;
+            return true;
+        }
+        if (!IsPowerOfTwo(x, &exponent))
+            return false;
+        return ExactPowerOfTwo(static_cast<float>(exponent) * y, result);
+      case EOpMod:
+        *result = x - y * floorf(x / y);
+        return true;
+      case EOpMin:
+        *result = std::min(x, y);
+        return true;
+      case EOpMax:
+        *result = std::max(x, y);
+        return true;
+      case EOpStep:
+        // step(edge, x)
+        *result = y < x ? 0.0f : 1.0f;
+        return true;
+      case EOpMul:
+        // matrixCompMult
+        *result = x * y;
+        return true;
+      default:
+        break;
+    }
+
+    const float z = args[2].f(i);
+    switch (op)
+    {
+      case EOpClamp:
+        *result = std::min(std::max(x, y), z);
+        return y <= z;
+      case EOpMix:
+        *result = x * (1.0f - z) + y * z;
+        return true;
+      case EOpSmoothStep:
+        {
+            // smoothstep(edge0, edge1, x)
+            float t = std::min(std::max((z - x) / (y - x), 0.0f), 1.0f);
+            *result = t * t * (3.0f - 2.0f * t);
+            return x < y;
+        }
+      default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
+// Computes a call to a built-in function on constant arguments. The
+// result has resultSize components. Returns false if the function can't
+// be folded, or if its result is undefined for the arguments.
+bool FoldBuiltIn(TOperator op, const BuiltInArgument *args, size_t argCount,
+                 ConstantUnion *result, size_t resultSize)
+{
+    const BuiltInArgument &x = args[0];
+
+    // The functions on booleans, and the comparisons, which also take
+    // integers.
+    switch (op)
+    {
+      case EOpAny:
+      case EOpAll:
+        {
+            bool any = false;
+            bool all = true;
+            for (size_t i = 0; i < x.size; ++i)
+            {
+                any = any || x[i].getBConst();
+                all = all && x[i].getBConst();
+            }
+            result[0].setBConst(op == EOpAny ? any : all);
+            return true;
+        }
+      case EOpVectorLogicalNot:
+        for (size_t i = 0; i < resultSize; ++i)
+            result[i].setBConst(!x[i].getBConst());
+        return true;
+      case EOpLessThan:
+      case EOpGreaterThan:
+      case EOpLessThanEqual:
+      case EOpGreaterThanEqual:
+      case EOpVectorEqual:
+      case EOpVectorNotEqual:
+        if (argCount != 2)
+            return false;
+        for (size_t i = 0; i < resultSize; ++i)
+        {
+            const ConstantUnion &left = x[i];
+            const ConstantUnion &right = args[1][i];
+            switch (op)
+            {
+              case EOpLessThan:         result[i].setBConst(left < right); break;
+              case EOpGreaterThan:      result[i].setBConst(left > right); break;
+              case EOpLessThanEqual:    result[i].setBConst(!(left > right)); break;
+              case EOpGreaterThanEqual: result[i].setBConst(!(left < right)); break;
+              case EOpVectorEqual:      result[i].setBConst(left == right); break;
+              default:                  result[i].setBConst(left != right); break;
+            }
+        }
+        return true;
+      default:
+        break;
+    }
+
+    // The rest only take floats.
+    for (size_t i = 0; i < argCount; ++i)
+    {
+        if (args[i][0].getType() != EbtFloat)
+            return false;
+    }
+
+    size_t componentWiseArgCount = GetComponentWiseArgCount(op, argCount);
+    if (componentWiseArgCount > 0)
+    {
+        if (argCount != componentWiseArgCount)
+            return false;
+        for (size_t i = 0; i < resultSize; ++i)
+        {
+            float value;
+            if (!FoldComponent(op, args, argCount, i, &value))
+                return false;
+            result[i].setFConst(value);
+        }
+    }
+    else
+    {
+        switch (op)
+        {
+          case EOpLength:
+            result[0].setFConst(sqrtf(Dot(x, x)));
+            break;
+
+          case EOpDistance:
+            {
+                float distance = 0.0f;
+                for (size_t i = 0; i < x.size; ++i)
+                {
+                    float difference = x.f(i) - args[1].f(i);
+                    distance += difference * difference;
+                }
+                result[0].setFConst(sqrtf(distance));
+                break;
+            }
+
+          case EOpDot:
+            result[0].setFConst(Dot(x, args[1]));
+            break;
+
+          case EOpCross:
+            {
+                const BuiltInArgument &y = args[1];
+                result[0].setFConst(x.f(1) * y.f(2) - y.f(1) * x.f(2));
+                result[1].setFConst(x.f(2) * y.f(0) - y.f(2) * x.f(0));
+                result[2].setFConst(x.f(0) * y.f(1) - y.f(0) * x.f(1));
+                break;
+            }
+
+          case EOpNormalize:
+            {
+                float length = sqrtf(Dot(x, x));
+                if (length == 0.0f)
+                    return false;
+                for (size_t i = 0; i < resultSize; ++i)
+                    result[i].setFConst(x.f(i) / length);
+                break;
+            }
+
+          case EOpFaceForward:
+            {
+                // faceforward(N, I, Nref)
+                float sign = Dot(args[2], args[1]) < 0.0f ? 1.0f : -1.0f;
+                for (size_t i = 0; i < resultSize; ++i)
+                    result[i].setFConst(sign * x.f(i));
+                break;
+            }
+
+          case EOpReflect:
+            {
+                // reflect(I, N)
+                const BuiltInArgument &n = args[1];
+                float dot = Dot(n, x);
+                for (size_t i = 0; i < resultSize; ++i)
+                    result[i].setFConst(x.f(i) - 2.0f * dot * n.f(i));
+                break;
+            }
+
+          case EOpRefract:
+            {
+                // refract(I, N, eta)
+                const BuiltInArgument &n = args[1];
+                float eta = args[2].f(0);
+                float dot = Dot(n, x);
+                float k = 1.0f - eta * eta * (1.0f - dot * dot);
+                for (size_t i = 0; i < resultSize; ++i)
+                {
+                    result[i].setFConst(k < 0.0f ? 0.0f :
+                                        eta * x.f(i) - (eta * dot + sqrtf(k)) * n.f(i));
+                }
+                break;
+            }
+
+          default:
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < resultSize; ++i)
+    {
+        if (!IsFinite(result[i].getFConst()))
+            return false;
+    }
+    return true;
+}
+
+TIntermConstantUnion *FoldBuiltInCall(TOperator op, const BuiltInArgument *args, size_t argCount,
+                                      const TType &resultType, const TSourceLoc &line)
+{
+    size_t resultSize = resultType.getObjectSize();
+    ConstantUnion *result = new ConstantUnion[resultSize];
+    if (!FoldBuiltIn(op, args, argCount, result, resultSize))
+        return NULL;
+
+    TIntermConstantUnion *node = new TIntermConstantUnion(result, resultType);
+    node->setLine(line);
+    return node;
+}
+
+// Only the operands that are binary or unary nodes are kept on the stack,
+// and only when a node has two of them, so chains take no stack at all.
+bool OperatorHasSideEffects(const TIntermOperator *node)
+{
+    TVector<const TIntermOperator *> pending;
+    while (node)
+    {
+        if (node->isAssignment())
+            return true;
+
+        const TIntermTyped *operands[2] = { NULL, NULL };
+        if (node->getNodeType() == EIntermBinary)
+        {
+            const TIntermBinary *binary = static_cast<const TIntermBinary *>(node);
+            operands[0] = binary->getLeft();
+            operands[1] = binary->getRight();
+        }
+        else
+        {
+            operands[0] = static_cast<const TIntermUnary *>(node)->getOperand();
+        }
+
+        node = NULL;
+        for (size_t i = 0; i < 2 && operands[i]; ++i)
+        {
+            TIntermNodeType type = operands[i]->getNodeType();
+            if (type == EIntermBinary || type == EIntermUnary)
+            {
+                if (node)
+                    pending.push_back(node);
+                node = static_cast<const TIntermOperator *>(operands[i]);
+            }
+            else if (operands[i]->hasSideEffects())
+            {
+                return true;
+            }
+        }
+
+        if (!node && !pending.empty())
+        {
+            node = pending.back();
+            pending.pop_back();
+        }
+    }
+    return false;
+}
+
 }  // namespace anonymous
 
 
@@ -157,26 +596,6 @@ bool TIntermLoop::replaceChildNode(
     return false;
 }
 
-void TIntermLoop::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
-{
-    if (mInit)
-    {
-        nodeQueue->push(mInit);
-    }
-    if (mCond)
-    {
-        nodeQueue->push(mCond);
-    }
-    if (mExpr)
-    {
-        nodeQueue->push(mExpr);
-    }
-    if (mBody)
-    {
-        nodeQueue->push(mBody);
-    }
-}
-
 bool TIntermBranch::replaceChildNode(
     TIntermNode *original, TIntermNode *replacement)
 {
@@ -184,14 +603,6 @@ bool TIntermBranch::replaceChildNode(
     return false;
 }
 
-void TIntermBranch::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
-{
-    if (mExpression)
-    {
-        nodeQueue->push(mExpression);
-    }
-}
-
 bool TIntermBinary::replaceChildNode(
     TIntermNode *original, TIntermNode *replacement)
 {
@@ -200,18 +611,6 @@ bool TIntermBinary::replaceChildNode(
     return false;
 }
 
-void TIntermBinary::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
-{
-    if (mLeft)
-    {
-        nodeQueue->push(mLeft);
-    }
-    if (mRight)
-    {
-        nodeQueue->push(mRight);
-    }
-}
-
 bool TIntermUnary::replaceChildNode(
     TIntermNode *original, TIntermNode *replacement)
 {
@@ -219,14 +618,6 @@ bool TIntermUnary::replaceChildNode(
     return false;
 }
 
-void TIntermUnary::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
-{
-    if (mOperand)
-    {
-        nodeQueue->push(mOperand);
-    }
-}
-
 bool TIntermAggregate::replaceChildNode(
     TIntermNode *original, TIntermNode *replacement)
 {
@@ -237,14 +628,6 @@ bool TIntermAggregate::replaceChildNode(
     return false;
 }
 
-void TIntermAggregate::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
-{
-    for (size_t childIndex = 0; childIndex < mSequence.size(); childIndex++)
-    {
-        nodeQueue->push(mSequence[childIndex]);
-    }
-}
-
 void TIntermAggregate::setPrecisionFromChildren()
 {
     if (getBasicType() == EbtBool)
@@ -300,20 +683,20 @@ bool TIntermSelection::replaceChildNode(
     return false;
 }
 
-void TIntermSelection::enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const
+//
+// Binary and unary nodes have side effects if they assign or if one of their
+// operands does. Chains of operators can be deeper than the thread's stack
+// allows recursing through, so the operands that are operators themselves
+// are searched with an explicit stack; the others answer without recursing.
+//
+bool TIntermBinary::hasSideEffects() const
 {
-    if (mCondition)
-    {
-        nodeQueue->push(mCondition);
-    }
-    if (mTrueBlock)
-    {
-        nodeQueue->push(mTrueBlock);
-    }
-    if (mFalseBlock)
-    {
-        nodeQueue->push(mFalseBlock);
-    }
+    return OperatorHasSideEffects(this);
+}
+
+bool TIntermUnary::hasSideEffects() const
+{
+    return OperatorHasSideEffects(this);
 }
 
 //
@@ -1096,6 +1479,18 @@ TIntermTyped *TIntermConstantUnion::fold(
         //
         // Do unary operations
         //
+        if (op != EOpNegative && op != EOpPositive && op != EOpLogicalNot)
+        {
+            // A call to a built-in function with a single argument.
+            BuiltInArgument argument = { unionArray, objectSize };
+            TType resultType = getType();
+            if (op == EOpLength)
+                resultType = TType(EbtFloat, getPrecision(), EvqConst);
+            else if (op == EOpAny || op == EOpAll)
+                resultType = TType(EbtBool, EbpUndefined, EvqConst);
+            return FoldBuiltInCall(op, &argument, 1, resultType, getLine());
+        }
+
         TIntermConstantUnion *newNode = 0;
         ConstantUnion* tempConstArray = new ConstantUnion[objectSize];
         for (size_t i = 0; i < objectSize; i++)
@@ -1170,6 +1565,32 @@ TIntermTyped *TIntermConstantUnion::fold(
     }
 }
 
+//
+// Folds a call to a built-in function mapped to an operator, if all its
+// arguments are constant.
+//
+// Returns the constant result, or NULL if the call can't be folded.
+//
+TIntermConstantUnion *TIntermAggregate::fold()
+{
+    BuiltInArgument arguments[3];
+    if (isConstructor() || mSequence.empty() || mSequence.size() > 3)
+        return NULL;
+
+    for (size_t i = 0; i < mSequence.size(); ++i)
+    {
+        TIntermConstantUnion *constant = mSequence[i]->getAsConstantUnion();
+        if (!constant || !constant->getUnionArrayPointer())
+            return NULL;
+        arguments[i].values = constant->getUnionArrayPointer();
+        arguments[i].size = constant->getType().getObjectSize();
+    }
+
+    TType resultType = getType();
+    resultType.setQualifier(EvqConst);
+    return FoldBuiltInCall(mOp, arguments, mSequence.size(), resultType, getLine());
+}
+
 // static
 TString TIntermTraverser::hash(const TString &name, ShHashFunction64 hashFunction)
 {
@@ -19,7 +19,6 @@
 #include "GLSLANG/ShaderLang.h"
 
 #include <algorithm>
-#include <queue>
 
 #include "compiler/translator/Common.h"
 #include "compiler/translator/Types.h"
@@ -202,6 +201,30 @@ class TIntermLoop;
 class TInfoSink;
 class TIntermRaw;
 
+//
+// The concrete type of a node, which tells the traversal with an explicit
+// stack which children the node has and which visit function to call for it.
+//
+enum TIntermNodeType
+{
+    EIntermSymbol,
+    EIntermRaw,
+    EIntermConstantUnion,
+    EIntermBinary,
+    EIntermUnary,
+    EIntermAggregate,
+    EIntermSelection,
+    EIntermLoop,
+    EIntermBranch
+};
+
+enum Visit
+{
+    PreVisit,
+    InVisit,
+    PostVisit
+};
+
 //
 // Base class for the tree nodes
 //
@@ -222,6 +245,7 @@ class TIntermNode
     void setLine(const TSourceLoc &l) { mLine = l; }
 
     virtual void traverse(TIntermTraverser *) = 0;
+    virtual TIntermNodeType getNodeType() const = 0;
     virtual TIntermTyped *getAsTyped() { return 0; }
     virtual TIntermConstantUnion *getAsConstantUnion() { return 0; }
     virtual TIntermAggregate *getAsAggregate() { return 0; }
@@ -237,12 +261,17 @@ class TIntermNode
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement) = 0;
 
-    // For traversing a tree in no particular order, but using
-    // heap memory.
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const = 0;
-
   protected:
+    // Past a certain depth, the traversal of a subtree goes on with an
+    // explicit stack rather than recursing, so that deep trees do not
+    // overflow the thread's stack. Returns false if the traversal is still
+    // shallow enough to recurse.
+    bool traverseWithStackIfDeep(TIntermTraverser *it);
+
     TSourceLoc mLine;
+
+  private:
+    void traverseWithStack(TIntermTraverser *it);
 };
 
 //
@@ -319,6 +348,7 @@ class TIntermLoop : public TIntermNode
 
     virtual TIntermLoop *getAsLoopNode() { return this; }
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermLoop; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
@@ -331,8 +361,6 @@ class TIntermLoop : public TIntermNode
     void setUnrollFlag(bool flag) { mUnrollFlag = flag; }
     bool getUnrollFlag() const { return mUnrollFlag; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
   protected:
     TLoopType mType;
     TIntermNode *mInit;  // for-loop initialization
@@ -354,14 +382,13 @@ class TIntermBranch : public TIntermNode
           mExpression(e) { }
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermBranch; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
     TOperator getFlowOp() { return mFlowOp; }
     TIntermTyped* getExpression() { return mExpression; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
 protected:
     TOperator mFlowOp;
     TIntermTyped *mExpression;  // non-zero except for "return exp;" statements
@@ -391,11 +418,10 @@ class TIntermSymbol : public TIntermTyped
     void setId(int newId) { mId = newId; }
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermSymbol; }
     virtual TIntermSymbol *getAsSymbolNode() { return this; }
     virtual bool replaceChildNode(TIntermNode *, TIntermNode *) { return false; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const {}
-
   protected:
     int mId;
     TString mSymbol;
@@ -416,10 +442,10 @@ class TIntermRaw : public TIntermTyped
     TString getRawText() const { return mRawText; }
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermRaw; }
 
     virtual TIntermRaw *getAsRawNode() { return this; }
     virtual bool replaceChildNode(TIntermNode *, TIntermNode *) { return false; }
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const {}
 
   protected:
     TString mRawText;
@@ -455,12 +481,11 @@ class TIntermConstantUnion : public TIntermTyped
 
     virtual TIntermConstantUnion *getAsConstantUnion()  { return this; }
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermConstantUnion; }
     virtual bool replaceChildNode(TIntermNode *, TIntermNode *) { return false; }
 
     TIntermTyped *fold(TOperator, TIntermTyped *, TInfoSink &);
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const {}
-
   protected:
     ConstantUnion *mUnionArrayPointer;
 };
@@ -502,13 +527,11 @@ class TIntermBinary : public TIntermOperator
 
     virtual TIntermBinary *getAsBinaryNode() { return this; }
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermBinary; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
-    virtual bool hasSideEffects() const
-    {
-        return isAssignment() || mLeft->hasSideEffects() || mRight->hasSideEffects();
-    }
+    virtual bool hasSideEffects() const;
 
     void setLeft(TIntermTyped *node) { mLeft = node; }
     void setRight(TIntermTyped *node) { mRight = node; }
@@ -519,8 +542,6 @@ class TIntermBinary : public TIntermOperator
     void setAddIndexClamp() { mAddIndexClamp = true; }
     bool getAddIndexClamp() { return mAddIndexClamp; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
   protected:
     TIntermTyped* mLeft;
     TIntermTyped* mRight;
@@ -545,24 +566,20 @@ class TIntermUnary : public TIntermOperator
           mUseEmulatedFunction(false) {}
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermUnary; }
     virtual TIntermUnary *getAsUnaryNode() { return this; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
-    virtual bool hasSideEffects() const
-    {
-        return isAssignment() || mOperand->hasSideEffects();
-    }
+    virtual bool hasSideEffects() const;
 
     void setOperand(TIntermTyped *operand) { mOperand = operand; }
-    TIntermTyped *getOperand() { return mOperand; }
+    TIntermTyped *getOperand() const { return mOperand; }
     bool promote(TInfoSink &);
 
     void setUseEmulatedFunction() { mUseEmulatedFunction = true; }
     bool getUseEmulatedFunction() { return mUseEmulatedFunction; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
   protected:
     TIntermTyped *mOperand;
 
@@ -591,6 +608,7 @@ class TIntermAggregate : public TIntermOperator
 
     virtual TIntermAggregate *getAsAggregate() { return this; }
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermAggregate; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
@@ -613,11 +631,11 @@ class TIntermAggregate : public TIntermOperator
     void setUseEmulatedFunction() { mUseEmulatedFunction = true; }
     bool getUseEmulatedFunction() { return mUseEmulatedFunction; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
     void setPrecisionFromChildren();
     void setBuiltInFunctionPrecision();
 
+    TIntermConstantUnion *fold();
+
   protected:
     TIntermAggregate(const TIntermAggregate &); // disallow copy constructor
     TIntermAggregate &operator=(const TIntermAggregate &); // disallow assignment operator
@@ -652,6 +670,7 @@ class TIntermSelection : public TIntermTyped
           mFalseBlock(falseB) {}
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermNodeType getNodeType() const { return EIntermSelection; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
@@ -664,21 +683,12 @@ class TIntermSelection : public TIntermTyped
     TIntermNode *getFalseBlock() const { return mFalseBlock; }
     TIntermSelection *getAsSelectionNode() { return this; }
 
-    virtual void enqueueChildren(std::queue<TIntermNode *> *nodeQueue) const;
-
 protected:
     TIntermTyped *mCondition;
     TIntermNode *mTrueBlock;
     TIntermNode *mFalseBlock;
 };
 
-enum Visit
-{
-    PreVisit,
-    InVisit,
-    PostVisit
-};
-
 //
 // For traversing the tree.  User should derive from this,
 // put their traversal specific data in it, and then pass
@@ -699,7 +709,8 @@ class TIntermTraverser
           postVisit(postVisit),
           rightToLeft(rightToLeft),
           mDepth(0),
-          mMaxDepth(0) {}
+          mMaxDepth(0),
+          mFrameCount(0) {}
     virtual ~TIntermTraverser() {}
 
     virtual void visitSymbol(TIntermSymbol *) {}
@@ -747,18 +758,38 @@ class TIntermTraverser
 
     // All the nodes from root to the current node's parent during traversing.
     TVector<TIntermNode *> mPath;
+
+  private:
+    friend class TIntermNode;
+
+    // A node whose children are being traversed.
+    struct Frame
+    {
+        TIntermNode *node;
+        TIntermNodeType type;
+        unsigned int nextChild;  // Position of the next child in traversal order.
+        bool visit;              // False once a visit of the node has returned false.
+    };
+
+    // The explicit stack of deep traversals: the first mFrameCount
+    // entries are in use. A traverse started from within a visit function
+    // stacks its frames on top of the running one.
+    TVector<Frame> mFrames;
+    size_t mFrameCount;
 };
 
 //
 // For traversing the tree, and computing max depth.
 // Takes a maximum depth limit to prevent stack overflow.
+// Once the limit is reached, every pre-visit returns false, so the depth
+// can't grow any more and there is no need for in-visits to stop sooner.
 //
 class TMaxDepthTraverser : public TIntermTraverser
 {
   public:
     POOL_ALLOCATOR_NEW_DELETE();
     TMaxDepthTraverser(int depthLimit)
-        : TIntermTraverser(true, true, false, false),
+        : TIntermTraverser(true, false, false, false),
           mDepthLimit(depthLimit) { }
 
     virtual bool visitBinary(Visit, TIntermBinary *) { return depthCheck(); }
@@ -774,4 +805,33 @@ protected:
     int mDepthLimit;
 };
 
+//
+// Counts the nodes of the tree it traverses. A traverser that does more at
+// every node can derive from it and override countNode().
+//
+class TNodeCounter : public TIntermTraverser
+{
+  public:
+    TNodeCounter()
+        : TIntermTraverser(true, false, false),
+          mNodeCount(0) { }
+
+    virtual void visitSymbol(TIntermSymbol *) { countNode(); }
+    virtual void visitRaw(TIntermRaw *) { countNode(); }
+    virtual void visitConstantUnion(TIntermConstantUnion *) { countNode(); }
+    virtual bool visitBinary(Visit, TIntermBinary *) { countNode(); return true; }
+    virtual bool visitUnary(Visit, TIntermUnary *) { countNode(); return true; }
+    virtual bool visitSelection(Visit, TIntermSelection *) { countNode(); return true; }
+    virtual bool visitAggregate(Visit, TIntermAggregate *) { countNode(); return true; }
+    virtual bool visitLoop(Visit, TIntermLoop *) { countNode(); return true; }
+    virtual bool visitBranch(Visit, TIntermBranch *) { countNode(); return true; }
+
+    size_t getNodeCount() const { return mNodeCount; }
+
+  protected:
+    virtual void countNode() { ++mNodeCount; }
+
+    size_t mNodeCount;
+};
+
 #endif  // COMPILER_TRANSLATOR_INTERMEDIATE_H_
@@ -9,7 +9,11 @@
 //
 // Traverse the intermediate representation tree, and
 // call a node type specific function for each node.
-// Done recursively through the member function Traverse().
+// Done recursively through the member function Traverse(), down to
+// kMaxRecursionDepth. The subtrees below are traversed with an explicit
+// stack of the nodes whose children are being visited, kept in the
+// traverser, so that the depth of the tree is not limited by the
+// thread's stack.
 // Node types can be skipped if their function to call is 0,
 // but their subtree will still be traversed.
 // Nodes with children can have their whole subtree skipped
@@ -19,6 +23,50 @@
 // preVisit, postVisit, and rightToLeft control what order
 // nodes are visited in.
 //
+// An in-visit comes between two children. For a binary node, an in-visit
+// returning false skips the right child and the post-visit. For an
+// aggregate node, it skips the later in-visits and the post-visit, but
+// the remaining children are still traversed.
+//
+
+namespace
+{
+
+// Recursing this deep takes a few tens of kilobytes of stack.
+const int kMaxRecursionDepth = 256;
+
+bool VisitNode(TIntermTraverser *it, Visit visit, TIntermNode *node, TIntermNodeType type)
+{
+    switch (type)
+    {
+      case EIntermBinary:
+        return it->visitBinary(visit, static_cast<TIntermBinary *>(node));
+      case EIntermUnary:
+        return it->visitUnary(visit, static_cast<TIntermUnary *>(node));
+      case EIntermAggregate:
+        return it->visitAggregate(visit, static_cast<TIntermAggregate *>(node));
+      case EIntermSelection:
+        return it->visitSelection(visit, static_cast<TIntermSelection *>(node));
+      case EIntermLoop:
+        return it->visitLoop(visit, static_cast<TIntermLoop *>(node));
+      case EIntermBranch:
+        return it->visitBranch(visit, static_cast<TIntermBranch *>(node));
+      default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
+}  // namespace anonymous
+
+inline bool TIntermNode::traverseWithStackIfDeep(TIntermTraverser *it)
+{
+    if (it->mDepth < kMaxRecursionDepth)
+        return false;
+
+    traverseWithStack(it);
+    return true;
+}
 
 //
 // Traversal functions for terminals are straighforward....
@@ -38,6 +86,9 @@ void TIntermConstantUnion::traverse(TIntermTraverser *it)
 //
 void TIntermBinary::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     //
@@ -92,6 +143,9 @@ void TIntermBinary::traverse(TIntermTraverser *it)
 //
 void TIntermUnary::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     if (it->preVisit)
@@ -112,6 +166,9 @@ void TIntermUnary::traverse(TIntermTraverser *it)
 //
 void TIntermAggregate::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     if (it->preVisit)
@@ -162,6 +219,9 @@ void TIntermAggregate::traverse(TIntermTraverser *it)
 //
 void TIntermSelection::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     if (it->preVisit)
@@ -198,6 +258,9 @@ void TIntermSelection::traverse(TIntermTraverser *it)
 //
 void TIntermLoop::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     if (it->preVisit)
@@ -248,6 +311,9 @@ void TIntermLoop::traverse(TIntermTraverser *it)
 //
 void TIntermBranch::traverse(TIntermTraverser *it)
 {
+    if (traverseWithStackIfDeep(it))
+        return;
+
     bool visit = true;
 
     if (it->preVisit)
@@ -267,3 +333,178 @@ void TIntermRaw::traverse(TIntermTraverser *it)
 {
     it->visitRaw(this);
 }
+
+//
+// Traverse a subtree with an explicit stack.  Same comments in binary node
+// apply here.
+//
+void TIntermNode::traverseWithStack(TIntermTraverser *it)
+{
+    // The frames are indexed from a local count rather than pushed and
+    // popped.  The count is published before every visit, since a visit may
+    // start a traversal of its own on top of ours.  That may reallocate the
+    // frames, so a frame is not referred to across a visit.
+    TVector<TIntermTraverser::Frame> &frames = it->mFrames;
+    const size_t baseFrame = it->mFrameCount;
+    size_t frameCount = baseFrame;
+    const bool rightToLeft = it->rightToLeft;
+
+    TIntermNode *node = this;
+    while (node)
+    {
+        //
+        // Visit the node before its children.  Terminals are visited once,
+        // whatever the traverser asks for.
+        //
+        TIntermNodeType type = node->getNodeType();
+        switch (type)
+        {
+          case EIntermSymbol:
+            it->visitSymbol(static_cast<TIntermSymbol *>(node));
+            break;
+          case EIntermConstantUnion:
+            it->visitConstantUnion(static_cast<TIntermConstantUnion *>(node));
+            break;
+          case EIntermRaw:
+            it->visitRaw(static_cast<TIntermRaw *>(node));
+            break;
+          case EIntermBranch:
+            // A branch without an expression has no children to descend into.
+            if (!static_cast<TIntermBranch *>(node)->getExpression())
+            {
+                TIntermBranch *branch = static_cast<TIntermBranch *>(node);
+                if ((!it->preVisit || it->visitBranch(PreVisit, branch)) && it->postVisit)
+                    it->visitBranch(PostVisit, branch);
+                break;
+            }
+            // Fall through.
+          default:
+            if (!it->preVisit || VisitNode(it, PreVisit, node, type))
+            {
+                it->incrementDepth(node);
+                if (frameCount == frames.size())
+                    frames.resize(frameCount * 2 + 16);
+                TIntermTraverser::Frame &frame = frames[frameCount++];
+                frame.node = node;
+                frame.type = type;
+                frame.nextChild = 0;
+                frame.visit = true;
+                it->mFrameCount = frameCount;
+            }
+            break;
+        }
+
+        //
+        // Find the next child to visit, finishing the nodes that have none
+        // left.  Missing children are NULL and skipped.
+        //
+        node = NULL;
+        while (!node && frameCount > baseFrame)
+        {
+            TIntermTraverser::Frame &frame = frames[frameCount - 1];
+            TIntermNode *parent = frame.node;
+            const unsigned int position = frame.nextChild++;
+            bool done = false;
+
+            switch (frame.type)
+            {
+              case EIntermBinary:
+              {
+                TIntermBinary *binary = static_cast<TIntermBinary *>(parent);
+                if (position == 0)
+                {
+                    node = rightToLeft ? binary->getRight() : binary->getLeft();
+                }
+                else if (position == 1)
+                {
+                    if (!it->inVisit || it->visitBinary(InVisit, binary))
+                        node = rightToLeft ? binary->getLeft() : binary->getRight();
+                    else
+                    {
+                        frames[frameCount - 1].visit = false;
+                        done = true;
+                    }
+                }
+                else
+                {
+                    done = true;
+                }
+                break;
+              }
+              case EIntermUnary:
+                if (position == 0)
+                    node = static_cast<TIntermUnary *>(parent)->getOperand();
+                else
+                    done = true;
+                break;
+              case EIntermAggregate:
+              {
+                TIntermAggregate *aggregate = static_cast<TIntermAggregate *>(parent);
+                TIntermSequence *sequence = aggregate->getSequence();
+                if (position < sequence->size())
+                {
+                    if (position > 0 && it->inVisit && frame.visit)
+                    {
+                        bool visit = it->visitAggregate(InVisit, aggregate);
+                        frames[frameCount - 1].visit = visit;
+                    }
+                    node = (*sequence)[rightToLeft ? sequence->size() - 1 - position : position];
+                }
+                else
+                {
+                    done = true;
+                }
+                break;
+              }
+              case EIntermSelection:
+              {
+                TIntermSelection *selection = static_cast<TIntermSelection *>(parent);
+                switch (rightToLeft ? 2 - position : position)
+                {
+                  case 0: node = selection->getCondition(); break;
+                  case 1: node = selection->getTrueBlock(); break;
+                  case 2: node = selection->getFalseBlock(); break;
+                  default: done = true; break;
+                }
+                break;
+              }
+              case EIntermLoop:
+              {
+                TIntermLoop *loop = static_cast<TIntermLoop *>(parent);
+                switch (rightToLeft ? 3 - position : position)
+                {
+                  case 0: node = loop->getInit(); break;
+                  case 1: node = loop->getCondition(); break;
+                  case 2: node = loop->getBody(); break;
+                  case 3: node = loop->getExpression(); break;
+                  default: done = true; break;
+                }
+                break;
+              }
+              case EIntermBranch:
+                if (position == 0)
+                    node = static_cast<TIntermBranch *>(parent)->getExpression();
+                else
+                    done = true;
+                break;
+              default:
+                UNREACHABLE();
+                done = true;
+                break;
+            }
+
+            if (done)
+            {
+                //
+                // Visit the node after the children, if requested and the
+                // traversal hasn't been cancelled yet.
+                //
+                const TIntermTraverser::Frame &finished = frames[--frameCount];
+                it->mFrameCount = frameCount;
+                it->decrementDepth();
+                if (finished.visit && it->postVisit)
+                    VisitNode(it, PostVisit, parent, finished.type);
+            }
+        }
+    }
+}
@@ -138,6 +138,32 @@ bool TLoopIndexInfo::satisfiesLoopCondition() const
     }
 }
 
+bool TLoopIndexInfo::hasFiniteIterations() const
+{
+    // The distance is computed in 64 bits, so that it doesn't overflow.
+    long long distance = static_cast<long long>(mStopValue) - mInitValue;
+    switch (mOp)
+    {
+      case EOpEqual:
+        return distance != 0 || mIncrementValue != 0;
+      case EOpNotEqual:
+        return distance == 0 ||
+               (mIncrementValue != 0 && distance % mIncrementValue == 0 &&
+                distance / mIncrementValue > 0);
+      case EOpLessThan:
+        return distance <= 0 || mIncrementValue > 0;
+      case EOpLessThanEqual:
+        return distance < 0 || mIncrementValue > 0;
+      case EOpGreaterThan:
+        return distance >= 0 || mIncrementValue < 0;
+      case EOpGreaterThanEqual:
+        return distance > 0 || mIncrementValue < 0;
+      default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
 TLoopInfo::TLoopInfo()
     : loop(NULL)
 {
@@ -161,43 +187,6 @@ TIntermLoop *TLoopStack::findLoop(TIntermSymbol *symbol)
     return NULL;
 }
 
-TLoopIndexInfo *TLoopStack::getIndexInfo(TIntermSymbol *symbol)
-{
-    if (!symbol)
-        return NULL;
-    for (iterator iter = begin(); iter != end(); ++iter)
-    {
-        if (iter->index.getId() == symbol->getId())
-            return &(iter->index);
-    }
-    return NULL;
-}
-
-void TLoopStack::step()
-{
-    ASSERT(!empty());
-    rbegin()->index.step();
-}
-
-bool TLoopStack::satisfiesLoopCondition()
-{
-    ASSERT(!empty());
-    return rbegin()->index.satisfiesLoopCondition();
-}
-
-bool TLoopStack::needsToReplaceSymbolWithValue(TIntermSymbol *symbol)
-{
-    TIntermLoop *loop = findLoop(symbol);
-    return loop && loop->getUnrollFlag();
-}
-
-int TLoopStack::getLoopIndexValue(TIntermSymbol *symbol)
-{
-    TLoopIndexInfo *info = getIndexInfo(symbol);
-    ASSERT(info);
-    return info->getCurrentValue();
-}
-
 void TLoopStack::push(TIntermLoop *loop)
 {
     TLoopInfo info(loop);
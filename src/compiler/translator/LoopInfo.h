@@ -30,6 +30,10 @@ class TLoopIndexInfo
     // Check if the current value satisfies the loop condition.
     bool satisfiesLoopCondition() const;
 
+    // Check if the loop ends: its index must step towards a value that
+    // fails the condition. Only valid if the index's type is int.
+    bool hasFiniteIterations() const;
+
   private:
     int mId;
     TBasicType mType;  // Either EbtInt or EbtFloat
@@ -57,21 +61,6 @@ class TLoopStack : public TVector<TLoopInfo>
     // Search loop stack for a loop whose index matches the input symbol.
     TIntermLoop *findLoop(TIntermSymbol *symbol);
 
-    // Find the loop index info in the loop stack by the input symbol.
-    TLoopIndexInfo *getIndexInfo(TIntermSymbol *symbol);
-
-    // Update the currentValue for the next loop iteration.
-    void step();
-
-    // Return false if loop condition is no longer satisfied.
-    bool satisfiesLoopCondition();
-
-    // Check if the symbol is the index of a loop that's unrolled.
-    bool needsToReplaceSymbolWithValue(TIntermSymbol *symbol);
-
-    // Return the current value of a given loop index symbol.
-    int getLoopIndexValue(TIntermSymbol *symbol);
-
     void push(TIntermLoop *info);
     void pop();
 };
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/NameMinifier.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "compiler/translator/SymbolTable.h"
+
+namespace
+{
+
+// Short names start with an upper case letter, which no keyword, built-in
+// or reserved name does.
+TString ShortName(size_t index)
+{
+    static const char kFirst[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char kRest[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    const size_t kFirstCount = sizeof(kFirst) - 1;
+    const size_t kRestCount = sizeof(kRest) - 1;
+
+    TString name(1, kFirst[index % kFirstCount]);
+    index /= kFirstCount;
+    while (index > 0)
+    {
+        --index;
+        name += kRest[index % kRestCount];
+        index /= kRestCount;
+    }
+    return name;
+}
+
+bool IsRenamedQualifier(TQualifier qualifier)
+{
+    switch (qualifier)
+    {
+      case EvqTemporary:
+      case EvqGlobal:
+      case EvqConst:
+      case EvqIn:
+      case EvqOut:
+      case EvqInOut:
+      case EvqConstReadOnly:
+        return true;
+      default:
+        return false;
+    }
+}
+
+bool MoreUses(const std::pair<TString, int> &a, const std::pair<TString, int> &b)
+{
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+}
+
+}  // namespace
+
+void NameMinifier::visitSymbol(TIntermSymbol *node)
+{
+    const TString &name = node->getSymbol();
+    addStruct(node->getType());
+    if (name.empty())
+        return;
+
+    if (IsRenamedQualifier(node->getQualifier()) &&
+        mSymbolTable.findBuiltIn(name, mShaderVersion) == NULL)
+    {
+        ++mUses[name];
+    }
+    else
+    {
+        mFixedNames.insert(name);
+    }
+}
+
+bool NameMinifier::visitAggregate(Visit, TIntermAggregate *node)
+{
+    addStruct(node->getType());
+    switch (node->getOp())
+    {
+      case EOpFunction:
+      case EOpFunctionCall:
+        {
+            TString name = TFunction::unmangleName(node->getName());
+            if (mSymbolTable.findBuiltIn(node->getName(), mShaderVersion) != NULL ||
+                name == "main")
+            {
+                mFixedNames.insert(name);
+            }
+            else
+            {
+                ++mUses[name];
+            }
+        }
+        break;
+      case EOpPrototype:
+        // Prototypes carry the unmangled name of a user function.
+        if (node->getName() != "main")
+            ++mUses[node->getName()];
+        break;
+      default:
+        break;
+    }
+    return true;
+}
+
+void NameMinifier::addStruct(const TType &type)
+{
+    const TStructure *structure = type.getStruct();
+    if (structure == NULL || !mStructs.insert(structure).second)
+        return;
+
+    mFixedNames.insert(structure->name());
+    const TFieldList &fields = structure->fields();
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        mFixedNames.insert(fields[i]->name());
+        addStruct(*fields[i]->type());
+    }
+}
+
+void NameMinifier::assignNames()
+{
+    std::vector<std::pair<TString, int> > uses;
+    for (std::map<TString, int>::const_iterator use = mUses.begin(); use != mUses.end(); ++use)
+    {
+        if (mFixedNames.count(use->first) == 0)
+            uses.push_back(*use);
+    }
+    std::sort(uses.begin(), uses.end(), MoreUses);
+
+    size_t index = 0;
+    for (size_t i = 0; i < uses.size(); ++i)
+    {
+        TString name = ShortName(index++);
+        while (mFixedNames.count(name) > 0)
+            name = ShortName(index++);
+        mNames[uses[i].first] = name;
+    }
+}
+
+const TString *NameMinifier::findName(const TString &name) const
+{
+    std::map<TString, TString>::const_iterator it = mNames.find(name);
+    return it != mNames.end() ? &it->second : NULL;
+}
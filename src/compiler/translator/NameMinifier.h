@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// NameMinifier picks short names for the user functions and for the
+// variables that aren't part of the shader interface, to be written by the
+// GLSL and ESSL output when minifying. Names are assigned per name rather
+// than per symbol, like hashed names, so a name that is also used by an
+// interface variable, a struct, a field or a built-in is never renamed.
+//
+
+#ifndef COMPILER_NAME_MINIFIER_H_
+#define COMPILER_NAME_MINIFIER_H_
+
+#include <map>
+#include <set>
+
+#include "common/angleutils.h"
+#include "compiler/translator/IntermNode.h"
+
+class TSymbolTable;
+
+class NameMinifier : public TIntermTraverser
+{
+  public:
+    NameMinifier(const TSymbolTable &symbolTable, int shaderVersion)
+        : TIntermTraverser(true, false, false),
+          mSymbolTable(symbolTable),
+          mShaderVersion(shaderVersion) {}
+
+    virtual void visitSymbol(TIntermSymbol *node);
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node);
+
+    // Assigns the short names once the tree has been traversed, the
+    // shortest to the most used names.
+    void assignNames();
+    // Returns the short name of name, or NULL if it isn't renamed.
+    const TString *findName(const TString &name) const;
+
+  private:
+    void addStruct(const TType &type);
+
+    const TSymbolTable &mSymbolTable;
+    int mShaderVersion;
+
+    // The number of uses of the names that can be renamed, and the names
+    // that can't.
+    std::map<TString, int> mUses;
+    std::set<TString> mFixedNames;
+    std::set<const TStructure *> mStructs;
+
+    std::map<TString, TString> mNames;
+
+    DISALLOW_COPY_AND_ASSIGN(NameMinifier);
+};
+
+#endif  // COMPILER_NAME_MINIFIER_H_
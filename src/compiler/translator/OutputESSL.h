@@ -17,7 +17,8 @@ public:
                 ShHashFunction64 hashFunction,
                 NameMap& nameMap,
                 TSymbolTable& symbolTable,
-                int shaderVersion);
+                int shaderVersion,
+                const NameMinifier *nameMinifier);
 
 protected:
     virtual bool writeVariablePrecision(TPrecision precision);
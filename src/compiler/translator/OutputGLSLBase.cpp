@@ -5,6 +5,7 @@
 //
 
 #include "compiler/translator/OutputGLSLBase.h"
+#include "compiler/translator/NameMinifier.h"
 #include "compiler/translator/compilerdebug.h"
 
 #include <cfloat>
@@ -38,6 +39,161 @@ bool isSingleStatement(TIntermNode *node)
     }
     return true;
 }
+
+bool IsNegativeConstant(TIntermNode *node)
+{
+    TIntermConstantUnion *constant = node->getAsConstantUnion();
+    if (constant == NULL || constant->getType().getObjectSize() != 1)
+        return false;
+    switch (constant->getBasicType())
+    {
+      case EbtFloat: return constant->getFConst(0) <= 0.0f;
+      case EbtInt: return constant->getIConst(0) < 0;
+      default: return false;
+    }
+}
+
+// The precedence of the operators in the GLSL ES spec, section 5.1, where
+// lower numbers bind tighter. Primary expressions and calls are 1.
+int Precedence(TIntermNode *node)
+{
+    if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        switch (binary->getOp())
+        {
+          case EOpIndexDirect:
+          case EOpIndexIndirect:
+          case EOpIndexDirectStruct:
+          case EOpVectorSwizzle:
+            return 2;
+          case EOpMul:
+          case EOpDiv:
+          case EOpVectorTimesScalar:
+          case EOpVectorTimesMatrix:
+          case EOpMatrixTimesVector:
+          case EOpMatrixTimesScalar:
+          case EOpMatrixTimesMatrix:
+            return 4;
+          case EOpAdd:
+          case EOpSub:
+            return 5;
+          case EOpLessThan:
+          case EOpGreaterThan:
+          case EOpLessThanEqual:
+          case EOpGreaterThanEqual:
+            return 6;
+          case EOpEqual:
+          case EOpNotEqual:
+            return 7;
+          case EOpLogicalAnd: return 8;
+          case EOpLogicalXor: return 9;
+          case EOpLogicalOr: return 10;
+          default:
+            // Assignments.
+            return 12;
+        }
+    }
+    if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        switch (unary->getOp())
+        {
+          case EOpPostIncrement:
+          case EOpPostDecrement:
+            return 2;
+          case EOpNegative:
+          case EOpPositive:
+          case EOpLogicalNot:
+          case EOpPreIncrement:
+          case EOpPreDecrement:
+            return 3;
+          default:
+            // Built-in functions.
+            return 1;
+        }
+    }
+    if (TIntermSelection *selection = node->getAsSelectionNode())
+        return selection->usesTernaryOperator() ? 11 : 14;
+    if (TIntermAggregate *aggregate = node->getAsAggregate())
+        return aggregate->getOp() == EOpComma ? 13 : 1;
+    return IsNegativeConstant(node) ? 3 : 1;
+}
+
+bool NeedsParentheses(TIntermNode *node, TIntermNode *parent);
+
+// Returns true if the expression written without parentheses would start
+// with a sign, which mustn't follow another one: "a - -b" isn't "a--b".
+bool StartsWithSign(TIntermNode *node)
+{
+    while (true)
+    {
+        if (Precedence(node) == 3)
+            return node->getAsUnaryNode() == NULL ||
+                   node->getAsUnaryNode()->getOp() != EOpLogicalNot;
+
+        TIntermNode *first = NULL;
+        if (TIntermBinary *binary = node->getAsBinaryNode())
+            first = binary->getLeft();
+        else if (TIntermUnary *unary = node->getAsUnaryNode())
+            first = Precedence(unary) == 2 ? unary->getOperand() : NULL;
+        else if (TIntermSelection *selection = node->getAsSelectionNode())
+            first = selection->usesTernaryOperator() ? selection->getCondition() : NULL;
+
+        if (first == NULL || NeedsParentheses(first, node))
+            return false;
+        node = first;
+    }
+}
+
+bool NeedsParentheses(TIntermNode *node, TIntermNode *parent)
+{
+    if (parent == NULL)
+        return false;
+
+    int precedence = Precedence(node);
+    if (TIntermBinary *binary = parent->getAsBinaryNode())
+    {
+        bool isLeft = (binary->getLeft() == node);
+        int parentPrecedence = Precedence(parent);
+        if (binary->getOp() == EOpInitialize)
+            return !isLeft && precedence > 12;
+        if (parentPrecedence == 2)
+            return isLeft && precedence > 2;
+        if (parentPrecedence == 12)
+            return isLeft ? precedence > 2 : precedence > 12;
+        // The other binary operators are left associative.
+        if (isLeft)
+            return precedence > parentPrecedence;
+        if (precedence >= parentPrecedence)
+            return true;
+        return (binary->getOp() == EOpAdd || binary->getOp() == EOpSub) && StartsWithSign(node);
+    }
+    if (parent->getAsUnaryNode())
+    {
+        int parentPrecedence = Precedence(parent);
+        if (parentPrecedence == 2)
+            return precedence > 2;
+        if (parentPrecedence == 3)
+            return precedence > 3 || StartsWithSign(node);
+        // The argument of a built-in function.
+        return precedence >= 13;
+    }
+    if (TIntermSelection *selection = parent->getAsSelectionNode())
+    {
+        if (!selection->usesTernaryOperator())
+            return false;
+        if (node == selection->getCondition())
+            return precedence >= 11;
+        return node == selection->getFalseBlock() && precedence > 12;
+    }
+    if (TIntermAggregate *aggregate = parent->getAsAggregate())
+    {
+        // Arguments of calls and constructors, and operands of a comma.
+        return aggregate->getOp() != EOpSequence && aggregate->getOp() != EOpDeclaration &&
+               precedence >= 13;
+    }
+    return false;
+}
+
 }  // namespace
 
 TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
@@ -45,28 +201,58 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
                                  ShHashFunction64 hashFunction,
                                  NameMap &nameMap,
                                  TSymbolTable &symbolTable,
-                                 int shaderVersion)
+                                 int shaderVersion,
+                                 const NameMinifier *nameMinifier)
     : TIntermTraverser(true, true, true),
       mObjSink(objSink),
       mDeclaringVariables(false),
       mClampingStrategy(clampingStrategy),
       mHashFunction(hashFunction),
       mNameMap(nameMap),
+      mNameMinifier(nameMinifier),
       mSymbolTable(symbolTable),
       mShaderVersion(shaderVersion)
 {
 }
 
+void TOutputGLSLBase::writeSpaced(const char *str)
+{
+    TInfoSinkBase &out = objSink();
+    if (!isMinifying())
+    {
+        out << str;
+        return;
+    }
+    for (; *str; ++str)
+    {
+        if (*str != ' ' && *str != '\n')
+            out << *str;
+    }
+}
+
 void TOutputGLSLBase::writeTriplet(
     Visit visit, const char *preStr, const char *inStr, const char *postStr)
 {
-    TInfoSinkBase &out = objSink();
     if (visit == PreVisit && preStr)
-        out << preStr;
+        writeSpaced(preStr);
     else if (visit == InVisit && inStr)
-        out << inStr;
+        writeSpaced(inStr);
     else if (visit == PostVisit && postStr)
-        out << postStr;
+        writeSpaced(postStr);
+}
+
+void TOutputGLSLBase::writeOperatorTriplet(
+    Visit visit, TIntermTyped *node, const char *preStr, const char *inStr, const char *postStr)
+{
+    TInfoSinkBase &out = objSink();
+    // The parent is only known before and after the children are visited.
+    bool parenthesize = (visit != InVisit) &&
+        (!isMinifying() || NeedsParentheses(node, getParentNode()));
+    if (visit == PreVisit && parenthesize)
+        out << "(";
+    writeTriplet(visit, preStr, inStr, postStr);
+    if (visit == PostVisit && parenthesize)
+        out << ")";
 }
 
 void TOutputGLSLBase::writeBuiltInFunctionTriplet(
@@ -125,7 +311,7 @@ void TOutputGLSLBase::writeFunctionParameters(const TIntermSequence &args)
 
         // Put a comma if this is not the last argument.
         if (iter != args.end() - 1)
-            out << ", ";
+            writeSpaced(", ");
     }
 }
 
@@ -146,7 +332,7 @@ const ConstantUnion *TOutputGLSLBase::writeConstantUnion(
             ASSERT(fieldType != NULL);
             pConstUnion = writeConstantUnion(*fieldType, pConstUnion);
             if (i != fields.size() - 1)
-                out << ", ";
+                writeSpaced(", ");
         }
         out << ")";
     }
@@ -172,7 +358,7 @@ const ConstantUnion *TOutputGLSLBase::writeConstantUnion(
               default: UNREACHABLE();
             }
             if (i != size - 1)
-                out << ", ";
+                writeSpaced(", ");
         }
         if (writeType)
             out << ")";
@@ -183,10 +369,7 @@ const ConstantUnion *TOutputGLSLBase::writeConstantUnion(
 void TOutputGLSLBase::visitSymbol(TIntermSymbol *node)
 {
     TInfoSinkBase &out = objSink();
-    if (mLoopUnrollStack.needsToReplaceSymbolWithValue(node))
-        out << mLoopUnrollStack.getLoopIndexValue(node);
-    else
-        out << hashVariableName(node->getSymbol());
+    out << hashVariableName(node->getSymbol());
 
     if (mDeclaringVariables && node->getType().isArray())
         out << arrayBrackets(node->getType());
@@ -194,7 +377,13 @@ void TOutputGLSLBase::visitSymbol(TIntermSymbol *node)
 
 void TOutputGLSLBase::visitConstantUnion(TIntermConstantUnion *node)
 {
+    // Negative constants are written like an operator.
+    bool parenthesize = isMinifying() && NeedsParentheses(node, getParentNode());
+    if (parenthesize)
+        objSink() << "(";
     writeConstantUnion(node->getType(), node->getUnionArrayPointer());
+    if (parenthesize)
+        objSink() << ")";
 }
 
 bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
@@ -206,22 +395,22 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
       case EOpInitialize:
         if (visit == InVisit)
         {
-            out << " = ";
+            writeSpaced(" = ");
             // RHS of initialize is not being declared.
             mDeclaringVariables = false;
         }
         break;
       case EOpAssign:
-        writeTriplet(visit, "(", " = ", ")");
+        writeOperatorTriplet(visit, node, NULL, " = ", NULL);
         break;
       case EOpAddAssign:
-        writeTriplet(visit, "(", " += ", ")");
+        writeOperatorTriplet(visit, node, NULL, " += ", NULL);
         break;
       case EOpSubAssign:
-        writeTriplet(visit, "(", " -= ", ")");
+        writeOperatorTriplet(visit, node, NULL, " -= ", NULL);
         break;
       case EOpDivAssign:
-        writeTriplet(visit, "(", " /= ", ")");
+        writeOperatorTriplet(visit, node, NULL, " /= ", NULL);
         break;
       // Notice the fall-through.
       case EOpMulAssign:
@@ -229,7 +418,7 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
       case EOpVectorTimesScalarAssign:
       case EOpMatrixTimesScalarAssign:
       case EOpMatrixTimesMatrixAssign:
-        writeTriplet(visit, "(", " *= ", ")");
+        writeOperatorTriplet(visit, node, NULL, " *= ", NULL);
         break;
 
       case EOpIndexDirect:
@@ -262,9 +451,15 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
                 }
 
                 if (mClampingStrategy == SH_CLAMP_WITH_CLAMP_INTRINSIC)
-                    out << "), 0.0, float(" << maxSize << ")))]";
+                {
+                    writeSpaced("), 0.0, float(");
+                    out << maxSize << ")))]";
+                }
                 else
-                    out << ", 0, " << maxSize << ")]";
+                {
+                    writeSpaced(", 0, ");
+                    out << maxSize << ")]";
+                }
             }
         }
         else
@@ -329,37 +524,37 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
         break;
 
       case EOpAdd:
-        writeTriplet(visit, "(", " + ", ")");
+        writeOperatorTriplet(visit, node, NULL, " + ", NULL);
         break;
       case EOpSub:
-        writeTriplet(visit, "(", " - ", ")");
+        writeOperatorTriplet(visit, node, NULL, " - ", NULL);
         break;
       case EOpMul:
-        writeTriplet(visit, "(", " * ", ")");
+        writeOperatorTriplet(visit, node, NULL, " * ", NULL);
         break;
       case EOpDiv:
-        writeTriplet(visit, "(", " / ", ")");
+        writeOperatorTriplet(visit, node, NULL, " / ", NULL);
         break;
       case EOpMod:
         UNIMPLEMENTED();
         break;
       case EOpEqual:
-        writeTriplet(visit, "(", " == ", ")");
+        writeOperatorTriplet(visit, node, NULL, " == ", NULL);
         break;
       case EOpNotEqual:
-        writeTriplet(visit, "(", " != ", ")");
+        writeOperatorTriplet(visit, node, NULL, " != ", NULL);
         break;
       case EOpLessThan:
-        writeTriplet(visit, "(", " < ", ")");
+        writeOperatorTriplet(visit, node, NULL, " < ", NULL);
         break;
       case EOpGreaterThan:
-        writeTriplet(visit, "(", " > ", ")");
+        writeOperatorTriplet(visit, node, NULL, " > ", NULL);
         break;
       case EOpLessThanEqual:
-        writeTriplet(visit, "(", " <= ", ")");
+        writeOperatorTriplet(visit, node, NULL, " <= ", NULL);
         break;
       case EOpGreaterThanEqual:
-        writeTriplet(visit, "(", " >= ", ")");
+        writeOperatorTriplet(visit, node, NULL, " >= ", NULL);
         break;
 
       // Notice the fall-through.
@@ -368,17 +563,17 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
       case EOpMatrixTimesVector:
       case EOpMatrixTimesScalar:
       case EOpMatrixTimesMatrix:
-        writeTriplet(visit, "(", " * ", ")");
+        writeOperatorTriplet(visit, node, NULL, " * ", NULL);
         break;
 
       case EOpLogicalOr:
-        writeTriplet(visit, "(", " || ", ")");
+        writeOperatorTriplet(visit, node, NULL, " || ", NULL);
         break;
       case EOpLogicalXor:
-        writeTriplet(visit, "(", " ^^ ", ")");
+        writeOperatorTriplet(visit, node, NULL, " ^^ ", NULL);
         break;
       case EOpLogicalAnd:
-        writeTriplet(visit, "(", " && ", ")");
+        writeOperatorTriplet(visit, node, NULL, " && ", NULL);
         break;
       default:
         UNREACHABLE();
@@ -394,15 +589,15 @@ bool TOutputGLSLBase::visitUnary(Visit visit, TIntermUnary *node)
 
     switch (node->getOp())
     {
-      case EOpNegative: preString = "(-"; break;
-      case EOpPositive: preString = "(+"; break;
+      case EOpNegative: writeOperatorTriplet(visit, node, "-", NULL, NULL); return true;
+      case EOpPositive: writeOperatorTriplet(visit, node, "+", NULL, NULL); return true;
       case EOpVectorLogicalNot: preString = "not("; break;
-      case EOpLogicalNot: preString = "(!"; break;
+      case EOpLogicalNot: writeOperatorTriplet(visit, node, "!", NULL, NULL); return true;
 
-      case EOpPostIncrement: preString = "("; postString = "++)"; break;
-      case EOpPostDecrement: preString = "("; postString = "--)"; break;
-      case EOpPreIncrement: preString = "(++"; break;
-      case EOpPreDecrement: preString = "(--"; break;
+      case EOpPostIncrement: writeOperatorTriplet(visit, node, NULL, NULL, "++"); return true;
+      case EOpPostDecrement: writeOperatorTriplet(visit, node, NULL, NULL, "--"); return true;
+      case EOpPreIncrement: writeOperatorTriplet(visit, node, "++", NULL, NULL); return true;
+      case EOpPreDecrement: writeOperatorTriplet(visit, node, "--", NULL, NULL); return true;
 
       case EOpRadians:
         preString = "radians(";
@@ -503,7 +698,19 @@ bool TOutputGLSLBase::visitSelection(Visit visit, TIntermSelection *node)
 {
     TInfoSinkBase &out = objSink();
 
-    if (node->usesTernaryOperator())
+    if (node->usesTernaryOperator() && isMinifying())
+    {
+        writeOperatorTriplet(PreVisit, node, NULL, NULL, NULL);
+        incrementDepth(node);
+        node->getCondition()->traverse(this);
+        out << "?";
+        node->getTrueBlock()->traverse(this);
+        out << ":";
+        node->getFalseBlock()->traverse(this);
+        decrementDepth();
+        writeOperatorTriplet(PostVisit, node, NULL, NULL, NULL);
+    }
+    else if (node->usesTernaryOperator())
     {
         // Notice two brackets at the beginning and end. The outer ones
         // encapsulate the whole ternary expression. This preserves the
@@ -519,16 +726,17 @@ bool TOutputGLSLBase::visitSelection(Visit visit, TIntermSelection *node)
     }
     else
     {
-        out << "if (";
+        writeSpaced("if (");
         node->getCondition()->traverse(this);
-        out << ")\n";
+        writeSpaced(")\n");
 
         incrementDepth(node);
         visitCodeBlock(node->getTrueBlock());
 
         if (node->getFalseBlock())
         {
-            out << "else\n";
+            out << "else";
+            writeBlockSeparator(node->getFalseBlock());
             visitCodeBlock(node->getFalseBlock());
         }
         decrementDepth();
@@ -548,7 +756,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
         // Scope the sequences except when at the global scope.
         if (mDepth > 0)
         {
-            out << "{\n";
+            writeSpaced("{\n");
         }
 
         incrementDepth(node);
@@ -560,14 +768,14 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
             node->traverse(this);
 
             if (isSingleStatement(node))
-                out << ";\n";
+                writeSpaced(";\n");
         }
         decrementDepth();
 
         // Scope the sequences except when at the global scope.
         if (mDepth > 0)
         {
-            out << "}\n";
+            writeSpaced("}\n");
         }
         visitChildren = false;
         break;
@@ -618,7 +826,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
         if (visit == PreVisit)
             out << hashFunctionName(node->getName()) << "(";
         else if (visit == InVisit)
-            out << ", ";
+            writeSpaced(", ");
         else
             out << ")";
         break;
@@ -642,7 +850,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
         }
         else if (visit == InVisit)
         {
-            out << ", ";
+            writeSpaced(", ");
             mDeclaringVariables = true;
         }
         else
@@ -716,7 +924,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
         }
         else if (visit == InVisit)
         {
-            out << ", ";
+            writeSpaced(", ");
         }
         else
         {
@@ -743,7 +951,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
         writeBuiltInFunctionTriplet(visit, "notEqual(", useEmulatedFunction);
         break;
       case EOpComma:
-        writeTriplet(visit, "(", ", ", ")");
+        writeOperatorTriplet(visit, node, NULL, ", ", NULL);
         break;
 
       case EOpMod:
@@ -810,72 +1018,43 @@ bool TOutputGLSLBase::visitLoop(Visit visit, TIntermLoop *node)
     TLoopType loopType = node->getType();
     if (loopType == ELoopFor)  // for loop
     {
-        if (!node->getUnrollFlag())
-        {
-            out << "for (";
-            if (node->getInit())
-                node->getInit()->traverse(this);
-            out << "; ";
-
-            if (node->getCondition())
-                node->getCondition()->traverse(this);
-            out << "; ";
-
-            if (node->getExpression())
-                node->getExpression()->traverse(this);
-            out << ")\n";
-        }
-        else
-        {
-            // Need to put a one-iteration loop here to handle break.
-            TIntermSequence *declSeq =
-                node->getInit()->getAsAggregate()->getSequence();
-            TIntermSymbol *indexSymbol =
-                (*declSeq)[0]->getAsBinaryNode()->getLeft()->getAsSymbolNode();
-            TString name = hashVariableName(indexSymbol->getSymbol());
-            out << "for (int " << name << " = 0; "
-                << name << " < 1; "
-                << "++" << name << ")\n";
-        }
+        writeSpaced("for (");
+        if (node->getInit())
+            node->getInit()->traverse(this);
+        writeSpaced("; ");
+
+        if (node->getCondition())
+            node->getCondition()->traverse(this);
+        writeSpaced("; ");
+
+        if (node->getExpression())
+            node->getExpression()->traverse(this);
+        writeSpaced(")\n");
     }
     else if (loopType == ELoopWhile)  // while loop
     {
-        out << "while (";
+        writeSpaced("while (");
         ASSERT(node->getCondition() != NULL);
         node->getCondition()->traverse(this);
-        out << ")\n";
+        writeSpaced(")\n");
     }
     else  // do-while loop
     {
         ASSERT(loopType == ELoopDoWhile);
-        out << "do\n";
+        out << "do";
+        writeBlockSeparator(node->getBody());
     }
 
     // Loop body.
-    if (node->getUnrollFlag())
-    {
-        out << "{\n";
-        mLoopUnrollStack.push(node);
-        while (mLoopUnrollStack.satisfiesLoopCondition())
-        {
-            visitCodeBlock(node->getBody());
-            mLoopUnrollStack.step();
-        }
-        mLoopUnrollStack.pop();
-        out << "}\n";
-    }
-    else
-    {
-        visitCodeBlock(node->getBody());
-    }
+    visitCodeBlock(node->getBody());
 
     // Loop footer.
     if (loopType == ELoopDoWhile)  // do-while loop
     {
-        out << "while (";
+        writeSpaced("while (");
         ASSERT(node->getCondition() != NULL);
         node->getCondition()->traverse(this);
-        out << ");\n";
+        writeSpaced(");\n");
     }
     decrementDepth();
 
@@ -898,7 +1077,8 @@ bool TOutputGLSLBase::visitBranch(Visit visit, TIntermBranch *node)
         writeTriplet(visit, "continue", NULL, NULL);
         break;
       case EOpReturn:
-        writeTriplet(visit, "return ", NULL, NULL);
+        if (visit == PreVisit)
+            objSink() << (isMinifying() && node->getExpression() == NULL ? "return" : "return ");
         break;
       default:
         UNREACHABLE();
@@ -907,20 +1087,30 @@ bool TOutputGLSLBase::visitBranch(Visit visit, TIntermBranch *node)
     return true;
 }
 
+void TOutputGLSLBase::writeBlockSeparator(TIntermNode *block)
+{
+    // A keyword is only separated from a following block by a newline, or
+    // when minifying by a space if the block isn't within braces.
+    TIntermAggregate *aggregate = block ? block->getAsAggregate() : NULL;
+    if (!isMinifying())
+        objSink() << "\n";
+    else if (block != NULL && (aggregate == NULL || aggregate->getOp() != EOpSequence))
+        objSink() << " ";
+}
+
 void TOutputGLSLBase::visitCodeBlock(TIntermNode *node)
 {
-    TInfoSinkBase &out = objSink();
     if (node != NULL)
     {
         node->traverse(this);
         // Single statements not part of a sequence need to be terminated
         // with semi-colon.
         if (isSingleStatement(node))
-            out << ";\n";
+            writeSpaced(";\n");
     }
     else
     {
-        out << "{\n}\n";  // Empty code block.
+        writeSpaced("{\n}\n");  // Empty code block.
     }
 }
 
@@ -962,6 +1152,15 @@ TString TOutputGLSLBase::getTypeName(const TType &type)
 
 TString TOutputGLSLBase::hashName(const TString &name)
 {
+    if (mNameMinifier != NULL)
+    {
+        const TString *minifiedName = mNameMinifier->findName(name);
+        if (minifiedName != NULL)
+        {
+            mNameMap[name.c_str()] = minifiedName->c_str();
+            return *minifiedName;
+        }
+    }
     if (mHashFunction == NULL || name.empty())
         return name;
     NameMap::const_iterator it = mNameMap.find(name.c_str());
@@ -1002,7 +1201,8 @@ void TOutputGLSLBase::declareStruct(const TStructure *structure)
 {
     TInfoSinkBase &out = objSink();
 
-    out << "struct " << hashName(structure->name()) << "{\n";
+    out << "struct " << hashName(structure->name());
+    writeSpaced("{\n");
     const TFieldList &fields = structure->fields();
     for (size_t i = 0; i < fields.size(); ++i)
     {
@@ -1012,7 +1212,7 @@ void TOutputGLSLBase::declareStruct(const TStructure *structure)
         out << getTypeName(*field->type()) << " " << hashName(field->name());
         if (field->type()->isArray())
             out << arrayBrackets(*field->type());
-        out << ";\n";
+        writeSpaced(";\n");
     }
     out << "}";
 }
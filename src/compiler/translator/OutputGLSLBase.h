@@ -10,9 +10,10 @@
 #include <set>
 
 #include "compiler/translator/IntermNode.h"
-#include "compiler/translator/LoopInfo.h"
 #include "compiler/translator/ParseContext.h"
 
+class NameMinifier;
+
 class TOutputGLSLBase : public TIntermTraverser
 {
   public:
@@ -21,11 +22,22 @@ class TOutputGLSLBase : public TIntermTraverser
                     ShHashFunction64 hashFunction,
                     NameMap &nameMap,
                     TSymbolTable& symbolTable,
-                    int shaderVersion);
+                    int shaderVersion,
+                    const NameMinifier *nameMinifier);
 
   protected:
     TInfoSinkBase &objSink() { return mObjSink; }
+    // When minifying, the output has no whitespace that the syntax doesn't
+    // need, no parentheses that precedence doesn't need, and the names
+    // picked by the name minifier.
+    bool isMinifying() const { return mNameMinifier != NULL; }
+    // Writes str, without its spaces and newlines when minifying.
+    void writeSpaced(const char *str);
     void writeTriplet(Visit visit, const char *preStr, const char *inStr, const char *postStr);
+    // Writes an operator within parentheses, which are left out when
+    // minifying if precedence doesn't need them.
+    void writeOperatorTriplet(Visit visit, TIntermTyped *node,
+                              const char *preStr, const char *inStr, const char *postStr);
     void writeVariableType(const TType &type);
     virtual bool writeVariablePrecision(TPrecision precision) = 0;
     void writeFunctionParameters(const TIntermSequence &args);
@@ -42,9 +54,11 @@ class TOutputGLSLBase : public TIntermTraverser
     virtual bool visitBranch(Visit visit, TIntermBranch *node);
 
     void visitCodeBlock(TIntermNode *node);
+    // Writes what separates "else" or "do" from the block that follows.
+    void writeBlockSeparator(TIntermNode *block);
 
-    // Return the original name if hash function pointer is NULL;
-    // otherwise return the hashed name.
+    // Return the minified name if there is one, the original name if hash
+    // function pointer is NULL; otherwise return the hashed name.
     TString hashName(const TString &name);
     // Same as hashName(), but without hashing built-in variables.
     TString hashVariableName(const TString &name);
@@ -65,9 +79,6 @@ class TOutputGLSLBase : public TIntermTraverser
     // This set contains all the ids of the structs from every scope.
     std::set<int> mDeclaredStructs;
 
-    // Stack of loops that need to be unrolled.
-    TLoopStack mLoopUnrollStack;
-
     ShArrayIndexClampingStrategy mClampingStrategy;
 
     // name hashing.
@@ -75,6 +86,8 @@ class TOutputGLSLBase : public TIntermTraverser
 
     NameMap &mNameMap;
 
+    const NameMinifier *mNameMinifier;
+
     TSymbolTable &mSymbolTable;
 
     const int mShaderVersion;
@@ -25,8 +25,18 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <map>
+#include <mutex>
 #include <stdio.h>
 
+namespace
+{
+
+// Guards the cache of texture function definitions.
+std::mutex textureFunctionCacheMutex;
+
+}  // namespace
+
 namespace sh
 {
 
@@ -141,6 +151,8 @@ OutputHLSL::OutputHLSL(TParseContext &context, TranslatorHLSL *parentTranslator)
 
     mExcessiveLoopIndex = NULL;
 
+    mBody.reserve(parentTranslator->getObjectCodeSizeHint());
+
     mStructureHLSL = new StructureHLSL;
     mUniformHLSL = new UniformHLSL(mStructureHLSL, parentTranslator);
 
@@ -185,8 +197,10 @@ void OutputHLSL::output()
     mContext.treeRoot->traverse(this);   // Output the body first to determine what has to go in the header
     header();
 
-    mContext.infoSink().obj << mHeader.c_str();
-    mContext.infoSink().obj << mBody.c_str();
+    TInfoSinkBase &obj = mContext.infoSink().obj;
+    obj.reserve(obj.size() + mHeader.size() + mBody.size());
+    obj << mHeader.str();
+    obj << mBody.str();
 }
 
 void OutputHLSL::makeFlaggedStructMaps(const std::vector<TIntermTyped *> &flaggedStructs)
@@ -234,24 +248,12 @@ int OutputHLSL::vectorSize(const TType &type) const
     return elementSize * arraySize;
 }
 
-TString OutputHLSL::structInitializerString(int indent, const TStructure &structure, const TString &rhsStructName)
+void OutputHLSL::outputStructInitializer(TInfoSinkBase &out, int indent, const TStructure &structure, const TString &rhsStructName)
 {
-    TString init;
-
-    TString preIndentString;
-    TString fullIndentString;
-
-    for (int spaces = 0; spaces < (indent * 4); spaces++)
-    {
-        preIndentString += ' ';
-    }
-
-    for (int spaces = 0; spaces < ((indent+1) * 4); spaces++)
-    {
-        fullIndentString += ' ';
-    }
+    const TString preIndentString(indent * 4, ' ');
+    const TString fullIndentString((indent + 1) * 4, ' ');
 
-    init += preIndentString + "{\n";
+    out << preIndentString << "{\n";
 
     const TFieldList &fields = structure.fields();
     for (unsigned int fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++)
@@ -262,27 +264,19 @@ TString OutputHLSL::structInitializerString(int indent, const TStructure &struct
 
         if (fieldType.getStruct())
         {
-            init += structInitializerString(indent + 1, *fieldType.getStruct(), fieldName);
+            outputStructInitializer(out, indent + 1, *fieldType.getStruct(), fieldName);
         }
         else
         {
-            init += fullIndentString + fieldName + ",\n";
+            out << fullIndentString << fieldName << ",\n";
         }
     }
 
-    init += preIndentString + "}" + (indent == 0 ? ";" : ",") + "\n";
-
-    return init;
+    out << preIndentString << "}" << (indent == 0 ? ";" : ",") << "\n";
 }
 
-void OutputHLSL::header()
+void OutputHLSL::outputFlaggedStructs(TInfoSinkBase &out)
 {
-    TInfoSinkBase &out = mHeader;
-
-    TString varyings;
-    TString attributes;
-    TString flaggedStructs;
-
     for (std::map<TIntermTyped*, TString>::const_iterator flaggedStructIt = mFlaggedStructMappedNames.begin(); flaggedStructIt != mFlaggedStructMappedNames.end(); flaggedStructIt++)
     {
         TIntermTyped *structNode = flaggedStructIt->first;
@@ -290,33 +284,48 @@ void OutputHLSL::header()
         const TStructure &structure = *structNode->getType().getStruct();
         const TString &originalName = mFlaggedStructOriginalNames[structNode];
 
-        flaggedStructs += "static " + Decorate(structure.name()) + " " + mappedName + " =\n";
-        flaggedStructs += structInitializerString(0, structure, originalName);
-        flaggedStructs += "\n";
+        out << "static " << Decorate(structure.name()) << " " << mappedName << " =\n";
+        outputStructInitializer(out, 0, structure, originalName);
+        out << "\n";
     }
+}
 
+void OutputHLSL::outputVaryings(TInfoSinkBase &out)
+{
     for (ReferencedSymbols::const_iterator varying = mReferencedVaryings.begin(); varying != mReferencedVaryings.end(); varying++)
     {
         const TType &type = varying->second->getType();
         const TString &name = varying->second->getSymbol();
 
         // Program linking depends on this exact format
-        varyings += "static " + InterpolationString(type.getQualifier()) + " " + TypeString(type) + " " +
-                    Decorate(name) + ArrayString(type) + " = " + initializer(type) + ";\n";
+        out << "static " << InterpolationString(type.getQualifier()) << " " << TypeString(type) << " "
+            << Decorate(name) << ArrayString(type) << " = ";
+        outputInitializer(out, type);
+        out << ";\n";
     }
+}
 
+void OutputHLSL::outputAttributes(TInfoSinkBase &out)
+{
     for (ReferencedSymbols::const_iterator attribute = mReferencedAttributes.begin(); attribute != mReferencedAttributes.end(); attribute++)
     {
         const TType &type = attribute->second->getType();
         const TString &name = attribute->second->getSymbol();
 
-        attributes += "static " + TypeString(type) + " " + Decorate(name) + ArrayString(type) + " = " + initializer(type) + ";\n";
+        out << "static " << TypeString(type) << " " << Decorate(name) << ArrayString(type) << " = ";
+        outputInitializer(out, type);
+        out << ";\n";
     }
+}
 
-    out << mStructureHLSL->structsHeader();
+void OutputHLSL::header()
+{
+    TInfoSinkBase &out = mHeader;
 
-    out << mUniformHLSL->uniformsHeader(mOutputType, mReferencedUniforms);
-    out << mUniformHLSL->interfaceBlocksHeader(mReferencedInterfaceBlocks);
+    mStructureHLSL->structsHeader(out);
+
+    mUniformHLSL->uniformsHeader(out, mOutputType, mReferencedUniforms);
+    mUniformHLSL->interfaceBlocksHeader(out, mReferencedInterfaceBlocks);
 
     if (mUsesDiscardRewriting)
     {
@@ -342,7 +351,7 @@ void OutputHLSL::header()
         const bool usingMRTExtension = (iter != mContext.extensionBehavior().end() && (iter->second == EBhEnable || iter->second == EBhRequire));
 
         out << "// Varyings\n";
-        out <<  varyings;
+        outputVaryings(out);
         out << "\n";
 
         if (mContext.getShaderVersion() >= 300)
@@ -352,8 +361,9 @@ void OutputHLSL::header()
                 const TString &variableName = outputVariableIt->first;
                 const TType &variableType = outputVariableIt->second->getType();
 
-                out << "static " + TypeString(variableType) + " out_" + variableName + ArrayString(variableType) +
-                       " = " + initializer(variableType) + ";\n";
+                out << "static " << TypeString(variableType) << " out_" << variableName << ArrayString(variableType) << " = ";
+                outputInitializer(out, variableType);
+                out << ";\n";
             }
         }
         else
@@ -456,11 +466,11 @@ void OutputHLSL::header()
                    "\n";
         }
 
-        if (!flaggedStructs.empty())
+        if (!mFlaggedStructMappedNames.empty())
         {
             out << "// Std140 Structures accessed by value\n";
             out << "\n";
-            out << flaggedStructs;
+            outputFlaggedStructs(out);
             out << "\n";
         }
 
@@ -482,7 +492,7 @@ void OutputHLSL::header()
     else   // Vertex shader
     {
         out << "// Attributes\n";
-        out <<  attributes;
+        outputAttributes(out);
         out << "\n"
                "static float4 gl_Position = float4(0, 0, 0, 0);\n";
 
@@ -493,7 +503,7 @@ void OutputHLSL::header()
 
         out << "\n"
                "// Varyings\n";
-        out <<  varyings;
+        outputVaryings(out);
         out << "\n";
 
         if (mUsesDepthRange)
@@ -535,601 +545,814 @@ void OutputHLSL::header()
                    "\n";
         }
 
-        if (!flaggedStructs.empty())
+        if (!mFlaggedStructMappedNames.empty())
         {
             out << "// Std140 Structures accessed by value\n";
             out << "\n";
-            out << flaggedStructs;
+            outputFlaggedStructs(out);
             out << "\n";
         }
     }
 
     for (TextureFunctionSet::const_iterator textureFunction = mUsesTexture.begin(); textureFunction != mUsesTexture.end(); textureFunction++)
     {
-        // Return type
-        if (textureFunction->method == TextureFunction::SIZE)
-        {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:            out << "int2 "; break;
-              case EbtSampler3D:            out << "int3 "; break;
-              case EbtSamplerCube:          out << "int2 "; break;
-              case EbtSampler2DArray:       out << "int3 "; break;
-              case EbtISampler2D:           out << "int2 "; break;
-              case EbtISampler3D:           out << "int3 "; break;
-              case EbtISamplerCube:         out << "int2 "; break;
-              case EbtISampler2DArray:      out << "int3 "; break;
-              case EbtUSampler2D:           out << "int2 "; break;
-              case EbtUSampler3D:           out << "int3 "; break;
-              case EbtUSamplerCube:         out << "int2 "; break;
-              case EbtUSampler2DArray:      out << "int3 "; break;
-              case EbtSampler2DShadow:      out << "int2 "; break;
-              case EbtSamplerCubeShadow:    out << "int2 "; break;
-              case EbtSampler2DArrayShadow: out << "int3 "; break;
-              default: UNREACHABLE();
-            }
-        }
-        else   // Sampling function
-        {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:            out << "float4 "; break;
-              case EbtSampler3D:            out << "float4 "; break;
-              case EbtSamplerCube:          out << "float4 "; break;
-              case EbtSampler2DArray:       out << "float4 "; break;
-              case EbtISampler2D:           out << "int4 ";   break;
-              case EbtISampler3D:           out << "int4 ";   break;
-              case EbtISamplerCube:         out << "int4 ";   break;
-              case EbtISampler2DArray:      out << "int4 ";   break;
-              case EbtUSampler2D:           out << "uint4 ";  break;
-              case EbtUSampler3D:           out << "uint4 ";  break;
-              case EbtUSamplerCube:         out << "uint4 ";  break;
-              case EbtUSampler2DArray:      out << "uint4 ";  break;
-              case EbtSampler2DShadow:      out << "float ";  break;
-              case EbtSamplerCubeShadow:    out << "float ";  break;
-              case EbtSampler2DArrayShadow: out << "float ";  break;
-              default: UNREACHABLE();
-            }
-        }
+        out << textureFunctionText(*textureFunction);
+    }
 
-        // Function name
-        out << textureFunction->name();
+    if (mUsesFragCoord)
+    {
+        out << "#define GL_USES_FRAG_COORD\n";
+    }
 
-        // Argument list
-        int hlslCoords = 4;
+    if (mUsesPointCoord)
+    {
+        out << "#define GL_USES_POINT_COORD\n";
+    }
 
-        if (mOutputType == SH_HLSL9_OUTPUT)
-        {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:   out << "sampler2D s";   hlslCoords = 2; break;
-              case EbtSamplerCube: out << "samplerCUBE s"; hlslCoords = 3; break;
-              default: UNREACHABLE();
-            }
+    if (mUsesFrontFacing)
+    {
+        out << "#define GL_USES_FRONT_FACING\n";
+    }
 
-            switch(textureFunction->method)
-            {
-              case TextureFunction::IMPLICIT:                 break;
-              case TextureFunction::BIAS:     hlslCoords = 4; break;
-              case TextureFunction::LOD:      hlslCoords = 4; break;
-              case TextureFunction::LOD0:     hlslCoords = 4; break;
-              case TextureFunction::LOD0BIAS: hlslCoords = 4; break;
-              default: UNREACHABLE();
-            }
+    if (mUsesPointSize)
+    {
+        out << "#define GL_USES_POINT_SIZE\n";
+    }
+
+    if (mUsesFragDepth)
+    {
+        out << "#define GL_USES_FRAG_DEPTH\n";
+    }
+
+    if (mUsesDepthRange)
+    {
+        out << "#define GL_USES_DEPTH_RANGE\n";
+    }
+
+    if (mUsesXor)
+    {
+        out << "bool xor(bool p, bool q)\n"
+               "{\n"
+               "    return (p || q) && !(p && q);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod1)
+    {
+        out << "float mod(float x, float y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod2v)
+    {
+        out << "float2 mod(float2 x, float2 y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod2f)
+    {
+        out << "float2 mod(float2 x, float y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod3v)
+    {
+        out << "float3 mod(float3 x, float3 y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod3f)
+    {
+        out << "float3 mod(float3 x, float y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod4v)
+    {
+        out << "float4 mod(float4 x, float4 y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesMod4f)
+    {
+        out << "float4 mod(float4 x, float y)\n"
+               "{\n"
+               "    return x - y * floor(x / y);\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesFaceforward1)
+    {
+        out << "float faceforward(float N, float I, float Nref)\n"
+               "{\n"
+               "    if(dot(Nref, I) >= 0)\n"
+               "    {\n"
+               "        return -N;\n"
+               "    }\n"
+               "    else\n"
+               "    {\n"
+               "        return N;\n"
+               "    }\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesFaceforward2)
+    {
+        out << "float2 faceforward(float2 N, float2 I, float2 Nref)\n"
+               "{\n"
+               "    if(dot(Nref, I) >= 0)\n"
+               "    {\n"
+               "        return -N;\n"
+               "    }\n"
+               "    else\n"
+               "    {\n"
+               "        return N;\n"
+               "    }\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesFaceforward3)
+    {
+        out << "float3 faceforward(float3 N, float3 I, float3 Nref)\n"
+               "{\n"
+               "    if(dot(Nref, I) >= 0)\n"
+               "    {\n"
+               "        return -N;\n"
+               "    }\n"
+               "    else\n"
+               "    {\n"
+               "        return N;\n"
+               "    }\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesFaceforward4)
+    {
+        out << "float4 faceforward(float4 N, float4 I, float4 Nref)\n"
+               "{\n"
+               "    if(dot(Nref, I) >= 0)\n"
+               "    {\n"
+               "        return -N;\n"
+               "    }\n"
+               "    else\n"
+               "    {\n"
+               "        return N;\n"
+               "    }\n"
+               "}\n"
+               "\n";
+    }
+
+    if (mUsesAtan2_1)
+    {
+        out << "float atanyx(float y, float x)\n"
+               "{\n"
+               "    if(x == 0 && y == 0) x = 1;\n"   // Avoid producing a NaN
+               "    return atan2(y, x);\n"
+               "}\n";
+    }
+
+    if (mUsesAtan2_2)
+    {
+        out << "float2 atanyx(float2 y, float2 x)\n"
+               "{\n"
+               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
+               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
+               "    return float2(atan2(y[0], x[0]), atan2(y[1], x[1]));\n"
+               "}\n";
+    }
+
+    if (mUsesAtan2_3)
+    {
+        out << "float3 atanyx(float3 y, float3 x)\n"
+               "{\n"
+               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
+               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
+               "    if(x[2] == 0 && y[2] == 0) x[2] = 1;\n"
+               "    return float3(atan2(y[0], x[0]), atan2(y[1], x[1]), atan2(y[2], x[2]));\n"
+               "}\n";
+    }
+
+    if (mUsesAtan2_4)
+    {
+        out << "float4 atanyx(float4 y, float4 x)\n"
+               "{\n"
+               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
+               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
+               "    if(x[2] == 0 && y[2] == 0) x[2] = 1;\n"
+               "    if(x[3] == 0 && y[3] == 0) x[3] = 1;\n"
+               "    return float4(atan2(y[0], x[0]), atan2(y[1], x[1]), atan2(y[2], x[2]), atan2(y[3], x[3]));\n"
+               "}\n";
+    }
+}
+
+// The definition of a texture function only depends on the function and the
+// output type, so it is generated once per process and shared by every
+// shader that uses the function.
+const std::string &OutputHLSL::textureFunctionText(const TextureFunction &textureFunction) const
+{
+    typedef std::map<std::pair<ShShaderOutput, TextureFunction>, std::string> TextureFunctionTextMap;
+    static TextureFunctionTextMap cache;
+
+    std::lock_guard<std::mutex> lock(textureFunctionCacheMutex);
+    std::string &text = cache[std::make_pair(mOutputType, textureFunction)];
+    if (text.empty())
+    {
+        TInfoSinkBase out;
+        outputTextureFunction(out, textureFunction);
+        text = out.str();
+    }
+    return text;
+}
+
+void OutputHLSL::outputTextureFunction(TInfoSinkBase &out, const TextureFunction &textureFunction) const
+{
+    // Return type
+    if (textureFunction.method == TextureFunction::SIZE)
+    {
+        switch(textureFunction.sampler)
+        {
+          case EbtSampler2D:            out << "int2 "; break;
+          case EbtSampler3D:            out << "int3 "; break;
+          case EbtSamplerCube:          out << "int2 "; break;
+          case EbtSampler2DArray:       out << "int3 "; break;
+          case EbtISampler2D:           out << "int2 "; break;
+          case EbtISampler3D:           out << "int3 "; break;
+          case EbtISamplerCube:         out << "int2 "; break;
+          case EbtISampler2DArray:      out << "int3 "; break;
+          case EbtUSampler2D:           out << "int2 "; break;
+          case EbtUSampler3D:           out << "int3 "; break;
+          case EbtUSamplerCube:         out << "int2 "; break;
+          case EbtUSampler2DArray:      out << "int3 "; break;
+          case EbtSampler2DShadow:      out << "int2 "; break;
+          case EbtSamplerCubeShadow:    out << "int2 "; break;
+          case EbtSampler2DArrayShadow: out << "int3 "; break;
+          default: UNREACHABLE();
         }
-        else if (mOutputType == SH_HLSL11_OUTPUT)
-        {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:            out << "Texture2D x, SamplerState s";                hlslCoords = 2; break;
-              case EbtSampler3D:            out << "Texture3D x, SamplerState s";                hlslCoords = 3; break;
-              case EbtSamplerCube:          out << "TextureCube x, SamplerState s";              hlslCoords = 3; break;
-              case EbtSampler2DArray:       out << "Texture2DArray x, SamplerState s";           hlslCoords = 3; break;
-              case EbtISampler2D:           out << "Texture2D<int4> x, SamplerState s";          hlslCoords = 2; break;
-              case EbtISampler3D:           out << "Texture3D<int4> x, SamplerState s";          hlslCoords = 3; break;
-              case EbtISamplerCube:         out << "Texture2DArray<int4> x, SamplerState s";     hlslCoords = 3; break;
-              case EbtISampler2DArray:      out << "Texture2DArray<int4> x, SamplerState s";     hlslCoords = 3; break;
-              case EbtUSampler2D:           out << "Texture2D<uint4> x, SamplerState s";         hlslCoords = 2; break;
-              case EbtUSampler3D:           out << "Texture3D<uint4> x, SamplerState s";         hlslCoords = 3; break;
-              case EbtUSamplerCube:         out << "Texture2DArray<uint4> x, SamplerState s";    hlslCoords = 3; break;
-              case EbtUSampler2DArray:      out << "Texture2DArray<uint4> x, SamplerState s";    hlslCoords = 3; break;
-              case EbtSampler2DShadow:      out << "Texture2D x, SamplerComparisonState s";      hlslCoords = 2; break;
-              case EbtSamplerCubeShadow:    out << "TextureCube x, SamplerComparisonState s";    hlslCoords = 3; break;
-              case EbtSampler2DArrayShadow: out << "Texture2DArray x, SamplerComparisonState s"; hlslCoords = 3; break;
-              default: UNREACHABLE();
-            }
+    }
+    else   // Sampling function
+    {
+        switch(textureFunction.sampler)
+        {
+          case EbtSampler2D:            out << "float4 "; break;
+          case EbtSampler3D:            out << "float4 "; break;
+          case EbtSamplerCube:          out << "float4 "; break;
+          case EbtSampler2DArray:       out << "float4 "; break;
+          case EbtISampler2D:           out << "int4 ";   break;
+          case EbtISampler3D:           out << "int4 ";   break;
+          case EbtISamplerCube:         out << "int4 ";   break;
+          case EbtISampler2DArray:      out << "int4 ";   break;
+          case EbtUSampler2D:           out << "uint4 ";  break;
+          case EbtUSampler3D:           out << "uint4 ";  break;
+          case EbtUSamplerCube:         out << "uint4 ";  break;
+          case EbtUSampler2DArray:      out << "uint4 ";  break;
+          case EbtSampler2DShadow:      out << "float ";  break;
+          case EbtSamplerCubeShadow:    out << "float ";  break;
+          case EbtSampler2DArrayShadow: out << "float ";  break;
+          default: UNREACHABLE();
         }
-        else UNREACHABLE();
+    }
+
+    // Function name
+    out << textureFunction.name();
 
-        if (textureFunction->method == TextureFunction::FETCH)   // Integer coordinates
+    // Argument list
+    int hlslCoords = 4;
+
+    if (mOutputType == SH_HLSL9_OUTPUT)
+    {
+        switch(textureFunction.sampler)
         {
-            switch(textureFunction->coords)
-            {
-              case 2: out << ", int2 t"; break;
-              case 3: out << ", int3 t"; break;
-              default: UNREACHABLE();
-            }
+          case EbtSampler2D:   out << "sampler2D s";   hlslCoords = 2; break;
+          case EbtSamplerCube: out << "samplerCUBE s"; hlslCoords = 3; break;
+          default: UNREACHABLE();
         }
-        else   // Floating-point coordinates (except textureSize)
+
+        switch(textureFunction.method)
         {
-            switch(textureFunction->coords)
-            {
-              case 1: out << ", int lod";  break;   // textureSize()
-              case 2: out << ", float2 t"; break;
-              case 3: out << ", float3 t"; break;
-              case 4: out << ", float4 t"; break;
-              default: UNREACHABLE();
-            }
+          case TextureFunction::IMPLICIT:                 break;
+          case TextureFunction::BIAS:     hlslCoords = 4; break;
+          case TextureFunction::LOD:      hlslCoords = 4; break;
+          case TextureFunction::LOD0:     hlslCoords = 4; break;
+          case TextureFunction::LOD0BIAS: hlslCoords = 4; break;
+          default: UNREACHABLE();
         }
-
-        if (textureFunction->method == TextureFunction::GRAD)
-        {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:
-              case EbtISampler2D:
-              case EbtUSampler2D:
-              case EbtSampler2DArray:
-              case EbtISampler2DArray:
-              case EbtUSampler2DArray:
-              case EbtSampler2DShadow:
-              case EbtSampler2DArrayShadow:
-                out << ", float2 ddx, float2 ddy";
-                break;
-              case EbtSampler3D:
-              case EbtISampler3D:
-              case EbtUSampler3D:
-              case EbtSamplerCube:
-              case EbtISamplerCube:
-              case EbtUSamplerCube:
-              case EbtSamplerCubeShadow:
-                out << ", float3 ddx, float3 ddy";
-                break;
-              default: UNREACHABLE();
-            }
+    }
+    else if (mOutputType == SH_HLSL11_OUTPUT)
+    {
+        switch(textureFunction.sampler)
+        {
+          case EbtSampler2D:            out << "Texture2D x, SamplerState s";                hlslCoords = 2; break;
+          case EbtSampler3D:            out << "Texture3D x, SamplerState s";                hlslCoords = 3; break;
+          case EbtSamplerCube:          out << "TextureCube x, SamplerState s";              hlslCoords = 3; break;
+          case EbtSampler2DArray:       out << "Texture2DArray x, SamplerState s";           hlslCoords = 3; break;
+          case EbtISampler2D:           out << "Texture2D<int4> x, SamplerState s";          hlslCoords = 2; break;
+          case EbtISampler3D:           out << "Texture3D<int4> x, SamplerState s";          hlslCoords = 3; break;
+          case EbtISamplerCube:         out << "Texture2DArray<int4> x, SamplerState s";     hlslCoords = 3; break;
+          case EbtISampler2DArray:      out << "Texture2DArray<int4> x, SamplerState s";     hlslCoords = 3; break;
+          case EbtUSampler2D:           out << "Texture2D<uint4> x, SamplerState s";         hlslCoords = 2; break;
+          case EbtUSampler3D:           out << "Texture3D<uint4> x, SamplerState s";         hlslCoords = 3; break;
+          case EbtUSamplerCube:         out << "Texture2DArray<uint4> x, SamplerState s";    hlslCoords = 3; break;
+          case EbtUSampler2DArray:      out << "Texture2DArray<uint4> x, SamplerState s";    hlslCoords = 3; break;
+          case EbtSampler2DShadow:      out << "Texture2D x, SamplerComparisonState s";      hlslCoords = 2; break;
+          case EbtSamplerCubeShadow:    out << "TextureCube x, SamplerComparisonState s";    hlslCoords = 3; break;
+          case EbtSampler2DArrayShadow: out << "Texture2DArray x, SamplerComparisonState s"; hlslCoords = 3; break;
+          default: UNREACHABLE();
         }
+    }
+    else UNREACHABLE();
 
-        switch(textureFunction->method)
+    if (textureFunction.method == TextureFunction::FETCH)   // Integer coordinates
+    {
+        switch(textureFunction.coords)
         {
-          case TextureFunction::IMPLICIT:                        break;
-          case TextureFunction::BIAS:                            break;   // Comes after the offset parameter
-          case TextureFunction::LOD:      out << ", float lod";  break;
-          case TextureFunction::LOD0:                            break;
-          case TextureFunction::LOD0BIAS:                        break;   // Comes after the offset parameter
-          case TextureFunction::SIZE:                            break;
-          case TextureFunction::FETCH:    out << ", int mip";    break;
-          case TextureFunction::GRAD:                            break;
+          case 2: out << ", int2 t"; break;
+          case 3: out << ", int3 t"; break;
           default: UNREACHABLE();
         }
-
-        if (textureFunction->offset)
+    }
+    else   // Floating-point coordinates (except textureSize)
+    {
+        switch(textureFunction.coords)
         {
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:            out << ", int2 offset"; break;
-              case EbtSampler3D:            out << ", int3 offset"; break;
-              case EbtSampler2DArray:       out << ", int2 offset"; break;
-              case EbtISampler2D:           out << ", int2 offset"; break;
-              case EbtISampler3D:           out << ", int3 offset"; break;
-              case EbtISampler2DArray:      out << ", int2 offset"; break;
-              case EbtUSampler2D:           out << ", int2 offset"; break;
-              case EbtUSampler3D:           out << ", int3 offset"; break;
-              case EbtUSampler2DArray:      out << ", int2 offset"; break;
-              case EbtSampler2DShadow:      out << ", int2 offset"; break;
-              case EbtSampler2DArrayShadow: out << ", int2 offset"; break;
-              default: UNREACHABLE();
-            }
+          case 1: out << ", int lod";  break;   // textureSize()
+          case 2: out << ", float2 t"; break;
+          case 3: out << ", float3 t"; break;
+          case 4: out << ", float4 t"; break;
+          default: UNREACHABLE();
         }
+    }
 
-        if (textureFunction->method == TextureFunction::BIAS ||
-            textureFunction->method == TextureFunction::LOD0BIAS)
+    if (textureFunction.method == TextureFunction::GRAD)
+    {
+        switch(textureFunction.sampler)
+        {
+          case EbtSampler2D:
+          case EbtISampler2D:
+          case EbtUSampler2D:
+          case EbtSampler2DArray:
+          case EbtISampler2DArray:
+          case EbtUSampler2DArray:
+          case EbtSampler2DShadow:
+          case EbtSampler2DArrayShadow:
+            out << ", float2 ddx, float2 ddy";
+            break;
+          case EbtSampler3D:
+          case EbtISampler3D:
+          case EbtUSampler3D:
+          case EbtSamplerCube:
+          case EbtISamplerCube:
+          case EbtUSamplerCube:
+          case EbtSamplerCubeShadow:
+            out << ", float3 ddx, float3 ddy";
+            break;
+          default: UNREACHABLE();
+        }
+    }
+
+    switch(textureFunction.method)
+    {
+      case TextureFunction::IMPLICIT:                        break;
+      case TextureFunction::BIAS:                            break;   // Comes after the offset parameter
+      case TextureFunction::LOD:      out << ", float lod";  break;
+      case TextureFunction::LOD0:                            break;
+      case TextureFunction::LOD0BIAS:                        break;   // Comes after the offset parameter
+      case TextureFunction::SIZE:                            break;
+      case TextureFunction::FETCH:    out << ", int mip";    break;
+      case TextureFunction::GRAD:                            break;
+      default: UNREACHABLE();
+    }
+
+    if (textureFunction.offset)
+    {
+        switch(textureFunction.sampler)
         {
-            out << ", float bias";
+          case EbtSampler2D:            out << ", int2 offset"; break;
+          case EbtSampler3D:            out << ", int3 offset"; break;
+          case EbtSampler2DArray:       out << ", int2 offset"; break;
+          case EbtISampler2D:           out << ", int2 offset"; break;
+          case EbtISampler3D:           out << ", int3 offset"; break;
+          case EbtISampler2DArray:      out << ", int2 offset"; break;
+          case EbtUSampler2D:           out << ", int2 offset"; break;
+          case EbtUSampler3D:           out << ", int3 offset"; break;
+          case EbtUSampler2DArray:      out << ", int2 offset"; break;
+          case EbtSampler2DShadow:      out << ", int2 offset"; break;
+          case EbtSampler2DArrayShadow: out << ", int2 offset"; break;
+          default: UNREACHABLE();
         }
+    }
+
+    if (textureFunction.method == TextureFunction::BIAS ||
+        textureFunction.method == TextureFunction::LOD0BIAS)
+    {
+        out << ", float bias";
+    }
 
-        out << ")\n"
-               "{\n";
+    out << ")\n"
+           "{\n";
 
-        if (textureFunction->method == TextureFunction::SIZE)
+    if (textureFunction.method == TextureFunction::SIZE)
+    {
+        if (IsSampler2D(textureFunction.sampler) || IsSamplerCube(textureFunction.sampler))
         {
-            if (IsSampler2D(textureFunction->sampler) || IsSamplerCube(textureFunction->sampler))
+            if (IsSamplerArray(textureFunction.sampler))
             {
-                if (IsSamplerArray(textureFunction->sampler))
-                {
-                    out << "    uint width; uint height; uint layers; uint numberOfLevels;\n"
-                           "    x.GetDimensions(lod, width, height, layers, numberOfLevels);\n";
-                }
-                else
-                {
-                    out << "    uint width; uint height; uint numberOfLevels;\n"
-                           "    x.GetDimensions(lod, width, height, numberOfLevels);\n";
-                }
+                out << "    uint width; uint height; uint layers; uint numberOfLevels;\n"
+                       "    x.GetDimensions(lod, width, height, layers, numberOfLevels);\n";
             }
-            else if (IsSampler3D(textureFunction->sampler))
+            else
             {
-                out << "    uint width; uint height; uint depth; uint numberOfLevels;\n"
-                       "    x.GetDimensions(lod, width, height, depth, numberOfLevels);\n";
+                out << "    uint width; uint height; uint numberOfLevels;\n"
+                       "    x.GetDimensions(lod, width, height, numberOfLevels);\n";
             }
-            else UNREACHABLE();
+        }
+        else if (IsSampler3D(textureFunction.sampler))
+        {
+            out << "    uint width; uint height; uint depth; uint numberOfLevels;\n"
+                   "    x.GetDimensions(lod, width, height, depth, numberOfLevels);\n";
+        }
+        else UNREACHABLE();
 
-            switch(textureFunction->sampler)
-            {
-              case EbtSampler2D:            out << "    return int2(width, height);";         break;
-              case EbtSampler3D:            out << "    return int3(width, height, depth);";  break;
-              case EbtSamplerCube:          out << "    return int2(width, height);";         break;
-              case EbtSampler2DArray:       out << "    return int3(width, height, layers);"; break;
-              case EbtISampler2D:           out << "    return int2(width, height);";         break;
-              case EbtISampler3D:           out << "    return int3(width, height, depth);";  break;
-              case EbtISamplerCube:         out << "    return int2(width, height);";         break;
-              case EbtISampler2DArray:      out << "    return int3(width, height, layers);"; break;
-              case EbtUSampler2D:           out << "    return int2(width, height);";         break;
-              case EbtUSampler3D:           out << "    return int3(width, height, depth);";  break;
-              case EbtUSamplerCube:         out << "    return int2(width, height);";         break;
-              case EbtUSampler2DArray:      out << "    return int3(width, height, layers);"; break;
-              case EbtSampler2DShadow:      out << "    return int2(width, height);";         break;
-              case EbtSamplerCubeShadow:    out << "    return int2(width, height);";         break;
-              case EbtSampler2DArrayShadow: out << "    return int3(width, height, layers);"; break;
-              default: UNREACHABLE();
-            }
+        switch(textureFunction.sampler)
+        {
+          case EbtSampler2D:            out << "    return int2(width, height);";         break;
+          case EbtSampler3D:            out << "    return int3(width, height, depth);";  break;
+          case EbtSamplerCube:          out << "    return int2(width, height);";         break;
+          case EbtSampler2DArray:       out << "    return int3(width, height, layers);"; break;
+          case EbtISampler2D:           out << "    return int2(width, height);";         break;
+          case EbtISampler3D:           out << "    return int3(width, height, depth);";  break;
+          case EbtISamplerCube:         out << "    return int2(width, height);";         break;
+          case EbtISampler2DArray:      out << "    return int3(width, height, layers);"; break;
+          case EbtUSampler2D:           out << "    return int2(width, height);";         break;
+          case EbtUSampler3D:           out << "    return int3(width, height, depth);";  break;
+          case EbtUSamplerCube:         out << "    return int2(width, height);";         break;
+          case EbtUSampler2DArray:      out << "    return int3(width, height, layers);"; break;
+          case EbtSampler2DShadow:      out << "    return int2(width, height);";         break;
+          case EbtSamplerCubeShadow:    out << "    return int2(width, height);";         break;
+          case EbtSampler2DArrayShadow: out << "    return int3(width, height, layers);"; break;
+          default: UNREACHABLE();
         }
-        else
+    }
+    else
+    {
+        if (IsIntegerSampler(textureFunction.sampler) && IsSamplerCube(textureFunction.sampler))
         {
-            if (IsIntegerSampler(textureFunction->sampler) && IsSamplerCube(textureFunction->sampler))
-            {
-                out << "    float width; float height; float layers; float levels;\n";
+            out << "    float width; float height; float layers; float levels;\n";
 
-                out << "    uint mip = 0;\n";
+            out << "    uint mip = 0;\n";
 
-                out << "    x.GetDimensions(mip, width, height, layers, levels);\n";
+            out << "    x.GetDimensions(mip, width, height, layers, levels);\n";
 
-                out << "    bool xMajor = abs(t.x) > abs(t.y) && abs(t.x) > abs(t.z);\n";
-                out << "    bool yMajor = abs(t.y) > abs(t.z) && abs(t.y) > abs(t.x);\n";
-                out << "    bool zMajor = abs(t.z) > abs(t.x) && abs(t.z) > abs(t.y);\n";
-                out << "    bool negative = (xMajor && t.x < 0.0f) || (yMajor && t.y < 0.0f) || (zMajor && t.z < 0.0f);\n";
+            out << "    bool xMajor = abs(t.x) > abs(t.y) && abs(t.x) > abs(t.z);\n";
+            out << "    bool yMajor = abs(t.y) > abs(t.z) && abs(t.y) > abs(t.x);\n";
+            out << "    bool zMajor = abs(t.z) > abs(t.x) && abs(t.z) > abs(t.y);\n";
+            out << "    bool negative = (xMajor && t.x < 0.0f) || (yMajor && t.y < 0.0f) || (zMajor && t.z < 0.0f);\n";
 
-                // FACE_POSITIVE_X = 000b
-                // FACE_NEGATIVE_X = 001b
-                // FACE_POSITIVE_Y = 010b
-                // FACE_NEGATIVE_Y = 011b
-                // FACE_POSITIVE_Z = 100b
-                // FACE_NEGATIVE_Z = 101b
-                out << "    int face = (int)negative + (int)yMajor * 2 + (int)zMajor * 4;\n";
+            // FACE_POSITIVE_X = 000b
+            // FACE_NEGATIVE_X = 001b
+            // FACE_POSITIVE_Y = 010b
+            // FACE_NEGATIVE_Y = 011b
+            // FACE_POSITIVE_Z = 100b
+            // FACE_NEGATIVE_Z = 101b
+            out << "    int face = (int)negative + (int)yMajor * 2 + (int)zMajor * 4;\n";
 
-                out << "    float u = xMajor ? -t.z : (yMajor && t.y < 0.0f ? -t.x : t.x);\n";
-                out << "    float v = yMajor ? t.z : (negative ? t.y : -t.y);\n";
-                out << "    float m = xMajor ? t.x : (yMajor ? t.y : t.z);\n";
+            out << "    float u = xMajor ? -t.z : (yMajor && t.y < 0.0f ? -t.x : t.x);\n";
+            out << "    float v = yMajor ? t.z : (negative ? t.y : -t.y);\n";
+            out << "    float m = xMajor ? t.x : (yMajor ? t.y : t.z);\n";
 
-                out << "    t.x = (u * 0.5f / m) + 0.5f;\n";
-                out << "    t.y = (v * 0.5f / m) + 0.5f;\n";
-            }
-            else if (IsIntegerSampler(textureFunction->sampler) &&
-                     textureFunction->method != TextureFunction::FETCH)
+            out << "    t.x = (u * 0.5f / m) + 0.5f;\n";
+            out << "    t.y = (v * 0.5f / m) + 0.5f;\n";
+        }
+        else if (IsIntegerSampler(textureFunction.sampler) &&
+                 textureFunction.method != TextureFunction::FETCH)
+        {
+            if (IsSampler2D(textureFunction.sampler))
             {
-                if (IsSampler2D(textureFunction->sampler))
+                if (IsSamplerArray(textureFunction.sampler))
                 {
-                    if (IsSamplerArray(textureFunction->sampler))
-                    {
-                        out << "    float width; float height; float layers; float levels;\n";
-
-                        if (textureFunction->method == TextureFunction::LOD0)
-                        {
-                            out << "    uint mip = 0;\n";
-                        }
-                        else if (textureFunction->method == TextureFunction::LOD0BIAS)
-                        {
-                            out << "    uint mip = bias;\n";
-                        }
-                        else
-                        {
-                            if (textureFunction->method == TextureFunction::IMPLICIT ||
-                                textureFunction->method == TextureFunction::BIAS)
-                            {
-                                out << "    x.GetDimensions(0, width, height, layers, levels);\n"
-                                       "    float2 tSized = float2(t.x * width, t.y * height);\n"
-                                       "    float dx = length(ddx(tSized));\n"
-                                       "    float dy = length(ddy(tSized));\n"
-                                       "    float lod = log2(max(dx, dy));\n";
-
-                                if (textureFunction->method == TextureFunction::BIAS)
-                                {
-                                    out << "    lod += bias;\n";
-                                }
-                            }
-                            else if (textureFunction->method == TextureFunction::GRAD)
-                            {
-                                out << "    x.GetDimensions(0, width, height, layers, levels);\n"
-                                       "    float lod = log2(max(length(ddx), length(ddy)));\n";
-                            }
-
-                            out << "    uint mip = uint(min(max(round(lod), 0), levels - 1));\n";
-                        }
+                    out << "    float width; float height; float layers; float levels;\n";
 
-                        out << "    x.GetDimensions(mip, width, height, layers, levels);\n";
+                    if (textureFunction.method == TextureFunction::LOD0)
+                    {
+                        out << "    uint mip = 0;\n";
+                    }
+                    else if (textureFunction.method == TextureFunction::LOD0BIAS)
+                    {
+                        out << "    uint mip = bias;\n";
                     }
                     else
                     {
-                        out << "    float width; float height; float levels;\n";
-
-                        if (textureFunction->method == TextureFunction::LOD0)
-                        {
-                            out << "    uint mip = 0;\n";
-                        }
-                        else if (textureFunction->method == TextureFunction::LOD0BIAS)
-                        {
-                            out << "    uint mip = bias;\n";
-                        }
-                        else
+                        if (textureFunction.method == TextureFunction::IMPLICIT ||
+                            textureFunction.method == TextureFunction::BIAS)
                         {
-                            if (textureFunction->method == TextureFunction::IMPLICIT ||
-                                textureFunction->method == TextureFunction::BIAS)
-                            {
-                                out << "    x.GetDimensions(0, width, height, levels);\n"
-                                       "    float2 tSized = float2(t.x * width, t.y * height);\n"
-                                       "    float dx = length(ddx(tSized));\n"
-                                       "    float dy = length(ddy(tSized));\n"
-                                       "    float lod = log2(max(dx, dy));\n";
-
-                                if (textureFunction->method == TextureFunction::BIAS)
-                                {
-                                    out << "    lod += bias;\n";
-                                }
-                            }
-                            else if (textureFunction->method == TextureFunction::LOD)
-                            {
-                                out << "    x.GetDimensions(0, width, height, levels);\n";
-                            }
-                            else if (textureFunction->method == TextureFunction::GRAD)
+                            out << "    x.GetDimensions(0, width, height, layers, levels);\n"
+                                   "    float2 tSized = float2(t.x * width, t.y * height);\n"
+                                   "    float dx = length(ddx(tSized));\n"
+                                   "    float dy = length(ddy(tSized));\n"
+                                   "    float lod = log2(max(dx, dy));\n";
+
+                            if (textureFunction.method == TextureFunction::BIAS)
                             {
-                                out << "    x.GetDimensions(0, width, height, levels);\n"
-                                       "    float lod = log2(max(length(ddx), length(ddy)));\n";
+                                out << "    lod += bias;\n";
                             }
-
-                            out << "    uint mip = uint(min(max(round(lod), 0), levels - 1));\n";
+                        }
+                        else if (textureFunction.method == TextureFunction::GRAD)
+                        {
+                            out << "    x.GetDimensions(0, width, height, layers, levels);\n"
+                                   "    float lod = log2(max(length(ddx), length(ddy)));\n";
                         }
 
-                        out << "    x.GetDimensions(mip, width, height, levels);\n";
+                        out << "    uint mip = uint(min(max(round(lod), 0), levels - 1));\n";
                     }
+
+                    out << "    x.GetDimensions(mip, width, height, layers, levels);\n";
                 }
-                else if (IsSampler3D(textureFunction->sampler))
+                else
                 {
-                    out << "    float width; float height; float depth; float levels;\n";
+                    out << "    float width; float height; float levels;\n";
 
-                    if (textureFunction->method == TextureFunction::LOD0)
+                    if (textureFunction.method == TextureFunction::LOD0)
                     {
                         out << "    uint mip = 0;\n";
                     }
-                    else if (textureFunction->method == TextureFunction::LOD0BIAS)
+                    else if (textureFunction.method == TextureFunction::LOD0BIAS)
                     {
                         out << "    uint mip = bias;\n";
                     }
                     else
                     {
-                        if (textureFunction->method == TextureFunction::IMPLICIT ||
-                            textureFunction->method == TextureFunction::BIAS)
+                        if (textureFunction.method == TextureFunction::IMPLICIT ||
+                            textureFunction.method == TextureFunction::BIAS)
                         {
-                            out << "    x.GetDimensions(0, width, height, depth, levels);\n"
-                                   "    float3 tSized = float3(t.x * width, t.y * height, t.z * depth);\n"
+                            out << "    x.GetDimensions(0, width, height, levels);\n"
+                                   "    float2 tSized = float2(t.x * width, t.y * height);\n"
                                    "    float dx = length(ddx(tSized));\n"
                                    "    float dy = length(ddy(tSized));\n"
                                    "    float lod = log2(max(dx, dy));\n";
 
-                            if (textureFunction->method == TextureFunction::BIAS)
+                            if (textureFunction.method == TextureFunction::BIAS)
                             {
                                 out << "    lod += bias;\n";
                             }
                         }
-                        else if (textureFunction->method == TextureFunction::GRAD)
+                        else if (textureFunction.method == TextureFunction::LOD)
+                        {
+                            out << "    x.GetDimensions(0, width, height, levels);\n";
+                        }
+                        else if (textureFunction.method == TextureFunction::GRAD)
                         {
-                            out << "    x.GetDimensions(0, width, height, depth, levels);\n"
+                            out << "    x.GetDimensions(0, width, height, levels);\n"
                                    "    float lod = log2(max(length(ddx), length(ddy)));\n";
                         }
 
                         out << "    uint mip = uint(min(max(round(lod), 0), levels - 1));\n";
                     }
 
-                    out << "    x.GetDimensions(mip, width, height, depth, levels);\n";
+                    out << "    x.GetDimensions(mip, width, height, levels);\n";
                 }
-                else UNREACHABLE();
             }
-
-            out << "    return ";
-
-            // HLSL intrinsic
-            if (mOutputType == SH_HLSL9_OUTPUT)
+            else if (IsSampler3D(textureFunction.sampler))
             {
-                switch(textureFunction->sampler)
+                out << "    float width; float height; float depth; float levels;\n";
+
+                if (textureFunction.method == TextureFunction::LOD0)
                 {
-                  case EbtSampler2D:   out << "tex2D";   break;
-                  case EbtSamplerCube: out << "texCUBE"; break;
-                  default: UNREACHABLE();
+                    out << "    uint mip = 0;\n";
                 }
-
-                switch(textureFunction->method)
+                else if (textureFunction.method == TextureFunction::LOD0BIAS)
                 {
-                  case TextureFunction::IMPLICIT: out << "(s, ";     break;
-                  case TextureFunction::BIAS:     out << "bias(s, "; break;
-                  case TextureFunction::LOD:      out << "lod(s, ";  break;
-                  case TextureFunction::LOD0:     out << "lod(s, ";  break;
-                  case TextureFunction::LOD0BIAS: out << "lod(s, ";  break;
-                  default: UNREACHABLE();
+                    out << "    uint mip = bias;\n";
                 }
-            }
-            else if (mOutputType == SH_HLSL11_OUTPUT)
-            {
-                if (textureFunction->method == TextureFunction::GRAD)
+                else
                 {
-                    if (IsIntegerSampler(textureFunction->sampler))
-                    {
-                        out << "x.Load(";
-                    }
-                    else if (IsShadowSampler(textureFunction->sampler))
+                    if (textureFunction.method == TextureFunction::IMPLICIT ||
+                        textureFunction.method == TextureFunction::BIAS)
                     {
-                        out << "x.SampleCmpLevelZero(s, ";
+                        out << "    x.GetDimensions(0, width, height, depth, levels);\n"
+                               "    float3 tSized = float3(t.x * width, t.y * height, t.z * depth);\n"
+                               "    float dx = length(ddx(tSized));\n"
+                               "    float dy = length(ddy(tSized));\n"
+                               "    float lod = log2(max(dx, dy));\n";
+
+                        if (textureFunction.method == TextureFunction::BIAS)
+                        {
+                            out << "    lod += bias;\n";
+                        }
                     }
-                    else
+                    else if (textureFunction.method == TextureFunction::GRAD)
                     {
-                        out << "x.SampleGrad(s, ";
+                        out << "    x.GetDimensions(0, width, height, depth, levels);\n"
+                               "    float lod = log2(max(length(ddx), length(ddy)));\n";
                     }
+
+                    out << "    uint mip = uint(min(max(round(lod), 0), levels - 1));\n";
                 }
-                else if (IsIntegerSampler(textureFunction->sampler) ||
-                         textureFunction->method == TextureFunction::FETCH)
+
+                out << "    x.GetDimensions(mip, width, height, depth, levels);\n";
+            }
+            else UNREACHABLE();
+        }
+
+        out << "    return ";
+
+        // HLSL intrinsic
+        if (mOutputType == SH_HLSL9_OUTPUT)
+        {
+            switch(textureFunction.sampler)
+            {
+              case EbtSampler2D:   out << "tex2D";   break;
+              case EbtSamplerCube: out << "texCUBE"; break;
+              default: UNREACHABLE();
+            }
+
+            switch(textureFunction.method)
+            {
+              case TextureFunction::IMPLICIT: out << "(s, ";     break;
+              case TextureFunction::BIAS:     out << "bias(s, "; break;
+              case TextureFunction::LOD:      out << "lod(s, ";  break;
+              case TextureFunction::LOD0:     out << "lod(s, ";  break;
+              case TextureFunction::LOD0BIAS: out << "lod(s, ";  break;
+              default: UNREACHABLE();
+            }
+        }
+        else if (mOutputType == SH_HLSL11_OUTPUT)
+        {
+            if (textureFunction.method == TextureFunction::GRAD)
+            {
+                if (IsIntegerSampler(textureFunction.sampler))
                 {
                     out << "x.Load(";
                 }
-                else if (IsShadowSampler(textureFunction->sampler))
+                else if (IsShadowSampler(textureFunction.sampler))
                 {
-                    out << "x.SampleCmp(s, ";
+                    out << "x.SampleCmpLevelZero(s, ";
                 }
                 else
                 {
-                    switch(textureFunction->method)
-                    {
-                      case TextureFunction::IMPLICIT: out << "x.Sample(s, ";      break;
-                      case TextureFunction::BIAS:     out << "x.SampleBias(s, ";  break;
-                      case TextureFunction::LOD:      out << "x.SampleLevel(s, "; break;
-                      case TextureFunction::LOD0:     out << "x.SampleLevel(s, "; break;
-                      case TextureFunction::LOD0BIAS: out << "x.SampleLevel(s, "; break;
-                      default: UNREACHABLE();
-                    }
+                    out << "x.SampleGrad(s, ";
                 }
             }
-            else UNREACHABLE();
-
-            // Integer sampling requires integer addresses
-            TString addressx = "";
-            TString addressy = "";
-            TString addressz = "";
-            TString close = "";
-
-            if (IsIntegerSampler(textureFunction->sampler) ||
-                textureFunction->method == TextureFunction::FETCH)
+            else if (IsIntegerSampler(textureFunction.sampler) ||
+                     textureFunction.method == TextureFunction::FETCH)
             {
-                switch(hlslCoords)
+                out << "x.Load(";
+            }
+            else if (IsShadowSampler(textureFunction.sampler))
+            {
+                out << "x.SampleCmp(s, ";
+            }
+            else
+            {
+                switch(textureFunction.method)
                 {
-                  case 2: out << "int3("; break;
-                  case 3: out << "int4("; break;
+                  case TextureFunction::IMPLICIT: out << "x.Sample(s, ";      break;
+                  case TextureFunction::BIAS:     out << "x.SampleBias(s, ";  break;
+                  case TextureFunction::LOD:      out << "x.SampleLevel(s, "; break;
+                  case TextureFunction::LOD0:     out << "x.SampleLevel(s, "; break;
+                  case TextureFunction::LOD0BIAS: out << "x.SampleLevel(s, "; break;
                   default: UNREACHABLE();
                 }
+            }
+        }
+        else UNREACHABLE();
 
-                // Convert from normalized floating-point to integer
-                if (textureFunction->method != TextureFunction::FETCH)
-                {
-                    addressx = "int(floor(width * frac((";
-                    addressy = "int(floor(height * frac((";
-
-                    if (IsSamplerArray(textureFunction->sampler))
-                    {
-                        addressz = "int(max(0, min(layers - 1, floor(0.5 + ";
-                    }
-                    else if (IsSamplerCube(textureFunction->sampler))
-                    {
-                        addressz = "((((";
-                    }
-                    else
-                    {
-                        addressz = "int(floor(depth * frac((";
-                    }
+        // Integer sampling requires integer addresses
+        TString addressx = "";
+        TString addressy = "";
+        TString addressz = "";
+        TString close = "";
 
-                    close = "))))";
-                }
+        if (IsIntegerSampler(textureFunction.sampler) ||
+            textureFunction.method == TextureFunction::FETCH)
+        {
+            switch(hlslCoords)
+            {
+              case 2: out << "int3("; break;
+              case 3: out << "int4("; break;
+              default: UNREACHABLE();
             }
-            else
+
+            // Convert from normalized floating-point to integer
+            if (textureFunction.method != TextureFunction::FETCH)
             {
-                switch(hlslCoords)
+                addressx = "int(floor(width * frac((";
+                addressy = "int(floor(height * frac((";
+
+                if (IsSamplerArray(textureFunction.sampler))
                 {
-                  case 2: out << "float2("; break;
-                  case 3: out << "float3("; break;
-                  case 4: out << "float4("; break;
-                  default: UNREACHABLE();
+                    addressz = "int(max(0, min(layers - 1, floor(0.5 + ";
+                }
+                else if (IsSamplerCube(textureFunction.sampler))
+                {
+                    addressz = "((((";
                 }
+                else
+                {
+                    addressz = "int(floor(depth * frac((";
+                }
+
+                close = "))))";
             }
+        }
+        else
+        {
+            switch(hlslCoords)
+            {
+              case 2: out << "float2("; break;
+              case 3: out << "float3("; break;
+              case 4: out << "float4("; break;
+              default: UNREACHABLE();
+            }
+        }
 
-            TString proj = "";   // Only used for projected textures
+        TString proj = "";   // Only used for projected textures
 
-            if (textureFunction->proj)
+        if (textureFunction.proj)
+        {
+            switch(textureFunction.coords)
             {
-                switch(textureFunction->coords)
-                {
-                  case 3: proj = " / t.z"; break;
-                  case 4: proj = " / t.w"; break;
-                  default: UNREACHABLE();
-                }
+              case 3: proj = " / t.z"; break;
+              case 4: proj = " / t.w"; break;
+              default: UNREACHABLE();
             }
+        }
 
-            out << addressx + ("t.x" + proj) + close + ", " + addressy + ("t.y" + proj) + close;
+        out << addressx + ("t.x" + proj) + close + ", " + addressy + ("t.y" + proj) + close;
 
-            if (mOutputType == SH_HLSL9_OUTPUT)
+        if (mOutputType == SH_HLSL9_OUTPUT)
+        {
+            if (hlslCoords >= 3)
             {
-                if (hlslCoords >= 3)
+                if (textureFunction.coords < 3)
                 {
-                    if (textureFunction->coords < 3)
-                    {
-                        out << ", 0";
-                    }
-                    else
-                    {
-                        out << ", t.z" + proj;
-                    }
+                    out << ", 0";
                 }
-
-                if (hlslCoords == 4)
+                else
                 {
-                    switch(textureFunction->method)
-                    {
-                      case TextureFunction::BIAS:     out << ", bias"; break;
-                      case TextureFunction::LOD:      out << ", lod";  break;
-                      case TextureFunction::LOD0:     out << ", 0";    break;
-                      case TextureFunction::LOD0BIAS: out << ", bias"; break;
-                      default: UNREACHABLE();
-                    }
+                    out << ", t.z" + proj;
                 }
-
-                out << "));\n";
             }
-            else if (mOutputType == SH_HLSL11_OUTPUT)
+
+            if (hlslCoords == 4)
             {
-                if (hlslCoords >= 3)
+                switch(textureFunction.method)
                 {
-                    if (IsIntegerSampler(textureFunction->sampler) && IsSamplerCube(textureFunction->sampler))
-                    {
-                        out << ", face";
-                    }
-                    else
-                    {
-                        out << ", " + addressz + ("t.z" + proj) + close;
-                    }
+                  case TextureFunction::BIAS:     out << ", bias"; break;
+                  case TextureFunction::LOD:      out << ", lod";  break;
+                  case TextureFunction::LOD0:     out << ", 0";    break;
+                  case TextureFunction::LOD0BIAS: out << ", bias"; break;
+                  default: UNREACHABLE();
+                }
+            }
+
+            out << "));\n";
+        }
+        else if (mOutputType == SH_HLSL11_OUTPUT)
+        {
+            if (hlslCoords >= 3)
+            {
+                if (IsIntegerSampler(textureFunction.sampler) && IsSamplerCube(textureFunction.sampler))
+                {
+                    out << ", face";
                 }
-
-                if (textureFunction->method == TextureFunction::GRAD)
+                else
                 {
-                    if (IsIntegerSampler(textureFunction->sampler))
-                    {
-                        out << ", mip)";
-                    }
-                    else if (IsShadowSampler(textureFunction->sampler))
-                    {
-                        // Compare value
-                        switch(textureFunction->coords)
-                        {
-                          case 3: out << "), t.z"; break;
-                          case 4: out << "), t.w"; break;
-                          default: UNREACHABLE();
-                        }
-                    }
-                    else
-                    {
-                        out << "), ddx, ddy";
-                    }
+                    out << ", " + addressz + ("t.z" + proj) + close;
                 }
-                else if (IsIntegerSampler(textureFunction->sampler) ||
-                         textureFunction->method == TextureFunction::FETCH)
+            }
+
+            if (textureFunction.method == TextureFunction::GRAD)
+            {
+                if (IsIntegerSampler(textureFunction.sampler))
                 {
                     out << ", mip)";
                 }
-                else if (IsShadowSampler(textureFunction->sampler))
+                else if (IsShadowSampler(textureFunction.sampler))
                 {
                     // Compare value
-                    switch(textureFunction->coords)
+                    switch(textureFunction.coords)
                     {
                       case 3: out << "), t.z"; break;
                       case 4: out << "), t.w"; break;
@@ -1138,239 +1361,50 @@ void OutputHLSL::header()
                 }
                 else
                 {
-                    switch(textureFunction->method)
-                    {
-                      case TextureFunction::IMPLICIT: out << ")";       break;
-                      case TextureFunction::BIAS:     out << "), bias"; break;
-                      case TextureFunction::LOD:      out << "), lod";  break;
-                      case TextureFunction::LOD0:     out << "), 0";    break;
-                      case TextureFunction::LOD0BIAS: out << "), bias"; break;
-                      default: UNREACHABLE();
-                    }
+                    out << "), ddx, ddy";
                 }
-
-                if (textureFunction->offset)
+            }
+            else if (IsIntegerSampler(textureFunction.sampler) ||
+                     textureFunction.method == TextureFunction::FETCH)
+            {
+                out << ", mip)";
+            }
+            else if (IsShadowSampler(textureFunction.sampler))
+            {
+                // Compare value
+                switch(textureFunction.coords)
                 {
-                    out << ", offset";
+                  case 3: out << "), t.z"; break;
+                  case 4: out << "), t.w"; break;
+                  default: UNREACHABLE();
+                }
+            }
+            else
+            {
+                switch(textureFunction.method)
+                {
+                  case TextureFunction::IMPLICIT: out << ")";       break;
+                  case TextureFunction::BIAS:     out << "), bias"; break;
+                  case TextureFunction::LOD:      out << "), lod";  break;
+                  case TextureFunction::LOD0:     out << "), 0";    break;
+                  case TextureFunction::LOD0BIAS: out << "), bias"; break;
+                  default: UNREACHABLE();
                 }
-
-                out << ");";
             }
-            else UNREACHABLE();
-        }
-
-        out << "\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesFragCoord)
-    {
-        out << "#define GL_USES_FRAG_COORD\n";
-    }
-
-    if (mUsesPointCoord)
-    {
-        out << "#define GL_USES_POINT_COORD\n";
-    }
-
-    if (mUsesFrontFacing)
-    {
-        out << "#define GL_USES_FRONT_FACING\n";
-    }
-
-    if (mUsesPointSize)
-    {
-        out << "#define GL_USES_POINT_SIZE\n";
-    }
-
-    if (mUsesFragDepth)
-    {
-        out << "#define GL_USES_FRAG_DEPTH\n";
-    }
-
-    if (mUsesDepthRange)
-    {
-        out << "#define GL_USES_DEPTH_RANGE\n";
-    }
-
-    if (mUsesXor)
-    {
-        out << "bool xor(bool p, bool q)\n"
-               "{\n"
-               "    return (p || q) && !(p && q);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod1)
-    {
-        out << "float mod(float x, float y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod2v)
-    {
-        out << "float2 mod(float2 x, float2 y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod2f)
-    {
-        out << "float2 mod(float2 x, float y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod3v)
-    {
-        out << "float3 mod(float3 x, float3 y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod3f)
-    {
-        out << "float3 mod(float3 x, float y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod4v)
-    {
-        out << "float4 mod(float4 x, float4 y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesMod4f)
-    {
-        out << "float4 mod(float4 x, float y)\n"
-               "{\n"
-               "    return x - y * floor(x / y);\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesFaceforward1)
-    {
-        out << "float faceforward(float N, float I, float Nref)\n"
-               "{\n"
-               "    if(dot(Nref, I) >= 0)\n"
-               "    {\n"
-               "        return -N;\n"
-               "    }\n"
-               "    else\n"
-               "    {\n"
-               "        return N;\n"
-               "    }\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesFaceforward2)
-    {
-        out << "float2 faceforward(float2 N, float2 I, float2 Nref)\n"
-               "{\n"
-               "    if(dot(Nref, I) >= 0)\n"
-               "    {\n"
-               "        return -N;\n"
-               "    }\n"
-               "    else\n"
-               "    {\n"
-               "        return N;\n"
-               "    }\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesFaceforward3)
-    {
-        out << "float3 faceforward(float3 N, float3 I, float3 Nref)\n"
-               "{\n"
-               "    if(dot(Nref, I) >= 0)\n"
-               "    {\n"
-               "        return -N;\n"
-               "    }\n"
-               "    else\n"
-               "    {\n"
-               "        return N;\n"
-               "    }\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesFaceforward4)
-    {
-        out << "float4 faceforward(float4 N, float4 I, float4 Nref)\n"
-               "{\n"
-               "    if(dot(Nref, I) >= 0)\n"
-               "    {\n"
-               "        return -N;\n"
-               "    }\n"
-               "    else\n"
-               "    {\n"
-               "        return N;\n"
-               "    }\n"
-               "}\n"
-               "\n";
-    }
-
-    if (mUsesAtan2_1)
-    {
-        out << "float atanyx(float y, float x)\n"
-               "{\n"
-               "    if(x == 0 && y == 0) x = 1;\n"   // Avoid producing a NaN
-               "    return atan2(y, x);\n"
-               "}\n";
-    }
 
-    if (mUsesAtan2_2)
-    {
-        out << "float2 atanyx(float2 y, float2 x)\n"
-               "{\n"
-               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
-               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
-               "    return float2(atan2(y[0], x[0]), atan2(y[1], x[1]));\n"
-               "}\n";
-    }
+            if (textureFunction.offset)
+            {
+                out << ", offset";
+            }
 
-    if (mUsesAtan2_3)
-    {
-        out << "float3 atanyx(float3 y, float3 x)\n"
-               "{\n"
-               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
-               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
-               "    if(x[2] == 0 && y[2] == 0) x[2] = 1;\n"
-               "    return float3(atan2(y[0], x[0]), atan2(y[1], x[1]), atan2(y[2], x[2]));\n"
-               "}\n";
+            out << ");";
+        }
+        else UNREACHABLE();
     }
 
-    if (mUsesAtan2_4)
-    {
-        out << "float4 atanyx(float4 y, float4 x)\n"
-               "{\n"
-               "    if(x[0] == 0 && y[0] == 0) x[0] = 1;\n"
-               "    if(x[1] == 0 && y[1] == 0) x[1] = 1;\n"
-               "    if(x[2] == 0 && y[2] == 0) x[2] = 1;\n"
-               "    if(x[3] == 0 && y[3] == 0) x[3] = 1;\n"
-               "    return float4(atan2(y[0], x[0]), atan2(y[1], x[1]), atan2(y[2], x[2]), atan2(y[3], x[3]));\n"
-               "}\n";
-    }
+    out << "\n"
+           "}\n"
+           "\n";
 }
 
 void OutputHLSL::visitSymbol(TIntermSymbol *node)
@@ -1509,11 +1543,11 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
             if (sameSymbol)
             {
                 // Type already printed
-                out << "t" + str(mUniqueIndex) + " = ";
+                out << "t" << mUniqueIndex << " = ";
                 expression->traverse(this);
                 out << ", ";
                 symbolNode->traverse(this);
-                out << " = t" + str(mUniqueIndex);
+                out << " = t" << mUniqueIndex;
 
                 mUniqueIndex++;
                 return false;
@@ -1593,7 +1627,7 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
             const TStructure* structure = node->getLeft()->getType().getStruct();
             const TIntermConstantUnion* index = node->getRight()->getAsConstantUnion();
             const TField* field = structure->fields()[index->getIConst(0)];
-            out << "." + DecorateField(field->name(), *structure);
+            out << "." << DecorateField(field->name(), *structure);
 
             return false;
         }
@@ -1604,7 +1638,7 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
             const TInterfaceBlock* interfaceBlock = node->getLeft()->getType().getInterfaceBlock();
             const TIntermConstantUnion* index = node->getRight()->getAsConstantUnion();
             const TField* field = interfaceBlock->fields()[index->getIConst(0)];
-            out << "." + Decorate(field->name());
+            out << "." << Decorate(field->name());
 
             return false;
         }
@@ -1681,9 +1715,9 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
                 const TField *field = fields[i];
 
                 node->getLeft()->traverse(this);
-                out << "." + DecorateField(field->name(), structure) + " == ";
+                out << "." << DecorateField(field->name(), structure) << " == ";
                 node->getRight()->traverse(this);
-                out << "." + DecorateField(field->name(), structure);
+                out << "." << DecorateField(field->name(), structure);
 
                 if (i < fields.size() - 1)
                 {
@@ -1881,7 +1915,7 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
                             out << "static ";
                         }
 
-                        out << TypeString(variable->getType()) + " ";
+                        out << TypeString(variable->getType()) << " ";
 
                         TIntermSymbol *symbol = (*sit)->getAsSymbolNode();
 
@@ -1889,7 +1923,8 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
                         {
                             symbol->traverse(this);
                             out << ArrayString(symbol->getType());
-                            out << " = " + initializer(symbol->getType());
+                            out << " = ";
+                            outputInitializer(out, symbol->getType());
                         }
                         else
                         {
@@ -1949,7 +1984,7 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
 
                 if (symbol)
                 {
-                    out << argumentString(symbol);
+                    outputArgument(out, symbol);
 
                     if (i < arguments->size() - 1)
                     {
@@ -2004,7 +2039,7 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
                         mStructureHLSL->addConstructor(symbol->getType(), StructNameString(*structure), NULL);
                     }
 
-                    out << argumentString(symbol);
+                    outputArgument(out, symbol);
 
                     if (i < arguments->size() - 1)
                     {
@@ -2213,9 +2248,16 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
       case EOpConstructMat4:    outputConstructor(visit, node->getType(), "mat4", node->getSequence());  break;
       case EOpConstructStruct:
         {
-            const TString &structName = StructNameString(*node->getType().getStruct());
-            mStructureHLSL->addConstructor(node->getType(), structName, node->getSequence());
-            outputTriplet(visit, structName + "_ctor(", ", ", ")");
+            if (visit == PreVisit)
+            {
+                const TString &structName = StructNameString(*node->getType().getStruct());
+                mStructureHLSL->addConstructor(node->getType(), structName, node->getSequence());
+                out << structName << "_ctor(";
+            }
+            else
+            {
+                outputTriplet(visit, "", ", ", ")");
+            }
         }
         break;
       case EOpLessThan:         outputTriplet(visit, "(", " < ", ")");                 break;
@@ -2745,7 +2787,7 @@ bool OutputHLSL::handleExcessiveLoop(TIntermLoop *node)
     return false;   // Not handled as an excessive loop
 }
 
-void OutputHLSL::outputTriplet(Visit visit, const TString &preString, const TString &inString, const TString &postString)
+void OutputHLSL::outputTriplet(Visit visit, const char *preString, const char *inString, const char *postString)
 {
     TInfoSinkBase &out = mBody;
 
@@ -2779,7 +2821,7 @@ void OutputHLSL::outputLineDirective(int line)
     }
 }
 
-TString OutputHLSL::argumentString(const TIntermSymbol *symbol)
+void OutputHLSL::outputArgument(TInfoSinkBase &out, const TIntermSymbol *symbol)
 {
     TQualifier qualifier = symbol->getQualifier();
     const TType &type = symbol->getType();
@@ -2796,29 +2838,30 @@ TString OutputHLSL::argumentString(const TIntermSymbol *symbol)
 
     if (mOutputType == SH_HLSL11_OUTPUT && IsSampler(type.getBasicType()))
     {
-        return QualifierString(qualifier) + " " + TextureString(type) + " texture_" + name + ArrayString(type) + ", " +
-               QualifierString(qualifier) + " " + SamplerString(type) + " sampler_" + name + ArrayString(type);
+        out << QualifierString(qualifier) << " " << TextureString(type) << " texture_" << name << ArrayString(type) << ", "
+            << QualifierString(qualifier) << " " << SamplerString(type) << " sampler_" << name << ArrayString(type);
+        return;
     }
 
-    return QualifierString(qualifier) + " " + TypeString(type) + " " + name + ArrayString(type);
+    out << QualifierString(qualifier) << " " << TypeString(type) << " " << name << ArrayString(type);
 }
 
-TString OutputHLSL::initializer(const TType &type)
+void OutputHLSL::outputInitializer(TInfoSinkBase &out, const TType &type)
 {
-    TString string;
+    out << "{";
 
     size_t size = type.getObjectSize();
     for (size_t component = 0; component < size; component++)
     {
-        string += "0";
+        out << "0";
 
         if (component + 1 < size)
         {
-            string += ", ";
+            out << ", ";
         }
     }
 
-    return "{" + string + "}";
+    out << "}";
 }
 
 void OutputHLSL::outputConstructor(Visit visit, const TType &type, const TString &name, const TIntermSequence *parameters)
@@ -2829,7 +2872,7 @@ void OutputHLSL::outputConstructor(Visit visit, const TType &type, const TString
     {
         mStructureHLSL->addConstructor(type, name, parameters);
 
-        out << name + "(";
+        out << name << "(";
     }
     else if (visit == InVisit)
     {
@@ -2848,7 +2891,7 @@ const ConstantUnion *OutputHLSL::writeConstantUnion(const TType &type, const Con
     const TStructure* structure = type.getStruct();
     if (structure)
     {
-        out << StructNameString(*structure) + "_ctor(";
+        out << StructNameString(*structure) << "_ctor(";
 
         const TFieldList& fields = structure->fields();
 
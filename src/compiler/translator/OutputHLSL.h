@@ -37,10 +37,11 @@ class OutputHLSL : public TIntermTraverser
     const std::map<std::string, unsigned int> &getInterfaceBlockRegisterMap() const;
     const std::map<std::string, unsigned int> &getUniformRegisterMap() const;
 
-    static TString initializer(const TType &type);
-
   protected:
     void header();
+    void outputFlaggedStructs(TInfoSinkBase &out);
+    void outputVaryings(TInfoSinkBase &out);
+    void outputAttributes(TInfoSinkBase &out);
 
     // Visit AST nodes and output their code to the body stream
     void visitSymbol(TIntermSymbol*);
@@ -56,9 +57,10 @@ class OutputHLSL : public TIntermTraverser
     void traverseStatements(TIntermNode *node);
     bool isSingleStatement(TIntermNode *node);
     bool handleExcessiveLoop(TIntermLoop *node);
-    void outputTriplet(Visit visit, const TString &preString, const TString &inString, const TString &postString);
+    void outputTriplet(Visit visit, const char *preString, const char *inString, const char *postString);
     void outputLineDirective(int line);
-    TString argumentString(const TIntermSymbol *symbol);
+    void outputArgument(TInfoSinkBase &out, const TIntermSymbol *symbol);
+    static void outputInitializer(TInfoSinkBase &out, const TType &type);
     int vectorSize(const TType &type) const;
 
     void outputConstructor(Visit visit, const TType &type, const TString &name, const TIntermSequence *parameters);
@@ -110,6 +112,9 @@ class OutputHLSL : public TIntermTraverser
 
     typedef std::set<TextureFunction> TextureFunctionSet;
 
+    const std::string &textureFunctionText(const TextureFunction &textureFunction) const;
+    void outputTextureFunction(TInfoSinkBase &out, const TextureFunction &textureFunction) const;
+
     // Parameters determining what goes in the header output
     TextureFunctionSet mUsesTexture;
     bool mUsesFragColor;
@@ -150,7 +155,7 @@ class OutputHLSL : public TIntermTraverser
 
     TIntermSymbol *mExcessiveLoopIndex;
 
-    TString structInitializerString(int indent, const TStructure &structure, const TString &rhsStructName);
+    void outputStructInitializer(TInfoSinkBase &out, int indent, const TStructure &structure, const TString &rhsStructName);
 
     std::map<TIntermTyped*, TString> mFlaggedStructMappedNames;
     std::map<TIntermTyped*, TString> mFlaggedStructOriginalNames;
@@ -44,7 +44,8 @@ struct TParseContext {
             shaderVersion(100),
             directiveHandler(ext, diagnostics, shaderVersion),
             preprocessor(&diagnostics, &directiveHandler),
-            scanner(NULL) {  }
+            scanner(NULL),
+            statistics(NULL) {  }
     TIntermediate& intermediate; // to hold and build a parse tree
     TSymbolTable& symbolTable;   // symbol table that goes with the language currently being parsed
     sh::GLenum shaderType;              // vertex or fragment language (future: pack or unpack)
@@ -66,6 +67,7 @@ struct TParseContext {
     TDirectiveHandler directiveHandler;
     pp::Preprocessor preprocessor;
     void* scanner;
+    ShCompileStatistics* statistics;  // NULL unless the phases are timed.
 
     int getShaderVersion() const { return shaderVersion; }
     int numErrors() const { return diagnostics.numErrors(); }
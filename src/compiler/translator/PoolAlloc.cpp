@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <assert.h>
+#include <string.h>
 
 TLSIndex PoolIndex = TLS_INVALID_INDEX;
 
@@ -53,10 +54,11 @@ void SetGlobalPoolAllocator(TPoolAllocator* poolAllocator)
 TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) : 
     pageSize(growthIncrement),
     alignment(allocationAlignment),
-    freeList(0),
+    currentPageOffset(0),
+    currentPageEnd(0),
+    maxRetainedBytes(~static_cast<size_t>(0)),
     inUseList(0),
-    numCalls(0),
-    totalBytes(0)
+    allocationLog(0)
 {
     //
     // Don't allow page sizes we know are smaller than all common
@@ -64,12 +66,11 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
     //
     if (pageSize < 4*1024)
         pageSize = 4*1024;
+    maxBlockSize = pageSize;
 
-    //
-    // A large currentPageOffset indicates a new page needs to
-    // be obtained to allocate memory.
-    //
-    currentPageOffset = pageSize;
+    for (int i = 0; i < numSizeClasses; ++i)
+        freeLists[i] = 0;
+    memset(&statistics, 0, sizeof(statistics));
 
     //
     // Adjust alignment to be at least pointer aligned and
@@ -107,10 +108,105 @@ TPoolAllocator::~TPoolAllocator()
     // here, because we did it already when the block was
     // placed into the free list.
     //
-    while (freeList) {
-        tHeader* next = freeList->nextPage;
-        delete [] reinterpret_cast<char*>(freeList);
-        freeList = next;
+    trimFreeLists(0);
+}
+
+void TPoolAllocator::setPageSize(size_t size)
+{
+    if (size < 4*1024)
+        size = 4*1024;
+
+    // The free lists are sorted by multiples of the page size.  Pages in
+    // use keep their own size and are filed by it when they are freed.
+    trimFreeLists(0);
+    pageSize = size;
+    if (maxBlockSize < pageSize)
+        maxBlockSize = pageSize;
+}
+
+void TPoolAllocator::setMaxBlockSize(size_t size)
+{
+    maxBlockSize = size < pageSize ? pageSize : size;
+}
+
+void TPoolAllocator::setMaxRetainedBytes(size_t size)
+{
+    maxRetainedBytes = size;
+    trimFreeLists(maxRetainedBytes);
+}
+
+//
+// Free retained pages, largest first, until at most maxBytes are left.
+//
+void TPoolAllocator::trimFreeLists(size_t maxBytes)
+{
+    for (int i = numSizeClasses - 1; i >= 0 && statistics.bytesRetained > maxBytes; --i) {
+        while (freeLists[i] && statistics.bytesRetained > maxBytes) {
+            tHeader* next = freeLists[i]->nextPage;
+            statistics.bytesRetained -= freeLists[i]->size;
+            --statistics.pagesRetained;
+            delete [] reinterpret_cast<char*>(freeLists[i]);
+            freeLists[i] = next;
+        }
+    }
+}
+
+int TPoolAllocator::sizeClass(size_t size) const
+{
+    size_t classSize = pageSize;
+    for (int i = 0; i < numSizeClasses; ++i, classSize <<= 1) {
+        if (classSize == size)
+            return i;
+        if (classSize > size)
+            break;
+    }
+    return -1;
+}
+
+//
+// Get a page of the given size, preferably one freed earlier.  The header
+// is left for the caller to initialize.
+//
+TPoolAllocator::tHeader* TPoolAllocator::acquirePage(size_t size)
+{
+    tHeader* page = 0;
+    int index = sizeClass(size);
+    if (index >= 0 && freeLists[index]) {
+        page = freeLists[index];
+        freeLists[index] = page->nextPage;
+        statistics.bytesRetained -= size;
+        --statistics.pagesRetained;
+    } else {
+        page = reinterpret_cast<tHeader*>(::new char[size]);
+        if (page == 0)
+            return 0;
+        ++statistics.osAllocations;
+    }
+
+    ++statistics.pagesInUse;
+    statistics.bytesInUse += size;
+    if (statistics.bytesInUse > statistics.peakBytesInUse)
+        statistics.peakBytesInUse = statistics.bytesInUse;
+    return page;
+}
+
+void TPoolAllocator::releasePage(tHeader* page)
+{
+    // invoke destructor to free allocation list
+    page->~tHeader();
+
+    size_t size = page->size;
+    --statistics.pagesInUse;
+    statistics.bytesInUse -= size;
+
+    int index = sizeClass(size);
+    if (index >= 0 && size <= maxRetainedBytes - statistics.bytesRetained) {
+        page->nextPage = freeLists[index];
+        freeLists[index] = page;
+        statistics.bytesRetained += size;
+        ++statistics.pagesRetained;
+    } else {
+        delete [] reinterpret_cast<char*>(page);
     }
 }
 
@@ -152,14 +248,15 @@ void TAllocation::checkGuardBlock(unsigned char* blockMem, unsigned char val, co
 
 void TPoolAllocator::push()
 {
-    tAllocState state = { currentPageOffset, inUseList };
+    tAllocState state = { currentPageOffset, currentPageEnd, inUseList };
 
     stack.push_back(state);
         
     //
     // Indicate there is no current page to allocate from.
     //
-    currentPageOffset = pageSize;
+    currentPageOffset = 0;
+    currentPageEnd = 0;
 }
 
 //
@@ -167,7 +264,8 @@ void TPoolAllocator::push()
 // that have occurred since the last push(), or since the
 // last pop(), or since the object's creation.
 //
-// The deallocated pages are saved for future allocations.
+// The deallocated pages are saved for future allocations, up to
+// maxRetainedBytes.
 //
 void TPoolAllocator::pop()
 {
@@ -176,18 +274,11 @@ void TPoolAllocator::pop()
 
     tHeader* page = stack.back().page;
     currentPageOffset = stack.back().offset;
+    currentPageEnd = stack.back().end;
 
     while (inUseList != page) {
-        // invoke destructor to free allocation list
-        inUseList->~tHeader();
-        
         tHeader* nextInUse = inUseList->nextPage;
-        if (inUseList->pageCount > 1)
-            delete [] reinterpret_cast<char*>(inUseList);
-        else {
-            inUseList->nextPage = freeList;
-            freeList = inUseList;
-        }
+        releasePage(inUseList);
         inUseList = nextInUse;
     }
 
@@ -209,8 +300,10 @@ void* TPoolAllocator::allocate(size_t numBytes)
     //
     // Just keep some interesting statistics.
     //
-    ++numCalls;
-    totalBytes += numBytes;
+    ++statistics.allocations;
+    statistics.bytesAllocated += numBytes;
+    if (allocationLog)
+        allocationLog->push_back(numBytes);
 
     // If we are using guard blocks, all allocations are bracketed by
     // them: [guardblock][allocation][guardblock].  numBytes is how
@@ -226,7 +319,7 @@ void* TPoolAllocator::allocate(size_t numBytes)
     // Do the allocation, most likely case first, for efficiency.
     // This step could be moved to be inline sometime.
     //
-    if (allocationSize <= pageSize - currentPageOffset) {
+    if (allocationSize <= currentPageEnd - currentPageOffset) {
         //
         // Safe to allocate from currentPageOffset.
         //
@@ -237,46 +330,26 @@ void* TPoolAllocator::allocate(size_t numBytes)
         return initializeAllocation(inUseList, memory, numBytes);
     }
 
-    if (allocationSize > pageSize - headerSkip) {
-        //
-        // Do a multi-page allocation.  Don't mix these with the others.
-        // The OS is efficient and allocating and free-ing multiple pages.
-        //
-        size_t numBytesToAlloc = allocationSize + headerSkip;
-        // Detect integer overflow.
-        if (numBytesToAlloc < allocationSize)
-            return 0;
-
-        tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
-        if (memory == 0)
-            return 0;
-
-        // Use placement-new to initialize header
-        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
-        inUseList = memory;
-
-        currentPageOffset = pageSize;  // make next allocation come from a new page
-
-        // No guard blocks for multi-page allocations (yet)
-        return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(memory) + headerSkip);
-    }
+    if (allocationSize > pageSize - headerSkip)
+        return allocateLarge(allocationSize);
 
     //
-    // Need a simple page to allocate from.
+    // Need a simple page to allocate from.  Once a pool holds more than
+    // a page, the new pages grow with it, up to maxBlockSize.
     //
-    tHeader* memory;
-    if (freeList) {
-        memory = freeList;
-        freeList = freeList->nextPage;
-    } else {
-        memory = reinterpret_cast<tHeader*>(::new char[pageSize]);
-        if (memory == 0)
-            return 0;
-    }
+    size_t blockSize = pageSize;
+    while (blockSize < maxBlockSize && blockSize * 2 <= statistics.bytesInUse &&
+           sizeClass(blockSize * 2) >= 0)
+        blockSize *= 2;
+
+    tHeader* memory = acquirePage(blockSize);
+    if (memory == 0)
+        return 0;
 
     // Use placement-new to initialize header
-    new(memory) tHeader(inUseList, 1);
+    new(memory) tHeader(inUseList, blockSize);
     inUseList = memory;
+    currentPageEnd = blockSize;
     
     unsigned char* ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
     currentPageOffset = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
@@ -284,6 +357,43 @@ void* TPoolAllocator::allocate(size_t numBytes)
     return initializeAllocation(inUseList, ret, numBytes);
 }
 
+//
+// Allocations that do not fit in a page get a page of their own, rounded
+// up to a size class so that it can be re-used by later allocations of a
+// similar size.  The current page stays current, so that the space left
+// in it is not wasted.
+//
+void* TPoolAllocator::allocateLarge(size_t allocationSize)
+{
+    size_t numBytesToAlloc = allocationSize + headerSkip;
+    // Detect integer overflow.
+    if (numBytesToAlloc < allocationSize)
+        return 0;
+
+    size_t blockSize = pageSize;
+    for (int i = 1; i < numSizeClasses && blockSize < numBytesToAlloc; ++i)
+        blockSize <<= 1;
+    if (blockSize < numBytesToAlloc)
+        blockSize = numBytesToAlloc;
+
+    tHeader* memory = acquirePage(blockSize);
+    if (memory == 0)
+        return 0;
+
+    // Use placement-new to initialize header.  The page goes under the
+    // current page, where pop() still finds it: both were allocated since
+    // the last push().
+    if (currentPageEnd != 0) {
+        new(memory) tHeader(inUseList->nextPage, blockSize);
+        inUseList->nextPage = memory;
+    } else {
+        new(memory) tHeader(inUseList, blockSize);
+        inUseList = memory;
+    }
+
+    // No guard blocks for multi-page allocations (yet)
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(memory) + headerSkip);
+}
 
 //
 // Check all allocations in a list for damage by calling check on each.
@@ -105,9 +105,10 @@ private:
 // repositories of free pages or used pages.
 //
 // Page stacks are linked together with a simple header at the beginning
-// of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// of each allocation obtained from the underlying OS.  Pages freed by pop()
+// are kept, up to a limit, on free lists sorted by size and re-used for
+// later allocations, so that a pool that is pushed and popped repeatedly
+// settles on a working set and stops calling into the OS.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of 
@@ -152,13 +153,52 @@ public:
     // by calling pop(), and to not have to solve memory leak problems.
     //
 
+    //
+    // Size of the pages obtained from the OS from now on.  Pages kept
+    // for re-use are freed.
+    //
+    void setPageSize(size_t size);
+
+    //
+    // When a new page is needed for small allocations, it is made as large
+    // as the memory already in use, doubling up to maxBlockSize.  This cuts
+    // the number of OS allocations of large compiles.  The default,
+    // equal to the page size, keeps all pages the same size.
+    //
+    void setMaxBlockSize(size_t size);
+
+    //
+    // Pages freed by pop() are kept for re-use until they add up to
+    // maxRetainedBytes; the rest are returned to the OS.  The default keeps
+    // all of them.
+    //
+    void setMaxRetainedBytes(size_t size);
+
+    struct Statistics {
+        size_t allocations;       // calls to allocate() since construction
+        size_t bytesAllocated;    // bytes requested by those calls
+        size_t pagesInUse;        // pages holding live allocations
+        size_t bytesInUse;        // size of those pages
+        size_t peakBytesInUse;    // largest bytesInUse so far
+        size_t pagesRetained;     // freed pages kept for re-use
+        size_t bytesRetained;     // size of those pages
+        size_t osAllocations;     // pages obtained from the OS
+    };
+    const Statistics& getStatistics() const { return statistics; }
+
+    //
+    // While a log is set, the size of every allocation is appended to it,
+    // so that benchmarks can replay the allocations of a compile.
+    //
+    void setAllocationLog(std::vector<size_t>* log) { allocationLog = log; }
+
 protected:
     friend struct tHeader;
     
     struct tHeader {
-        tHeader(tHeader* nextPage, size_t pageCount) :
+        tHeader(tHeader* nextPage, size_t size) :
             nextPage(nextPage),
-            pageCount(pageCount)
+            size(size)
 #ifdef GUARD_BLOCKS
           , lastAllocation(0)
 #endif
@@ -172,7 +212,7 @@ protected:
         }
 
         tHeader* nextPage;
-        size_t pageCount;
+        size_t size;            // of the whole page, header included
 #ifdef GUARD_BLOCKS
         TAllocation* lastAllocation;
 #endif
@@ -180,10 +220,14 @@ protected:
 
     struct tAllocState {
         size_t offset;
+        size_t end;
         tHeader* page;
     };
     typedef std::vector<tAllocState> tAllocStack;
 
+    // Pages of pageSize << n bytes are kept on freeLists[n].
+    enum { numSizeClasses = 16 };
+
     // Track allocations if and only if we're using guard blocks
     void* initializeAllocation(tHeader* block, unsigned char* memory, size_t numBytes) {
 #ifdef GUARD_BLOCKS
@@ -194,6 +238,14 @@ protected:
         return TAllocation::offsetAllocation(memory);
     }
 
+    void* allocateLarge(size_t allocationSize);
+    // Returns the size class of a page of the given size, or -1 if the
+    // page is not kept on the free lists.
+    int sizeClass(size_t size) const;
+    tHeader* acquirePage(size_t size);
+    void releasePage(tHeader* page);
+    void trimFreeLists(size_t maxBytes);
+
     size_t pageSize;        // granularity of allocation from the OS
     size_t alignment;       // all returned allocations will be aligned at 
                             // this granularity, which will be a power of 2
@@ -202,12 +254,16 @@ protected:
                             //      header (basically, size of header, rounded
                             //      up to make it aligned
     size_t currentPageOffset;  // next offset in top of inUseList to allocate from
-    tHeader* freeList;      // list of popped memory
+    size_t currentPageEnd;  // size of the top of inUseList, or 0 if a new
+                            //      page is needed for the next allocation
+    size_t maxBlockSize;
+    size_t maxRetainedBytes;
+    tHeader* freeLists[numSizeClasses];  // popped pages, by size
     tHeader* inUseList;     // list of all memory currently being used
     tAllocStack stack;      // stack of where to allocate from, to partition pool
 
-    int numCalls;           // just an interesting statistic
-    size_t totalBytes;      // just an interesting statistic
+    Statistics statistics;
+    std::vector<size_t>* allocationLog;
 private:
     TPoolAllocator& operator=(const TPoolAllocator&);  // dont allow assignment operator
     TPoolAllocator(const TPoolAllocator&);  // dont allow default copy constructor
@@ -290,6 +346,11 @@ public:
     size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
     size_type max_size(int size) const { return static_cast<size_type>(-1) / size; }
 
+    // Copies of pooled containers allocate from the current global pool,
+    // not from the pool of the original. This lets compiles copy strings
+    // out of the shared built-in symbol table without touching its pool.
+    pool_allocator select_on_container_copy_construction() const { return pool_allocator(); }
+
     void setAllocator(TPoolAllocator* a) { allocator = a; }
     TPoolAllocator& getAllocator() const { return *allocator; }
 
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/Preprocess.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/SourceLocation.h"
+#include "compiler/preprocessor/Token.h"
+#include "compiler/translator/Diagnostics.h"
+#include "compiler/translator/length_limits.h"
+
+namespace
+{
+
+enum CharacterClass
+{
+    // Always a token of its own, so it never runs into its neighbours.
+    kSelfDelimiting,
+    // Part of an identifier or a number.
+    kWord,
+    // Part of an operator.
+    kOperator
+};
+
+CharacterClass GetCharacterClass(char c)
+{
+    switch (c)
+    {
+      case '(': case ')': case '[': case ']': case '{': case '}':
+      case ';': case ',': case '?': case ':': case '~':
+        return kSelfDelimiting;
+      case '_': case '.':
+        return kWord;
+      default:
+        return (isalnum(static_cast<unsigned char>(c)) ? kWord : kOperator);
+    }
+}
+
+// Receives the tokens from the loop in WriteCanonicalSource, and the
+// directives from the preprocessor while it lexes them, so that both are
+// written in source order. No token contains a newline, so a newline always
+// starts or ends a directive line.
+class CanonicalSourceWriter : public pp::DirectiveHandler
+{
+  public:
+    CanonicalSourceWriter(TDiagnostics &diagnostics, bool keepLines, std::string *output)
+        : mDiagnostics(diagnostics),
+          mKeepLines(keepLines),
+          mOutput(*output),
+          mLastClass(kSelfDelimiting),
+          mLastWasNumber(false),
+          mFile(0),
+          mLine(0)
+    {
+    }
+
+    void writeToken(const pp::Token &token)
+    {
+        if (mKeepLines && (token.location.file != mFile || token.location.line != mLine))
+        {
+            mFile = token.location.file;
+            mLine = token.location.line;
+            char line[48];
+            snprintf(line, sizeof(line), "#line %d %d", mLine, mFile);
+            writeLine(line, "", "", "", "");
+        }
+
+        const char *text = token.text.data();
+        size_t size = token.text.size();
+        if (size == 0)
+            return;
+        // A space goes between two identifiers or numbers, and between two
+        // operators, so that each run of characters of the same class is one
+        // token. A number followed by a sign gets one too, since a number
+        // ending in e or E, like 0xE, would take the sign if lexed again.
+        CharacterClass first = GetCharacterClass(text[0]);
+        if (first != kSelfDelimiting &&
+            (first == mLastClass || (mLastWasNumber && (text[0] == '+' || text[0] == '-'))))
+        {
+            mOutput += ' ';
+        }
+        mOutput.append(text, size);
+        mLastClass = GetCharacterClass(text[size - 1]);
+        mLastWasNumber = (token.type == pp::Token::CONST_INT ||
+                          token.type == pp::Token::CONST_FLOAT);
+    }
+
+    virtual void handleError(const pp::SourceLocation &loc, const std::string &msg)
+    {
+        mDiagnostics.writeInfo(pp::Diagnostics::PP_ERROR, loc, msg, "", "");
+    }
+
+    virtual void handlePragma(const pp::SourceLocation &loc,
+                              const std::string &name,
+                              const std::string &value,
+                              bool stdgl)
+    {
+        writeLine(stdgl ? "#pragma STDGL " : "#pragma ", name.c_str(), "(", value.c_str(), ")");
+    }
+
+    virtual void handleExtension(const pp::SourceLocation &loc,
+                                 const std::string &name,
+                                 const std::string &behavior)
+    {
+        writeLine("#extension ", name.c_str(), " : ", behavior.c_str(), "");
+    }
+
+    virtual void handleVersion(const pp::SourceLocation &loc, int version)
+    {
+        char line[32];
+        snprintf(line, sizeof(line), "#version %d", version);
+        writeLine(line, "", "", "", "");
+    }
+
+  private:
+    void writeLine(const char *a, const char *b, const char *c, const char *d, const char *e)
+    {
+        if (!mOutput.empty() && mOutput[mOutput.size() - 1] != '\n')
+            mOutput += '\n';
+        mOutput.append(a).append(b).append(c).append(d).append(e);
+        mOutput += '\n';
+        mLastClass = kSelfDelimiting;
+        mLastWasNumber = false;
+    }
+
+    TDiagnostics &mDiagnostics;
+    bool mKeepLines;
+    std::string &mOutput;
+    // The class of the last character written, and whether it ended a number.
+    CharacterClass mLastClass;
+    bool mLastWasNumber;
+    // The location of the last token, when locations are kept.
+    int mFile;
+    int mLine;
+};
+
+}  // namespace anonymous
+
+void InitializePreprocessor(pp::Preprocessor *preprocessor,
+                            const TExtensionBehavior &extensionBehavior,
+                            bool fragmentPrecisionHigh,
+                            ShShaderSpec spec)
+{
+    for (TExtensionBehavior::const_iterator iter = extensionBehavior.begin();
+         iter != extensionBehavior.end(); ++iter)
+    {
+        preprocessor->predefineMacro(iter->first.c_str(), 1);
+    }
+    if (fragmentPrecisionHigh)
+        preprocessor->predefineMacro("GL_FRAGMENT_PRECISION_HIGH", 1);
+
+    preprocessor->setMaxTokenSize(GetGlobalMaxTokenSize(spec));
+}
+
+bool WriteCanonicalSource(const char *const shaderStrings[],
+                          size_t numStrings,
+                          const TExtensionBehavior &extensionBehavior,
+                          bool fragmentPrecisionHigh,
+                          ShShaderSpec spec,
+                          bool keepLines,
+                          TDiagnostics &diagnostics,
+                          std::string *output)
+{
+    output->clear();
+
+    CanonicalSourceWriter writer(diagnostics, keepLines, output);
+    pp::Preprocessor preprocessor(&diagnostics, &writer);
+    if (!preprocessor.init(numStrings, shaderStrings, NULL))
+        return false;
+    InitializePreprocessor(&preprocessor, extensionBehavior, fragmentPrecisionHigh, spec);
+
+    // Comments and indentation make up a good part of most sources, so the
+    // output rarely needs more room than the source.
+    size_t sourceSize = 0;
+    for (size_t i = 0; i < numStrings; ++i)
+        sourceSize += strlen(shaderStrings[i]);
+    output->reserve(sourceSize);
+
+    pp::Token token;
+    for (preprocessor.lex(&token); token.type != pp::Token::LAST; preprocessor.lex(&token))
+        writer.writeToken(token);
+
+    return diagnostics.numErrors() == 0;
+}
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Preprocess.h: Sets up the preprocessor the way the translator runs it, and
+// runs it alone to write a canonical form of a shader's source.
+//
+
+#ifndef COMPILER_TRANSLATOR_PREPROCESS_H_
+#define COMPILER_TRANSLATOR_PREPROCESS_H_
+
+#include <string>
+
+#include "compiler/translator/ExtensionBehavior.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace pp
+{
+class Preprocessor;
+}
+class TDiagnostics;
+
+// Predefines a macro for each supported extension, and
+// GL_FRAGMENT_PRECISION_HIGH if fragment shaders support highp, and sets the
+// maximum token size of the spec.
+void InitializePreprocessor(pp::Preprocessor *preprocessor,
+                            const TExtensionBehavior &extensionBehavior,
+                            bool fragmentPrecisionHigh,
+                            ShShaderSpec spec);
+
+// Preprocesses the strings and writes the tokens that would reach the parser,
+// with the #version, #extension and #pragma directives in between where they
+// appear. Tokens are separated by a space only where the boundary between
+// them could be ambiguous, and directives take a line each, so sources that
+// differ only in comments, whitespace, inactive #if groups or macros that
+// expand to the same tokens give the same output. Unless keepLines is set,
+// token locations are left out. Returns false if preprocessing reported an
+// error.
+bool WriteCanonicalSource(const char *const shaderStrings[],
+                          size_t numStrings,
+                          const TExtensionBehavior &extensionBehavior,
+                          bool fragmentPrecisionHigh,
+                          ShShaderSpec spec,
+                          bool keepLines,
+                          TDiagnostics &diagnostics,
+                          std::string *output);
+
+#endif  // COMPILER_TRANSLATOR_PREPROCESS_H_
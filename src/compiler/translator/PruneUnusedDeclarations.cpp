@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/PruneUnusedDeclarations.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "compiler/translator/IntermNode.h"
+
+namespace
+{
+
+// Collects the functions, global variables and structs that a global
+// declaration refers to.
+class ReferenceCollector : public TIntermTraverser
+{
+  public:
+    ReferenceCollector()
+        : TIntermTraverser(true, false, false) {}
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        addType(node->getType());
+        if (node->getId() != 0)
+            mSymbols.push_back(node->getId());
+    }
+    virtual void visitConstantUnion(TIntermConstantUnion *node)
+    {
+        addType(node->getType());
+    }
+    virtual bool visitBinary(Visit, TIntermBinary *node)
+    {
+        addType(node->getType());
+        return true;
+    }
+    virtual bool visitUnary(Visit, TIntermUnary *node)
+    {
+        addType(node->getType());
+        return true;
+    }
+    virtual bool visitSelection(Visit, TIntermSelection *node)
+    {
+        addType(node->getType());
+        return true;
+    }
+    virtual bool visitAggregate(Visit, TIntermAggregate *node)
+    {
+        addType(node->getType());
+        if (node->getOp() == EOpFunctionCall)
+            mCalls.push_back(&node->getName());
+        return true;
+    }
+
+    std::vector<const TString *> mCalls;
+    std::vector<int> mSymbols;
+    std::vector<const TStructure *> mStructs;
+
+  private:
+    void addType(const TType &type)
+    {
+        if (type.getStruct())
+            mStructs.push_back(type.getStruct());
+    }
+};
+
+bool IsInterfaceQualifier(TQualifier qualifier)
+{
+    return qualifier != EvqTemporary && qualifier != EvqGlobal && qualifier != EvqConst;
+}
+
+TString UnmangledName(const TString &mangledName)
+{
+    return mangledName.substr(0, mangledName.find('('));
+}
+
+class Pruner
+{
+  public:
+    explicit Pruner(TIntermSequence *globals)
+        : mGlobals(globals),
+          mLive(globals->size(), false)
+    {
+    }
+
+    size_t prune();
+
+  private:
+    void addDeclaration(size_t index, TIntermAggregate *declaration);
+    void markLive(size_t index);
+    void markStructLive(const TStructure *structure);
+
+    TIntermSequence *mGlobals;
+    std::vector<bool> mLive;
+    std::vector<size_t> mWorklist;
+
+    // The global declaring each function, variable and struct. Structs are
+    // declared by the first global whose type is the struct, since that is
+    // where the output writes the definition.
+    std::map<TString, size_t> mFunctions;
+    std::map<int, size_t> mVariables;
+    std::map<const TStructure *, size_t> mStructs;
+    std::set<const TStructure *> mLiveStructs;
+};
+
+size_t Pruner::prune()
+{
+    bool hasMain = false;
+    for (size_t i = 0; i < mGlobals->size(); ++i)
+    {
+        TIntermAggregate *aggregate = (*mGlobals)[i]->getAsAggregate();
+        TOperator op = aggregate ? aggregate->getOp() : EOpNull;
+        if (op == EOpFunction)
+        {
+            mFunctions.insert(std::make_pair(aggregate->getName(), i));
+            if (aggregate->getName() == "main(")
+            {
+                hasMain = true;
+                mWorklist.push_back(i);
+            }
+        }
+        else if (op == EOpDeclaration)
+        {
+            addDeclaration(i, aggregate);
+        }
+        else if (op != EOpPrototype)
+        {
+            // Anything else, such as an invariant declaration, is kept.
+            mWorklist.push_back(i);
+        }
+    }
+    if (!hasMain)
+        return 0;
+
+    for (size_t i = 0; i < mWorklist.size(); ++i)
+        mLive[mWorklist[i]] = true;
+
+    while (!mWorklist.empty())
+    {
+        size_t index = mWorklist.back();
+        mWorklist.pop_back();
+
+        ReferenceCollector collector;
+        (*mGlobals)[index]->traverse(&collector);
+
+        for (size_t i = 0; i < collector.mCalls.size(); ++i)
+        {
+            std::map<TString, size_t>::const_iterator function =
+                mFunctions.find(*collector.mCalls[i]);
+            if (function != mFunctions.end())
+                markLive(function->second);
+        }
+        for (size_t i = 0; i < collector.mSymbols.size(); ++i)
+        {
+            std::map<int, size_t>::const_iterator variable =
+                mVariables.find(collector.mSymbols[i]);
+            if (variable != mVariables.end())
+                markLive(variable->second);
+        }
+        for (size_t i = 0; i < collector.mStructs.size(); ++i)
+            markStructLive(collector.mStructs[i]);
+    }
+
+    // Prototypes carry the unmangled name, so the prototypes of all the
+    // overloads of a live function are kept.
+    std::set<TString> liveFunctionNames;
+    for (std::map<TString, size_t>::const_iterator function = mFunctions.begin();
+         function != mFunctions.end(); ++function)
+    {
+        if (mLive[function->second])
+            liveFunctionNames.insert(UnmangledName(function->first));
+    }
+
+    TIntermSequence kept;
+    for (size_t i = 0; i < mGlobals->size(); ++i)
+    {
+        TIntermAggregate *aggregate = (*mGlobals)[i]->getAsAggregate();
+        if (aggregate && aggregate->getOp() == EOpPrototype &&
+            liveFunctionNames.count(aggregate->getName()) > 0)
+        {
+            mLive[i] = true;
+        }
+        if (mLive[i])
+            kept.push_back((*mGlobals)[i]);
+    }
+
+    size_t removed = mGlobals->size() - kept.size();
+    mGlobals->swap(kept);
+    return removed;
+}
+
+void Pruner::addDeclaration(size_t index, TIntermAggregate *declaration)
+{
+    TIntermSequence *declarators = declaration->getSequence();
+    if (declarators->empty())
+        return;
+
+    TIntermTyped *first = (*declarators)[0]->getAsTyped();
+    if (first && first->getType().getStruct())
+        mStructs.insert(std::make_pair(first->getType().getStruct(), index));
+
+    for (size_t i = 0; i < declarators->size(); ++i)
+    {
+        TIntermNode *declarator = (*declarators)[i];
+        TIntermSymbol *symbol = declarator->getAsSymbolNode();
+        if (symbol == NULL && declarator->getAsBinaryNode())
+            symbol = declarator->getAsBinaryNode()->getLeft()->getAsSymbolNode();
+        if (symbol == NULL || IsInterfaceQualifier(symbol->getQualifier()))
+        {
+            mWorklist.push_back(index);
+            return;
+        }
+        if (symbol->getId() != 0)
+            mVariables.insert(std::make_pair(symbol->getId(), index));
+    }
+}
+
+void Pruner::markLive(size_t index)
+{
+    if (!mLive[index])
+    {
+        mLive[index] = true;
+        mWorklist.push_back(index);
+    }
+}
+
+void Pruner::markStructLive(const TStructure *structure)
+{
+    if (!mLiveStructs.insert(structure).second)
+        return;
+
+    std::map<const TStructure *, size_t>::const_iterator declaration =
+        mStructs.find(structure);
+    if (declaration != mStructs.end())
+        markLive(declaration->second);
+
+    // The definition of a struct names the structs of its fields.
+    const TFieldList &fields = structure->fields();
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        if (fields[i]->type()->getStruct())
+            markStructLive(fields[i]->type()->getStruct());
+    }
+}
+
+}  // namespace
+
+size_t PruneUnusedDeclarations(TIntermNode *root)
+{
+    TIntermAggregate *globals = root->getAsAggregate();
+    if (globals == NULL || globals->getOp() != EOpSequence)
+        return 0;
+
+    Pruner pruner(globals->getSequence());
+    return pruner.prune();
+}
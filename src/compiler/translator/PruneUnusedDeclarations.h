@@ -0,0 +1,23 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PruneUnusedDeclarations removes the global declarations that main()
+// never reaches: functions and their prototypes, struct declarations and
+// the globals that aren't part of the shader interface. Uniforms, inputs,
+// outputs and invariant declarations are always kept.
+//
+
+#ifndef COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
+#define COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
+
+#include <stddef.h>
+
+class TIntermNode;
+
+// Returns the number of global declarations that were removed. The tree is
+// left as it is if it has no main().
+size_t PruneUnusedDeclarations(TIntermNode *root);
+
+#endif  // COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
@@ -14,10 +14,18 @@
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeDll.h"
 #include "compiler/translator/length_limits.h"
+#include "compiler/translator/TranslationCache.h"
 #include "compiler/translator/TranslatorHLSL.h"
 #include "compiler/translator/VariablePacker.h"
 #include "angle_gl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <string.h>
+
 namespace
 {
 
@@ -31,6 +39,12 @@ enum ShaderVariableType
 };
     
 bool isInitialized = false;
+// Guards isInitialized, so that ShInitialize and ShFinalize may be called
+// from any thread.
+std::mutex initializationMutex;
+
+// Disabled until ShSetTranslationCacheSize is called.
+TranslationCache translationCache;
 
 //
 // This is the platform independent interface between an OGL driver
@@ -100,6 +114,166 @@ TranslatorHLSL *GetTranslatorHLSLFromHandle(ShHandle handle)
     return base->getAsTranslatorHLSL();
 }
 
+// The jobs of a batch that use the same handle, in array order. A handle
+// must not be used by two threads at once, so each group runs on a single
+// worker.
+struct JobGroup
+{
+    JobGroup() : sourceSize(0) {}
+
+    std::vector<size_t> jobs;
+    // The size of the sources, so that the longest groups start first.
+    size_t sourceSize;
+};
+
+bool IsLargerGroup(const JobGroup *a, const JobGroup *b)
+{
+    return a->sourceSize > b->sourceSize;
+}
+
+void CompileJobGroups(ShCompileJob *jobs,
+                      const std::vector<const JobGroup *> *groups,
+                      std::atomic<size_t> *nextGroup)
+{
+    for (size_t groupIndex = (*nextGroup)++; groupIndex < groups->size();
+         groupIndex = (*nextGroup)++)
+    {
+        const std::vector<size_t> &groupJobs = (*groups)[groupIndex]->jobs;
+        for (size_t i = 0; i < groupJobs.size(); ++i)
+        {
+            ShCompileJob &job = jobs[groupJobs[i]];
+            job.success = ShCompile(job.handle, job.shaderStrings, job.numStrings,
+                                    job.compileOptions);
+        }
+    }
+}
+
+const sh::Varying *FindVarying(const std::vector<sh::Varying> &varyings,
+                               const std::string &name)
+{
+    for (size_t i = 0; i < varyings.size(); ++i)
+    {
+        if (varyings[i].name == name)
+            return &varyings[i];
+    }
+    return NULL;
+}
+
+// Checks that the varyings of a program match and pack, following the
+// GLSL ES 1.00 spec, section 4.3.5 and Appendix A, section 7.
+void CheckProgram(const ShCompileJob *jobs, size_t numJobs, ShProgramJob *program)
+{
+    program->success = false;
+    program->infoLog.clear();
+
+    if (program->vertexJob >= numJobs || program->fragmentJob >= numJobs)
+    {
+        program->infoLog = "ERROR: program refers to a job outside the batch\n";
+        return;
+    }
+    const ShCompileJob &vertexJob = jobs[program->vertexJob];
+    const ShCompileJob &fragmentJob = jobs[program->fragmentJob];
+    const TCompiler *vertexCompiler = GetCompilerFromHandle(vertexJob.handle);
+    const TCompiler *fragmentCompiler = GetCompilerFromHandle(fragmentJob.handle);
+    if (!vertexCompiler || vertexCompiler->getShaderType() != GL_VERTEX_SHADER ||
+        !fragmentCompiler || fragmentCompiler->getShaderType() != GL_FRAGMENT_SHADER)
+    {
+        program->infoLog = "ERROR: program needs a vertex and a fragment shader\n";
+        return;
+    }
+    if (!vertexJob.success || !fragmentJob.success)
+    {
+        program->infoLog = "ERROR: program has a shader that failed to compile\n";
+        return;
+    }
+    if (!(vertexJob.compileOptions & SH_VARIABLES) ||
+        !(fragmentJob.compileOptions & SH_VARIABLES))
+    {
+        program->infoLog = "ERROR: program shaders must be compiled with SH_VARIABLES\n";
+        return;
+    }
+
+    bool success = true;
+    const std::vector<sh::Varying> &vertexVaryings = vertexCompiler->getVaryings();
+    const std::vector<sh::Varying> &fragmentVaryings = fragmentCompiler->getVaryings();
+    std::vector<sh::Varying> usedVaryings;
+    for (size_t i = 0; i < fragmentVaryings.size(); ++i)
+    {
+        const sh::Varying &varying = fragmentVaryings[i];
+        if (varying.name.compare(0, 3, "gl_") == 0)
+            continue;
+
+        const sh::Varying *vertexVarying = FindVarying(vertexVaryings, varying.name);
+        if (!vertexVarying)
+        {
+            if (varying.staticUse)
+            {
+                program->infoLog += "ERROR: varying '" + varying.name +
+                                    "' is not declared in the vertex shader\n";
+                success = false;
+            }
+        }
+        else if (!vertexVarying->isSameVaryingAtLinkTime(varying))
+        {
+            program->infoLog += "ERROR: varying '" + varying.name +
+                                "' does not match between the vertex and fragment shaders\n";
+            success = false;
+        }
+        else if (varying.staticUse)
+        {
+            usedVaryings.push_back(varying);
+        }
+    }
+
+    if (success && program->maxVaryingVectors > 0)
+    {
+        std::vector<sh::ShaderVariable> expandedVaryings;
+        sh::ExpandVaryings(usedVaryings, &expandedVaryings);
+        VariablePacker packer;
+        if (!packer.CheckVariablesWithinPackingLimits(program->maxVaryingVectors,
+                                                      expandedVaryings))
+        {
+            program->infoLog += "ERROR: varyings do not pack in the available vectors\n";
+            success = false;
+        }
+    }
+    program->success = success;
+}
+
+// Everything that determines the results of ShCompile on the given handle.
+std::string TranslationCacheKey(const TCompiler *compiler,
+                                const char *const shaderStrings[],
+                                size_t numStrings,
+                                int compileOptions)
+{
+    // The resources string leaves out the members that are not needed to
+    // build the symbol table.
+    const ShBuiltInResources &resources = compiler->getResources();
+
+    std::ostringstream header;
+    header << ":Type:" << compiler->getShaderType()
+           << ":Spec:" << compiler->getShaderSpec()
+           << ":Output:" << compiler->getOutputType()
+           << ":CompileOptions:" << compileOptions
+           << ":HashFunction:" << reinterpret_cast<size_t>(resources.HashFunction)
+           << ":ArrayIndexClampingStrategy:" << resources.ArrayIndexClampingStrategy
+           << compiler->getBuiltInResourcesString()
+           << ":NumStrings:" << numStrings;
+
+    std::string key = header.str();
+    for (size_t ii = 0; ii < numStrings; ++ii)
+    {
+        // String boundaries show in the info log, so the lengths are part
+        // of the key too.
+        size_t length = strlen(shaderStrings[ii]);
+        std::ostringstream lengthString;
+        lengthString << ":" << length << ":";
+        key += lengthString.str();
+        key.append(shaderStrings[ii], length);
+    }
+    return key;
+}
+
 }  // namespace anonymous
 
 //
@@ -108,6 +282,7 @@ TranslatorHLSL *GetTranslatorHLSLFromHandle(ShHandle handle)
 //
 bool ShInitialize()
 {
+    std::lock_guard<std::mutex> lock(initializationMutex);
     if (!isInitialized)
     {
         isInitialized = InitProcess();
@@ -120,6 +295,7 @@ bool ShInitialize()
 //
 bool ShFinalize()
 {
+    std::lock_guard<std::mutex> lock(initializationMutex);
     if (isInitialized)
     {
         DetachProcess();
@@ -172,6 +348,7 @@ void ShInitBuiltInResources(ShBuiltInResources* resources)
 
     resources->MaxExpressionComplexity = 256;
     resources->MaxCallStackDepth = 256;
+    resources->MaxUnrolledLoopSize = 0;
 }
 
 //
@@ -229,7 +406,95 @@ bool ShCompile(
     TCompiler *compiler = GetCompilerFromHandle(handle);
     ASSERT(compiler);
 
-    return compiler->compile(shaderStrings, numStrings, compileOptions);
+    if (!translationCache.isEnabled())
+    {
+        return compiler->compile(shaderStrings, numStrings, compileOptions);
+    }
+
+    const std::string key = TranslationCacheKey(compiler, shaderStrings, numStrings,
+                                                compileOptions);
+    // A hash function pointer means nothing to another process, so such
+    // results stay out of the backing store.
+    const bool persistent = (compiler->getHashFunction() == NULL);
+
+    TCompileResults results;
+    if (translationCache.lookup(key, persistent, &results))
+    {
+        compiler->setResults(results);
+        return results.success;
+    }
+
+    results.success = compiler->compile(shaderStrings, numStrings, compileOptions);
+    compiler->getResults(&results);
+    translationCache.insert(key, persistent, results);
+    return results.success;
+}
+
+bool ShPreprocess(const ShHandle handle,
+                  const char *const shaderStrings[],
+                  size_t numStrings,
+                  int compileOptions,
+                  std::string *output)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    ASSERT(output);
+
+    return compiler->preprocess(shaderStrings, numStrings, compileOptions, output);
+}
+
+bool ShCompileBatch(ShCompileJob *jobs,
+                    size_t numJobs,
+                    ShProgramJob *programs,
+                    size_t numPrograms,
+                    unsigned int numWorkers)
+{
+    ASSERT(jobs || numJobs == 0);
+    ASSERT(programs || numPrograms == 0);
+
+    std::vector<JobGroup> groups;
+    std::map<ShHandle, size_t> groupIndices;
+    for (size_t i = 0; i < numJobs; ++i)
+    {
+        std::pair<std::map<ShHandle, size_t>::iterator, bool> inserted =
+            groupIndices.insert(std::make_pair(jobs[i].handle, groups.size()));
+        if (inserted.second)
+            groups.push_back(JobGroup());
+
+        JobGroup &group = groups[inserted.first->second];
+        group.jobs.push_back(i);
+        for (size_t s = 0; s < jobs[i].numStrings; ++s)
+            group.sourceSize += strlen(jobs[i].shaderStrings[s]);
+    }
+
+    std::vector<const JobGroup *> order;
+    for (size_t i = 0; i < groups.size(); ++i)
+        order.push_back(&groups[i]);
+    std::stable_sort(order.begin(), order.end(), IsLargerGroup);
+
+    // The calling thread is one of the workers.
+    std::atomic<size_t> nextGroup(0);
+    size_t numThreads = std::min<size_t>(std::max(numWorkers, 1u), order.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numThreads; ++i)
+        workers.push_back(std::thread(CompileJobGroups, jobs, &order, &nextGroup));
+    CompileJobGroups(jobs, &order, &nextGroup);
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+
+    bool success = true;
+    for (size_t i = 0; i < numJobs; ++i)
+    {
+        if (!jobs[i].success)
+            success = false;
+    }
+    for (size_t i = 0; i < numPrograms; ++i)
+    {
+        CheckProgram(jobs, numJobs, &programs[i]);
+        if (!programs[i].success)
+            success = false;
+    }
+    return success;
 }
 
 int ShGetShaderVersion(const ShHandle handle)
@@ -270,6 +535,16 @@ const std::string &ShGetObjectCode(const ShHandle handle)
     return infoSink.obj.str();
 }
 
+void ShTakeObjectCode(const ShHandle handle, std::string *objectCode)
+{
+    ASSERT(objectCode);
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+
+    TInfoSink &infoSink = compiler->getInfoSink();
+    infoSink.obj.take(objectCode);
+}
+
 const std::map<std::string, std::string> *ShGetNameHashingMap(
     const ShHandle handle)
 {
@@ -310,6 +585,7 @@ bool ShCheckVariablesWithinPackingLimits(
         return true;
     ASSERT(varInfoArray);
     std::vector<sh::ShaderVariable> variables;
+    variables.reserve(varInfoArraySize);
     for (size_t ii = 0; ii < varInfoArraySize; ++ii)
     {
         sh::ShaderVariable var(varInfoArray[ii].type, varInfoArray[ii].size);
@@ -319,6 +595,34 @@ bool ShCheckVariablesWithinPackingLimits(
     return packer.CheckVariablesWithinPackingLimits(maxVectors, variables);
 }
 
+bool ShPackVariables(int maxVectors,
+                     ShVariableInfo *varInfoArray,
+                     size_t varInfoArraySize,
+                     ShVariablePlacement *placements)
+{
+    if (varInfoArraySize == 0)
+        return true;
+    ASSERT(varInfoArray);
+    ASSERT(placements);
+    std::vector<sh::ShaderVariable> variables;
+    variables.reserve(varInfoArraySize);
+    for (size_t ii = 0; ii < varInfoArraySize; ++ii)
+    {
+        sh::ShaderVariable var(varInfoArray[ii].type, varInfoArray[ii].size);
+        variables.push_back(var);
+    }
+    VariablePacker packer;
+    std::vector<VariablePacker::Placement> packed;
+    if (!packer.PackVariables(maxVectors, variables, &packed))
+        return false;
+    for (size_t ii = 0; ii < varInfoArraySize; ++ii)
+    {
+        placements[ii].row = packed[ii].row;
+        placements[ii].column = packed[ii].column;
+    }
+    return true;
+}
+
 bool ShGetInterfaceBlockRegister(const ShHandle handle,
                                  const std::string &interfaceBlockName,
                                  unsigned int *indexOut)
@@ -353,3 +657,67 @@ bool ShGetUniformRegister(const ShHandle handle,
     *indexOut = translator->getUniformRegister(uniformName);
     return true;
 }
+
+void ShSetTranslationCacheSize(size_t maxSize)
+{
+    translationCache.setMaxSize(maxSize);
+}
+
+void ShSetTranslationCacheBackingStore(ShTranslationCacheGetFunction getFunction,
+                                       ShTranslationCachePutFunction putFunction,
+                                       void *userData)
+{
+    translationCache.setBackingStore(getFunction, putFunction, userData);
+}
+
+void ShClearTranslationCache()
+{
+    translationCache.clear();
+}
+
+void ShGetTranslationCacheStatistics(ShTranslationCacheStatistics *statistics)
+{
+    translationCache.getStatistics(statistics);
+}
+
+void ShInitPoolAllocatorOptions(ShPoolAllocatorOptions *options)
+{
+    ASSERT(options);
+    options->pageSize = 8 * 1024;
+    options->maxPageSize = options->pageSize;
+    options->maxRetainedBytes = ~static_cast<size_t>(0);
+}
+
+void ShSetPoolAllocatorOptions(const ShHandle handle, const ShPoolAllocatorOptions *options)
+{
+    ASSERT(handle && options);
+    TPoolAllocator &allocator = static_cast<TShHandleBase *>(handle)->getAllocator();
+    allocator.setPageSize(options->pageSize);
+    allocator.setMaxBlockSize(options->maxPageSize);
+    allocator.setMaxRetainedBytes(options->maxRetainedBytes);
+}
+
+void ShGetPoolAllocatorStatistics(const ShHandle handle, ShPoolAllocatorStatistics *statistics)
+{
+    ASSERT(handle && statistics);
+    const TPoolAllocator::Statistics &poolStatistics =
+        static_cast<TShHandleBase *>(handle)->getAllocator().getStatistics();
+    statistics->allocations = poolStatistics.allocations;
+    statistics->bytesAllocated = poolStatistics.bytesAllocated;
+    statistics->pagesInUse = poolStatistics.pagesInUse;
+    statistics->bytesInUse = poolStatistics.bytesInUse;
+    statistics->peakBytesInUse = poolStatistics.peakBytesInUse;
+    statistics->pagesRetained = poolStatistics.pagesRetained;
+    statistics->bytesRetained = poolStatistics.bytesRetained;
+    statistics->osAllocations = poolStatistics.osAllocations;
+}
+
+bool ShGetCompileStatistics(const ShHandle handle, ShCompileStatistics *statistics)
+{
+    ASSERT(statistics);
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    if (!compiler || !compiler->getStatistics())
+        return false;
+    *statistics = *compiler->getStatistics();
+    return true;
+}
@@ -162,10 +162,14 @@ TString StructureHLSL::define(const TStructure &structure, bool useHLSLRowMajorP
     const bool isNameless = (structure.name() == "");
     const TString &structName = QualifiedStructNameString(structure, useHLSLRowMajorPacking,
                                                           useStd140Packing);
-    const TString declareString = (isNameless ? "struct" : "struct " + structName);
 
-    TString string;
-    string += declareString + "\n"
+    TString string = "struct";
+    if (!isNameless)
+    {
+        string += " ";
+        string += structName;
+    }
+    string += "\n"
               "{\n";
 
     for (unsigned int i = 0; i < fields.size(); i++)
@@ -183,7 +187,12 @@ TString StructureHLSL::define(const TStructure &structure, bool useHLSLRowMajorP
             string += padHelper->prePaddingString(fieldType);
         }
 
-        string += "    " + fieldTypeString + " " + DecorateField(field.name(), structure) + ArrayString(fieldType) + ";\n";
+        string += "    ";
+        string += fieldTypeString;
+        string += " ";
+        string += DecorateField(field.name(), structure);
+        string += ArrayString(fieldType);
+        string += ";\n";
 
         if (padHelper)
         {
@@ -214,7 +223,7 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
     ctorType.setPrecision(EbpHigh);
     ctorType.setQualifier(EvqTemporary);
 
-    typedef std::vector<TType> ParameterArray;
+    typedef std::vector<const TType*> ParameterArray;
     ParameterArray ctorParameters;
 
     const TStructure* structure = type.getStruct();
@@ -249,14 +258,14 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
         const TFieldList &fields = structure->fields();
         for (unsigned int i = 0; i < fields.size(); i++)
         {
-            ctorParameters.push_back(*fields[i]->type());
+            ctorParameters.push_back(fields[i]->type());
         }
     }
     else if (parameters)
     {
         for (TIntermSequence::const_iterator parameter = parameters->begin(); parameter != parameters->end(); parameter++)
         {
-            ctorParameters.push_back((*parameter)->getAsTyped()->getType());
+            ctorParameters.push_back(&(*parameter)->getAsTyped()->getType());
         }
     }
     else UNREACHABLE();
@@ -265,18 +274,27 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
 
     if (ctorType.getStruct())
     {
-        constructor += name + " " + name + "_ctor(";
+        constructor += name;
+        constructor += " ";
+        constructor += name;
+        constructor += "_ctor(";
     }
     else   // Built-in type
     {
-        constructor += TypeString(ctorType) + " " + name + "(";
+        constructor += TypeString(ctorType);
+        constructor += " ";
+        constructor += name;
+        constructor += "(";
     }
 
     for (unsigned int parameter = 0; parameter < ctorParameters.size(); parameter++)
     {
-        const TType &type = ctorParameters[parameter];
+        const TType &type = *ctorParameters[parameter];
 
-        constructor += TypeString(type) + " x" + str(parameter) + ArrayString(type);
+        constructor += TypeString(type);
+        constructor += " x";
+        constructor += str(parameter);
+        constructor += ArrayString(type);
 
         if (parameter < ctorParameters.size() - 1)
         {
@@ -284,23 +302,37 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
         }
     }
 
-    constructor += ")\n"
-                   "{\n";
+    constructor += ")\n";
+
+    // The signature determines the rest of the constructor, so there is
+    // no need to write out the body of one that was already added.
+    std::pair<Constructors::iterator, bool> inserted =
+        mConstructors.insert(std::make_pair(constructor, TString()));
+    if (!inserted.second)
+    {
+        return;
+    }
+
+    constructor += "{\n";
 
     if (ctorType.getStruct())
     {
-        constructor += "    " + name + " structure = {";
+        constructor += "    ";
+        constructor += name;
+        constructor += " structure = {";
     }
     else
     {
-        constructor += "    return " + TypeString(ctorType) + "(";
+        constructor += "    return ";
+        constructor += TypeString(ctorType);
+        constructor += "(";
     }
 
     if (ctorType.isMatrix() && ctorParameters.size() == 1)
     {
         int rows = ctorType.getRows();
         int cols = ctorType.getCols();
-        const TType &parameter = ctorParameters[0];
+        const TType &parameter = *ctorParameters[0];
 
         if (parameter.isScalar())
         {
@@ -308,7 +340,7 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
             {
                 for (int row = 0; row < rows; row++)
                 {
-                    constructor += TString((row == col) ? "x0" : "0.0");
+                    constructor += (row == col) ? "x0" : "0.0";
 
                     if (row < rows - 1 || col < cols - 1)
                     {
@@ -325,11 +357,15 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
                 {
                     if (row < parameter.getRows() && col < parameter.getCols())
                     {
-                        constructor += TString("x0") + "[" + str(col) + "][" + str(row) + "]";
+                        constructor += "x0[";
+                        constructor += str(col);
+                        constructor += "][";
+                        constructor += str(row);
+                        constructor += "]";
                     }
                     else
                     {
-                        constructor += TString((row == col) ? "1.0" : "0.0");
+                        constructor += (row == col) ? "1.0" : "0.0";
                     }
 
                     if (row < rows - 1 || col < cols - 1)
@@ -353,11 +389,12 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
 
         while (remainingComponents > 0)
         {
-            const TType &parameter = ctorParameters[parameterIndex];
+            const TType &parameter = *ctorParameters[parameterIndex];
             const size_t parameterSize = parameter.getObjectSize();
             bool moreParameters = parameterIndex + 1 < ctorParameters.size();
 
-            constructor += "x" + str(parameterIndex);
+            constructor += "x";
+            constructor += str(parameterIndex);
 
             if (ctorType.getStruct())
             {
@@ -397,7 +434,9 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
                 int column = 0;
                 while (remainingComponents > 0 && column < parameter.getCols())
                 {
-                    constructor += "[" + str(column) + "]";
+                    constructor += "[";
+                    constructor += str(column);
+                    constructor += "]";
 
                     if (remainingComponents < static_cast<size_t>(parameter.getRows()))
                     {
@@ -417,7 +456,8 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
 
                         if (remainingComponents > 0)
                         {
-                            constructor += ", x" + str(parameterIndex);
+                            constructor += ", x";
+                            constructor += str(parameterIndex);
                         }
                     }
 
@@ -450,13 +490,11 @@ void StructureHLSL::addConstructor(const TType &type, const TString &name, const
                        "}\n";
     }
 
-    mConstructors.insert(constructor);
+    inserted.first->second.swap(constructor);
 }
 
-std::string StructureHLSL::structsHeader() const
+void StructureHLSL::structsHeader(TInfoSinkBase &out) const
 {
-    TInfoSinkBase out;
-
     for (size_t structIndex = 0; structIndex < mStructDeclarations.size(); structIndex++)
     {
         out << mStructDeclarations[structIndex];
@@ -466,10 +504,8 @@ std::string StructureHLSL::structsHeader() const
          constructor != mConstructors.end();
          constructor++)
     {
-        out << *constructor;
+        out << constructor->second;
     }
-
-    return out.str();
 }
 
 void StructureHLSL::storeStd140ElementIndex(const TStructure &structure, bool useHLSLRowMajorPacking)
@@ -48,7 +48,7 @@ class StructureHLSL
     StructureHLSL();
 
     void addConstructor(const TType &type, const TString &name, const TIntermSequence *parameters);
-    std::string structsHeader() const;
+    void structsHeader(TInfoSinkBase &out) const;
 
     TString defineQualified(const TStructure &structure, bool useHLSLRowMajorPacking, bool useStd140Packing);
     static TString defineNameless(const TStructure &structure);
@@ -63,7 +63,9 @@ class StructureHLSL
     typedef std::set<TString> StructNames;
     StructNames mStructNames;
 
-    typedef std::set<TString> Constructors;
+    // The constructors by their signature line, so that they are written
+    // out in the order of their text.
+    typedef std::map<TString, TString> Constructors;
     Constructors mConstructors;
 
     typedef std::vector<TString> StructDeclarations;
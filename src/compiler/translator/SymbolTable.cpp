@@ -18,8 +18,6 @@
 #include <stdio.h>
 #include <algorithm>
 
-int TSymbolTable::uniqueIdCounter = 0;
-
 //
 // Functions have buried pointers to delete.
 //
@@ -29,32 +27,153 @@ TFunction::~TFunction()
         delete (*i).type;
 }
 
+void TAtomTable::setParent(const TAtomTable *parent)
+{
+    assert(mEntries.empty());
+    mParent = parent;
+    mBase = parent->size();
+}
+
+size_t TAtomTable::Hash(const TString &name)
+{
+    // FNV-1a
+    size_t hash = static_cast<size_t>(2166136261u);
+    for (TString::const_iterator it = name.begin(); it != name.end(); ++it)
+    {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int TAtomTable::find(const TString &name, size_t hash) const
+{
+    if (mParent)
+    {
+        int atom = mParent->find(name, hash);
+        if (atom >= 0)
+            return atom;
+    }
+
+    if (mSlots.empty())
+        return -1;
+
+    size_t mask = mSlots.size() - 1;
+    for (size_t i = hash & mask; mSlots[i] != 0; i = (i + 1) & mask)
+    {
+        const Entry &entry = mEntries[mSlots[i] - 1];
+        if (entry.hash == hash && *entry.name == name)
+            return static_cast<int>(mBase + mSlots[i] - 1);
+    }
+    return -1;
+}
+
+int TAtomTable::intern(const TString &name)
+{
+    size_t hash = Hash(name);
+    int atom = find(name, hash);
+    if (atom >= 0)
+        return atom;
+
+    // Keep the load factor below 3/4.
+    if ((mEntries.size() + 1) * 4 > mSlots.size() * 3)
+    {
+        mSlots.assign(mSlots.empty() ? 64 : mSlots.size() * 2, 0);
+        for (size_t i = 0; i < mEntries.size(); ++i)
+            insertSlot(i);
+    }
+
+    Entry entry = { hash, NewPoolTString(name.c_str()) };
+    mEntries.push_back(entry);
+    insertSlot(mEntries.size() - 1);
+    return static_cast<int>(mBase + mEntries.size() - 1);
+}
+
+void TAtomTable::insertSlot(size_t index)
+{
+    size_t mask = mSlots.size() - 1;
+    size_t i = mEntries[index].hash & mask;
+    while (mSlots[i] != 0)
+        i = (i + 1) & mask;
+    mSlots[i] = static_cast<unsigned int>(index + 1);
+}
+
+void TAtomTable::truncate(size_t size)
+{
+    assert(size >= mBase);
+    size_t count = size - mBase;
+    if (count >= mEntries.size())
+        return;
+
+    mEntries.resize(count);
+    std::fill(mSlots.begin(), mSlots.end(), 0u);
+    for (size_t i = 0; i < count; ++i)
+        insertSlot(i);
+}
+
 //
-// Symbol table levels are a map of pointers to symbols that have to be deleted.
+// Symbol table levels hold pointers to symbols that have to be deleted.
 //
 TSymbolTableLevel::~TSymbolTableLevel()
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
-        delete (*it).second;
+    for (TVector<Slot>::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
+        delete it->symbol;
 }
 
 bool TSymbolTableLevel::insert(TSymbol *symbol)
 {
-    symbol->setUniqueId(TSymbolTable::nextUniqueId());
+    symbol->setUniqueId(mTable->nextUniqueId());
+    int atom = mTable->internAtom(symbol->getMangledName());
 
     // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(symbol->getMangledName(), symbol));
+    if (find(atom))
+        return false;
+
+    if ((mCount + 1) * 4 > mSlots.size() * 3)
+        grow();
 
-    return result.second;
+    size_t mask = mSlots.size() - 1;
+    size_t i = atom & mask;
+    while (mSlots[i].symbol)
+        i = (i + 1) & mask;
+    mSlots[i].atom = atom;
+    mSlots[i].symbol = symbol;
+    ++mCount;
+    return true;
 }
 
-TSymbol *TSymbolTableLevel::find(const TString &name) const
+TSymbol *TSymbolTableLevel::find(int atom) const
 {
-    tLevel::const_iterator it = level.find(name);
-    if (it == level.end())
+    if (mSlots.empty())
         return 0;
-    else
-        return (*it).second;
+
+    // Atoms are dense, so they are used as their own hash.
+    size_t mask = mSlots.size() - 1;
+    for (size_t i = atom & mask; mSlots[i].symbol; i = (i + 1) & mask)
+    {
+        if (mSlots[i].atom == atom)
+            return mSlots[i].symbol;
+    }
+    return 0;
+}
+
+void TSymbolTableLevel::grow()
+{
+    TVector<Slot> slots;
+    Slot empty = { -1, 0 };
+    slots.swap(mSlots);
+    mSlots.assign(slots.empty() ? 8 : slots.size() * 2, empty);
+
+    size_t mask = mSlots.size() - 1;
+    for (TVector<Slot>::iterator it = slots.begin(); it != slots.end(); ++it)
+    {
+        if (!it->symbol)
+            continue;
+        size_t i = it->atom & mask;
+        while (mSlots[i].symbol)
+            i = (i + 1) & mask;
+        mSlots[i] = *it;
+    }
 }
 
 //
@@ -65,11 +184,11 @@ TSymbol *TSymbolTableLevel::find(const TString &name) const
 //
 void TSymbolTableLevel::relateToOperator(const char *name, TOperator op)
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
+    for (TVector<Slot>::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
     {
-        if ((*it).second->isFunction())
+        if (it->symbol && it->symbol->isFunction())
         {
-            TFunction *function = static_cast<TFunction*>((*it).second);
+            TFunction *function = static_cast<TFunction*>(it->symbol);
             if (function->getName() == name)
                 function->relateToOperator(op);
         }
@@ -84,14 +203,41 @@ void TSymbolTableLevel::relateToOperator(const char *name, TOperator op)
 //
 void TSymbolTableLevel::relateToExtension(const char *name, const TString &ext)
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
+    for (TVector<Slot>::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
     {
-        TSymbol *symbol = it->second;
-        if (symbol->getName() == name)
+        TSymbol *symbol = it->symbol;
+        if (symbol && symbol->getName() == name)
             symbol->relateToExtension(ext);
     }
 }
 
+void TSymbolTableLevel::computeCachedData()
+{
+    for (TVector<Slot>::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
+    {
+        TSymbol *symbol = it->symbol;
+        if (!symbol)
+            continue;
+        if (symbol->isFunction())
+        {
+            TFunction *function = static_cast<TFunction*>(symbol);
+            function->computeCachedData();
+        }
+        else if (symbol->isVariable())
+        {
+            TVariable *variable = static_cast<TVariable*>(symbol);
+            variable->getType().computeCachedData();
+        }
+    }
+}
+
+void TFunction::computeCachedData()
+{
+    returnType.computeCachedData();
+    for (TParamList::iterator i = parameters.begin(); i != parameters.end(); ++i)
+        (*i).type->computeCachedData();
+}
+
 TSymbol::TSymbol(const TSymbol &copyOf)
 {
     name = NewPoolTString(copyOf.name->c_str());
@@ -101,19 +247,29 @@ TSymbol::TSymbol(const TSymbol &copyOf)
 TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
                             bool *builtIn, bool *sameScope) const
 {
+    if (mLog)
+        log(TSymbolTableOperation::Find, shaderVersion, name.c_str());
+
     int level = currentLevel();
-    TSymbol *symbol;
+    TSymbol *symbol = 0;
+
+    // A name without an atom was never declared.
+    int atom = mAtoms.find(name);
+    if (atom < 0)
+        level = -1;
 
-    do
+    while (level >= 0)
     {
         if (level == ESSL3_BUILTINS && shaderVersion != 300)
             level--;
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        symbol = table[level]->find(name);
+        symbol = table[level]->find(atom);
+        if (symbol)
+            break;
+        --level;
     }
-    while (symbol == 0 && --level >= 0);
 
     if (builtIn)
         *builtIn = (level <= LAST_BUILTIN_LEVEL);
@@ -126,6 +282,13 @@ TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
 TSymbol *TSymbolTable::findBuiltIn(
     const TString &name, int shaderVersion) const
 {
+    if (mLog)
+        log(TSymbolTableOperation::FindBuiltIn, shaderVersion, name.c_str());
+
+    int atom = mAtoms.find(name);
+    if (atom < 0)
+        return 0;
+
     for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
     {
         if (level == ESSL3_BUILTINS && shaderVersion != 300)
@@ -133,7 +296,7 @@ TSymbol *TSymbolTable::findBuiltIn(
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        TSymbol *symbol = table[level]->find(name);
+        TSymbol *symbol = table[level]->find(atom);
 
         if (symbol)
             return symbol;
@@ -142,12 +305,41 @@ TSymbol *TSymbolTable::findBuiltIn(
     return 0;
 }
 
+void TSymbolTable::log(TSymbolTableOperation::Kind kind, int argument, const char *name) const
+{
+    TSymbolTableOperation operation;
+    operation.kind = kind;
+    operation.argument = argument;
+    operation.name = name;
+    mLog->push_back(operation);
+}
+
 TSymbolTable::~TSymbolTable()
 {
     while (table.size() > 0)
         pop();
 }
 
+void TSymbolTable::shareBuiltInLevels(const TSymbolTable &builtIns)
+{
+    assert(isEmpty());
+    assert(builtIns.currentLevel() == LAST_BUILTIN_LEVEL);
+
+    table = builtIns.table;
+    precisionStack = builtIns.precisionStack;
+    mSharedLevelCount = table.size();
+    mAtoms.setParent(&builtIns.mAtoms);
+
+    // Keep the ids of our own symbols clear of the built-in ones.
+    mUniqueIdCounter = builtIns.mUniqueIdCounter;
+}
+
+void TSymbolTable::computeCachedData()
+{
+    for (size_t i = 0; i < table.size(); ++i)
+        table[i]->computeCachedData();
+}
+
 void TSymbolTable::insertBuiltIn(
     ESymbolLevel level, TType *rvalue, const char *name,
     TType *ptype1, TType *ptype2, TType *ptype3, TType *ptype4, TType *ptype5)
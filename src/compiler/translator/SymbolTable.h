@@ -32,6 +32,8 @@
 
 #include <assert.h>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "common/angleutils.h"
 #include "compiler/translator/InfoSink.h"
@@ -209,10 +211,13 @@ class TFunction : public TSymbol
         return TString(mangledName.c_str(), mangledName.find_first_of('('));
     }
 
+    // See TSymbolTableLevel::computeCachedData().
+    void computeCachedData();
+
     void addParameter(TParameter &p)
     { 
         parameters.push_back(p);
-        mangledName = mangledName + p.type->getMangledName();
+        mangledName += p.type->getMangledName();
     }
 
     const TString &getMangledName() const
@@ -276,28 +281,109 @@ class TInterfaceBlockName : public TSymbol
     }
 };
 
-class TSymbolTableLevel
+class TSymbolTable;
+
+//
+// Interns the (mangled) names of the symbols of a table as integer atoms.
+// A name is hashed once per lookup, and the levels are then searched by
+// atom rather than by comparing strings at every level.
+//
+// A table may extend a frozen parent and share its atoms: the atoms of the
+// built-in levels are shared by every compiler that shares those levels.
+//
+class TAtomTable
 {
   public:
-    typedef TMap<TString, TSymbol *> tLevel;
-    typedef tLevel::const_iterator const_iterator;
-    typedef const tLevel::value_type tLevelPair;
-    typedef std::pair<tLevel::iterator, bool> tInsertResult;
+    TAtomTable()
+        : mParent(NULL),
+          mBase(0)
+    {
+    }
+
+    // Must be called while the table is empty. |parent| must outlive it
+    // and must not intern any more names.
+    void setParent(const TAtomTable *parent);
 
-    TSymbolTableLevel()
+    static size_t Hash(const TString &name);
+
+    // Returns the atom of |name|, or -1 if it has none.
+    int find(const TString &name) const
+    {
+        return find(name, Hash(name));
+    }
+    int find(const TString &name, size_t hash) const;
+    int intern(const TString &name);
+
+    // Number of atoms, the parent's included. Atoms are numbered from 0
+    // in the order they are interned.
+    size_t size() const
+    {
+        return mBase + mEntries.size();
+    }
+    // Forgets the atoms interned after the table held |size| atoms.
+    void truncate(size_t size);
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(TAtomTable);
+
+    void insertSlot(size_t index);
+
+    struct Entry
+    {
+        size_t hash;
+        const TString *name;
+    };
+    // Unlike the levels, which are popped before the pool of the compile
+    // that filled them, a compiler's table keeps its atoms from compile to
+    // compile, and truncate() only forgets entries. So these arrays can't
+    // come from the pool: only the names do, and only the names of atoms
+    // that are forgotten before the pool is popped.
+    std::vector<Entry> mEntries;
+    // Open addressing with linear probing. Each slot holds an index into
+    // mEntries plus one, or 0 when empty.
+    std::vector<unsigned int> mSlots;
+
+    const TAtomTable *mParent;
+    size_t mBase;
+};
+
+class TSymbolTableLevel
+{
+  public:
+    // Symbols inserted into the level get their unique ids and atoms from
+    // the owning table, so that ids never collide within one compiler.
+    explicit TSymbolTableLevel(TSymbolTable *table)
+        : mCount(0),
+          mTable(table)
     {
     }
     ~TSymbolTableLevel();
 
     bool insert(TSymbol *symbol);
 
-    TSymbol *find(const TString &name) const;
+    TSymbol *find(int atom) const;
 
     void relateToOperator(const char *name, TOperator op);
     void relateToExtension(const char *name, const TString &ext);
 
-  protected:
-    tLevel level;
+    // Computes the data that symbols and their types otherwise cache on
+    // first use, so that lookups never write to a level shared between
+    // threads.
+    void computeCachedData();
+
+  private:
+    void grow();
+
+    // Open addressing with linear probing on the atom of the mangled name.
+    struct Slot
+    {
+        int atom;
+        TSymbol *symbol;
+    };
+    TVector<Slot> mSlots;
+    size_t mCount;
+
+    TSymbolTable *mTable;
 };
 
 // Define ESymbolLevel as int rather than an enum since level can go
@@ -310,11 +396,34 @@ const int ESSL3_BUILTINS = 2;
 const int LAST_BUILTIN_LEVEL = ESSL3_BUILTINS;
 const int GLOBAL_LEVEL = 3;
 
+// An operation on a symbol table, as recorded by TSymbolTable::setLog().
+struct TSymbolTableOperation
+{
+    enum Kind
+    {
+        Push,
+        Pop,
+        Insert,
+        Find,
+        FindBuiltIn
+    };
+
+    Kind kind;
+    // The level of an insert, or the shader version of a lookup.
+    int argument;
+    // The mangled name that is inserted or looked up.
+    std::string name;
+};
+
 class TSymbolTable
 {
   public:
     TSymbolTable()
-        : mGlobalInvariant(false)
+        : mGlobalInvariant(false),
+          mUniqueIdCounter(0),
+          mSharedLevelCount(0),
+          mGlobalAtomCount(0),
+          mLog(NULL)
     {
         // The symbol table cannot be used until push() is called, but
         // the lack of an initial call to push() can be used to detect
@@ -340,19 +449,46 @@ class TSymbolTable
     }
     void push()
     {
-        table.push_back(new TSymbolTableLevel);
+        if (mLog)
+            log(TSymbolTableOperation::Push, 0, "");
+        if (table.size() == GLOBAL_LEVEL)
+            mGlobalAtomCount = mAtoms.size();
+        table.push_back(new TSymbolTableLevel(this));
         precisionStack.push_back(new PrecisionStackLevel);
     }
 
     void pop()
     {
-        delete table.back();
+        if (mLog)
+            log(TSymbolTableOperation::Pop, 0, "");
+        // The names of the shader's own symbols live in the pool of the
+        // compile, so their atoms go with the global level.
+        if (table.size() == GLOBAL_LEVEL + 1)
+            mAtoms.truncate(mGlobalAtomCount);
+
+        // Levels borrowed through shareBuiltInLevels() are not ours to delete.
+        if (table.size() > mSharedLevelCount)
+        {
+            delete table.back();
+            delete precisionStack.back();
+        }
+        else
+        {
+            mSharedLevelCount = table.size() - 1;
+        }
         table.pop_back();
-
-        delete precisionStack.back();
         precisionStack.pop_back();
     }
 
+    // Uses the built-in levels of |builtIns|, which must hold exactly the
+    // built-in levels, as the built-in levels of this empty table. They are
+    // borrowed, not copied: |builtIns| must outlive this table and must not
+    // be modified any more.
+    void shareBuiltInLevels(const TSymbolTable &builtIns);
+
+    // See TSymbolTableLevel::computeCachedData().
+    void computeCachedData();
+
     bool declare(TSymbol *symbol)
     {
         return insert(currentLevel(), symbol);
@@ -360,6 +496,8 @@ class TSymbolTable
 
     bool insert(ESymbolLevel level, TSymbol *symbol)
     {
+        if (mLog)
+            log(TSymbolTableOperation::Insert, level, symbol->getMangledName().c_str());
         return table[level]->insert(symbol);
     }
 
@@ -430,12 +568,39 @@ class TSymbolTable
     void setGlobalInvariant() { mGlobalInvariant = true; }
     bool getGlobalInvariant() const { return mGlobalInvariant; }
 
-    static int nextUniqueId()
+    // Unique ids are allocated per symbol table rather than per process,
+    // so that independent compilers can run on different threads and the
+    // ids, which leak into the output through struct names, are
+    // deterministic for a given compiler.
+    int nextUniqueId()
+    {
+        return ++mUniqueIdCounter;
+    }
+    int getUniqueIdCounter() const
     {
-        return ++uniqueIdCounter;
+        return mUniqueIdCounter;
+    }
+    void resetUniqueIdCounter(int counter)
+    {
+        mUniqueIdCounter = counter;
+    }
+
+    int internAtom(const TString &name)
+    {
+        return mAtoms.intern(name);
+    }
+
+    // While a log is set, every push, pop, insert and lookup is appended
+    // to it, so that benchmarks can replay the symbol table work of a
+    // compile.
+    void setLog(std::vector<TSymbolTableOperation> *log)
+    {
+        mLog = log;
     }
 
   private:
+    void log(TSymbolTableOperation::Kind kind, int argument, const char *name) const;
+
     ESymbolLevel currentLevel() const
     {
         return static_cast<ESymbolLevel>(table.size() - 1);
@@ -448,7 +613,13 @@ class TSymbolTable
     std::set<std::string> mInvariantVaryings;
     bool mGlobalInvariant;
 
-    static int uniqueIdCounter;
+    int mUniqueIdCounter;
+    size_t mSharedLevelCount;
+
+    TAtomTable mAtoms;
+    size_t mGlobalAtomCount;
+
+    std::vector<TSymbolTableOperation> *mLog;
 };
 
 #endif // _SYMBOL_TABLE_INCLUDED_
@@ -0,0 +1,491 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TokenBridge.cpp: Feeds the tokens of the preprocessor to the GLSL ES parser.
+// The preprocessor has already split the source into tokens, so this only
+// classifies them: keywords and reserved words by looking the identifier up
+// in a table, and the rest by the type of the preprocessor token.
+//
+
+#include "compiler/preprocessor/Token.h"
+#include "compiler/translator/CompileStatistics.h"
+#include "compiler/translator/ParseContext.h"
+#include "compiler/translator/Preprocess.h"
+#include "compiler/translator/glslang.h"
+#include "compiler/translator/util.h"
+#include "glslang_tab.h"
+
+#include <string.h>
+
+namespace
+{
+
+// How an identifier that spells a keyword or reserved word is treated,
+// depending on the shader version.
+enum KeywordKind
+{
+    // A keyword in every version.
+    kKeyword,
+    // "true" or "false".
+    kBoolConstant,
+    kES2KeywordES3Reserved,
+    kES2ReservedES3Keyword,
+    // Not reserved in GLSL ES 1.00, so it can be used as an identifier there.
+    kES2IdentES3Keyword,
+    kES2IdentES3Reserved,
+    kES2ReservedES3Ident,
+    // Reserved in every version.
+    kReserved
+};
+
+struct Keyword
+{
+    const char *name;
+    int token;
+    KeywordKind kind;
+};
+
+// Sorted by strcmp for binary search.
+const Keyword kKeywords[] =
+{
+    { "active",               0,                     kES2IdentES3Reserved },
+    { "asm",                  0,                     kReserved },
+    { "atomic_uint",          0,                     kES2IdentES3Reserved },
+    { "attribute",            ATTRIBUTE,             kES2KeywordES3Reserved },
+    { "bool",                 BOOL_TYPE,             kKeyword },
+    { "break",                BREAK,                 kKeyword },
+    { "bvec2",                BVEC2,                 kKeyword },
+    { "bvec3",                BVEC3,                 kKeyword },
+    { "bvec4",                BVEC4,                 kKeyword },
+    { "case",                 CASE,                  kES2IdentES3Keyword },
+    { "cast",                 0,                     kReserved },
+    { "centroid",             CENTROID,              kES2IdentES3Keyword },
+    { "class",                0,                     kReserved },
+    { "coherent",             0,                     kES2IdentES3Reserved },
+    { "common",               0,                     kES2IdentES3Reserved },
+    { "const",                CONST_QUAL,            kKeyword },
+    { "continue",             CONTINUE,              kKeyword },
+    { "default",              DEFAULT,               kES2ReservedES3Keyword },
+    { "discard",              DISCARD,               kKeyword },
+    { "do",                   DO,                    kKeyword },
+    { "double",               0,                     kReserved },
+    { "dvec2",                0,                     kReserved },
+    { "dvec3",                0,                     kReserved },
+    { "dvec4",                0,                     kReserved },
+    { "else",                 ELSE,                  kKeyword },
+    { "enum",                 0,                     kReserved },
+    { "extern",               0,                     kReserved },
+    { "external",             0,                     kReserved },
+    { "false",                BOOLCONSTANT,          kBoolConstant },
+    { "filter",               0,                     kES2IdentES3Reserved },
+    { "fixed",                0,                     kReserved },
+    { "flat",                 FLAT,                  kES2ReservedES3Keyword },
+    { "float",                FLOAT_TYPE,            kKeyword },
+    { "for",                  FOR,                   kKeyword },
+    { "fvec2",                0,                     kReserved },
+    { "fvec3",                0,                     kReserved },
+    { "fvec4",                0,                     kReserved },
+    { "goto",                 0,                     kReserved },
+    { "half",                 0,                     kReserved },
+    { "highp",                HIGH_PRECISION,        kKeyword },
+    { "hvec2",                0,                     kReserved },
+    { "hvec3",                0,                     kReserved },
+    { "hvec4",                0,                     kReserved },
+    { "if",                   IF,                    kKeyword },
+    { "iimage1D",             0,                     kES2IdentES3Reserved },
+    { "iimage1DArray",        0,                     kES2IdentES3Reserved },
+    { "iimage2D",             0,                     kES2IdentES3Reserved },
+    { "iimage2DArray",        0,                     kES2IdentES3Reserved },
+    { "iimage3D",             0,                     kES2IdentES3Reserved },
+    { "iimageBuffer",         0,                     kES2IdentES3Reserved },
+    { "iimageCube",           0,                     kES2IdentES3Reserved },
+    { "image1D",              0,                     kES2IdentES3Reserved },
+    { "image1DArray",         0,                     kES2IdentES3Reserved },
+    { "image1DArrayShadow",   0,                     kES2IdentES3Reserved },
+    { "image1DShadow",        0,                     kES2IdentES3Reserved },
+    { "image2D",              0,                     kES2IdentES3Reserved },
+    { "image2DArray",         0,                     kES2IdentES3Reserved },
+    { "image2DArrayShadow",   0,                     kES2IdentES3Reserved },
+    { "image2DShadow",        0,                     kES2IdentES3Reserved },
+    { "image3D",              0,                     kES2IdentES3Reserved },
+    { "imageBuffer",          0,                     kES2IdentES3Reserved },
+    { "imageCube",            0,                     kES2IdentES3Reserved },
+    { "in",                   IN_QUAL,               kKeyword },
+    { "inline",               0,                     kReserved },
+    { "inout",                INOUT_QUAL,            kKeyword },
+    { "input",                0,                     kReserved },
+    { "int",                  INT_TYPE,              kKeyword },
+    { "interface",            0,                     kReserved },
+    { "invariant",            INVARIANT,             kKeyword },
+    { "isampler1D",           0,                     kES2IdentES3Reserved },
+    { "isampler1DArray",      0,                     kES2IdentES3Reserved },
+    { "isampler2D",           ISAMPLER2D,            kES2IdentES3Keyword },
+    { "isampler2DArray",      ISAMPLER2DARRAY,       kES2IdentES3Keyword },
+    { "isampler2DMS",         0,                     kES2IdentES3Reserved },
+    { "isampler2DMSArray",    0,                     kES2IdentES3Reserved },
+    { "isampler2DRect",       0,                     kES2IdentES3Reserved },
+    { "isampler3D",           ISAMPLER3D,            kES2IdentES3Keyword },
+    { "isamplerBuffer",       0,                     kES2IdentES3Reserved },
+    { "isamplerCube",         ISAMPLERCUBE,          kES2IdentES3Keyword },
+    { "ivec2",                IVEC2,                 kKeyword },
+    { "ivec3",                IVEC3,                 kKeyword },
+    { "ivec4",                IVEC4,                 kKeyword },
+    { "layout",               LAYOUT,                kES2IdentES3Keyword },
+    { "long",                 0,                     kReserved },
+    { "lowp",                 LOW_PRECISION,         kKeyword },
+    { "mat2",                 MATRIX2,               kKeyword },
+    { "mat2x2",               MATRIX2,               kES2IdentES3Keyword },
+    { "mat2x3",               MATRIX2x3,             kES2IdentES3Keyword },
+    { "mat2x4",               MATRIX2x4,             kES2IdentES3Keyword },
+    { "mat3",                 MATRIX3,               kKeyword },
+    { "mat3x2",               MATRIX3x2,             kES2IdentES3Keyword },
+    { "mat3x3",               MATRIX3,               kES2IdentES3Keyword },
+    { "mat3x4",               MATRIX3x4,             kES2IdentES3Keyword },
+    { "mat4",                 MATRIX4,               kKeyword },
+    { "mat4x2",               MATRIX4x2,             kES2IdentES3Keyword },
+    { "mat4x3",               MATRIX4x3,             kES2IdentES3Keyword },
+    { "mat4x4",               MATRIX4,               kES2IdentES3Keyword },
+    { "mediump",              MEDIUM_PRECISION,      kKeyword },
+    { "namespace",            0,                     kReserved },
+    { "noinline",             0,                     kReserved },
+    { "noperspective",        0,                     kES2IdentES3Reserved },
+    { "out",                  OUT_QUAL,              kKeyword },
+    { "output",               0,                     kReserved },
+    { "packed",               0,                     kES2ReservedES3Ident },
+    { "partition",            0,                     kES2IdentES3Reserved },
+    { "patch",                0,                     kES2IdentES3Reserved },
+    { "precision",            PRECISION,             kKeyword },
+    { "public",               0,                     kReserved },
+    { "readonly",             0,                     kES2IdentES3Reserved },
+    { "resource",             0,                     kES2IdentES3Reserved },
+    { "restrict",             0,                     kES2IdentES3Reserved },
+    { "return",               RETURN,                kKeyword },
+    { "sample",               0,                     kES2IdentES3Reserved },
+    { "sampler1D",            0,                     kReserved },
+    { "sampler1DArray",       0,                     kES2IdentES3Reserved },
+    { "sampler1DArrayShadow", 0,                     kES2IdentES3Reserved },
+    { "sampler1DShadow",      0,                     kReserved },
+    { "sampler2D",            SAMPLER2D,             kKeyword },
+    { "sampler2DArray",       SAMPLER2DARRAY,        kES2IdentES3Keyword },
+    { "sampler2DArrayShadow", SAMPLER2DARRAYSHADOW,  kES2IdentES3Keyword },
+    { "sampler2DMS",          0,                     kES2IdentES3Reserved },
+    { "sampler2DMSArray",     0,                     kES2IdentES3Reserved },
+    { "sampler2DRect",        SAMPLER2DRECT,         kKeyword },
+    { "sampler2DRectShadow",  0,                     kReserved },
+    { "sampler2DShadow",      SAMPLER2DSHADOW,       kES2ReservedES3Keyword },
+    { "sampler3D",            SAMPLER3D,             kES2ReservedES3Keyword },
+    { "sampler3DRect",        SAMPLER3DRECT,         kES2ReservedES3Keyword },
+    { "samplerBuffer",        0,                     kES2IdentES3Reserved },
+    { "samplerCube",          SAMPLERCUBE,           kKeyword },
+    { "samplerCubeShadow",    SAMPLERCUBESHADOW,     kES2IdentES3Keyword },
+    { "samplerExternalOES",   SAMPLER_EXTERNAL_OES,  kKeyword },
+    { "short",                0,                     kReserved },
+    { "sizeof",               0,                     kReserved },
+    { "smooth",               SMOOTH,                kES2IdentES3Keyword },
+    { "static",               0,                     kReserved },
+    { "struct",               STRUCT,                kKeyword },
+    { "subroutine",           0,                     kES2IdentES3Reserved },
+    { "superp",               0,                     kReserved },
+    { "switch",               SWITCH,                kES2ReservedES3Keyword },
+    { "template",             0,                     kReserved },
+    { "this",                 0,                     kReserved },
+    { "true",                 BOOLCONSTANT,          kBoolConstant },
+    { "typedef",              0,                     kReserved },
+    { "uimage1D",             0,                     kES2IdentES3Reserved },
+    { "uimage1DArray",        0,                     kES2IdentES3Reserved },
+    { "uimage2D",             0,                     kES2IdentES3Reserved },
+    { "uimage2DArray",        0,                     kES2IdentES3Reserved },
+    { "uimage3D",             0,                     kES2IdentES3Reserved },
+    { "uimageBuffer",         0,                     kES2IdentES3Reserved },
+    { "uimageCube",           0,                     kES2IdentES3Reserved },
+    { "uint",                 UINT_TYPE,             kES2IdentES3Keyword },
+    { "uniform",              UNIFORM,               kKeyword },
+    { "union",                0,                     kReserved },
+    { "unsigned",             0,                     kReserved },
+    { "usampler1D",           0,                     kES2IdentES3Reserved },
+    { "usampler1DArray",      0,                     kES2IdentES3Reserved },
+    { "usampler2D",           USAMPLER2D,            kES2IdentES3Keyword },
+    { "usampler2DArray",      USAMPLER2DARRAY,       kES2IdentES3Keyword },
+    { "usampler2DMS",         0,                     kES2IdentES3Reserved },
+    { "usampler2DMSArray",    0,                     kES2IdentES3Reserved },
+    { "usampler2DRect",       0,                     kES2IdentES3Reserved },
+    { "usampler3D",           USAMPLER3D,            kES2IdentES3Keyword },
+    { "usamplerBuffer",       0,                     kES2IdentES3Reserved },
+    { "usamplerCube",         USAMPLERCUBE,          kES2IdentES3Keyword },
+    { "using",                0,                     kReserved },
+    { "uvec2",                UVEC2,                 kES2IdentES3Keyword },
+    { "uvec3",                UVEC3,                 kES2IdentES3Keyword },
+    { "uvec4",                UVEC4,                 kES2IdentES3Keyword },
+    { "varying",              VARYING,               kES2KeywordES3Reserved },
+    { "vec2",                 VEC2,                  kKeyword },
+    { "vec3",                 VEC3,                  kKeyword },
+    { "vec4",                 VEC4,                  kKeyword },
+    { "void",                 VOID_TYPE,             kKeyword },
+    { "volatile",             0,                     kReserved },
+    { "while",                WHILE,                 kKeyword },
+    { "writeonly",            0,                     kES2IdentES3Reserved },
+};
+
+// The name is the size characters at name, which needn't be null-terminated.
+const Keyword *FindKeyword(const char *name, size_t size)
+{
+    size_t low = 0;
+    size_t high = sizeof(kKeywords) / sizeof(kKeywords[0]);
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        const char *keyword = kKeywords[middle].name;
+        int order = strncmp(name, keyword, size);
+        if (order == 0 && keyword[size] != '\0')
+            order = -1;
+        if (order == 0)
+            return &kKeywords[middle];
+        if (order < 0)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return NULL;
+}
+
+// State of the scanner for one parse, pointed to by TParseContext::scanner.
+struct TokenBridge
+{
+    explicit TokenBridge(TParseContext *context) : context(context) {}
+
+    TParseContext *context;
+    // The token last returned to the parser, kept for error messages.
+    pp::Token token;
+    // The text of the token refers to the source, and isn't null-terminated.
+    // It is copied here when a C string is needed.
+    std::string text;
+};
+
+const std::string &TokenString(TokenBridge *bridge)
+{
+    const pp::TokenText &text = bridge->token.text;
+    bridge->text.assign(text.data(), text.size());
+    return bridge->text;
+}
+
+int CheckType(TokenBridge *bridge, YYSTYPE *yylval)
+{
+    TParseContext *context = bridge->context;
+    // The identifier is copied once, into the pool, and the copy is used
+    // both for the symbol lookup and by the parser.
+    TString *name = NewPoolTString(bridge->token.text.data(), bridge->token.text.size());
+    yylval->lex.string = name;
+
+    int token = IDENTIFIER;
+    TSymbol *symbol = context->symbolTable.find(*name, context->shaderVersion);
+    if (symbol && symbol->isVariable())
+    {
+        TVariable *variable = static_cast<TVariable *>(symbol);
+        if (variable->isUserType())
+        {
+            token = TYPE_NAME;
+        }
+    }
+    yylval->lex.symbol = symbol;
+    return token;
+}
+
+int ReservedWord(TokenBridge *bridge, const YYLTYPE &yylloc)
+{
+    bridge->context->error(yylloc, "Illegal use of reserved word", TokenString(bridge).c_str(), "");
+    bridge->context->recover();
+    return 0;
+}
+
+int ClassifyKeyword(TokenBridge *bridge, const Keyword &keyword, YYSTYPE *yylval, const YYLTYPE &yylloc)
+{
+    bool isES3 = bridge->context->shaderVersion >= 300;
+    switch (keyword.kind)
+    {
+      case kKeyword:
+        return keyword.token;
+      case kBoolConstant:
+        yylval->lex.b = (keyword.name[0] == 't');
+        return keyword.token;
+      case kES2KeywordES3Reserved:
+        return isES3 ? ReservedWord(bridge, yylloc) : keyword.token;
+      case kES2ReservedES3Keyword:
+        return isES3 ? keyword.token : ReservedWord(bridge, yylloc);
+      case kES2IdentES3Keyword:
+        return isES3 ? keyword.token : CheckType(bridge, yylval);
+      case kES2IdentES3Reserved:
+        return isES3 ? ReservedWord(bridge, yylloc) : CheckType(bridge, yylval);
+      case kES2ReservedES3Ident:
+        return isES3 ? CheckType(bridge, yylval) : ReservedWord(bridge, yylloc);
+      case kReserved:
+        return ReservedWord(bridge, yylloc);
+      default:
+        UNREACHABLE();
+        return 0;
+    }
+}
+
+int IntConstant(TokenBridge *bridge, YYSTYPE *yylval, const YYLTYPE &yylloc)
+{
+    TParseContext *context = bridge->context;
+    const std::string &text = TokenString(bridge);
+    bool isUnsigned = (text[text.size() - 1] == 'u' || text[text.size() - 1] == 'U');
+
+    if (isUnsigned && context->shaderVersion < 300)
+    {
+        context->error(yylloc, "Unsigned integers are unsupported prior to GLSL ES 3.00", text.c_str(), "");
+        context->recover();
+        return 0;
+    }
+
+    if (!atoi_clamp(text.c_str(), &(yylval->lex.i)))
+        context->warning(yylloc, "Integer overflow", text.c_str(), "");
+
+    return isUnsigned ? UINTCONSTANT : INTCONSTANT;
+}
+
+int FloatConstant(TokenBridge *bridge, YYSTYPE *yylval, const YYLTYPE &yylloc)
+{
+    TParseContext *context = bridge->context;
+    const std::string &text = TokenString(bridge);
+    bool hasSuffix = (text[text.size() - 1] == 'f' || text[text.size() - 1] == 'F');
+
+    if (hasSuffix && context->shaderVersion < 300)
+    {
+        context->error(yylloc, "Floating-point suffix unsupported prior to GLSL ES 3.00", text.c_str());
+        context->recover();
+        return 0;
+    }
+
+    if (!atof_clamp(text.c_str(), &(yylval->lex.f)))
+        context->warning(yylloc, "Float overflow", text.c_str(), "");
+
+    return FLOATCONSTANT;
+}
+
+int Punctuator(int type)
+{
+    switch (type)
+    {
+      case pp::Token::OP_INC:          return INC_OP;
+      case pp::Token::OP_DEC:          return DEC_OP;
+      case pp::Token::OP_LEFT:         return LEFT_OP;
+      case pp::Token::OP_RIGHT:        return RIGHT_OP;
+      case pp::Token::OP_LE:           return LE_OP;
+      case pp::Token::OP_GE:           return GE_OP;
+      case pp::Token::OP_EQ:           return EQ_OP;
+      case pp::Token::OP_NE:           return NE_OP;
+      case pp::Token::OP_AND:          return AND_OP;
+      case pp::Token::OP_XOR:          return XOR_OP;
+      case pp::Token::OP_OR:           return OR_OP;
+      case pp::Token::OP_ADD_ASSIGN:   return ADD_ASSIGN;
+      case pp::Token::OP_SUB_ASSIGN:   return SUB_ASSIGN;
+      case pp::Token::OP_MUL_ASSIGN:   return MUL_ASSIGN;
+      case pp::Token::OP_DIV_ASSIGN:   return DIV_ASSIGN;
+      case pp::Token::OP_MOD_ASSIGN:   return MOD_ASSIGN;
+      case pp::Token::OP_LEFT_ASSIGN:  return LEFT_ASSIGN;
+      case pp::Token::OP_RIGHT_ASSIGN: return RIGHT_ASSIGN;
+      case pp::Token::OP_AND_ASSIGN:   return AND_ASSIGN;
+      case pp::Token::OP_XOR_ASSIGN:   return XOR_ASSIGN;
+      case pp::Token::OP_OR_ASSIGN:    return OR_ASSIGN;
+      case ';': return SEMICOLON;
+      case '{': return LEFT_BRACE;
+      case '}': return RIGHT_BRACE;
+      case ',': return COMMA;
+      case ':': return COLON;
+      case '=': return EQUAL;
+      case '(': return LEFT_PAREN;
+      case ')': return RIGHT_PAREN;
+      case '[': return LEFT_BRACKET;
+      case ']': return RIGHT_BRACKET;
+      case '.': return DOT;
+      case '!': return BANG;
+      case '-': return DASH;
+      case '~': return TILDE;
+      case '+': return PLUS;
+      case '*': return STAR;
+      case '/': return SLASH;
+      case '%': return PERCENT;
+      case '<': return LEFT_ANGLE;
+      case '>': return RIGHT_ANGLE;
+      case '|': return VERTICAL_BAR;
+      case '^': return CARET;
+      case '&': return AMPERSAND;
+      case '?': return QUESTION;
+      default:
+        // The preprocessor reports and drops every other token.
+        UNREACHABLE();
+        return 0;
+    }
+}
+
+}  // namespace
+
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, void *yyscanner)
+{
+    TokenBridge *bridge = static_cast<TokenBridge *>(yyscanner);
+    pp::Token &token = bridge->token;
+    {
+        TScopedPhaseTimer timer(bridge->context->statistics, SH_COMPILE_PHASE_PREPROCESS);
+        bridge->context->preprocessor.lex(&token);
+    }
+
+    yylloc->first_file = yylloc->last_file = token.location.file;
+    yylloc->first_line = yylloc->last_line = token.location.line;
+
+    switch (token.type)
+    {
+      case pp::Token::LAST:
+        return 0;
+      case pp::Token::IDENTIFIER:
+        {
+            const Keyword *keyword = FindKeyword(token.text.data(), token.text.size());
+            if (keyword)
+                return ClassifyKeyword(bridge, *keyword, yylval, *yylloc);
+            return CheckType(bridge, yylval);
+        }
+      case pp::Token::CONST_INT:
+        return IntConstant(bridge, yylval, *yylloc);
+      case pp::Token::CONST_FLOAT:
+        return FloatConstant(bridge, yylval, *yylloc);
+      default:
+        return Punctuator(token.type);
+    }
+}
+
+void yyerror(YYLTYPE *lloc, TParseContext *context, const char *reason)
+{
+    TokenBridge *bridge = static_cast<TokenBridge *>(context->scanner);
+    context->error(*lloc, reason, TokenString(bridge).c_str());
+    context->recover();
+}
+
+int glslang_initialize(TParseContext *context)
+{
+    context->scanner = new TokenBridge(context);
+    return 0;
+}
+
+int glslang_finalize(TParseContext *context)
+{
+    TokenBridge *bridge = static_cast<TokenBridge *>(context->scanner);
+    context->scanner = NULL;
+    delete bridge;
+
+    return 0;
+}
+
+int glslang_scan(size_t count, const char *const string[], const int length[],
+                 TParseContext *context)
+{
+    // Initialize preprocessor.
+    if (!context->preprocessor.init(count, string, length))
+        return 1;
+
+    InitializePreprocessor(&context->preprocessor, context->extensionBehavior(),
+                           context->fragmentPrecisionHigh, context->shaderSpec);
+
+    return 0;
+}
@@ -0,0 +1,546 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/TranslationCache.h"
+
+#include "common/debug.h"
+
+namespace
+{
+
+// Bump when the serialized form of an entry changes.
+const unsigned int kSerializationVersion = 1;
+
+unsigned long long HashKey(const std::string &key)
+{
+    // 64-bit FNV-1a.
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t ii = 0; ii < key.size(); ++ii)
+    {
+        hash ^= static_cast<unsigned char>(key[ii]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string HashToString(unsigned long long hash)
+{
+    static const char kDigits[] = "0123456789abcdef";
+    std::string result(16, '0');
+    for (int ii = 15; ii >= 0; --ii)
+    {
+        result[ii] = kDigits[hash & 0xf];
+        hash >>= 4;
+    }
+    return result;
+}
+
+//
+// Approximate memory used by the results, for the LRU bound.
+//
+size_t VariableSize(const sh::ShaderVariable &variable)
+{
+    size_t size = sizeof(variable) + variable.name.size() + variable.mappedName.size() +
+                  variable.structName.size();
+    for (size_t ii = 0; ii < variable.fields.size(); ++ii)
+        size += VariableSize(variable.fields[ii]);
+    return size;
+}
+
+size_t VariableSize(const sh::InterfaceBlock &block)
+{
+    size_t size = sizeof(block) + block.name.size() + block.mappedName.size() +
+                  block.instanceName.size();
+    for (size_t ii = 0; ii < block.fields.size(); ++ii)
+        size += VariableSize(block.fields[ii]);
+    return size;
+}
+
+template <typename VarT>
+size_t VariablesSize(const std::vector<VarT> &variables)
+{
+    size_t size = 0;
+    for (size_t ii = 0; ii < variables.size(); ++ii)
+        size += VariableSize(variables[ii]);
+    return size;
+}
+
+template <typename MapT>
+size_t MapSize(const MapT &map)
+{
+    size_t size = 0;
+    for (typename MapT::const_iterator iter = map.begin(); iter != map.end(); ++iter)
+        size += sizeof(*iter) + iter->first.size();
+    return size;
+}
+
+size_t ResultsSize(const TCompileResults &results)
+{
+    size_t size = sizeof(results) + results.objectCode.size() + results.infoLog.size();
+    for (std::map<std::string, std::string>::const_iterator iter = results.nameMap.begin();
+         iter != results.nameMap.end(); ++iter)
+    {
+        size += sizeof(*iter) + iter->first.size() + iter->second.size();
+    }
+    size += VariablesSize(results.attributes);
+    size += VariablesSize(results.outputVariables);
+    size += VariablesSize(results.uniforms);
+    size += VariablesSize(results.varyings);
+    size += VariablesSize(results.interfaceBlocks);
+    size += MapSize(results.interfaceBlockRegisters);
+    size += MapSize(results.uniformRegisters);
+    return size;
+}
+
+//
+// Serialization of entries for the backing store. Integers are stored as
+// little-endian 32-bit values and strings are prefixed with their length.
+//
+class EntryWriter
+{
+  public:
+    explicit EntryWriter(std::string *data) : mData(data) {}
+
+    void writeInt(unsigned int value)
+    {
+        for (int ii = 0; ii < 4; ++ii)
+        {
+            mData->push_back(static_cast<char>(value & 0xff));
+            value >>= 8;
+        }
+    }
+
+    void writeString(const std::string &value)
+    {
+        writeInt(static_cast<unsigned int>(value.size()));
+        mData->append(value);
+    }
+
+    void writeVariable(const sh::ShaderVariable &variable)
+    {
+        writeInt(variable.type);
+        writeInt(variable.precision);
+        writeString(variable.name);
+        writeString(variable.mappedName);
+        writeInt(variable.arraySize);
+        writeInt(variable.staticUse);
+        writeString(variable.structName);
+        writeVariables(variable.fields);
+    }
+
+    void writeVariable(const sh::Uniform &uniform)
+    {
+        writeVariable(static_cast<const sh::ShaderVariable &>(uniform));
+    }
+
+    void writeVariable(const sh::Attribute &attribute)
+    {
+        writeVariable(static_cast<const sh::ShaderVariable &>(attribute));
+        writeInt(attribute.location);
+    }
+
+    void writeVariable(const sh::Varying &varying)
+    {
+        writeVariable(static_cast<const sh::ShaderVariable &>(varying));
+        writeInt(varying.interpolation);
+        writeInt(varying.isInvariant);
+    }
+
+    void writeVariable(const sh::InterfaceBlockField &field)
+    {
+        writeVariable(static_cast<const sh::ShaderVariable &>(field));
+        writeInt(field.isRowMajorLayout);
+    }
+
+    void writeVariable(const sh::InterfaceBlock &block)
+    {
+        writeString(block.name);
+        writeString(block.mappedName);
+        writeString(block.instanceName);
+        writeInt(block.arraySize);
+        writeInt(block.layout);
+        writeInt(block.isRowMajorLayout);
+        writeInt(block.staticUse);
+        writeVariables(block.fields);
+    }
+
+    template <typename VarT>
+    void writeVariables(const std::vector<VarT> &variables)
+    {
+        writeInt(static_cast<unsigned int>(variables.size()));
+        for (size_t ii = 0; ii < variables.size(); ++ii)
+            writeVariable(variables[ii]);
+    }
+
+    template <typename ValueT>
+    void writeMap(const std::map<std::string, ValueT> &map)
+    {
+        writeInt(static_cast<unsigned int>(map.size()));
+        for (typename std::map<std::string, ValueT>::const_iterator iter = map.begin();
+             iter != map.end(); ++iter)
+        {
+            writeString(iter->first);
+            writeValue(iter->second);
+        }
+    }
+
+  private:
+    void writeValue(const std::string &value) { writeString(value); }
+    void writeValue(unsigned int value) { writeInt(value); }
+
+    std::string *mData;
+};
+
+// Every read fails once the data runs out; callers check ok() at the end.
+class EntryReader
+{
+  public:
+    explicit EntryReader(const std::string &data) : mData(data), mOffset(0), mOk(true) {}
+
+    bool ok() const { return mOk; }
+    bool atEnd() const { return mOffset == mData.size(); }
+
+    unsigned int readInt()
+    {
+        if (!mOk || mData.size() - mOffset < 4)
+        {
+            mOk = false;
+            return 0;
+        }
+        unsigned int value = 0;
+        for (int ii = 3; ii >= 0; --ii)
+            value = (value << 8) | static_cast<unsigned char>(mData[mOffset + ii]);
+        mOffset += 4;
+        return value;
+    }
+
+    std::string readString()
+    {
+        size_t size = readInt();
+        if (!mOk || mData.size() - mOffset < size)
+        {
+            mOk = false;
+            return std::string();
+        }
+        std::string value = mData.substr(mOffset, size);
+        mOffset += size;
+        return value;
+    }
+
+    void readVariable(sh::ShaderVariable *variable)
+    {
+        variable->type = readInt();
+        variable->precision = readInt();
+        variable->name = readString();
+        variable->mappedName = readString();
+        variable->arraySize = readInt();
+        variable->staticUse = readInt() != 0;
+        variable->structName = readString();
+        readVariables(&variable->fields);
+    }
+
+    void readVariable(sh::Uniform *uniform)
+    {
+        readVariable(static_cast<sh::ShaderVariable *>(uniform));
+    }
+
+    void readVariable(sh::Attribute *attribute)
+    {
+        readVariable(static_cast<sh::ShaderVariable *>(attribute));
+        attribute->location = static_cast<int>(readInt());
+    }
+
+    void readVariable(sh::Varying *varying)
+    {
+        readVariable(static_cast<sh::ShaderVariable *>(varying));
+        varying->interpolation = static_cast<sh::InterpolationType>(readInt());
+        varying->isInvariant = readInt() != 0;
+    }
+
+    void readVariable(sh::InterfaceBlockField *field)
+    {
+        readVariable(static_cast<sh::ShaderVariable *>(field));
+        field->isRowMajorLayout = readInt() != 0;
+    }
+
+    void readVariable(sh::InterfaceBlock *block)
+    {
+        block->name = readString();
+        block->mappedName = readString();
+        block->instanceName = readString();
+        block->arraySize = readInt();
+        block->layout = static_cast<sh::BlockLayoutType>(readInt());
+        block->isRowMajorLayout = readInt() != 0;
+        block->staticUse = readInt() != 0;
+        readVariables(&block->fields);
+    }
+
+    template <typename VarT>
+    void readVariables(std::vector<VarT> *variables)
+    {
+        size_t count = readInt();
+        // Every variable takes more than a byte, so a count beyond the
+        // remaining data is corrupt; don't let it drive a huge resize.
+        if (!mOk || count > mData.size() - mOffset)
+        {
+            mOk = false;
+            return;
+        }
+        variables->resize(count);
+        for (size_t ii = 0; ii < count && mOk; ++ii)
+            readVariable(&(*variables)[ii]);
+    }
+
+    template <typename ValueT>
+    void readMap(std::map<std::string, ValueT> *map)
+    {
+        size_t count = readInt();
+        for (size_t ii = 0; ii < count && mOk; ++ii)
+        {
+            std::string key = readString();
+            readValue(&(*map)[key]);
+        }
+    }
+
+  private:
+    void readValue(std::string *value) { *value = readString(); }
+    void readValue(unsigned int *value) { *value = readInt(); }
+
+    const std::string &mData;
+    size_t mOffset;
+    bool mOk;
+};
+
+std::string SerializeEntry(const std::string &key, const TCompileResults &results)
+{
+    std::string data;
+    EntryWriter writer(&data);
+    writer.writeInt(kSerializationVersion);
+    writer.writeInt(ANGLE_SH_VERSION);
+    writer.writeString(key);
+    writer.writeInt(results.success);
+    writer.writeInt(static_cast<unsigned int>(results.shaderVersion));
+    writer.writeString(results.objectCode);
+    writer.writeString(results.infoLog);
+    writer.writeMap(results.nameMap);
+    writer.writeVariables(results.attributes);
+    writer.writeVariables(results.outputVariables);
+    writer.writeVariables(results.uniforms);
+    writer.writeVariables(results.varyings);
+    writer.writeVariables(results.interfaceBlocks);
+    writer.writeMap(results.interfaceBlockRegisters);
+    writer.writeMap(results.uniformRegisters);
+    return data;
+}
+
+// Returns false if the data is malformed, was written by a different
+// version of the translator, or belongs to a different key.
+bool DeserializeEntry(const std::string &data, const std::string &key, TCompileResults *results)
+{
+    EntryReader reader(data);
+    if (reader.readInt() != kSerializationVersion || reader.readInt() != ANGLE_SH_VERSION)
+        return false;
+    if (!reader.ok() || reader.readString() != key)
+        return false;
+
+    results->success = reader.readInt() != 0;
+    results->shaderVersion = static_cast<int>(reader.readInt());
+    results->objectCode = reader.readString();
+    results->infoLog = reader.readString();
+    reader.readMap(&results->nameMap);
+    reader.readVariables(&results->attributes);
+    reader.readVariables(&results->outputVariables);
+    reader.readVariables(&results->uniforms);
+    reader.readVariables(&results->varyings);
+    reader.readVariables(&results->interfaceBlocks);
+    reader.readMap(&results->interfaceBlockRegisters);
+    reader.readMap(&results->uniformRegisters);
+    return reader.ok() && reader.atEnd();
+}
+
+}  // namespace
+
+TCompileResults::TCompileResults()
+    : success(false),
+      shaderVersion(100)
+{
+}
+
+TranslationCache::TranslationCache()
+    : mSize(0),
+      mMaxSize(0),
+      mGetFunction(NULL),
+      mPutFunction(NULL),
+      mUserData(NULL),
+      mHits(0),
+      mBackingStoreHits(0),
+      mMisses(0),
+      mEvictions(0)
+{
+}
+
+void TranslationCache::setMaxSize(size_t maxSize)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxSize = maxSize;
+    evictLocked();
+}
+
+bool TranslationCache::isEnabled()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxSize > 0;
+}
+
+void TranslationCache::setBackingStore(ShTranslationCacheGetFunction getFunction,
+                                       ShTranslationCachePutFunction putFunction,
+                                       void *userData)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mGetFunction = getFunction;
+    mPutFunction = putFunction;
+    mUserData = userData;
+}
+
+bool TranslationCache::lookup(const std::string &key, bool persistent, TCompileResults *results)
+{
+    const unsigned long long hash = HashKey(key);
+
+    ShTranslationCacheGetFunction getFunction = NULL;
+    void *userData = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        EntryIndex::iterator found = find(hash, key);
+        if (found != mIndex.end())
+        {
+            // Move the entry to the front of the LRU list.
+            mEntries.splice(mEntries.begin(), mEntries, found->second);
+            *results = found->second->results;
+            ++mHits;
+            return true;
+        }
+        if (persistent)
+        {
+            getFunction = mGetFunction;
+            userData = mUserData;
+        }
+    }
+
+    // The store may be slow, so don't hold the lock while calling into it.
+    std::string data;
+    bool stored = getFunction != NULL &&
+                  getFunction(userData, HashToString(hash), &data) &&
+                  DeserializeEntry(data, key, results);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!stored)
+    {
+        ++mMisses;
+        return false;
+    }
+
+    ++mBackingStoreHits;
+    if (find(hash, key) == mIndex.end())
+        insertLocked(hash, key, *results);
+    return true;
+}
+
+void TranslationCache::insert(const std::string &key, bool persistent,
+                              const TCompileResults &results)
+{
+    const unsigned long long hash = HashKey(key);
+
+    ShTranslationCachePutFunction putFunction = NULL;
+    void *userData = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (find(hash, key) == mIndex.end())
+            insertLocked(hash, key, results);
+        if (persistent)
+        {
+            putFunction = mPutFunction;
+            userData = mUserData;
+        }
+    }
+
+    if (putFunction)
+        putFunction(userData, HashToString(hash), SerializeEntry(key, results));
+}
+
+void TranslationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+    mSize = 0;
+    mHits = 0;
+    mBackingStoreHits = 0;
+    mMisses = 0;
+    mEvictions = 0;
+}
+
+void TranslationCache::getStatistics(ShTranslationCacheStatistics *statistics)
+{
+    ASSERT(statistics);
+    std::lock_guard<std::mutex> lock(mMutex);
+    statistics->hits = mHits;
+    statistics->backingStoreHits = mBackingStoreHits;
+    statistics->misses = mMisses;
+    statistics->evictions = mEvictions;
+    statistics->entries = mEntries.size();
+    statistics->size = mSize;
+    statistics->maxSize = mMaxSize;
+}
+
+TranslationCache::EntryIndex::iterator TranslationCache::find(unsigned long long hash,
+                                                              const std::string &key)
+{
+    std::pair<EntryIndex::iterator, EntryIndex::iterator> range = mIndex.equal_range(hash);
+    for (EntryIndex::iterator iter = range.first; iter != range.second; ++iter)
+    {
+        if (iter->second->key == key)
+            return iter;
+    }
+    return mIndex.end();
+}
+
+void TranslationCache::insertLocked(unsigned long long hash, const std::string &key,
+                                    const TCompileResults &results)
+{
+    Entry entry;
+    entry.hash = hash;
+    entry.key = key;
+    entry.size = sizeof(Entry) + key.size() + ResultsSize(results);
+    if (entry.size > mMaxSize)
+        return;
+
+    mEntries.push_front(entry);
+    mEntries.front().results = results;
+    mIndex.insert(std::make_pair(hash, mEntries.begin()));
+    mSize += entry.size;
+    evictLocked();
+}
+
+void TranslationCache::evictLocked()
+{
+    while (mSize > mMaxSize)
+    {
+        ASSERT(!mEntries.empty());
+        EntryList::iterator last = --mEntries.end();
+        std::pair<EntryIndex::iterator, EntryIndex::iterator> range = mIndex.equal_range(last->hash);
+        for (EntryIndex::iterator iter = range.first; iter != range.second; ++iter)
+        {
+            if (iter->second == last)
+            {
+                mIndex.erase(iter);
+                break;
+            }
+        }
+        mSize -= last->size;
+        mEntries.pop_back();
+        ++mEvictions;
+    }
+}
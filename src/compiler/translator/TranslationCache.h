@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+#define COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+
+#include "GLSLANG/ShaderLang.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//
+// Everything the Sh* getters report about one compile.
+//
+struct TCompileResults
+{
+    TCompileResults();
+
+    bool success;
+    int shaderVersion;
+    std::string objectCode;
+    std::string infoLog;
+    std::map<std::string, std::string> nameMap;
+
+    std::vector<sh::Attribute> attributes;
+    std::vector<sh::Attribute> outputVariables;
+    std::vector<sh::Uniform> uniforms;
+    std::vector<sh::Varying> varyings;
+    std::vector<sh::InterfaceBlock> interfaceBlocks;
+
+    // Only filled in by the HLSL translator.
+    std::map<std::string, unsigned int> interfaceBlockRegisters;
+    std::map<std::string, unsigned int> uniformRegisters;
+};
+
+//
+// A size-bounded LRU cache of compile results, optionally backed by a
+// persistent store supplied by the embedder.
+//
+// Keys must capture everything that determines the results; the cache
+// compares them in full, so hash collisions never return a wrong entry.
+// All members are safe to call from any thread.
+//
+class TranslationCache
+{
+  public:
+    TranslationCache();
+
+    // Sets the bound on the approximate memory used by the entries,
+    // evicting the least recently used ones to fit. A size of 0 disables
+    // the cache, which is the default.
+    void setMaxSize(size_t maxSize);
+    bool isEnabled();
+
+    void setBackingStore(ShTranslationCacheGetFunction getFunction,
+                         ShTranslationCachePutFunction putFunction,
+                         void *userData);
+
+    // Returns true and fills |results| if the key is in the cache or in the
+    // backing store. |persistent| must be false if the key depends on
+    // state that is only meaningful within this process.
+    bool lookup(const std::string &key, bool persistent, TCompileResults *results);
+    void insert(const std::string &key, bool persistent, const TCompileResults &results);
+
+    void clear();
+    void getStatistics(ShTranslationCacheStatistics *statistics);
+
+  private:
+    struct Entry
+    {
+        unsigned long long hash;
+        std::string key;
+        TCompileResults results;
+        size_t size;
+    };
+    typedef std::list<Entry> EntryList;
+    // Indexed by the hash of the key; several keys may share a hash.
+    typedef std::multimap<unsigned long long, EntryList::iterator> EntryIndex;
+
+    EntryIndex::iterator find(unsigned long long hash, const std::string &key);
+    void insertLocked(unsigned long long hash, const std::string &key,
+                      const TCompileResults &results);
+    void evictLocked();
+
+    std::mutex mMutex;
+
+    // Most recently used first.
+    EntryList mEntries;
+    EntryIndex mIndex;
+    size_t mSize;
+    size_t mMaxSize;
+
+    ShTranslationCacheGetFunction mGetFunction;
+    ShTranslationCachePutFunction mPutFunction;
+    void *mUserData;
+
+    size_t mHits;
+    size_t mBackingStoreHits;
+    size_t mMisses;
+    size_t mEvictions;
+};
+
+#endif  // COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
@@ -6,6 +6,7 @@
 
 #include "compiler/translator/TranslatorESSL.h"
 
+#include "compiler/translator/NameMinifier.h"
 #include "compiler/translator/OutputESSL.h"
 #include "angle_gl.h"
 
@@ -13,7 +14,7 @@ TranslatorESSL::TranslatorESSL(sh::GLenum type, ShShaderSpec spec)
     : TCompiler(type, spec, SH_ESSL_OUTPUT) {
 }
 
-void TranslatorESSL::translate(TIntermNode* root) {
+void TranslatorESSL::translate(TIntermNode* root, int compileOptions) {
     TInfoSinkBase& sink = getInfoSink().obj;
 
     writePragma();
@@ -29,7 +30,15 @@ void TranslatorESSL::translate(TIntermNode* root) {
     getArrayBoundsClamper().OutputClampingFunctionDefinition(sink);
 
     // Write translated shader.
-    TOutputESSL outputESSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion());
+    NameMinifier nameMinifier(getSymbolTable(), getShaderVersion());
+    bool minify = (compileOptions & SH_MINIFY_OUTPUT) != 0;
+    if (minify)
+    {
+        root->traverse(&nameMinifier);
+        nameMinifier.assignNames();
+    }
+    TOutputESSL outputESSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion(),
+                           minify ? &nameMinifier : NULL);
     root->traverse(&outputESSL);
 }
 
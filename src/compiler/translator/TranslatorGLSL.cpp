@@ -6,6 +6,7 @@
 
 #include "compiler/translator/TranslatorGLSL.h"
 
+#include "compiler/translator/NameMinifier.h"
 #include "compiler/translator/OutputGLSL.h"
 #include "compiler/translator/VersionGLSL.h"
 
@@ -13,7 +14,7 @@ TranslatorGLSL::TranslatorGLSL(sh::GLenum type, ShShaderSpec spec)
     : TCompiler(type, spec, SH_GLSL_OUTPUT) {
 }
 
-void TranslatorGLSL::translate(TIntermNode* root) {
+void TranslatorGLSL::translate(TIntermNode* root, int compileOptions) {
     TInfoSinkBase& sink = getInfoSink().obj;
 
     // Write GLSL version.
@@ -32,7 +33,15 @@ void TranslatorGLSL::translate(TIntermNode* root) {
     getArrayBoundsClamper().OutputClampingFunctionDefinition(sink);
 
     // Write translated shader.
-    TOutputGLSL outputGLSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion());
+    NameMinifier nameMinifier(getSymbolTable(), getShaderVersion());
+    bool minify = (compileOptions & SH_MINIFY_OUTPUT) != 0;
+    if (minify)
+    {
+        root->traverse(&nameMinifier);
+        nameMinifier.assignNames();
+    }
+    TOutputGLSL outputGLSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion(),
+                           minify ? &nameMinifier : NULL);
     root->traverse(&outputGLSL);
 }
 
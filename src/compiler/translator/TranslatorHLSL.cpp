@@ -8,13 +8,14 @@
 
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/OutputHLSL.h"
+#include "compiler/translator/TranslationCache.h"
 
 TranslatorHLSL::TranslatorHLSL(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
     : TCompiler(type, spec, output)
 {
 }
 
-void TranslatorHLSL::translate(TIntermNode *root)
+void TranslatorHLSL::translate(TIntermNode *root, int compileOptions)
 {
     TParseContext& parseContext = *GetGlobalParseContext();
     sh::OutputHLSL outputHLSL(parseContext, this);
@@ -25,6 +26,20 @@ void TranslatorHLSL::translate(TIntermNode *root)
     mUniformRegisterMap = outputHLSL.getUniformRegisterMap();
 }
 
+void TranslatorHLSL::getResults(TCompileResults *results) const
+{
+    TCompiler::getResults(results);
+    results->interfaceBlockRegisters = mInterfaceBlockRegisterMap;
+    results->uniformRegisters = mUniformRegisterMap;
+}
+
+void TranslatorHLSL::setResults(const TCompileResults &results)
+{
+    TCompiler::setResults(results);
+    mInterfaceBlockRegisterMap = results.interfaceBlockRegisters;
+    mUniformRegisterMap = results.uniformRegisters;
+}
+
 bool TranslatorHLSL::hasInterfaceBlock(const std::string &interfaceBlockName) const
 {
     return (mInterfaceBlockRegisterMap.count(interfaceBlockName) > 0);
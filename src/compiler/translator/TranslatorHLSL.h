@@ -15,6 +15,9 @@ class TranslatorHLSL : public TCompiler
     TranslatorHLSL(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output);
     virtual TranslatorHLSL *getAsTranslatorHLSL() { return this; }
 
+    virtual void getResults(TCompileResults *results) const;
+    virtual void setResults(const TCompileResults &results);
+
     bool hasInterfaceBlock(const std::string &interfaceBlockName) const;
     unsigned int getInterfaceBlockRegister(const std::string &interfaceBlockName) const;
 
@@ -22,7 +25,9 @@ class TranslatorHLSL : public TCompiler
     unsigned int getUniformRegister(const std::string &uniformName) const;
 
   protected:
-    virtual void translate(TIntermNode* root);
+    virtual void translate(TIntermNode* root, int compileOptions);
+    // The registers of the uniforms are assigned from the collected variables.
+    virtual bool shouldCollectVariables(int compileOptions) { return true; }
 
     std::map<std::string, unsigned int> mInterfaceBlockRegisterMap;
     std::map<std::string, unsigned int> mUniformRegisterMap;
@@ -167,6 +167,15 @@ TString TType::buildMangledName() const
     return mangledName;
 }
 
+void TType::computeCachedData()
+{
+    getMangledName();
+    if (structure)
+        structure->computeCachedData();
+    if (interfaceBlock)
+        interfaceBlock->computeCachedData();
+}
+
 size_t TType::getObjectSize() const
 {
     size_t totalSize;
@@ -225,6 +234,20 @@ size_t TFieldListCollection::calculateObjectSize() const
     return size;
 }
 
+void TFieldListCollection::computeCachedData()
+{
+    mangledName();
+    objectSize();
+    for (size_t i = 0; i < mFields->size(); ++i)
+        (*mFields)[i]->type()->computeCachedData();
+}
+
+void TStructure::computeCachedData()
+{
+    TFieldListCollection::computeCachedData();
+    deepestNesting();
+}
+
 int TStructure::calculateDeepestNesting() const
 {
     int maxNesting = 0;
@@ -87,6 +87,10 @@ class TFieldListCollection
         return mObjectSize;
     };
 
+    // Fills in the lazily computed members up front, so that later reads
+    // from several threads never write to a shared instance.
+    void computeCachedData();
+
   protected:
     TFieldListCollection(const TString *name, TFieldList *fields)
         : mName(name),
@@ -127,6 +131,8 @@ class TStructure : public TFieldListCollection
 
     bool equals(const TStructure &other) const;
 
+    void computeCachedData();
+
     void setUniqueId(int uniqueId)
     {
         mUniqueId = uniqueId;
@@ -390,6 +396,10 @@ class TType
         return mangled;
     }
 
+    // Computes the mangled name and the cached data of any struct or
+    // interface block, see TFieldListCollection::computeCachedData().
+    void computeCachedData();
+
     bool sameElementType(const TType &right) const
     {
         return type == right.type &&
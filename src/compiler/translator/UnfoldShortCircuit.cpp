@@ -16,7 +16,8 @@
 
 namespace sh
 {
-UnfoldShortCircuit::UnfoldShortCircuit(TParseContext &context, OutputHLSL *outputHLSL) : mContext(context), mOutputHLSL(outputHLSL)
+UnfoldShortCircuit::UnfoldShortCircuit(TParseContext &context, OutputHLSL *outputHLSL)
+    : TIntermTraverser(true, true, true), mContext(context), mOutputHLSL(outputHLSL)
 {
     mTemporaryIndex = 0;
 }
@@ -32,36 +33,28 @@ bool UnfoldShortCircuit::visitBinary(Visit visit, TIntermBinary *node)
 {
     TInfoSinkBase &out = mOutputHLSL->getBodyStream();
 
-    // If our right node doesn't have side effects, we know we don't need to unfold this
-    // expression: there will be no short-circuiting side effects to avoid
-    // (note: unfolding doesn't depend on the left node -- it will always be evaluated)
-    if (!node->getRight()->hasSideEffects())
+    // The operands of an unfolded operator are unfolded by the traversal
+    // itself, between the visits of the operator, so that long chains of
+    // them don't recurse.
+    if (visit != PreVisit)
     {
-        return true;
-    }
-
-    switch (node->getOp())
-    {
-      case EOpLogicalOr:
-        // "x || y" is equivalent to "x ? true : y", which unfolds to "bool s; if(x) s = true; else s = y;",
-        // and then further simplifies down to "bool s = x; if(!s) s = y;".
+        if (mUnfolded.empty() || mUnfolded.back().node != node)
         {
-            int i = mTemporaryIndex;
-
-            out << "bool s" << i << ";\n";
-
-            out << "{\n";
+            return true;
+        }
 
-            mTemporaryIndex = i + 1;
-            node->getLeft()->traverse(this);
+        int i = mUnfolded.back().index;
+        if (visit == InVisit)
+        {
             out << "s" << i << " = ";
             mTemporaryIndex = i + 1;
             node->getLeft()->traverse(mOutputHLSL);
             out << ";\n";
-            out << "if (!s" << i << ")\n"
+            out << (node->getOp() == EOpLogicalOr ? "if (!s" : "if (s") << i << ")\n"
                    "{\n";
-            mTemporaryIndex = i + 1;
-            node->getRight()->traverse(this);
+        }
+        else
+        {
             out << "    s" << i << " = ";
             mTemporaryIndex = i + 1;
             node->getRight()->traverse(mOutputHLSL);
@@ -70,43 +63,43 @@ bool UnfoldShortCircuit::visitBinary(Visit visit, TIntermBinary *node)
 
             out << "}\n";
 
-            mTemporaryIndex = i + 1;
+            mUnfolded.pop_back();
         }
-        return false;
+
+        mTemporaryIndex = i + 1;
+        return true;
+    }
+
+    switch (node->getOp())
+    {
+      case EOpLogicalOr:
+        // "x || y" is equivalent to "x ? true : y", which unfolds to "bool s; if(x) s = true; else s = y;",
+        // and then further simplifies down to "bool s = x; if(!s) s = y;".
       case EOpLogicalAnd:
         // "x && y" is equivalent to "x ? y : false", which unfolds to "bool s; if(x) s = y; else s = false;",
         // and then further simplifies down to "bool s = x; if(s) s = y;".
-        {
-            int i = mTemporaryIndex;
+        break;
+      default:
+        return true;
+    }
 
-            out << "bool s" << i << ";\n";
+    // If our right node doesn't have side effects, we know we don't need to unfold this
+    // expression: there will be no short-circuiting side effects to avoid
+    // (note: unfolding doesn't depend on the left node -- it will always be evaluated)
+    if (!node->getRight()->hasSideEffects())
+    {
+        return true;
+    }
 
-            out << "{\n";
+    UnfoldedOperator unfolded = { node, mTemporaryIndex };
+    mUnfolded.push_back(unfolded);
 
-            mTemporaryIndex = i + 1;
-            node->getLeft()->traverse(this);
-            out << "s" << i << " = ";
-            mTemporaryIndex = i + 1;
-            node->getLeft()->traverse(mOutputHLSL);
-            out << ";\n";
-            out << "if (s" << i << ")\n"
-                   "{\n";
-            mTemporaryIndex = i + 1;
-            node->getRight()->traverse(this);
-            out << "    s" << i << " = ";
-            mTemporaryIndex = i + 1;
-            node->getRight()->traverse(mOutputHLSL);
-            out << ";\n"
-                   "}\n";
+    out << "bool s" << unfolded.index << ";\n";
 
-            out << "}\n";
+    out << "{\n";
 
-            mTemporaryIndex = i + 1;
-        }
-        return false;
-      default:
-        return true;
-    }
+    mTemporaryIndex = unfolded.index + 1;
+    return true;
 }
 
 bool UnfoldShortCircuit::visitSelection(Visit visit, TIntermSelection *node)
@@ -33,6 +33,16 @@ class UnfoldShortCircuit : public TIntermTraverser
     OutputHLSL *const mOutputHLSL;
 
     int mTemporaryIndex;
+
+  private:
+    // A short-circuiting operator whose operands are being unfolded, and
+    // the index of the temporary holding its result.
+    struct UnfoldedOperator
+    {
+        TIntermBinary *node;
+        int index;
+    };
+    TVector<UnfoldedOperator> mUnfolded;
 };
 }
 
@@ -117,9 +117,12 @@ unsigned int UniformHLSL::declareUniformAndAssignRegister(const TType &type, con
     return registerIndex;
 }
 
-TString UniformHLSL::uniformsHeader(ShShaderOutput outputType, const ReferencedSymbols &referencedUniforms)
+void UniformHLSL::uniformsHeader(TInfoSinkBase &out, ShShaderOutput outputType, const ReferencedSymbols &referencedUniforms)
 {
-    TString uniforms;
+    if (!referencedUniforms.empty())
+    {
+        out << "// Uniforms\n\n";
+    }
 
     for (ReferencedSymbols::const_iterator uniformIt = referencedUniforms.begin();
          uniformIt != referencedUniforms.end(); uniformIt++)
@@ -132,11 +135,11 @@ TString UniformHLSL::uniformsHeader(ShShaderOutput outputType, const ReferencedS
 
         if (outputType == SH_HLSL11_OUTPUT && IsSampler(type.getBasicType()))   // Also declare the texture
         {
-            uniforms += "uniform " + SamplerString(type) + " sampler_" + DecorateUniform(name, type) + ArrayString(type) +
-                        " : register(s" + str(registerIndex) + ");\n";
+            out << "uniform " << SamplerString(type) << " sampler_" << DecorateUniform(name, type) << ArrayString(type)
+                << " : register(s" << registerIndex << ");\n";
 
-            uniforms += "uniform " + TextureString(type) + " texture_" + DecorateUniform(name, type) + ArrayString(type) +
-                        " : register(t" + str(registerIndex) + ");\n";
+            out << "uniform " << TextureString(type) << " texture_" << DecorateUniform(name, type) << ArrayString(type)
+                << " : register(t" << registerIndex << ");\n";
         }
         else
         {
@@ -148,18 +151,18 @@ TString UniformHLSL::uniformsHeader(ShShaderOutput outputType, const ReferencedS
             const TString &typeName = ((structure && !structure->name().empty()) ?
                                         QualifiedStructNameString(*structure, false, false) : TypeString(type));
 
-            const TString &registerString = TString("register(") + UniformRegisterPrefix(type) + str(registerIndex) + ")";
-
-            uniforms += "uniform " + typeName + " " + DecorateUniform(name, type) + ArrayString(type) + " : " + registerString + ";\n";
+            out << "uniform " << typeName << " " << DecorateUniform(name, type) << ArrayString(type)
+                << " : register(" << UniformRegisterPrefix(type) << registerIndex << ");\n";
         }
     }
-
-    return (uniforms.empty() ? "" : ("// Uniforms\n\n" + uniforms));
 }
 
-TString UniformHLSL::interfaceBlocksHeader(const ReferencedSymbols &referencedInterfaceBlocks)
+void UniformHLSL::interfaceBlocksHeader(TInfoSinkBase &out, const ReferencedSymbols &referencedInterfaceBlocks)
 {
-    TString interfaceBlocks;
+    if (!referencedInterfaceBlocks.empty())
+    {
+        out << "// Interface Blocks\n\n";
+    }
 
     for (ReferencedSymbols::const_iterator interfaceBlockIt = referencedInterfaceBlocks.begin();
          interfaceBlockIt != referencedInterfaceBlocks.end(); interfaceBlockIt++)
@@ -177,23 +180,21 @@ TString UniformHLSL::interfaceBlocksHeader(const ReferencedSymbols &referencedIn
 
         if (interfaceBlock.hasInstanceName())
         {
-            interfaceBlocks += interfaceBlockStructString(interfaceBlock);
+            out << interfaceBlockStructString(interfaceBlock);
         }
 
         if (arraySize > 0)
         {
             for (unsigned int arrayIndex = 0; arrayIndex < arraySize; arrayIndex++)
             {
-                interfaceBlocks += interfaceBlockString(interfaceBlock, activeRegister + arrayIndex, arrayIndex);
+                out << interfaceBlockString(interfaceBlock, activeRegister + arrayIndex, arrayIndex);
             }
         }
         else
         {
-            interfaceBlocks += interfaceBlockString(interfaceBlock, activeRegister, GL_INVALID_INDEX);
+            out << interfaceBlockString(interfaceBlock, activeRegister, GL_INVALID_INDEX);
         }
     }
-
-    return (interfaceBlocks.empty() ? "" : ("// Interface Blocks\n\n" + interfaceBlocks));
 }
 
 TString UniformHLSL::interfaceBlockString(const TInterfaceBlock &interfaceBlock, unsigned int registerIndex, unsigned int arrayIndex)
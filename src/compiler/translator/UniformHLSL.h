@@ -12,6 +12,8 @@
 
 #include "compiler/translator/Types.h"
 
+class TInfoSinkBase;
+
 namespace sh
 {
 class StructureHLSL;
@@ -23,8 +25,8 @@ class UniformHLSL
 
     void reserveUniformRegisters(unsigned int registerCount);
     void reserveInterfaceBlockRegisters(unsigned int registerCount);
-    TString uniformsHeader(ShShaderOutput outputType, const ReferencedSymbols &referencedUniforms);
-    TString interfaceBlocksHeader(const ReferencedSymbols &referencedInterfaceBlocks);
+    void uniformsHeader(TInfoSinkBase &out, ShShaderOutput outputType, const ReferencedSymbols &referencedUniforms);
+    void interfaceBlocksHeader(TInfoSinkBase &out, const ReferencedSymbols &referencedInterfaceBlocks);
 
     // Used for direct index references
     static TString interfaceBlockInstanceString(const TInterfaceBlock& interfaceBlock, unsigned int arrayIndex);
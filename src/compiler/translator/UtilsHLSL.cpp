@@ -14,7 +14,7 @@
 namespace sh
 {
 
-TString SamplerString(const TType &type)
+const char *SamplerString(const TType &type)
 {
     if (IsShadowSampler(type.getBasicType()))
     {
@@ -26,7 +26,7 @@ TString SamplerString(const TType &type)
     }
 }
 
-TString TextureString(const TType &type)
+const char *TextureString(const TType &type)
 {
     switch (type.getBasicType())
     {
@@ -104,9 +104,16 @@ TString TypeString(const TType &type)
     }
     else if (type.isMatrix())
     {
+        static const char *const matrixNames[3][3] =
+        {
+            { "float2x2", "float2x3", "float2x4" },
+            { "float3x2", "float3x3", "float3x4" },
+            { "float4x2", "float4x3", "float4x4" },
+        };
         int cols = type.getCols();
         int rows = type.getRows();
-        return "float" + str(cols) + "x" + str(rows);
+        ASSERT(cols >= 2 && cols <= 4 && rows >= 2 && rows <= 4);
+        return matrixNames[cols - 2][rows - 2];
     }
     else
     {
@@ -204,7 +211,7 @@ TString QualifiedStructNameString(const TStructure &structure, bool useHLSLRowMa
     return prefix + StructNameString(structure);
 }
 
-TString InterpolationString(TQualifier qualifier)
+const char *InterpolationString(TQualifier qualifier)
 {
     switch (qualifier)
     {
@@ -226,7 +233,7 @@ TString InterpolationString(TQualifier qualifier)
     return "";
 }
 
-TString QualifierString(TQualifier qualifier)
+const char *QualifierString(TQualifier qualifier)
 {
     switch (qualifier)
     {
@@ -18,8 +18,10 @@
 namespace sh
 {
 
-TString TextureString(const TType &type);
-TString SamplerString(const TType &type);
+// The fixed strings are returned as literals, so that they can be streamed
+// into the output without building a TString.
+const char *TextureString(const TType &type);
+const char *SamplerString(const TType &type);
 // Prepends an underscore to avoid naming clashes
 TString Decorate(const TString &string);
 TString DecorateUniform(const TString &string, const TType &type);
@@ -29,8 +31,8 @@ TString TypeString(const TType &type);
 TString StructNameString(const TStructure &structure);
 TString QualifiedStructNameString(const TStructure &structure, bool useHLSLRowMajorPacking,
                                   bool useStd140Packing);
-TString InterpolationString(TQualifier qualifier);
-TString QualifierString(TQualifier qualifier);
+const char *InterpolationString(TQualifier qualifier);
+const char *QualifierString(TQualifier qualifier);
 
 }
 
@@ -55,11 +55,21 @@ void ExpandVariable(const ShaderVariable &variable,
     {
         if (variable.isArray())
         {
+            // The elements only differ by the prefix of their fields' names,
+            // so the struct is expanded once, nested arrays included.
+            std::vector<ShaderVariable> fields;
+            ExpandUserDefinedVariable(variable, "", "", markStaticUse, &fields);
+
             for (size_t elementIndex = 0; elementIndex < variable.elementCount(); elementIndex++)
             {
                 std::string lname = name + ::ArrayString(elementIndex);
                 std::string lmappedName = mappedName + ::ArrayString(elementIndex);
-                ExpandUserDefinedVariable(variable, lname, lmappedName, markStaticUse, expanded);
+                for (size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++)
+                {
+                    expanded->push_back(fields[fieldIndex]);
+                    expanded->back().name.insert(0, lname);
+                    expanded->back().mappedName.insert(0, lmappedName);
+                }
             }
         }
         else
@@ -111,18 +121,24 @@ void ExpandUserDefinedVariable(const ShaderVariable &variable,
     }
 }
 
+template <class VarT>
+void AddToIndex(const std::vector<VarT> &infoList, size_t first, NameIndex *nameIndex)
+{
+    // The first of variables with the same name is the one found.
+    for (size_t ii = first; ii < infoList.size(); ++ii)
+        nameIndex->insert(std::make_pair(infoList[ii].name, ii));
+}
+
 template <class VarT>
 VarT *FindVariable(const TString &name,
-                  std::vector<VarT> *infoList)
+                   const NameIndex &nameIndex,
+                   std::vector<VarT> *infoList)
 {
-    // TODO(zmo): optimize this function.
-    for (size_t ii = 0; ii < infoList->size(); ++ii)
-    {
-        if ((*infoList)[ii].name.c_str() == name)
-            return &((*infoList)[ii]);
-    }
+    NameIndex::const_iterator it = nameIndex.find(std::string(name.c_str(), name.size()));
+    if (it == nameIndex.end())
+        return NULL;
 
-    return NULL;
+    return &((*infoList)[it->second]);
 }
 
 }
@@ -147,6 +163,29 @@ CollectVariables::CollectVariables(std::vector<sh::Attribute> *attribs,
       mHashFunction(hashFunction),
       mSymbolTable(symbolTable)
 {
+    AddToIndex(*mAttribs, 0, &mAttribIndex);
+    AddToIndex(*mOutputVariables, 0, &mOutputVariableIndex);
+    AddToIndex(*mUniforms, 0, &mUniformIndex);
+    AddToIndex(*mVaryings, 0, &mVaryingIndex);
+    AddToIndex(*mInterfaceBlocks, 0, &mInterfaceBlockIndex);
+}
+
+InterfaceBlock *CollectVariables::findInterfaceBlock(const TString &name, NameIndex **fieldIndex)
+{
+    InterfaceBlock *block = FindVariable(name, mInterfaceBlockIndex, mInterfaceBlocks);
+    if (block && fieldIndex)
+    {
+        size_t blockIndex = block - &mInterfaceBlocks->front();
+        std::unordered_map<size_t, NameIndex>::iterator it =
+            mInterfaceBlockFieldIndices.find(blockIndex);
+        if (it == mInterfaceBlockFieldIndices.end())
+        {
+            it = mInterfaceBlockFieldIndices.insert(std::make_pair(blockIndex, NameIndex())).first;
+            AddToIndex(block->fields, 0, &it->second);
+        }
+        *fieldIndex = &it->second;
+    }
+    return block;
 }
 
 // We want to check whether a uniform/varying is statically used
@@ -162,7 +201,7 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
 
     if (IsVarying(symbol->getQualifier()))
     {
-        var = FindVariable(symbolName, mVaryings);
+        var = FindVariable(symbolName, mVaryingIndex, mVaryings);
     }
     else if (symbol->getType().getBasicType() == EbtInterfaceBlock)
     {
@@ -174,19 +213,20 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
         {
           case EvqAttribute:
           case EvqVertexIn:
-            var = FindVariable(symbolName, mAttribs);
+            var = FindVariable(symbolName, mAttribIndex, mAttribs);
             break;
           case EvqFragmentOut:
-            var = FindVariable(symbolName, mOutputVariables);
+            var = FindVariable(symbolName, mOutputVariableIndex, mOutputVariables);
             break;
           case EvqUniform:
             {
                 const TInterfaceBlock *interfaceBlock = symbol->getType().getInterfaceBlock();
                 if (interfaceBlock)
                 {
-                    InterfaceBlock *namedBlock = FindVariable(interfaceBlock->name(), mInterfaceBlocks);
+                    NameIndex *fieldIndex = NULL;
+                    InterfaceBlock *namedBlock = findInterfaceBlock(interfaceBlock->name(), &fieldIndex);
                     ASSERT(namedBlock);
-                    var = FindVariable(symbolName, &namedBlock->fields);
+                    var = FindVariable(symbolName, *fieldIndex, &namedBlock->fields);
 
                     // Set static use on the parent interface block here
                     namedBlock->staticUse = true;
@@ -194,7 +234,7 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
                 }
                 else
                 {
-                    var = FindVariable(symbolName, mUniforms);
+                    var = FindVariable(symbolName, mUniformIndex, mUniforms);
                 }
 
                 // It's an internal error to reference an undefined user uniform
@@ -376,8 +416,10 @@ void CollectVariables::visitVariable(const TIntermSymbol *variable,
 
 template <typename VarT>
 void CollectVariables::visitInfoList(const TIntermSequence &sequence,
-                                     std::vector<VarT> *infoList) const
+                                     std::vector<VarT> *infoList,
+                                     NameIndex *nameIndex)
 {
+    size_t first = infoList->size();
     for (size_t seqIndex = 0; seqIndex < sequence.size(); seqIndex++)
     {
         const TIntermSymbol *variable = sequence[seqIndex]->getAsSymbolNode();
@@ -389,6 +431,7 @@ void CollectVariables::visitInfoList(const TIntermSequence &sequence,
         ASSERT(variable != NULL);
         visitVariable(variable, infoList);
     }
+    AddToIndex(*infoList, first, nameIndex);
 }
 
 bool CollectVariables::visitAggregate(Visit, TIntermAggregate *node)
@@ -407,7 +450,7 @@ bool CollectVariables::visitAggregate(Visit, TIntermAggregate *node)
 
             if (typedNode.getBasicType() == EbtInterfaceBlock)
             {
-                visitInfoList(sequence, mInterfaceBlocks);
+                visitInfoList(sequence, mInterfaceBlocks, &mInterfaceBlockIndex);
                 visitChildren = false;
             }
             else if (qualifier == EvqAttribute || qualifier == EvqVertexIn ||
@@ -418,16 +461,16 @@ bool CollectVariables::visitAggregate(Visit, TIntermAggregate *node)
                 {
                   case EvqAttribute:
                   case EvqVertexIn:
-                    visitInfoList(sequence, mAttribs);
+                    visitInfoList(sequence, mAttribs, &mAttribIndex);
                     break;
                   case EvqFragmentOut:
-                    visitInfoList(sequence, mOutputVariables);
+                    visitInfoList(sequence, mOutputVariables, &mOutputVariableIndex);
                     break;
                   case EvqUniform:
-                    visitInfoList(sequence, mUniforms);
+                    visitInfoList(sequence, mUniforms, &mUniformIndex);
                     break;
                   default:
-                    visitInfoList(sequence, mVaryings);
+                    visitInfoList(sequence, mVaryings, &mVaryingIndex);
                     break;
                 }
 
@@ -453,7 +496,7 @@ bool CollectVariables::visitBinary(Visit, TIntermBinary *binaryNode)
         ASSERT(constantUnion);
 
         const TInterfaceBlock *interfaceBlock = blockNode->getType().getInterfaceBlock();
-        InterfaceBlock *namedBlock = FindVariable(interfaceBlock->name(), mInterfaceBlocks);
+        InterfaceBlock *namedBlock = findInterfaceBlock(interfaceBlock->name(), NULL);
         ASSERT(namedBlock);
         namedBlock->staticUse = true;
 
@@ -476,4 +519,14 @@ void ExpandUniforms(const std::vector<Uniform> &compact,
     }
 }
 
+void ExpandVaryings(const std::vector<Varying> &compact,
+                    std::vector<ShaderVariable> *expanded)
+{
+    for (size_t variableIndex = 0; variableIndex < compact.size(); variableIndex++)
+    {
+        const ShaderVariable &variable = compact[variableIndex];
+        ExpandVariable(variable, variable.name, variable.mappedName, variable.staticUse, expanded);
+    }
+}
+
 }
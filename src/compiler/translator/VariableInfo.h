@@ -7,6 +7,8 @@
 #ifndef COMPILER_VARIABLE_INFO_H_
 #define COMPILER_VARIABLE_INFO_H_
 
+#include <unordered_map>
+
 #include <GLSLANG/ShaderLang.h>
 
 #include "compiler/translator/IntermNode.h"
@@ -16,6 +18,9 @@ class TSymbolTable;
 namespace sh
 {
 
+// Maps the names of the variables of an info list to their index in it.
+typedef std::unordered_map<std::string, size_t> NameIndex;
+
 // Traverses intermediate tree to collect all attributes, uniforms, varyings.
 class CollectVariables : public TIntermTraverser
 {
@@ -37,7 +42,10 @@ class CollectVariables : public TIntermTraverser
     void visitVariable(const TIntermSymbol *variable, std::vector<VarT> *infoList) const;
 
     template <typename VarT>
-    void visitInfoList(const TIntermSequence &sequence, std::vector<VarT> *infoList) const;
+    void visitInfoList(const TIntermSequence &sequence, std::vector<VarT> *infoList,
+                       NameIndex *nameIndex);
+
+    InterfaceBlock *findInterfaceBlock(const TString &name, NameIndex **fieldIndex);
 
     std::vector<Attribute> *mAttribs;
     std::vector<Attribute> *mOutputVariables;
@@ -45,7 +53,16 @@ class CollectVariables : public TIntermTraverser
     std::vector<Varying> *mVaryings;
     std::vector<InterfaceBlock> *mInterfaceBlocks;
 
-    std::map<std::string, InterfaceBlockField *> mInterfaceBlockFields;
+    // The symbols reference the variables by name: these find them without
+    // scanning the lists, which may hold thousands of uniforms.
+    NameIndex mAttribIndex;
+    NameIndex mOutputVariableIndex;
+    NameIndex mUniformIndex;
+    NameIndex mVaryingIndex;
+    NameIndex mInterfaceBlockIndex;
+    // The index of the fields of each interface block, by block index,
+    // built when the block is first looked up.
+    std::unordered_map<size_t, NameIndex> mInterfaceBlockFieldIndices;
 
     bool mPointCoordAdded;
     bool mFrontFacingAdded;
@@ -62,6 +79,9 @@ class CollectVariables : public TIntermTraverser
 // Expand struct uniforms to flattened lists of split variables
 void ExpandUniforms(const std::vector<Uniform> &compact,
                     std::vector<ShaderVariable> *expanded);
+// Expand struct varyings the same way, for the varying packing check
+void ExpandVaryings(const std::vector<Varying> &compact,
+                    std::vector<ShaderVariable> *expanded);
 
 }
 
@@ -69,184 +69,121 @@ int VariablePacker::GetNumRows(sh::GLenum type)
 
 struct TVariableInfoComparer
 {
-    bool operator()(const sh::ShaderVariable &lhs, const sh::ShaderVariable &rhs) const
+    template <typename ItemT>
+    bool operator()(const ItemT &lhs, const ItemT &rhs) const
     {
-        int lhsSortOrder = gl::VariableSortOrder(lhs.type);
-        int rhsSortOrder = gl::VariableSortOrder(rhs.type);
-        if (lhsSortOrder != rhsSortOrder) {
-            return lhsSortOrder < rhsSortOrder;
+        if (lhs.sortOrder != rhs.sortOrder) {
+            return lhs.sortOrder < rhs.sortOrder;
         }
         // Sort by largest first.
         return lhs.arraySize > rhs.arraySize;
     }
 };
 
-unsigned VariablePacker::makeColumnFlags(int column, int numComponentsPerRow)
-{
-    return ((kColumnMask << (kNumColumns - numComponentsPerRow)) &
-                    kColumnMask) >> column;
-}
-
-void VariablePacker::fillColumns(int topRow, int numRows, int column, int numComponentsPerRow)
-{
-    unsigned columnFlags = makeColumnFlags(column, numComponentsPerRow);
-    for (int r = 0; r < numRows; ++r) {
-        int row = topRow + r;
-        ASSERT((rows_[row] & columnFlags) == 0);
-        rows_[row] |= columnFlags;
-    }
-}
-
-bool VariablePacker::searchColumn(int column, int numRows, int* destRow, int* destSize)
+template <typename VarT>
+bool VariablePacker::addItems(unsigned int maxVectors, const std::vector<VarT> &variables)
 {
-    ASSERT(destRow);
-
-    for (; topNonFullRow_ < maxRows_ && rows_[topNonFullRow_] == kColumnMask;
-         ++topNonFullRow_) {
-    }
-
-    for (; bottomNonFullRow_ >= 0 && rows_[bottomNonFullRow_] == kColumnMask;
-         --bottomNonFullRow_) {
-    }
-
-    if (bottomNonFullRow_ - topNonFullRow_ + 1 < numRows) {
-        return false;
-    }
+    items_.clear();
+    items_.reserve(variables.size());
+    for (size_t i = 0; i < variables.size(); i++) {
+        const sh::ShaderVariable &variable = variables[i];
 
-    unsigned columnFlags = makeColumnFlags(column, 1);
-    int topGoodRow = 0;
-    int smallestGoodTop = -1;
-    int smallestGoodSize = maxRows_ + 1;
-    int bottomRow = bottomNonFullRow_ + 1;
-    bool found = false;
-    for (int row = topNonFullRow_; row <= bottomRow; ++row) {
-        bool rowEmpty = row < bottomRow ? ((rows_[row] & columnFlags) == 0) : false;
-        if (rowEmpty) {
-            if (!found) {
-                topGoodRow = row;
-                found = true;
-            }
-        } else {
-            if (found) {
-                int size = row - topGoodRow;
-                if (size >= numRows && size < smallestGoodSize) {
-                    smallestGoodSize = size;
-                    smallestGoodTop = topGoodRow;
-                }
-            }
-            found = false;
+        // Check whether each variable fits in the available vectors.
+        int numRows = GetNumRows(variable.type);
+        if (variable.elementCount() > maxVectors / numRows) {
+            return false;
         }
-    }
-    if (smallestGoodTop < 0) {
-        return false;
-    }
 
-    *destRow = smallestGoodTop;
-    if (destSize) {
-        *destSize = smallestGoodSize;
+        Item item;
+        item.sortOrder = gl::VariableSortOrder(variable.type);
+        item.arraySize = variable.arraySize;
+        item.numComponentsPerRow = GetNumComponentsPerRow(variable.type);
+        item.numRows = numRows * variable.elementCount();
+        item.index = i;
+        items_.push_back(item);
     }
     return true;
 }
 
-template <typename VarT>
-bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int maxVectors,
-                                                       const std::vector<VarT> &in_variables)
+void VariablePacker::place(const Item &item, int row, int column,
+                           std::vector<Placement> *placements)
 {
-    ASSERT(maxVectors > 0);
-    maxRows_ = maxVectors;
-    topNonFullRow_ = 0;
-    bottomNonFullRow_ = maxRows_ - 1;
-    std::vector<VarT> variables(in_variables);
-
-    // Check whether each variable fits in the available vectors.
-    for (size_t i = 0; i < variables.size(); i++) {
-        const sh::ShaderVariable &variable = variables[i];
-        if (variable.elementCount() > maxVectors / GetNumRows(variable.type)) {
-            return false;
-        }
+    if (placements) {
+        Placement &placement = (*placements)[item.index];
+        placement.row = row;
+        placement.column = column;
     }
+}
+
+// Each kind of variable is packed against the ones before it, and the
+// single column variables always take the top of the free rows of a column,
+// so the free rows of every column stay one run. The best fit among the
+// columns that the spec asks for is then the shortest of four runs, and
+// there is no need to keep the occupancy of each row.
+bool VariablePacker::pack(unsigned int maxVectors, std::vector<Placement> *placements)
+{
+    const int maxRows = maxVectors;
 
     // As per GLSL 1.017 Appendix A, Section 7 variables are packed in specific
-    // order by type, then by size of array, largest first.
-    std::sort(variables.begin(), variables.end(), TVariableInfoComparer());
-    rows_.clear();
-    rows_.resize(maxVectors, 0);
+    // order by type, then by size of array, largest first. The sort is stable
+    // so that the placements don't depend on the sort implementation.
+    std::stable_sort(items_.begin(), items_.end(), TVariableInfoComparer());
+    if (placements) {
+        placements->resize(items_.size());
+    }
 
     // Packs the 4 column variables.
     size_t ii = 0;
-    for (; ii < variables.size(); ++ii) {
-        const sh::ShaderVariable &variable = variables[ii];
-        if (GetNumComponentsPerRow(variable.type) != 4) {
-            break;
+    int top3ColumnRow = 0;
+    for (; ii < items_.size() && items_[ii].numComponentsPerRow == 4; ++ii) {
+        place(items_[ii], top3ColumnRow, 0, placements);
+        top3ColumnRow += items_[ii].numRows;
+        if (top3ColumnRow > maxRows) {
+            return false;
         }
-        topNonFullRow_ += GetNumRows(variable.type) * variable.elementCount();
-    }
-
-    if (topNonFullRow_ > maxRows_) {
-        return false;
     }
 
     // Packs the 3 column variables.
-    int num3ColumnRows = 0;
-    for (; ii < variables.size(); ++ii) {
-        const sh::ShaderVariable &variable = variables[ii];
-        if (GetNumComponentsPerRow(variable.type) != 3) {
-            break;
+    int top2ColumnRow = top3ColumnRow;
+    for (; ii < items_.size() && items_[ii].numComponentsPerRow == 3; ++ii) {
+        place(items_[ii], top2ColumnRow, 0, placements);
+        top2ColumnRow += items_[ii].numRows;
+        if (top2ColumnRow > maxRows) {
+            return false;
         }
-        num3ColumnRows += GetNumRows(variable.type) * variable.elementCount();
     }
 
-    if (topNonFullRow_ + num3ColumnRows > maxRows_) {
-        return false;
-    }
-
-    fillColumns(topNonFullRow_, num3ColumnRows, 0, 3);
-
-    // Packs the 2 column variables.
-    int top2ColumnRow = topNonFullRow_ + num3ColumnRows;
-    int twoColumnRowsAvailable = maxRows_ - top2ColumnRow;
-    int rowsAvailableInColumns01 = twoColumnRowsAvailable;
-    int rowsAvailableInColumns23 = twoColumnRowsAvailable;
-    for (; ii < variables.size(); ++ii) {
-        const sh::ShaderVariable &variable = variables[ii];
-        if (GetNumComponentsPerRow(variable.type) != 2) {
-            break;
-        }
-        int numRows = GetNumRows(variable.type) * variable.elementCount();
-        if (numRows <= rowsAvailableInColumns01) {
-            rowsAvailableInColumns01 -= numRows;
-        } else if (numRows <= rowsAvailableInColumns23) {
-            rowsAvailableInColumns23 -= numRows;
+    // Packs the 2 column variables, top down in columns 0 and 1 while they
+    // fit, and then bottom up in columns 2 and 3.
+    int bottomOfColumns01 = top2ColumnRow;
+    int topOfColumns23 = maxRows;
+    for (; ii < items_.size() && items_[ii].numComponentsPerRow == 2; ++ii) {
+        int numRows = items_[ii].numRows;
+        if (numRows <= maxRows - bottomOfColumns01) {
+            place(items_[ii], bottomOfColumns01, 0, placements);
+            bottomOfColumns01 += numRows;
+        } else if (numRows <= topOfColumns23 - top2ColumnRow) {
+            topOfColumns23 -= numRows;
+            place(items_[ii], topOfColumns23, 2, placements);
         } else {
             return false;
         }
     }
 
-    int numRowsUsedInColumns01 =
-        twoColumnRowsAvailable - rowsAvailableInColumns01;
-    int numRowsUsedInColumns23 =
-        twoColumnRowsAvailable - rowsAvailableInColumns23;
-    fillColumns(top2ColumnRow, numRowsUsedInColumns01, 0, 2);
-    fillColumns(maxRows_ - numRowsUsedInColumns23, numRowsUsedInColumns23,
-                2, 2);
-
-    // Packs the 1 column variables.
-    for (; ii < variables.size(); ++ii) {
-        const sh::ShaderVariable &variable = variables[ii];
-        ASSERT(1 == GetNumComponentsPerRow(variable.type));
-        int numRows = GetNumRows(variable.type) * variable.elementCount();
+    // Packs the 1 column variables at the top of the smallest run of free
+    // rows that holds them, in the leftmost column on a tie.
+    int runTop[kNumColumns] = { bottomOfColumns01, bottomOfColumns01, top2ColumnRow, top3ColumnRow };
+    int runBottom[kNumColumns] = { maxRows, maxRows, topOfColumns23, topOfColumns23 };
+    for (; ii < items_.size(); ++ii) {
+        ASSERT(1 == items_[ii].numComponentsPerRow);
+        int numRows = items_[ii].numRows;
         int smallestColumn = -1;
-        int smallestSize = maxRows_ + 1;
-        int topRow = -1;
+        int smallestSize = maxRows + 1;
         for (int column = 0; column < kNumColumns; ++column) {
-            int row = 0;
-            int size = 0;
-            if (searchColumn(column, numRows, &row, &size)) {
-                if (size < smallestSize) {
-                    smallestSize = size;
-                    smallestColumn = column;
-                    topRow = row;
-                }
+            int size = runBottom[column] - runTop[column];
+            if (size >= numRows && size < smallestSize) {
+                smallestSize = size;
+                smallestColumn = column;
             }
         }
 
@@ -254,16 +191,37 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int maxVectors,
             return false;
         }
 
-        fillColumns(topRow, numRows, smallestColumn, 1);
+        place(items_[ii], runTop[smallestColumn], smallestColumn, placements);
+        runTop[smallestColumn] += numRows;
     }
 
-    ASSERT(variables.size() == ii);
-
     return true;
 }
 
+template <typename VarT>
+bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int maxVectors,
+                                                       const std::vector<VarT> &in_variables)
+{
+    ASSERT(maxVectors > 0);
+    return addItems(maxVectors, in_variables) && pack(maxVectors, NULL);
+}
+
+template <typename VarT>
+bool VariablePacker::PackVariables(unsigned int maxVectors,
+                                   const std::vector<VarT> &in_variables,
+                                   std::vector<Placement> *placements)
+{
+    ASSERT(maxVectors > 0);
+    ASSERT(placements);
+    return addItems(maxVectors, in_variables) && pack(maxVectors, placements);
+}
+
 // Instantiate all possible variable packings
 template bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int, const std::vector<sh::ShaderVariable> &);
 template bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int, const std::vector<sh::Attribute> &);
 template bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int, const std::vector<sh::Uniform> &);
 template bool VariablePacker::CheckVariablesWithinPackingLimits(unsigned int, const std::vector<sh::Varying> &);
+template bool VariablePacker::PackVariables(unsigned int, const std::vector<sh::ShaderVariable> &, std::vector<Placement> *);
+template bool VariablePacker::PackVariables(unsigned int, const std::vector<sh::Attribute> &, std::vector<Placement> *);
+template bool VariablePacker::PackVariables(unsigned int, const std::vector<sh::Uniform> &, std::vector<Placement> *);
+template bool VariablePacker::PackVariables(unsigned int, const std::vector<sh::Varying> &, std::vector<Placement> *);
@@ -12,12 +12,28 @@
 
 class VariablePacker {
  public:
+    // Where a variable is packed: the row of its first element, and its
+    // leftmost column. The rows of its elements follow each other.
+    struct Placement
+    {
+        int row;
+        int column;
+    };
+
     // Returns true if the passed in variables pack in maxVectors following
     // the packing rules from the GLSL 1.017 spec, Appendix A, section 7.
     template <typename VarT>
     bool CheckVariablesWithinPackingLimits(unsigned int maxVectors,
                                            const std::vector<VarT> &in_variables);
 
+    // Packs the variables like CheckVariablesWithinPackingLimits, and if they
+    // fit, sets placements to where each of them went, in the order of
+    // in_variables.
+    template <typename VarT>
+    bool PackVariables(unsigned int maxVectors,
+                       const std::vector<VarT> &in_variables,
+                       std::vector<Placement> *placements);
+
     // Gets how many components in a row a data type takes.
     static int GetNumComponentsPerRow(sh::GLenum type);
 
@@ -26,16 +42,26 @@ class VariablePacker {
 
   private:
     static const int kNumColumns = 4;
-    static const unsigned kColumnMask = (1 << kNumColumns) - 1;
 
-    unsigned makeColumnFlags(int column, int numComponentsPerRow);
-    void fillColumns(int topRow, int numRows, int column, int numComponentsPerRow);
-    bool searchColumn(int column, int numRows, int* destRow, int* destSize);
+    // What the packing needs to know of a variable.
+    struct Item
+    {
+        int sortOrder;
+        unsigned int arraySize;
+        int numComponentsPerRow;
+        // The rows of all of its elements.
+        int numRows;
+        // Its index in the variables passed in.
+        size_t index;
+    };
+
+    template <typename VarT>
+    bool addItems(unsigned int maxVectors, const std::vector<VarT> &variables);
+    bool pack(unsigned int maxVectors, std::vector<Placement> *placements);
+    void place(const Item &item, int row, int column, std::vector<Placement> *placements);
 
-    int topNonFullRow_;
-    int bottomNonFullRow_;
-    int maxRows_;
-    std::vector<unsigned> rows_;
+    // Kept from one packing to the next, to reuse its storage.
+    std::vector<Item> items_;
 };
 
 #endif // _VARIABLEPACKER_INCLUDED_
@@ -19,15 +19,15 @@ bool TDependencyGraphBuilder::visitAggregate(
     {
       case EOpFunction:
         visitFunctionDefinition(intermAggregate);
-        break;
+        return false;
       case EOpFunctionCall:
         visitFunctionCall(intermAggregate);
-        break;
+        return false;
       default:
-        visitAggregateChildren(intermAggregate);
-        break;
+        // The children are traversed after the visit, so that long chains
+        // of aggregates don't recurse.
+        return true;
     }
-    return false;
 }
 
 void TDependencyGraphBuilder::visitFunctionDefinition(
@@ -110,13 +110,37 @@ bool TDependencyGraphBuilder::visitBinary(Visit visit, TIntermBinary *intermBina
 {
     TOperator op = intermBinary->getOp();
     if (op == EOpInitialize || intermBinary->isAssignment())
+    {
         visitAssignment(intermBinary);
-    else if (op == EOpLogicalAnd || op == EOpLogicalOr)
-        visitLogicalOp(intermBinary);
-    else
-        visitBinaryChildren(intermBinary);
+        return false;
+    }
 
-    return false;
+    // The children of the other operators are traversed between the visits,
+    // so that long chains of operators don't recurse.
+    bool isLogicalOp = (op == EOpLogicalAnd || op == EOpLogicalOr);
+    switch (visit)
+    {
+      case PreVisit:
+        if (isLogicalOp)
+            mNodeSets.pushSet();
+        break;
+      case InVisit:
+        if (isLogicalOp)
+        {
+            if (TParentNodeSet *leftNodes = mNodeSets.getTopSet())
+            {
+                TGraphLogicalOp *logicalOp = mGraph->createLogicalOp(intermBinary);
+                connectMultipleNodesToSingleNode(leftNodes, logicalOp);
+            }
+            mNodeSets.popSetIntoNext();
+        }
+        pushRightSubtree();
+        break;
+      case PostVisit:
+        popRightSubtree();
+        break;
+    }
+    return true;
 }
 
 void TDependencyGraphBuilder::visitAssignment(TIntermBinary *intermAssignment)
@@ -162,37 +186,21 @@ void TDependencyGraphBuilder::visitAssignment(TIntermBinary *intermAssignment)
     mNodeSets.insertIntoTopSet(leftmostSymbol);
 }
 
-void TDependencyGraphBuilder::visitLogicalOp(TIntermBinary *intermLogicalOp)
+void TDependencyGraphBuilder::pushRightSubtree()
 {
-    if (TIntermTyped *intermLeft = intermLogicalOp->getLeft())
-    {
-        TNodeSetPropagatingMaintainer nodeSetMaintainer(this);
-
-        intermLeft->traverse(this);
-        if (TParentNodeSet *leftNodes = mNodeSets.getTopSet())
-        {
-            TGraphLogicalOp *logicalOp = mGraph->createLogicalOp(intermLogicalOp);
-            connectMultipleNodesToSingleNode(leftNodes, logicalOp);
-        }
-    }
-
-    if (TIntermTyped *intermRight = intermLogicalOp->getRight())
-    {
-        TLeftmostSymbolMaintainer leftmostSymbolMaintainer(this, mRightSubtree);
-        intermRight->traverse(this);
-    }
+    // Same as TLeftmostSymbolMaintainer under a right subtree.
+    bool needsPlaceholderSymbol =
+        mLeftmostSymbols.empty() || mLeftmostSymbols.top() != &mRightSubtree;
+    if (needsPlaceholderSymbol)
+        mLeftmostSymbols.push(&mRightSubtree);
+    mRightSubtreePlaceholders.push(needsPlaceholderSymbol);
 }
 
-void TDependencyGraphBuilder::visitBinaryChildren(TIntermBinary *intermBinary)
+void TDependencyGraphBuilder::popRightSubtree()
 {
-    if (TIntermTyped *intermLeft = intermBinary->getLeft())
-        intermLeft->traverse(this);
-
-    if (TIntermTyped *intermRight = intermBinary->getRight())
-    {
-        TLeftmostSymbolMaintainer leftmostSymbolMaintainer(this, mRightSubtree);
-        intermRight->traverse(this);
-    }
+    if (mRightSubtreePlaceholders.top())
+        mLeftmostSymbols.pop();
+    mRightSubtreePlaceholders.pop();
 }
 
 bool TDependencyGraphBuilder::visitSelection(
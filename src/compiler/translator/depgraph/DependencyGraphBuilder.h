@@ -117,24 +117,6 @@ class TDependencyGraphBuilder : public TIntermTraverser
         TNodeSetStack &mSets;
     };
 
-    //
-    // An instance of this class pushes a new node set when instantiated.
-    // When the instance goes out of scope, it and pops the top node set and adds
-    // its contents to the new top node set.
-    //
-    class TNodeSetPropagatingMaintainer
-    {
-      public:
-        TNodeSetPropagatingMaintainer(TDependencyGraphBuilder *factory)
-            : mSets(factory->mNodeSets)
-        {
-            mSets.pushSet();
-        }
-        ~TNodeSetPropagatingMaintainer() { mSets.popSetIntoNext(); }
-      protected:
-        TNodeSetStack &mSets;
-    };
-
     //
     // An instance of this class keeps track of the leftmost symbol while we're
     // exploring an assignment.
@@ -172,7 +154,7 @@ class TDependencyGraphBuilder : public TIntermTraverser
     };
 
     TDependencyGraphBuilder(TDependencyGraph *graph)
-        : TIntermTraverser(true, false, false),
+        : TIntermTraverser(true, true, true),
           mLeftSubtree(NULL),
           mRightSubtree(NULL),
           mGraph(graph) {}
@@ -182,8 +164,10 @@ class TDependencyGraphBuilder : public TIntermTraverser
         TParentNodeSet *nodes, TGraphNode *node) const;
 
     void visitAssignment(TIntermBinary *);
-    void visitLogicalOp(TIntermBinary *);
-    void visitBinaryChildren(TIntermBinary *);
+    // Keep track of the leftmost symbol around the right child of a binary
+    // node whose children are traversed between its visits.
+    void pushRightSubtree();
+    void popRightSubtree();
     void visitFunctionDefinition(TIntermAggregate *);
     void visitFunctionCall(TIntermAggregate *intermFunctionCall);
     void visitAggregateChildren(TIntermAggregate *);
@@ -194,6 +178,7 @@ class TDependencyGraphBuilder : public TIntermTraverser
     TDependencyGraph *mGraph;
     TNodeSetStack mNodeSets;
     TSymbolStack mLeftmostSymbols;
+    std::stack<bool> mRightSubtreePlaceholders;
 };
 
 #endif  // COMPILER_TRANSLATOR_DEPGRAPH_DEPENDENCY_GRAPH_BUILDER_H
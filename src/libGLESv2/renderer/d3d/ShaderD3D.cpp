@@ -261,7 +261,7 @@ void ShaderD3D::compileToHLSL(void *compiler, const std::string &source)
     }
     else if (result)
     {
-        mHlsl = ShGetObjectCode(compiler);
+        ShTakeObjectCode(compiler, &mHlsl);
 
 #ifdef _DEBUG
         // Prefix hlsl shader with commented out glsl shader
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BenchmarkUtils.h:
+//   Timing and memory helpers for the benchmarks that measure a single call
+//   over and over, rather than a pass over the corpus.
+//
+
+#ifndef COMPILER_PERF_TESTS_BENCHMARK_UTILS_H
+#define COMPILER_PERF_TESTS_BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <string>
+
+#include "GLSLANG/ShaderLang.h"
+
+double Seconds(std::chrono::steady_clock::duration duration);
+
+// The resident memory of the process in bytes, or 0 where it can't be read.
+size_t ResidentMemoryBytes();
+
+// Runs function over and over for about runTimeSeconds, and returns the
+// mean time of a run in microseconds. The clock is read after batches of
+// runs that grow up to 64, so that fast functions aren't timed mostly by
+// the clock, and slow ones aren't run much longer than asked.
+template <typename Function>
+double MeasureMicroseconds(Function function, double runTimeSeconds)
+{
+    typedef std::chrono::steady_clock Clock;
+    size_t runs = 0;
+    size_t batch = 1;
+    Clock::time_point start = Clock::now();
+    Clock::time_point now = start;
+    while (Seconds(now - start) < runTimeSeconds)
+    {
+        for (size_t i = 0; i < batch; ++i)
+            function();
+        runs += batch;
+        if (batch < 64)
+            batch *= 2;
+        now = Clock::now();
+    }
+    return 1e6 * Seconds(now - start) / runs;
+}
+
+// Compiles a single shader string, for MeasureMicroseconds.
+struct CompileFunction
+{
+    ShHandle compiler;
+    const std::string *source;
+    int compileOptions;
+
+    void operator()() const
+    {
+        const char *shaderStrings[] = { source->c_str() };
+        ShCompile(compiler, shaderStrings, 1, compileOptions);
+    }
+};
+
+#endif // COMPILER_PERF_TESTS_BENCHMARK_UTILS_H
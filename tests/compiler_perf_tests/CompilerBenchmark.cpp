@@ -0,0 +1,241 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "CompilerBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "angle_gl.h"
+#include "third_party/perf/perf_test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+namespace
+{
+
+bool HasSuffix(const std::string &name, const std::string &suffix)
+{
+    return name.size() > suffix.size() &&
+           name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool ListDirectory(const std::string &directory, std::vector<std::string> *names)
+{
+#if defined(_WIN32)
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &findData);
+    if (find == INVALID_HANDLE_VALUE)
+        return false;
+    do
+    {
+        names->push_back(findData.cFileName);
+    }
+    while (FindNextFileA(find, &findData));
+    FindClose(find);
+#else
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+        return false;
+    while (dirent *entry = readdir(dir))
+        names->push_back(entry->d_name);
+    closedir(dir);
+#endif
+    return true;
+}
+
+// The sample below which the given fraction of the sorted samples fall.
+double Percentile(const std::vector<double> &sorted, double fraction)
+{
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+}  // namespace
+
+bool LoadShaderCorpus(const std::string &directory, std::vector<CorpusShader> *corpus)
+{
+    std::vector<std::string> names;
+    if (!ListDirectory(directory, &names))
+        return false;
+    std::sort(names.begin(), names.end());
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        CorpusShader shader;
+        if (HasSuffix(names[i], ".vert"))
+            shader.type = GL_VERTEX_SHADER;
+        else if (HasSuffix(names[i], ".frag"))
+            shader.type = GL_FRAGMENT_SHADER;
+        else
+            continue;
+
+        std::ifstream file((directory + "/" + names[i]).c_str(), std::ios::binary);
+        if (!file)
+            return false;
+        std::ostringstream source;
+        source << file.rdbuf();
+
+        shader.name = names[i];
+        shader.source = source.str();
+        corpus->push_back(shader);
+    }
+    return true;
+}
+
+void InitCorpusResources(ShBuiltInResources *resources)
+{
+    ShInitBuiltInResources(resources);
+    resources->MaxVertexTextureImageUnits = 4;
+    resources->MaxCombinedTextureImageUnits = 20;
+    resources->FragmentPrecisionHigh = 1;
+    resources->OES_standard_derivatives = 1;
+    resources->MaxUnrolledLoopSize = 4096;
+}
+
+std::string CompilerBenchmarkParams::suffix() const
+{
+    std::string outputName;
+    switch (output)
+    {
+      case SH_ESSL_OUTPUT:   outputName = "_essl"; break;
+      case SH_GLSL_OUTPUT:   outputName = "_glsl"; break;
+      case SH_HLSL9_OUTPUT:  outputName = "_hlsl9"; break;
+      case SH_HLSL11_OUTPUT: outputName = "_hlsl11"; break;
+      default: assert(0); outputName = "_unk"; break;
+    }
+    return outputName + "_" + optionsName;
+}
+
+CompilerBenchmark::CompilerBenchmark(const std::vector<CorpusShader> &corpus,
+                                     const CompilerBenchmarkParams &params)
+    : mRunTimeSeconds(2.0),
+      mCorpus(corpus),
+      mParams(params),
+      mName("compiler"),
+      mSuffix(params.suffix()),
+      mVertexCompiler(NULL),
+      mFragmentCompiler(NULL)
+{
+}
+
+CompilerBenchmark::~CompilerBenchmark()
+{
+    if (mVertexCompiler)
+        ShDestruct(mVertexCompiler);
+    if (mFragmentCompiler)
+        ShDestruct(mFragmentCompiler);
+}
+
+void CompilerBenchmark::printResult(const std::string &trace, double value, const std::string &units, bool important) const
+{
+    perf_test::PrintResult(mName, mSuffix, trace, value, units, important);
+}
+
+void CompilerBenchmark::printResult(const std::string &trace, size_t value, const std::string &units, bool important) const
+{
+    perf_test::PrintResult(mName, mSuffix, trace, value, units, important);
+}
+
+bool CompilerBenchmark::initialize()
+{
+    ShBuiltInResources resources;
+    InitCorpusResources(&resources);
+
+    mVertexCompiler = ShConstructCompiler(GL_VERTEX_SHADER, mParams.spec, mParams.output, &resources);
+    mFragmentCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, mParams.spec, mParams.output, &resources);
+    if (!mVertexCompiler || !mFragmentCompiler)
+    {
+        std::cerr << "Failed to construct the compilers for " << mSuffix << std::endl;
+        return false;
+    }
+
+    // Compile the corpus once, so that every shader is known to compile and
+    // the first timed pass doesn't build the built-in symbol tables.
+    for (size_t i = 0; i < mCorpus.size(); ++i)
+    {
+        if (!compile(mCorpus[i], mParams.compileOptions))
+        {
+            std::cerr << mCorpus[i].name << " failed to compile for " << mSuffix << ":\n"
+                      << ShGetInfoLog(compilerFor(mCorpus[i])) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompilerBenchmark::compile(const CorpusShader &shader, int compileOptions)
+{
+    const char *shaderStrings[] = { shader.source.c_str() };
+    return ShCompile(compilerFor(shader), shaderStrings, 1, compileOptions) != 0;
+}
+
+ShHandle CompilerBenchmark::compilerFor(const CorpusShader &shader) const
+{
+    return shader.type == GL_VERTEX_SHADER ? mVertexCompiler : mFragmentCompiler;
+}
+
+int CompilerBenchmark::run()
+{
+    if (mCorpus.empty() || !initialize())
+        return -1;
+
+    typedef std::chrono::steady_clock Clock;
+    std::vector<double> latencies;
+    Clock::time_point start = Clock::now();
+    Clock::time_point now = start;
+    while (Seconds(now - start) < mRunTimeSeconds)
+    {
+        for (size_t i = 0; i < mCorpus.size(); ++i)
+        {
+            Clock::time_point compileStart = now;
+            compile(mCorpus[i], mParams.compileOptions);
+            now = Clock::now();
+            latencies.push_back(Seconds(now - compileStart));
+        }
+    }
+    double totalTime = Seconds(now - start);
+
+    ShPoolAllocatorStatistics vertexStatistics;
+    ShPoolAllocatorStatistics fragmentStatistics;
+    ShGetPoolAllocatorStatistics(mVertexCompiler, &vertexStatistics);
+    ShGetPoolAllocatorStatistics(mFragmentCompiler, &fragmentStatistics);
+
+    std::sort(latencies.begin(), latencies.end());
+
+    const int statisticsPasses = 10;
+    khronos_uint64_t outputTime = 0;
+    for (int pass = 0; pass < statisticsPasses; ++pass)
+    {
+        for (size_t i = 0; i < mCorpus.size(); ++i)
+        {
+            compile(mCorpus[i], mParams.compileOptions | SH_COMPILE_STATISTICS);
+            ShCompileStatistics statistics;
+            ShGetCompileStatistics(compilerFor(mCorpus[i]), &statistics);
+            outputTime += statistics.phaseTimes[SH_COMPILE_PHASE_OUTPUT];
+        }
+    }
+
+    printResult("shaders_per_second", latencies.size() / totalTime, "shaders", true);
+    printResult("compiles", latencies.size(), "shaders", false);
+    printResult("latency_50th_percentile", 1e6 * Percentile(latencies, 0.5), "us", true);
+    printResult("latency_90th_percentile", 1e6 * Percentile(latencies, 0.9), "us", false);
+    printResult("latency_99th_percentile", 1e6 * Percentile(latencies, 0.99), "us", false);
+    printResult("output_time", 1e-3 * outputTime / (statisticsPasses * mCorpus.size()), "us", false);
+    printResult("peak_pool_memory", std::max(vertexStatistics.peakBytesInUse,
+                                             fragmentStatistics.peakBytesInUse), "bytes", true);
+
+    return 0;
+}
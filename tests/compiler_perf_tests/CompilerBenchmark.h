@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompilerBenchmark.h:
+//   Measures the throughput and latency of the translator over a corpus of
+//   shaders, without a window or a GL context.
+//
+
+#ifndef COMPILER_PERF_TESTS_COMPILER_BENCHMARK_H
+#define COMPILER_PERF_TESTS_COMPILER_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "shared_utils.h"
+
+struct CorpusShader
+{
+    std::string name;
+    sh::GLenum type;
+    std::string source;
+};
+
+// Loads the .vert and .frag files of a directory, sorted by name.
+bool LoadShaderCorpus(const std::string &directory, std::vector<CorpusShader> *corpus);
+
+// The resources that the shaders of the corpus need.
+void InitCorpusResources(ShBuiltInResources *resources);
+
+struct CompilerBenchmarkParams
+{
+    std::string suffix() const;
+
+    ShShaderOutput output;
+    ShShaderSpec spec;
+    int compileOptions;
+    // Names the option set in the results, e.g. "webgl".
+    std::string optionsName;
+};
+
+class CompilerBenchmark
+{
+  public:
+    CompilerBenchmark(const std::vector<CorpusShader> &corpus,
+                      const CompilerBenchmarkParams &params);
+    ~CompilerBenchmark();
+
+    // Compiles the corpus over and over for mRunTimeSeconds, then prints
+    // the results, along with the time spent writing the output, which
+    // is taken from the compile statistics of a few more passes. Returns
+    // nonzero if a shader fails to compile.
+    int run();
+
+  protected:
+    void printResult(const std::string &trace, double value, const std::string &units, bool important) const;
+    void printResult(const std::string &trace, size_t value, const std::string &units, bool important) const;
+
+    double mRunTimeSeconds;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CompilerBenchmark);
+
+    bool initialize();
+    bool compile(const CorpusShader &shader, int compileOptions);
+    ShHandle compilerFor(const CorpusShader &shader) const;
+
+    const std::vector<CorpusShader> &mCorpus;
+    CompilerBenchmarkParams mParams;
+    std::string mName;
+    std::string mSuffix;
+
+    ShHandle mVertexCompiler;
+    ShHandle mFragmentCompiler;
+};
+
+#endif // COMPILER_PERF_TESTS_COMPILER_BENCHMARK_H
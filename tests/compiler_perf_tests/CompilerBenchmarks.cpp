@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "CompilerBenchmark.h"
+#include "CompilerConstructionBenchmark.h"
+#include "DeepTreeBenchmark.h"
+#include "DependencyGraphBenchmark.h"
+#include "PackingBenchmark.h"
+#include "PoolAllocatorBenchmark.h"
+#include "UniformsBenchmark.h"
+#include "ValidationWalkBenchmark.h"
+#include "angle_gl.h"
+
+#include <iostream>
+#include <sstream>
+
+ShShaderOutput outputs[] =
+{
+    SH_ESSL_OUTPUT,
+    SH_GLSL_OUTPUT,
+    SH_HLSL9_OUTPUT,
+    SH_HLSL11_OUTPUT
+};
+
+// What a browser asks for when it compiles a WebGL shader.
+const int webGLOptions = SH_OBJECT_CODE | SH_VARIABLES | SH_ENFORCE_PACKING_RESTRICTIONS |
+                         SH_LIMIT_EXPRESSION_COMPLEXITY | SH_LIMIT_CALL_STACK_DEPTH |
+                         SH_CLAMP_INDIRECT_ARRAY_BOUNDS | SH_INIT_VARYINGS_WITHOUT_STATIC_USE;
+
+// The GL driver workarounds that browsers add on some platforms.
+const int webGLWorkaroundOptions = webGLOptions | SH_EMULATE_BUILT_IN_FUNCTIONS |
+                                   SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX | SH_UNFOLD_SHORT_CIRCUIT |
+                                   SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS | SH_INIT_GL_POSITION |
+                                   SH_REGENERATE_STRUCT_NAMES;
+
+int main(int argc, char **argv)
+{
+    // The shaders are copied next to the executable, unless a directory is given.
+    std::string directory;
+    if (argc > 1)
+    {
+        directory = argv[1];
+    }
+    else
+    {
+        std::string executable = argv[0];
+        size_t separator = executable.find_last_of("/\\");
+        directory = (separator == std::string::npos ? "." : executable.substr(0, separator)) +
+                    "/compiler_perf_shaders";
+    }
+
+    std::vector<CorpusShader> corpus;
+    if (!LoadShaderCorpus(directory, &corpus) || corpus.empty())
+    {
+        std::cerr << "No .vert or .frag shaders found in " << directory << std::endl;
+        return -1;
+    }
+
+    // The shaders that use every kind of texture lookup, which is where
+    // the HLSL outputs write the most helper functions.
+    std::vector<CorpusShader> textureCorpus;
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        if (corpus[i].name.compare(0, 8, "texture_") == 0)
+            textureCorpus.push_back(corpus[i]);
+    }
+
+    std::vector<CompilerBenchmarkParams> benchmarks;
+    for (size_t outputIt = 0; outputIt < ArraySize(outputs); outputIt++)
+    {
+        CompilerBenchmarkParams params;
+        params.output = outputs[outputIt];
+        params.spec = SH_WEBGL_SPEC;
+        params.compileOptions = webGLOptions;
+        params.optionsName = "webgl";
+        benchmarks.push_back(params);
+
+        // The workarounds are only for GL drivers.
+        if (params.output == SH_ESSL_OUTPUT || params.output == SH_GLSL_OUTPUT)
+        {
+            params.compileOptions = webGLWorkaroundOptions;
+            params.optionsName = "webgl_workarounds";
+            benchmarks.push_back(params);
+        }
+    }
+
+    std::vector<CompilerBenchmarkParams> textureBenchmarks;
+    for (size_t outputIt = 0; outputIt < ArraySize(outputs); outputIt++)
+    {
+        CompilerBenchmarkParams params;
+        params.output = outputs[outputIt];
+        params.spec = SH_WEBGL_SPEC;
+        params.compileOptions = webGLOptions;
+        params.optionsName = "webgl_texture_lookups";
+        textureBenchmarks.push_back(params);
+    }
+
+    ShInitialize();
+
+    int result = 0;
+    for (size_t benchIndex = 0; benchIndex < benchmarks.size(); benchIndex++)
+    {
+        CompilerBenchmark benchmark(corpus, benchmarks[benchIndex]);
+        result = benchmark.run();
+        if (result != 0) { break; }
+    }
+    for (size_t benchIndex = 0; result == 0 && benchIndex < textureBenchmarks.size(); benchIndex++)
+    {
+        if (textureCorpus.empty()) { break; }
+        CompilerBenchmark benchmark(textureCorpus, textureBenchmarks[benchIndex]);
+        result = benchmark.run();
+    }
+
+    // Constructing compilers, as a browser does for each shader.
+    if (result == 0)
+    {
+        result = RunCompilerConstructionBenchmark();
+    }
+
+    // Compiling shader after shader on the same handles, as a browser does.
+    if (result == 0)
+    {
+        result = RunPoolAllocatorBenchmark(corpus, webGLOptions);
+    }
+
+    // The validation passes of the compiles of the corpus, each walking the
+    // tree on its own and all sharing one walk.
+    if (result == 0)
+    {
+        result = RunValidationWalkBenchmark(corpus, webGLOptions);
+    }
+
+    // WebGL fragment shader compiles, which used to build a dependency graph
+    // and no longer do: the largest shader of the corpus, and generated ones
+    // from a long straight-line main to hundreds of functions.
+    for (size_t i = 0; result == 0 && i < corpus.size(); i++)
+    {
+        if (corpus[i].name == "procedural.frag")
+            result = RunDependencyGraphBenchmark("procedural", corpus[i].source, webGLOptions);
+    }
+    if (result == 0)
+    {
+        result = RunDependencyGraphBenchmark("2000_statements", GenerateStatementChainShader(2000),
+                                             webGLOptions);
+    }
+    const size_t layerCounts[] = { 50, 400 };
+    for (size_t countIndex = 0; result == 0 && countIndex < ArraySize(layerCounts); countIndex++)
+    {
+        std::ostringstream name;
+        name << layerCounts[countIndex] << "_layers";
+        result = RunDependencyGraphBenchmark(name.str(),
+                                             GenerateLayeredMaterialShader(layerCounts[countIndex]),
+                                             webGLOptions);
+    }
+
+    // Walking trees from a little to a lot deeper than the traversal recurses.
+    const size_t treeDepths[] = { 5000, 20000, 100000 };
+    for (size_t depthIndex = 0; result == 0 && depthIndex < ArraySize(treeDepths); depthIndex++)
+    {
+        result = RunDeepTreeBenchmark(treeDepths[depthIndex]);
+    }
+
+    // The packing check at link time, from a small program to a very large one.
+    const size_t packingSizes[] = { 16, 256, 4096 };
+    for (size_t sizeIndex = 0; result == 0 && sizeIndex < ArraySize(packingSizes); sizeIndex++)
+    {
+        result = RunPackingBenchmark(packingSizes[sizeIndex]);
+    }
+
+    // Collecting and packing the variables of a shader, as the number of
+    // uniforms grows.
+    const size_t uniformCounts[] = { 100, 1000, 10000 };
+    std::vector<size_t> uniformCountList(uniformCounts, uniformCounts + ArraySize(uniformCounts));
+    if (result == 0)
+    {
+        result = RunUniformsBenchmark("vectors", GL_VERTEX_SHADER, GenerateVectorUniformsShader,
+                                      uniformCountList);
+    }
+    if (result == 0)
+    {
+        result = RunUniformsBenchmark("light_arrays", GL_FRAGMENT_SHADER,
+                                      GenerateLightArraysShader, uniformCountList);
+    }
+
+    ShFinalize();
+    return result;
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "CompilerConstructionBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+struct ConstructFunction
+{
+    const ShBuiltInResources *resources;
+    bool *success;
+
+    void operator()() const
+    {
+        ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                                resources);
+        if (compiler)
+            ShDestruct(compiler);
+        else
+            *success = false;
+    }
+};
+
+// Constructs count compilers, each with MaxVertexAttribs raised by
+// attribsStep over the previous one, so that with a step of 0 they share
+// their built-in symbols and otherwise each builds its own. Returns the
+// growth of the resident memory per compiler, while they are all alive.
+double ResidentBytesPerCompiler(ShBuiltInResources resources, int count, int attribsStep,
+                                bool *success)
+{
+    std::vector<ShHandle> compilers;
+    size_t residentBefore = ResidentMemoryBytes();
+    for (int i = 0; i < count; ++i)
+    {
+        ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC,
+                                                SH_ESSL_OUTPUT, &resources);
+        if (!compiler)
+            *success = false;
+        else
+            compilers.push_back(compiler);
+        resources.MaxVertexAttribs += attribsStep;
+    }
+    size_t residentAfter = ResidentMemoryBytes();
+    for (size_t i = 0; i < compilers.size(); ++i)
+        ShDestruct(compilers[i]);
+
+    if (residentAfter < residentBefore)
+        return 0.0;
+    return static_cast<double>(residentAfter - residentBefore) / count;
+}
+
+}  // namespace
+
+int RunCompilerConstructionBenchmark()
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    bool success = true;
+
+    // The memory is measured first, so that the heap freed by the other
+    // measurements doesn't hide the growth. The shared compilers go first
+    // for the same reason.
+    const int residentCompilers = 50;
+    resources.MaxVertexAttribs = 2000;
+    double sharedMemory = ResidentBytesPerCompiler(resources, residentCompilers, 0, &success);
+    resources.MaxVertexAttribs = 3000;
+    double unsharedMemory = ResidentBytesPerCompiler(resources, residentCompilers, 1, &success);
+
+    // The built-in symbols are freed with the last compiler that uses them,
+    // so constructing and destroying a compiler alone builds them each time.
+    resources.MaxVertexAttribs = 1000;
+    ConstructFunction construct = { &resources, &success };
+    double firstTime = MeasureMicroseconds(construct, 0.5);
+
+    // While another compiler holds them, the next ones share them.
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                            &resources);
+    double constructTime = MeasureMicroseconds(construct, 0.5);
+    if (compiler)
+        ShDestruct(compiler);
+
+    if (!success || !compiler)
+    {
+        std::cerr << "Failed to construct the compilers for the construction benchmark"
+                  << std::endl;
+        return -1;
+    }
+
+    perf_test::PrintResult("construction", "", "first_construct_time", firstTime, "us", false);
+    perf_test::PrintResult("construction", "", "construct_time", constructTime, "us", true);
+    perf_test::PrintResult("construction", "", "resident_memory_unshared", unsharedMemory,
+                           "bytes", false);
+    perf_test::PrintResult("construction", "", "resident_memory_shared", sharedMemory, "bytes",
+                           true);
+    return 0;
+}
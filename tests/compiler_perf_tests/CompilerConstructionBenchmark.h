@@ -0,0 +1,21 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompilerConstructionBenchmark.h:
+//   Measures the construction of compilers, which share the built-in
+//   symbols of the live compilers constructed with the same resources.
+//
+
+#ifndef COMPILER_PERF_TESTS_COMPILER_CONSTRUCTION_BENCHMARK_H
+#define COMPILER_PERF_TESTS_COMPILER_CONSTRUCTION_BENCHMARK_H
+
+// Constructs and destroys WebGL fragment compilers. Prints the time of a
+// construction that builds the built-in symbols, the time of one that
+// shares them, and the resident memory per compiler of many live compilers
+// with and without sharing. Returns nonzero if a compiler can't be
+// constructed.
+int RunCompilerConstructionBenchmark();
+
+#endif // COMPILER_PERF_TESTS_COMPILER_CONSTRUCTION_BENCHMARK_H
@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "DeepTreeBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+
+// The sum is left associative, so each term is a level down from the
+// next, while the parser itself doesn't nest.
+std::string GenerateShader(size_t depth)
+{
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "uniform float u;\n"
+           << "void main() {\n"
+           << "    float sum = u";
+    for (size_t i = 0; i < depth; ++i)
+        shader << " + u";
+    shader << ";\n"
+           << "    gl_FragColor = vec4(sum);\n"
+           << "}\n";
+    return shader.str();
+}
+
+}  // namespace
+
+int RunDeepTreeBenchmark(size_t depth)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_HLSL11_OUTPUT,
+                                            &resources);
+    if (!compiler)
+    {
+        std::cerr << "Failed to construct the compiler for the deep tree benchmark" << std::endl;
+        return -1;
+    }
+
+    std::string source = GenerateShader(depth);
+    const int compileOptions = SH_VALIDATE_LOOP_INDEXING | SH_LIMIT_CALL_STACK_DEPTH |
+                               SH_OBJECT_CODE;
+    const char *shaderStrings[] = { source.c_str() };
+    if (!ShCompile(compiler, shaderStrings, 1, compileOptions))
+    {
+        std::cerr << "The shader of depth " << depth << " failed to compile:\n"
+                  << ShGetInfoLog(compiler) << std::endl;
+        ShDestruct(compiler);
+        return -1;
+    }
+
+    const double runTimeSeconds = 0.5;
+    CompileFunction compile = { compiler, &source, compileOptions };
+    double compileTime = MeasureMicroseconds(compile, runTimeSeconds);
+
+    const int statisticsRuns = 10;
+    khronos_uint64_t validateTime = 0;
+    khronos_uint64_t outputTime = 0;
+    for (int run = 0; run < statisticsRuns; ++run)
+    {
+        ShCompile(compiler, shaderStrings, 1, compileOptions | SH_COMPILE_STATISTICS);
+        ShCompileStatistics statistics;
+        ShGetCompileStatistics(compiler, &statistics);
+        validateTime += statistics.phaseTimes[SH_COMPILE_PHASE_VALIDATE];
+        outputTime += statistics.phaseTimes[SH_COMPILE_PHASE_OUTPUT];
+    }
+    ShDestruct(compiler);
+
+    std::ostringstream suffix;
+    suffix << "_depth_" << depth;
+    perf_test::PrintResult("deep_tree", suffix.str(), "compile_time", 1e-3 * compileTime, "ms", false);
+    perf_test::PrintResult("deep_tree", suffix.str(), "validate_time",
+                           1e-3 * validateTime / statisticsRuns, "us", false);
+    perf_test::PrintResult("deep_tree", suffix.str(), "output_time",
+                           1e-3 * outputTime / statisticsRuns, "us", true);
+    return 0;
+}
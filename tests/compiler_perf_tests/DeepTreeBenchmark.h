@@ -0,0 +1,22 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DeepTreeBenchmark.h:
+//   Measures the walks of a tree much deeper than the traversal recurses,
+//   as generated shaders can build with long chains of operators.
+//
+
+#ifndef COMPILER_PERF_TESTS_DEEP_TREE_BENCHMARK_H
+#define COMPILER_PERF_TESTS_DEEP_TREE_BENCHMARK_H
+
+#include <stddef.h>
+
+// Translates to HLSL a fragment shader that adds up depth terms in a single
+// expression, which the parser makes a tree of that depth. Prints the time
+// of the compile, of the validation walk and of the output. Returns nonzero
+// if the shader doesn't compile.
+int RunDeepTreeBenchmark(size_t depth);
+
+#endif // COMPILER_PERF_TESTS_DEEP_TREE_BENCHMARK_H
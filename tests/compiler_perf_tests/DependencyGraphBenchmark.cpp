@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "DependencyGraphBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "CompilerBenchmark.h"
+#include "DependencyGraphWork.h"
+#include "angle_gl.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+#include <sstream>
+
+std::string GenerateStatementChainShader(size_t numStatements)
+{
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "uniform vec4 u;\n"
+           << "void main() {\n"
+           << "    vec4 v0 = u;\n";
+    for (size_t i = 1; i <= numStatements; ++i)
+        shader << "    vec4 v" << i << " = v" << i - 1 << " * u.x + vec4(u.y, v" << i - 1 << ".xz, 1.0);\n";
+    shader << "    gl_FragColor = v" << numStatements << ";\n"
+           << "}\n";
+    return shader.str();
+}
+
+std::string GenerateLayeredMaterialShader(size_t numLayers)
+{
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "uniform vec4 uTints[8];\n"
+           << "uniform float uThreshold;\n"
+           << "varying vec2 vUv;\n"
+           << "vec4 blendLayer(vec4 below, vec4 tint, float mask) {\n"
+           << "    if (mask > uThreshold)\n"
+           << "        return mix(below, tint * below, mask);\n"
+           << "    return below + tint * mask * 0.25;\n"
+           << "}\n";
+    for (size_t i = 0; i < numLayers; ++i)
+    {
+        shader << "vec4 layer" << i << "(vec4 below, vec2 uv) {\n"
+               << "    float mask = clamp(dot(uv, vec2(" << (i % 7 + 1) * 0.125 << ", 0.5)) - below.a, 0.0, 1.0);\n"
+               << "    return blendLayer(below, uTints[" << i % 8 << "], mask);\n"
+               << "}\n";
+    }
+    shader << "void main() {\n"
+           << "    vec4 c0 = vec4(vUv, 0.0, 1.0);\n";
+    for (size_t i = 0; i < numLayers; ++i)
+        shader << "    vec4 c" << i + 1 << " = layer" << i << "(c" << i << ", vUv);\n";
+    shader << "    gl_FragColor = c" << numLayers << ";\n"
+           << "}\n";
+    return shader.str();
+}
+
+int RunDependencyGraphBenchmark(const std::string &name, const std::string &source,
+                                int compileOptions)
+{
+    ShBuiltInResources resources;
+    InitCorpusResources(&resources);
+
+    // The graph of one compile takes from microseconds to milliseconds, so
+    // it is built enough times for the clock.
+    const int graphRuns = 20;
+    DependencyGraphWork work = { 0, 0, 0.0, 0.0 };
+    if (!MeasureDependencyGraphWork(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, resources, source.c_str(),
+                                    compileOptions, graphRuns, &work))
+    {
+        std::cerr << name << " failed to compile" << std::endl;
+        return -1;
+    }
+
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                            &resources);
+    if (!compiler)
+    {
+        std::cerr << "Failed to construct the compiler for the dependency graph benchmark"
+                  << std::endl;
+        return -1;
+    }
+
+    // The timing restrictions reject any call to a user-defined function,
+    // and a rejected compile stops before the object code, so its time is
+    // only measured for the shaders they accept.
+    const int timingOptions = compileOptions | SH_TIMING_RESTRICTIONS;
+    const char *shaderStrings[] = { source.c_str() };
+    bool timingAccepted = ShCompile(compiler, shaderStrings, 1, timingOptions) != 0;
+
+    const double runTimeSeconds = 0.5;
+    CompileFunction compile = { compiler, &source, compileOptions };
+    double compileTime = MeasureMicroseconds(compile, runTimeSeconds);
+    double timingCompileTime = 0.0;
+    if (timingAccepted)
+    {
+        compile.compileOptions = timingOptions;
+        timingCompileTime = MeasureMicroseconds(compile, runTimeSeconds);
+    }
+    ShDestruct(compiler);
+
+    double graphTime = work.buildTime + work.traverseTime;
+    std::string suffix = "_" + name;
+    perf_test::PrintResult("dependency_graph", suffix, "graph_nodes", work.graphNodes, "nodes",
+                           false);
+    perf_test::PrintResult("dependency_graph", suffix, "function_calls", work.functionCalls,
+                           "calls", false);
+    perf_test::PrintResult("dependency_graph", suffix, "graph_build_time", work.buildTime, "us",
+                           false);
+    perf_test::PrintResult("dependency_graph", suffix, "graph_traverse_time", work.traverseTime,
+                           "us", false);
+    perf_test::PrintResult("dependency_graph", suffix, "compile_time_with_graph",
+                           compileTime + graphTime, "us", false);
+    perf_test::PrintResult("dependency_graph", suffix, "compile_time", compileTime, "us", true);
+    perf_test::PrintResult("dependency_graph", suffix, "saved_time_percent",
+                           100.0 * graphTime / (compileTime + graphTime), "%", true);
+    if (timingAccepted)
+    {
+        perf_test::PrintResult("dependency_graph", suffix, "timing_restrictions_compile_time",
+                               timingCompileTime, "us", false);
+    }
+    return 0;
+}
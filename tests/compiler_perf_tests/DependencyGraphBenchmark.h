@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DependencyGraphBenchmark.h:
+//   Measures the compile time that limitExpressionComplexity no longer
+//   spends on a dependency graph, and what the graph still costs the
+//   compiles that ask for the timing restrictions.
+//
+
+#ifndef COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_BENCHMARK_H
+#define COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_BENCHMARK_H
+
+#include <string>
+
+// A fragment shader of numStatements statements, each using the variable
+// declared by the one before.
+std::string GenerateStatementChainShader(size_t numStatements);
+
+// A fragment shader that blends numLayers material layers, each a function
+// of the layer below that calls a shared blend function, as a material
+// editor writes them.
+std::string GenerateLayeredMaterialShader(size_t numLayers);
+
+// Compiles the fragment shader with compileOptions, which must limit the
+// expression complexity, and prints the compile time, the time of the
+// graph that such compiles used to build and walk, and, if the timing
+// restrictions accept the shader, the compile time with them, under name.
+// Returns nonzero if the shader doesn't compile.
+int RunDependencyGraphBenchmark(const std::string &name, const std::string &source,
+                                int compileOptions);
+
+#endif // COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_BENCHMARK_H
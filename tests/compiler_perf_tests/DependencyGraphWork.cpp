@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "DependencyGraphWork.h"
+
+#include "BenchmarkUtils.h"
+#include "compiler/translator/TranslatorESSL.h"
+#include "compiler/translator/depgraph/DependencyGraph.h"
+
+#include <iostream>
+
+namespace
+{
+
+// Builds and walks the graph in place of writing the object code, after
+// the validation and the passes that mark the tree, which leave it much
+// the same.
+class DependencyGraphTranslator : public TranslatorESSL
+{
+  public:
+    DependencyGraphTranslator(sh::GLenum type, ShShaderSpec spec, int runs,
+                              DependencyGraphWork *work)
+        : TranslatorESSL(type, spec),
+          mRuns(runs),
+          mWork(work)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root, int)
+    {
+        typedef std::chrono::steady_clock Clock;
+        TPoolAllocator *allocator = GetGlobalPoolAllocator();
+
+        double buildSeconds = 0.0;
+        double traverseSeconds = 0.0;
+        for (int run = 0; run < mRuns; ++run)
+        {
+            allocator->push();
+            Clock::time_point start = Clock::now();
+            Clock::time_point traverseStart;
+            Clock::time_point traverseEnd;
+            {
+                TDependencyGraph graph(root);
+                traverseStart = Clock::now();
+                for (TFunctionCallVector::const_iterator iter = graph.beginUserDefinedFunctionCalls();
+                     iter != graph.endUserDefinedFunctionCalls();
+                     ++iter)
+                {
+                    TDependencyGraphTraverser graphTraverser;
+                    (*iter)->traverse(&graphTraverser);
+                }
+                traverseEnd = Clock::now();
+
+                if (run == 0)
+                {
+                    mWork->graphNodes = graph.end() - graph.begin();
+                    mWork->functionCalls =
+                        graph.endUserDefinedFunctionCalls() - graph.beginUserDefinedFunctionCalls();
+                }
+            }
+            Clock::time_point end = Clock::now();
+            allocator->pop();
+
+            buildSeconds += Seconds(end - start) - Seconds(traverseEnd - traverseStart);
+            traverseSeconds += Seconds(traverseEnd - traverseStart);
+        }
+
+        mWork->buildTime = 1e6 * buildSeconds / mRuns;
+        mWork->traverseTime = 1e6 * traverseSeconds / mRuns;
+    }
+
+  private:
+    int mRuns;
+    DependencyGraphWork *mWork;
+};
+
+}  // namespace
+
+bool MeasureDependencyGraphWork(sh::GLenum type, ShShaderSpec spec,
+                                const ShBuiltInResources &resources, const char *source,
+                                int compileOptions, int runs, DependencyGraphWork *work)
+{
+    DependencyGraphTranslator translator(type, spec, runs, work);
+    if (!translator.Init(resources))
+    {
+        std::cerr << "Failed to initialize the compiler for the dependency graph benchmark"
+                  << std::endl;
+        return false;
+    }
+
+    const char *shaderStrings[] = { source };
+    if (!translator.compile(shaderStrings, 1, compileOptions | SH_OBJECT_CODE))
+    {
+        std::cerr << translator.getInfoSink().info.c_str() << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DependencyGraphWork.h:
+//   Times the dependency graph that limitExpressionComplexity used to build
+//   and walk on every compile, and no longer does. This reaches into the
+//   compiler, so it is kept apart from the benchmarks, which only use the
+//   public API.
+//
+
+#ifndef COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_WORK_H
+#define COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_WORK_H
+
+#include "GLSLANG/ShaderLang.h"
+
+struct DependencyGraphWork
+{
+    // Nodes of the graph, and the user-defined function calls that it was
+    // walked from.
+    size_t graphNodes;
+    size_t functionCalls;
+    // Mean time per compile, in microseconds, of building the graph and
+    // freeing it, and of the walks from the function calls.
+    double buildTime;
+    double traverseTime;
+};
+
+// Compiles a single shader string, and at the point where the object code
+// would be written, builds the graph of the tree and walks it from every
+// user-defined function call, runs times over, as the compiler used to.
+// Returns false if the shader doesn't compile.
+bool MeasureDependencyGraphWork(sh::GLenum type, ShShaderSpec spec,
+                                const ShBuiltInResources &resources, const char *source,
+                                int compileOptions, int runs, DependencyGraphWork *work);
+
+#endif // COMPILER_PERF_TESTS_DEPENDENCY_GRAPH_WORK_H
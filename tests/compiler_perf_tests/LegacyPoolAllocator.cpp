@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "LegacyPoolAllocator.h"
+
+#include <new>
+
+LegacyPoolAllocator::LegacyPoolAllocator(int growthIncrement, int allocationAlignment)
+    : mPageSize(growthIncrement),
+      mFreeList(NULL),
+      mInUseList(NULL),
+      mNumCalls(0),
+      mTotalBytes(0),
+      mOSAllocations(0)
+{
+    if (mPageSize < 4 * 1024)
+        mPageSize = 4 * 1024;
+
+    // A large offset means a new page is needed for the next allocation.
+    mCurrentPageOffset = mPageSize;
+
+    size_t minAlign = sizeof(void *);
+    size_t alignment = allocationAlignment & ~(minAlign - 1);
+    if (alignment < minAlign)
+        alignment = minAlign;
+    size_t a = 1;
+    while (a < alignment)
+        a <<= 1;
+    mAlignmentMask = a - 1;
+
+    mHeaderSkip = minAlign;
+    if (mHeaderSkip < sizeof(Header))
+        mHeaderSkip = (sizeof(Header) + mAlignmentMask) & ~mAlignmentMask;
+}
+
+LegacyPoolAllocator::~LegacyPoolAllocator()
+{
+    while (mInUseList)
+    {
+        Header *next = mInUseList->nextPage;
+        delete[] reinterpret_cast<char *>(mInUseList);
+        mInUseList = next;
+    }
+    while (mFreeList)
+    {
+        Header *next = mFreeList->nextPage;
+        delete[] reinterpret_cast<char *>(mFreeList);
+        mFreeList = next;
+    }
+}
+
+void LegacyPoolAllocator::push()
+{
+    AllocState state = { mCurrentPageOffset, mInUseList };
+    mStack.push_back(state);
+    mCurrentPageOffset = mPageSize;
+}
+
+void LegacyPoolAllocator::pop()
+{
+    if (mStack.empty())
+        return;
+
+    Header *page = mStack.back().page;
+    mCurrentPageOffset = mStack.back().offset;
+
+    while (mInUseList != page)
+    {
+        Header *nextInUse = mInUseList->nextPage;
+        if (mInUseList->pageCount > 1)
+        {
+            delete[] reinterpret_cast<char *>(mInUseList);
+        }
+        else
+        {
+            mInUseList->nextPage = mFreeList;
+            mFreeList = mInUseList;
+        }
+        mInUseList = nextInUse;
+    }
+
+    mStack.pop_back();
+}
+
+void *LegacyPoolAllocator::allocate(size_t numBytes)
+{
+    // Statistics that nothing reads, kept so that the cost is the same.
+    ++mNumCalls;
+    mTotalBytes += numBytes;
+
+    if (numBytes <= mPageSize - mCurrentPageOffset)
+    {
+        unsigned char *memory = reinterpret_cast<unsigned char *>(mInUseList) + mCurrentPageOffset;
+        mCurrentPageOffset += numBytes;
+        mCurrentPageOffset = (mCurrentPageOffset + mAlignmentMask) & ~mAlignmentMask;
+        return memory;
+    }
+
+    if (numBytes > mPageSize - mHeaderSkip)
+    {
+        // A multi-page allocation, which abandons the current page.
+        size_t numBytesToAlloc = numBytes + mHeaderSkip;
+        if (numBytesToAlloc < numBytes)
+            return NULL;
+
+        Header *memory = reinterpret_cast<Header *>(new char[numBytesToAlloc]);
+        ++mOSAllocations;
+        new (memory) Header(mInUseList, (numBytesToAlloc + mPageSize - 1) / mPageSize);
+        mInUseList = memory;
+
+        mCurrentPageOffset = mPageSize;
+        return reinterpret_cast<unsigned char *>(memory) + mHeaderSkip;
+    }
+
+    Header *memory;
+    if (mFreeList)
+    {
+        memory = mFreeList;
+        mFreeList = mFreeList->nextPage;
+    }
+    else
+    {
+        memory = reinterpret_cast<Header *>(new char[mPageSize]);
+        ++mOSAllocations;
+    }
+    new (memory) Header(mInUseList, 1);
+    mInUseList = memory;
+
+    unsigned char *ret = reinterpret_cast<unsigned char *>(mInUseList) + mHeaderSkip;
+    mCurrentPageOffset = (mHeaderSkip + numBytes + mAlignmentMask) & ~mAlignmentMask;
+    return ret;
+}
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LegacyPoolAllocator.h:
+//   The pool allocator as it was before pages were recycled by size class,
+//   kept to compare the two on the same allocations.
+//
+
+#ifndef COMPILER_PERF_TESTS_LEGACY_POOL_ALLOCATOR_H
+#define COMPILER_PERF_TESTS_LEGACY_POOL_ALLOCATOR_H
+
+#include <stddef.h>
+#include <vector>
+
+// Allocates from pages of a fixed size. Allocations that don't fit in a
+// page get their own, which is freed by pop(); the others are kept on a
+// free list until the allocator is destroyed. Guard blocks are left out.
+class LegacyPoolAllocator
+{
+  public:
+    LegacyPoolAllocator(int growthIncrement = 8 * 1024, int allocationAlignment = 16);
+    ~LegacyPoolAllocator();
+
+    void push();
+    void pop();
+    void *allocate(size_t numBytes);
+
+    // Pages obtained from the OS since construction.
+    size_t osAllocations() const { return mOSAllocations; }
+
+  private:
+    struct Header
+    {
+        Header(Header *nextPage, size_t pageCount) : nextPage(nextPage), pageCount(pageCount) {}
+
+        Header *nextPage;
+        size_t pageCount;
+    };
+
+    struct AllocState
+    {
+        size_t offset;
+        Header *page;
+    };
+
+    size_t mPageSize;
+    size_t mAlignmentMask;
+    size_t mHeaderSkip;
+    size_t mCurrentPageOffset;
+    Header *mFreeList;
+    Header *mInUseList;
+    std::vector<AllocState> mStack;
+    size_t mNumCalls;
+    size_t mTotalBytes;
+    size_t mOSAllocations;
+};
+
+#endif // COMPILER_PERF_TESTS_LEGACY_POOL_ALLOCATOR_H
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LegacyVariableInfo.h:
+//   The variable collection as it was before the collected variables were
+//   indexed by name, kept to compare the two on the same trees.
+//
+
+#ifndef COMPILER_PERF_TESTS_LEGACY_VARIABLE_INFO_H
+#define COMPILER_PERF_TESTS_LEGACY_VARIABLE_INFO_H
+
+#include "GLSLANG/ShaderLang.h"
+
+#include "compiler/translator/IntermNode.h"
+
+class TSymbolTable;
+
+namespace sh
+{
+
+// Finds the variable of every symbol it visits by scanning the list that
+// holds it, comparing names.
+class LegacyCollectVariables : public TIntermTraverser
+{
+  public:
+    LegacyCollectVariables(std::vector<Attribute> *attribs,
+                           std::vector<Attribute> *outputVariables,
+                           std::vector<Uniform> *uniforms,
+                           std::vector<Varying> *varyings,
+                           std::vector<InterfaceBlock> *interfaceBlocks,
+                           ShHashFunction64 hashFunction,
+                           const TSymbolTable &symbolTable);
+
+    virtual void visitSymbol(TIntermSymbol *symbol);
+    virtual bool visitAggregate(Visit, TIntermAggregate *node);
+    virtual bool visitBinary(Visit visit, TIntermBinary *binaryNode);
+
+  private:
+    template <typename VarT>
+    void visitVariable(const TIntermSymbol *variable, std::vector<VarT> *infoList) const;
+
+    template <typename VarT>
+    void visitInfoList(const TIntermSequence &sequence, std::vector<VarT> *infoList) const;
+
+    std::vector<Attribute> *mAttribs;
+    std::vector<Attribute> *mOutputVariables;
+    std::vector<Uniform> *mUniforms;
+    std::vector<Varying> *mVaryings;
+    std::vector<InterfaceBlock> *mInterfaceBlocks;
+
+    bool mPointCoordAdded;
+    bool mFrontFacingAdded;
+    bool mFragCoordAdded;
+
+    bool mPositionAdded;
+    bool mPointSizeAdded;
+
+    ShHashFunction64 mHashFunction;
+
+    const TSymbolTable &mSymbolTable;
+};
+
+// Expands struct uniforms, expanding the struct again for every element of
+// an array.
+void LegacyExpandUniforms(const std::vector<Uniform> &compact,
+                          std::vector<ShaderVariable> *expanded);
+
+}  // namespace sh
+
+#endif // COMPILER_PERF_TESTS_LEGACY_VARIABLE_INFO_H
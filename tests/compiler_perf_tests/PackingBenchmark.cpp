@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PackingBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+// The shapes of a uniform-heavy shader: a few matrices and vectors, and
+// many scalars and samplers, some of them in arrays.
+const ShVariableInfo kVariableMix[] =
+{
+    { GL_FLOAT_MAT4, 0 },
+    { GL_FLOAT_VEC4, 4 },
+    { GL_FLOAT_MAT3, 0 },
+    { GL_FLOAT_VEC3, 0 },
+    { GL_FLOAT_VEC2, 2 },
+    { GL_FLOAT_VEC2, 0 },
+    { GL_FLOAT, 3 },
+    { GL_FLOAT, 0 },
+    { GL_SAMPLER_2D, 0 },
+    { GL_FLOAT, 0 },
+    { GL_INT, 2 },
+    { GL_BOOL, 0 },
+    { GL_FLOAT, 5 },
+    { GL_SAMPLER_CUBE, 0 },
+    { GL_FLOAT, 0 },
+    { GL_INT, 0 },
+};
+
+struct CheckFunction
+{
+    int maxVectors;
+    std::vector<ShVariableInfo> *variables;
+
+    void operator()() const
+    {
+        ShCheckVariablesWithinPackingLimits(maxVectors, &(*variables)[0], variables->size());
+    }
+};
+
+struct PackFunction
+{
+    int maxVectors;
+    std::vector<ShVariableInfo> *variables;
+    std::vector<ShVariablePlacement> *placements;
+
+    void operator()() const
+    {
+        ShPackVariables(maxVectors, &(*variables)[0], variables->size(), &(*placements)[0]);
+    }
+};
+
+}  // namespace
+
+int RunPackingBenchmark(size_t numVariables)
+{
+    std::vector<ShVariableInfo> variables;
+    for (size_t i = 0; i < numVariables; ++i)
+        variables.push_back(kVariableMix[i % (sizeof(kVariableMix) / sizeof(kVariableMix[0]))]);
+    std::vector<ShVariablePlacement> placements(numVariables);
+
+    // The fewest vectors that the variables pack in.
+    int low = 1;
+    int high = static_cast<int>(numVariables) * 16;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (ShCheckVariablesWithinPackingLimits(middle, &variables[0], variables.size()))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    const int maxVectors = low;
+    if (!ShPackVariables(maxVectors, &variables[0], variables.size(), &placements[0]))
+    {
+        std::cerr << numVariables << " variables don't pack" << std::endl;
+        return -1;
+    }
+
+    CheckFunction check = { maxVectors, &variables };
+    PackFunction pack = { maxVectors, &variables, &placements };
+    const double runTimeSeconds = 0.5;
+    double checkTime = MeasureMicroseconds(check, runTimeSeconds);
+    double packTime = MeasureMicroseconds(pack, runTimeSeconds);
+
+    std::ostringstream suffix;
+    suffix << "_" << numVariables << "_variables";
+    perf_test::PrintResult("packing", suffix.str(), "vectors", static_cast<size_t>(maxVectors), "vectors", false);
+    perf_test::PrintResult("packing", suffix.str(), "check_time", checkTime, "us", true);
+    perf_test::PrintResult("packing", suffix.str(), "pack_time", packTime, "us", false);
+    return 0;
+}
@@ -0,0 +1,22 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PackingBenchmark.h:
+//   Measures how the variable packing check scales with the number of
+//   variables, as embedders run it at every link.
+//
+
+#ifndef COMPILER_PERF_TESTS_PACKING_BENCHMARK_H
+#define COMPILER_PERF_TESTS_PACKING_BENCHMARK_H
+
+#include <stddef.h>
+
+// Packs a mix of numVariables uniforms, most of them scalars and samplers,
+// in as few vectors as they fit in, and prints the time taken by
+// ShCheckVariablesWithinPackingLimits and ShPackVariables. Returns nonzero
+// if the variables don't pack.
+int RunPackingBenchmark(size_t numVariables);
+
+#endif // COMPILER_PERF_TESTS_PACKING_BENCHMARK_H
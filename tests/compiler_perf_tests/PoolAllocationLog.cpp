@@ -0,0 +1,21 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PoolAllocationLog.h"
+
+#include "compiler/translator/Compiler.h"
+
+int CompileWithAllocationLog(ShHandle compiler, const char *source, int compileOptions,
+                             std::vector<size_t> *log)
+{
+    TPoolAllocator &allocator = static_cast<TShHandleBase *>(compiler)->getAllocator();
+    const char *shaderStrings[] = { source };
+
+    allocator.setAllocationLog(log);
+    int result = ShCompile(compiler, shaderStrings, 1, compileOptions);
+    allocator.setAllocationLog(NULL);
+    return result;
+}
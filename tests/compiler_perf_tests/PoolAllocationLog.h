@@ -0,0 +1,24 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAllocationLog.h:
+//   Records the pool allocations of a compile. This reaches into the
+//   compiler, so it is kept apart from the benchmarks, which only use the
+//   public API.
+//
+
+#ifndef COMPILER_PERF_TESTS_POOL_ALLOCATION_LOG_H
+#define COMPILER_PERF_TESTS_POOL_ALLOCATION_LOG_H
+
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+
+// Compiles a single shader string as ShCompile does, appending the size of
+// every allocation from the compiler's pool to log.
+int CompileWithAllocationLog(ShHandle compiler, const char *source, int compileOptions,
+                             std::vector<size_t> *log);
+
+#endif // COMPILER_PERF_TESTS_POOL_ALLOCATION_LOG_H
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PoolAllocatorBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "LegacyPoolAllocator.h"
+#include "PoolAllocationLog.h"
+#include "angle_gl.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "third_party/perf/perf_test.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+
+typedef std::vector<std::vector<size_t> > AllocationTraces;
+
+struct PoolOptions
+{
+    const char *name;
+    size_t maxPageSize;
+    size_t maxRetainedBytes;
+};
+
+size_t OSAllocations(const LegacyPoolAllocator &allocator)
+{
+    return allocator.osAllocations();
+}
+
+size_t OSAllocations(const TPoolAllocator &allocator)
+{
+    return allocator.getStatistics().osAllocations;
+}
+
+// Makes the allocations of every shader of the corpus once, each shader
+// between a push and a pop, as a compile does.
+template <typename Allocator>
+struct ReplayPassFunction
+{
+    Allocator *allocator;
+    const AllocationTraces *traces;
+    size_t *passes;
+
+    void operator()() const
+    {
+        for (size_t i = 0; i < traces->size(); ++i)
+        {
+            const std::vector<size_t> &trace = (*traces)[i];
+            allocator->push();
+            for (size_t j = 0; j < trace.size(); ++j)
+            {
+                char *memory = static_cast<char *>(allocator->allocate(trace[j]));
+                if (trace[j] > 0)
+                    memory[0] = 0;
+            }
+            allocator->pop();
+        }
+        ++*passes;
+    }
+};
+
+bool RecordAllocations(const std::vector<CorpusShader> &corpus, int compileOptions,
+                       AllocationTraces *traces)
+{
+    ShBuiltInResources resources;
+    InitCorpusResources(&resources);
+    ShHandle vertexCompiler =
+        ShConstructCompiler(GL_VERTEX_SHADER, SH_WEBGL_SPEC, SH_HLSL11_OUTPUT, &resources);
+    ShHandle fragmentCompiler =
+        ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_HLSL11_OUTPUT, &resources);
+    bool success = vertexCompiler && fragmentCompiler;
+    if (!success)
+        std::cerr << "Failed to construct the compilers for the pool benchmark" << std::endl;
+
+    for (size_t i = 0; success && i < corpus.size(); ++i)
+    {
+        const CorpusShader &shader = corpus[i];
+        ShHandle compiler = shader.type == GL_VERTEX_SHADER ? vertexCompiler : fragmentCompiler;
+        traces->push_back(std::vector<size_t>());
+        success = CompileWithAllocationLog(compiler, shader.source.c_str(), compileOptions,
+                                           &traces->back()) != 0;
+        if (!success)
+        {
+            std::cerr << shader.name << " failed to compile:\n"
+                      << ShGetInfoLog(compiler) << std::endl;
+        }
+    }
+
+    if (vertexCompiler)
+        ShDestruct(vertexCompiler);
+    if (fragmentCompiler)
+        ShDestruct(fragmentCompiler);
+    return success;
+}
+
+template <typename Allocator>
+void Replay(Allocator *allocator, const AllocationTraces &traces, const std::string &name)
+{
+    size_t passes = 0;
+    ReplayPassFunction<Allocator> pass = { allocator, &traces, &passes };
+
+    // The first pass fills the retained pages, if they are kept.
+    pass();
+    size_t firstAllocations = OSAllocations(*allocator);
+
+    passes = 0;
+    double passTime = MeasureMicroseconds(pass, 1.0);
+    size_t allocations = OSAllocations(*allocator) - firstAllocations;
+
+    std::string suffix = "_" + name;
+    perf_test::PrintResult("pool", suffix, "pass_time", passTime, "us", true);
+    perf_test::PrintResult("pool", suffix, "os_allocations_first_pass", firstAllocations,
+                           "pages", false);
+    perf_test::PrintResult("pool", suffix, "os_allocations_per_pass",
+                           static_cast<double>(allocations) / passes, "pages", false);
+}
+
+}  // namespace
+
+int RunPoolAllocatorBenchmark(const std::vector<CorpusShader> &corpus, int compileOptions)
+{
+    AllocationTraces traces;
+    if (!RecordAllocations(corpus, compileOptions, &traces))
+        return -1;
+
+    size_t allocationCount = 0;
+    for (size_t i = 0; i < traces.size(); ++i)
+        allocationCount += traces[i].size();
+    perf_test::PrintResult("pool", "", "allocations_per_pass", allocationCount, "allocations",
+                           false);
+
+    {
+        LegacyPoolAllocator allocator;
+        Replay(&allocator, traces, "legacy");
+    }
+
+    const PoolOptions poolOptions[] =
+    {
+        { "default", 0, ~static_cast<size_t>(0) },
+        { "no_retained_pages", 0, 0 },
+        { "growing_pages", 64 * 1024, ~static_cast<size_t>(0) },
+    };
+    for (size_t i = 0; i < ArraySize(poolOptions); ++i)
+    {
+        TPoolAllocator allocator;
+        ShPoolAllocatorOptions options;
+        ShInitPoolAllocatorOptions(&options);
+        allocator.setPageSize(options.pageSize);
+        allocator.setMaxBlockSize(std::max(options.pageSize, poolOptions[i].maxPageSize));
+        allocator.setMaxRetainedBytes(poolOptions[i].maxRetainedBytes);
+        Replay(&allocator, traces, poolOptions[i].name);
+    }
+    return 0;
+}
@@ -0,0 +1,25 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAllocatorBenchmark.h:
+//   Compares the pool allocator with the one it replaced on the allocations
+//   of the corpus.
+//
+
+#ifndef COMPILER_PERF_TESTS_POOL_ALLOCATOR_BENCHMARK_H
+#define COMPILER_PERF_TESTS_POOL_ALLOCATOR_BENCHMARK_H
+
+#include "CompilerBenchmark.h"
+
+// Records the pool allocations of compiling each shader of the corpus to
+// HLSL11, then replays them over and over, a push and a pop per shader, on
+// the legacy allocator and on the current one with the default options,
+// with no freed page kept, and with pages growing up to 64 KB. Prints the
+// time and the pages obtained from the OS per pass over the corpus, and
+// the pages of the first pass on a new allocator. Returns nonzero if a
+// shader fails to compile.
+int RunPoolAllocatorBenchmark(const std::vector<CorpusShader> &corpus, int compileOptions);
+
+#endif // COMPILER_PERF_TESTS_POOL_ALLOCATOR_BENCHMARK_H
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "UniformsBenchmark.h"
+
+#include "BenchmarkUtils.h"
+#include "VariableCollection.h"
+#include "angle_gl.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+#include <sstream>
+
+std::string GenerateVectorUniformsShader(size_t numUniforms)
+{
+    std::ostringstream declarations;
+    std::ostringstream body;
+    declarations << "struct S { vec4 v; float f; };\n";
+    for (size_t i = 0; i < numUniforms; ++i)
+    {
+        if (i % 10 == 9)
+        {
+            declarations << "uniform S u" << i << "[2];\n";
+            for (int use = 0; use < 3; ++use)
+                body << "    sum += u" << i << "[" << (use & 1) << "].v * u" << i << "[1].f;\n";
+        }
+        else
+        {
+            declarations << "uniform vec4 u" << i << ";\n";
+            for (int use = 0; use < 3; ++use)
+                body << "    sum += u" << i << ";\n";
+        }
+    }
+
+    std::ostringstream shader;
+    shader << declarations.str()
+           << "void main() {\n"
+           << "    vec4 sum = vec4(0.0);\n"
+           << body.str()
+           << "    gl_Position = sum;\n"
+           << "}\n";
+    return shader.str();
+}
+
+std::string GenerateLightArraysShader(size_t numUniforms)
+{
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "struct Falloff { float constant; float linear; float quadratic; };\n"
+           << "struct Light { vec3 position; vec3 color; Falloff falloff; };\n";
+    for (size_t i = 0; i < numUniforms; ++i)
+        shader << "uniform Light lights" << i << "[4];\n";
+    shader << "varying vec3 vPosition;\n"
+           << "vec3 shade(Light light) {\n"
+           << "    float d = distance(light.position, vPosition);\n"
+           << "    Falloff f = light.falloff;\n"
+           << "    return light.color / (f.constant + d * (f.linear + d * f.quadratic));\n"
+           << "}\n"
+           << "void main() {\n"
+           << "    vec3 color = vec3(0.0);\n";
+    for (size_t i = 0; i < numUniforms; ++i)
+        shader << "    color += shade(lights" << i << "[" << i % 4 << "]);\n";
+    shader << "    gl_FragColor = vec4(color, 1.0);\n"
+           << "}\n";
+    return shader.str();
+}
+
+int RunUniformsBenchmark(const std::string &name, sh::GLenum type,
+                         UniformsShaderGenerator generateShader,
+                         const std::vector<size_t> &uniformCounts)
+{
+    VariableCollectionTimes previousTimes = { 0, 0, 0.0, 0.0, 0.0, 0.0 };
+    for (size_t countIndex = 0; countIndex < uniformCounts.size(); ++countIndex)
+    {
+        size_t numUniforms = uniformCounts[countIndex];
+        std::string source = generateShader(numUniforms);
+
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        // Enough vectors for every uniform, so that the packing check succeeds.
+        resources.MaxVertexUniformVectors = static_cast<int>(numUniforms) * 16;
+        resources.MaxFragmentUniformVectors = static_cast<int>(numUniforms) * 16;
+
+        // The legacy collection of the largest shaders takes seconds, so it
+        // is timed once; the others are repeated for a fraction of that.
+        const double collectionTimeSeconds = 0.2;
+        VariableCollectionTimes times = { 0, 0, 0.0, 0.0, 0.0, 0.0 };
+        if (!MeasureVariableCollection(type, SH_WEBGL_SPEC, resources, source.c_str(),
+                                       collectionTimeSeconds, &times))
+        {
+            std::cerr << "The " << name << " shader with " << numUniforms
+                      << " uniforms failed to compile" << std::endl;
+            return -1;
+        }
+
+        ShHandle compiler = ShConstructCompiler(type, SH_WEBGL_SPEC, SH_ESSL_OUTPUT, &resources);
+        if (!compiler)
+        {
+            std::cerr << "Failed to construct the compiler for the uniforms benchmark" << std::endl;
+            return -1;
+        }
+
+        const int packingOptions = SH_VARIABLES | SH_ENFORCE_PACKING_RESTRICTIONS;
+        const char *shaderStrings[] = { source.c_str() };
+        if (!ShCompile(compiler, shaderStrings, 1, packingOptions))
+        {
+            std::cerr << "The " << name << " shader with " << numUniforms
+                      << " uniforms failed the packing check:\n"
+                      << ShGetInfoLog(compiler) << std::endl;
+            ShDestruct(compiler);
+            return -1;
+        }
+
+        const double runTimeSeconds = 0.5;
+        CompileFunction compile = { compiler, &source, SH_VARIABLES };
+        double variablesTime = MeasureMicroseconds(compile, runTimeSeconds);
+        compile.compileOptions = packingOptions;
+        double packingTime = MeasureMicroseconds(compile, runTimeSeconds);
+        ShDestruct(compiler);
+
+        // The legacy compiler collected and expanded on every SH_VARIABLES
+        // compile; the compiler now only expands for the packing check.
+        double legacyTime = times.legacyCollectTime + times.legacyExpandTime;
+        std::ostringstream suffix;
+        suffix << "_" << name << "_" << numUniforms << "_uniforms";
+        perf_test::PrintResult("uniforms", suffix.str(), "expanded_uniforms",
+                               times.expandedUniforms, "variables", false);
+        perf_test::PrintResult("uniforms", suffix.str(), "legacy_collect_time",
+                               1e-3 * times.legacyCollectTime, "ms", false);
+        perf_test::PrintResult("uniforms", suffix.str(), "collect_time",
+                               1e-3 * times.collectTime, "ms", true);
+        perf_test::PrintResult("uniforms", suffix.str(), "legacy_expand_time",
+                               1e-3 * times.legacyExpandTime, "ms", false);
+        perf_test::PrintResult("uniforms", suffix.str(), "expand_time",
+                               1e-3 * times.expandTime, "ms", true);
+        if (countIndex > 0)
+        {
+            perf_test::PrintResult("uniforms", suffix.str(), "legacy_collect_growth",
+                                   times.legacyCollectTime / previousTimes.legacyCollectTime,
+                                   "x", false);
+            perf_test::PrintResult("uniforms", suffix.str(), "collect_growth",
+                                   times.collectTime / previousTimes.collectTime, "x", false);
+        }
+        perf_test::PrintResult("uniforms", suffix.str(), "legacy_variables_compile_time",
+                               1e-3 * (variablesTime - times.collectTime + legacyTime), "ms",
+                               false);
+        perf_test::PrintResult("uniforms", suffix.str(), "variables_compile_time",
+                               1e-3 * variablesTime, "ms", true);
+        perf_test::PrintResult("uniforms", suffix.str(), "legacy_packing_compile_time",
+                               1e-3 * (packingTime - times.collectTime - times.expandTime +
+                                       legacyTime), "ms", false);
+        perf_test::PrintResult("uniforms", suffix.str(), "packing_compile_time",
+                               1e-3 * packingTime, "ms", false);
+        previousTimes = times;
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// UniformsBenchmark.h:
+//   Measures how the compile time of a shader scales with its number of
+//   uniforms, as the variables are collected and packed, against the
+//   collection that scanned the variable lists.
+//
+
+#ifndef COMPILER_PERF_TESTS_UNIFORMS_BENCHMARK_H
+#define COMPILER_PERF_TESTS_UNIFORMS_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+
+// Generates a shader that declares numUniforms uniforms.
+typedef std::string (*UniformsShaderGenerator)(size_t numUniforms);
+
+// A vertex shader of vec4 uniforms, a tenth of them arrays of structs
+// instead, each referenced three times.
+std::string GenerateVectorUniformsShader(size_t numUniforms);
+
+// A fragment shader of arrays of lights, which are structs with a nested
+// struct, each light referenced once.
+std::string GenerateLightArraysShader(size_t numUniforms);
+
+// Compiles the shader that generateShader gives for each of uniformCounts.
+// For each, prints under name the time of collecting the variables and
+// expanding the uniforms, the legacy way and as the compiler does now, how
+// much the collection time grew from the count before, and the compile
+// time with SH_VARIABLES and with the packing check. Returns nonzero if a
+// shader doesn't compile.
+int RunUniformsBenchmark(const std::string &name, sh::GLenum type,
+                         UniformsShaderGenerator generateShader,
+                         const std::vector<size_t> &uniformCounts);
+
+#endif // COMPILER_PERF_TESTS_UNIFORMS_BENCHMARK_H
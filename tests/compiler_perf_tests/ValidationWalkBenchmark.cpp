@@ -0,0 +1,46 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "ValidationWalkBenchmark.h"
+
+#include "ValidationWalks.h"
+#include "third_party/perf/perf_test.h"
+
+#include <iostream>
+
+int RunValidationWalkBenchmark(const std::vector<CorpusShader> &corpus, int compileOptions)
+{
+    ShBuiltInResources resources;
+    InitCorpusResources(&resources);
+
+    // The walks of a shader take tens of microseconds, so each is repeated
+    // enough for the clock, alternating between the two ways.
+    const int runs = 50;
+    ValidationWalkTimes times = { 0, 0, 0, 0.0, 0.0 };
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        const CorpusShader &shader = corpus[i];
+        if (!MeasureValidationWalks(shader.type, SH_WEBGL_SPEC, resources, shader.source.c_str(),
+                                    compileOptions, runs, &times))
+        {
+            std::cerr << shader.name << " failed to compile" << std::endl;
+            return -1;
+        }
+    }
+
+    double compiles = static_cast<double>(corpus.size());
+    perf_test::PrintResult("validation_walks", "", "nodes_per_compile", times.nodes / compiles,
+                           "nodes", false);
+    perf_test::PrintResult("validation_walks", "_separate", "walks_per_compile",
+                           times.separateWalks / compiles, "walks", false);
+    perf_test::PrintResult("validation_walks", "_fused", "walks_per_compile",
+                           times.fusedWalks / compiles, "walks", false);
+    perf_test::PrintResult("validation_walks", "_separate", "walk_time",
+                           times.separateTime / (compiles * runs), "us", true);
+    perf_test::PrintResult("validation_walks", "_fused", "walk_time",
+                           times.fusedTime / (compiles * runs), "us", true);
+    return 0;
+}
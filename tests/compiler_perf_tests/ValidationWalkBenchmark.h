@@ -0,0 +1,23 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ValidationWalkBenchmark.h:
+//   Compares the validation passes walking the trees of the corpus one
+//   after another with the single walk that they share.
+//
+
+#ifndef COMPILER_PERF_TESTS_VALIDATION_WALK_BENCHMARK_H
+#define COMPILER_PERF_TESTS_VALIDATION_WALK_BENCHMARK_H
+
+#include "CompilerBenchmark.h"
+
+// Compiles each shader of the corpus for WebGL, and walks its tree with the
+// validation passes that compileOptions enables, both each pass on its own
+// and all of them together. Prints the walks and nodes per compile, and the
+// mean time per compile of the separate walks and of the fused one.
+// Returns nonzero if a shader fails to compile.
+int RunValidationWalkBenchmark(const std::vector<CorpusShader> &corpus, int compileOptions);
+
+#endif // COMPILER_PERF_TESTS_VALIDATION_WALK_BENCHMARK_H
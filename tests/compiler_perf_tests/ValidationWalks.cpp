@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "ValidationWalks.h"
+
+#include "BenchmarkUtils.h"
+#include "angle_gl.h"
+#include "compiler/translator/CallDAG.h"
+#include "compiler/translator/CompositeTraverser.h"
+#include "compiler/translator/TranslatorESSL.h"
+#include "compiler/translator/ValidateLimitations.h"
+#include "compiler/translator/ValidateOutputs.h"
+
+#include <iostream>
+
+namespace
+{
+
+// The passes of TCompiler::validateTree, with the options of a compile.
+class ValidationPasses
+{
+  public:
+    ValidationPasses(sh::GLenum shaderType, int shaderVersion, const ShBuiltInResources &resources,
+                     int compileOptions)
+        : mDepthTraverser(resources.MaxExpressionComplexity + 1),
+          mCallDagBuilder(&mCallDag),
+          mValidateOutputs(mOutputErrors, resources.MaxDrawBuffers),
+          mValidateLimitations(shaderType, mLimitationErrors)
+    {
+        if (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY)
+            mPasses.push_back(&mDepthTraverser);
+        mPasses.push_back(&mCallDagBuilder);
+        if (shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
+            mPasses.push_back(&mValidateOutputs);
+        if (compileOptions & SH_VALIDATE_LOOP_INDEXING)
+            mPasses.push_back(&mValidateLimitations);
+    }
+
+    size_t count() const { return mPasses.size(); }
+    size_t nodeCount() const { return mCallDagBuilder.getNodeCount(); }
+
+    void walkSeparately(TIntermNode *root)
+    {
+        for (size_t i = 0; i < mPasses.size(); ++i)
+            root->traverse(mPasses[i]);
+    }
+
+    void walkFused(TIntermNode *root)
+    {
+        CompositeTraverser validation(mPasses);
+        root->traverse(&validation);
+    }
+
+  private:
+    TMaxDepthTraverser mDepthTraverser;
+    CallDAG mCallDag;
+    CallDAG::Builder mCallDagBuilder;
+    TInfoSinkBase mOutputErrors;
+    ValidateOutputs mValidateOutputs;
+    TInfoSinkBase mLimitationErrors;
+    ValidateLimitations mValidateLimitations;
+
+    std::vector<TIntermTraverser *> mPasses;
+};
+
+// Walks the tree in place of writing the object code, after the validation
+// and the passes that mark the tree, which leave it much the same.
+class ValidationWalkTranslator : public TranslatorESSL
+{
+  public:
+    ValidationWalkTranslator(sh::GLenum type, ShShaderSpec spec, int runs,
+                             ValidationWalkTimes *times)
+        : TranslatorESSL(type, spec),
+          mRuns(runs),
+          mTimes(times)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root, int compileOptions)
+    {
+        typedef std::chrono::steady_clock Clock;
+        TPoolAllocator *allocator = GetGlobalPoolAllocator();
+
+        for (int run = 0; run < mRuns; ++run)
+        {
+            // Each run gets new passes, as each compile does.
+            allocator->push();
+            Clock::time_point start = Clock::now();
+            {
+                ValidationPasses passes(getShaderType(), getShaderVersion(), getResources(),
+                                        compileOptions);
+                passes.walkSeparately(root);
+                if (run == 0)
+                {
+                    mTimes->separateWalks += passes.count();
+                    mTimes->nodes += passes.nodeCount();
+                }
+            }
+            Clock::time_point separateEnd = Clock::now();
+            allocator->pop();
+
+            allocator->push();
+            Clock::time_point fusedStart = Clock::now();
+            {
+                ValidationPasses passes(getShaderType(), getShaderVersion(), getResources(),
+                                        compileOptions);
+                passes.walkFused(root);
+            }
+            Clock::time_point end = Clock::now();
+            allocator->pop();
+
+            if (run == 0)
+                mTimes->fusedWalks += 1;
+            mTimes->separateTime += 1e6 * Seconds(separateEnd - start);
+            mTimes->fusedTime += 1e6 * Seconds(end - fusedStart);
+        }
+    }
+
+  private:
+    int mRuns;
+    ValidationWalkTimes *mTimes;
+};
+
+}  // namespace
+
+bool MeasureValidationWalks(sh::GLenum type, ShShaderSpec spec,
+                            const ShBuiltInResources &resources, const char *source,
+                            int compileOptions, int runs, ValidationWalkTimes *times)
+{
+    ValidationWalkTranslator translator(type, spec, runs, times);
+    if (!translator.Init(resources))
+    {
+        std::cerr << "Failed to initialize the compiler for the validation walk benchmark"
+                  << std::endl;
+        return false;
+    }
+
+    const char *shaderStrings[] = { source };
+    if (!translator.compile(shaderStrings, 1, compileOptions | SH_OBJECT_CODE))
+    {
+        std::cerr << translator.getInfoSink().info.c_str() << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ValidationWalks.h:
+//   Times the validation passes of a compile walking the tree one after
+//   another, and all together in the single walk that the compiler makes.
+//   This reaches into the compiler, so it is kept apart from the
+//   benchmarks, which only use the public API.
+//
+
+#ifndef COMPILER_PERF_TESTS_VALIDATION_WALKS_H
+#define COMPILER_PERF_TESTS_VALIDATION_WALKS_H
+
+#include "GLSLANG/ShaderLang.h"
+
+struct ValidationWalkTimes
+{
+    // Walks of the whole tree.
+    size_t separateWalks;
+    size_t fusedWalks;
+    // Nodes of the tree.
+    size_t nodes;
+    // Total time of the walks, in microseconds.
+    double separateTime;
+    double fusedTime;
+};
+
+// Compiles a single shader string, and at the point where the object code
+// would be written, walks the tree with the validation passes that
+// compileOptions enables: runs times each on its own, and runs times all
+// together, interleaved. Adds the walks and nodes of one compile and the
+// times of all the runs to times. Returns false if the shader doesn't
+// compile.
+bool MeasureValidationWalks(sh::GLenum type, ShShaderSpec spec,
+                            const ShBuiltInResources &resources, const char *source,
+                            int compileOptions, int runs, ValidationWalkTimes *times);
+
+#endif // COMPILER_PERF_TESTS_VALIDATION_WALKS_H
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "VariableCollection.h"
+
+#include "BenchmarkUtils.h"
+#include "LegacyVariableInfo.h"
+#include "compiler/translator/TranslatorESSL.h"
+#include "compiler/translator/VariableInfo.h"
+
+#include <iostream>
+
+namespace
+{
+
+typedef void (*ExpandUniformsFunction)(const std::vector<sh::Uniform> &,
+                                       std::vector<sh::ShaderVariable> *);
+
+// Collects the variables of the tree into variables, as a compile does,
+// for MeasureMicroseconds.
+template <typename Collector>
+struct CollectFunction
+{
+    TIntermNode *root;
+    ShHashFunction64 hashFunction;
+    const TSymbolTable *symbolTable;
+    std::vector<sh::Uniform> *uniforms;
+    std::vector<sh::Varying> *varyings;
+
+    void operator()() const
+    {
+        std::vector<sh::Attribute> attributes;
+        std::vector<sh::Attribute> outputVariables;
+        std::vector<sh::InterfaceBlock> interfaceBlocks;
+        uniforms->clear();
+        varyings->clear();
+
+        TPoolAllocator *allocator = GetGlobalPoolAllocator();
+        allocator->push();
+        {
+            Collector collect(&attributes, &outputVariables, uniforms, varyings,
+                              &interfaceBlocks, hashFunction, *symbolTable);
+            root->traverse(&collect);
+        }
+        allocator->pop();
+    }
+};
+
+struct ExpandFunction
+{
+    ExpandUniformsFunction expand;
+    const std::vector<sh::Uniform> *uniforms;
+    std::vector<sh::ShaderVariable> *expanded;
+
+    void operator()() const
+    {
+        expanded->clear();
+        expand(*uniforms, expanded);
+    }
+};
+
+// ShaderVariable only compares as part of the variable kinds, so the
+// expanded uniforms are compared by hand.
+bool SameExpandedVariables(const std::vector<sh::ShaderVariable> &a,
+                           const std::vector<sh::ShaderVariable> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].name != b[i].name || a[i].mappedName != b[i].mappedName ||
+            a[i].type != b[i].type || a[i].arraySize != b[i].arraySize ||
+            a[i].staticUse != b[i].staticUse)
+            return false;
+    }
+    return true;
+}
+
+// Collects the variables in place of writing the object code, after the
+// validation and the passes that mark the tree, which leave it much the
+// same.
+class VariableCollectionTranslator : public TranslatorESSL
+{
+  public:
+    VariableCollectionTranslator(sh::GLenum type, ShShaderSpec spec, double runTimeSeconds,
+                                 VariableCollectionTimes *times)
+        : TranslatorESSL(type, spec),
+          mRunTimeSeconds(runTimeSeconds),
+          mTimes(times),
+          mSameVariables(false)
+    {
+    }
+
+    bool sameVariables() const { return mSameVariables; }
+
+  protected:
+    virtual void translate(TIntermNode *root, int)
+    {
+        std::vector<sh::Uniform> legacyUniforms;
+        std::vector<sh::Varying> legacyVaryings;
+        CollectFunction<sh::LegacyCollectVariables> legacyCollect =
+            { root, getHashFunction(), &getSymbolTable(), &legacyUniforms, &legacyVaryings };
+        mTimes->legacyCollectTime = MeasureMicroseconds(legacyCollect, mRunTimeSeconds);
+
+        std::vector<sh::Uniform> uniforms;
+        std::vector<sh::Varying> varyings;
+        CollectFunction<sh::CollectVariables> collect =
+            { root, getHashFunction(), &getSymbolTable(), &uniforms, &varyings };
+        mTimes->collectTime = MeasureMicroseconds(collect, mRunTimeSeconds);
+
+        std::vector<sh::ShaderVariable> legacyExpanded;
+        ExpandFunction legacyExpand = { sh::LegacyExpandUniforms, &legacyUniforms,
+                                        &legacyExpanded };
+        mTimes->legacyExpandTime = MeasureMicroseconds(legacyExpand, mRunTimeSeconds);
+
+        std::vector<sh::ShaderVariable> expanded;
+        ExpandFunction expand = { sh::ExpandUniforms, &uniforms, &expanded };
+        mTimes->expandTime = MeasureMicroseconds(expand, mRunTimeSeconds);
+
+        mTimes->uniforms = uniforms.size();
+        mTimes->expandedUniforms = expanded.size();
+        mSameVariables = uniforms == legacyUniforms && varyings == legacyVaryings &&
+                         SameExpandedVariables(expanded, legacyExpanded);
+    }
+
+  private:
+    double mRunTimeSeconds;
+    VariableCollectionTimes *mTimes;
+    bool mSameVariables;
+};
+
+}  // namespace
+
+bool MeasureVariableCollection(sh::GLenum type, ShShaderSpec spec,
+                               const ShBuiltInResources &resources, const char *source,
+                               double runTimeSeconds, VariableCollectionTimes *times)
+{
+    VariableCollectionTranslator translator(type, spec, runTimeSeconds, times);
+    if (!translator.Init(resources))
+    {
+        std::cerr << "Failed to initialize the compiler for the uniforms benchmark" << std::endl;
+        return false;
+    }
+
+    const char *shaderStrings[] = { source };
+    if (!translator.compile(shaderStrings, 1, SH_OBJECT_CODE))
+    {
+        std::cerr << translator.getInfoSink().info.c_str() << std::endl;
+        return false;
+    }
+    if (!translator.sameVariables())
+    {
+        std::cerr << "The legacy and indexed variable collections differ" << std::endl;
+        return false;
+    }
+    return true;
+}
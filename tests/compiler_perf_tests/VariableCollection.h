@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VariableCollection.h:
+//   Times the collection of the variables of a compile and the expansion of
+//   its uniforms, as the compiler does them and as it used to. This reaches
+//   into the compiler, so it is kept apart from the benchmarks, which only
+//   use the public API.
+//
+
+#ifndef COMPILER_PERF_TESTS_VARIABLE_COLLECTION_H
+#define COMPILER_PERF_TESTS_VARIABLE_COLLECTION_H
+
+#include "GLSLANG/ShaderLang.h"
+
+struct VariableCollectionTimes
+{
+    // The uniforms collected, and the variables they expand to.
+    size_t uniforms;
+    size_t expandedUniforms;
+    // Mean times in microseconds. The legacy compiler expanded the uniforms
+    // on every SH_VARIABLES compile; the compiler now only does for the
+    // packing check.
+    double legacyCollectTime;
+    double legacyExpandTime;
+    double collectTime;
+    double expandTime;
+};
+
+// Compiles a single shader string, and at the point where the object code
+// would be written, collects the variables of the tree and expands the
+// uniforms both ways, each for about runTimeSeconds. Returns false if the
+// shader doesn't compile, or if the two ways don't give the same
+// variables.
+bool MeasureVariableCollection(sh::GLenum type, ShShaderSpec spec,
+                               const ShBuiltInResources &resources, const char *source,
+                               double runTimeSeconds, VariableCollectionTimes *times);
+
+#endif // COMPILER_PERF_TESTS_VARIABLE_COLLECTION_H
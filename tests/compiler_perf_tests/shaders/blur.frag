@@ -0,0 +1,28 @@
+// Separable gaussian blur with weights computed in the loop.
+precision mediump float;
+
+const int kTaps = 13;
+
+uniform sampler2D s_source;
+uniform vec2 u_direction;
+uniform float u_sigma;
+varying vec2 v_texCoord;
+
+float gaussian(float x, float sigma)
+{
+    return exp(-(x * x) / (2.0 * sigma * sigma));
+}
+
+void main()
+{
+    vec4 sum = vec4(0.0);
+    float total = 0.0;
+    for (int i = 0; i < kTaps; i++)
+    {
+        float offset = float(i - kTaps / 2);
+        float weight = gaussian(offset, u_sigma);
+        sum += texture2D(s_source, v_texCoord + u_direction * offset) * weight;
+        total += weight;
+    }
+    gl_FragColor = sum / total;
+}
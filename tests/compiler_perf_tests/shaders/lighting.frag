@@ -0,0 +1,75 @@
+// Normal-mapped Blinn-Phong shading with point and directional lights.
+precision mediump float;
+
+const int kMaxLights = 4;
+
+struct Light
+{
+    vec3 position;
+    vec3 color;
+    float radius;
+    bool directional;
+};
+
+struct Material
+{
+    vec3 diffuse;
+    vec3 specular;
+    float shininess;
+};
+
+uniform Light u_lights[kMaxLights];
+uniform int u_lightCount;
+uniform Material u_material;
+uniform vec3 u_ambient;
+uniform sampler2D s_diffuseMap;
+uniform sampler2D s_normalMap;
+
+varying vec3 v_worldPosition;
+varying vec3 v_normal;
+varying vec3 v_tangent;
+varying vec3 v_bitangent;
+varying vec3 v_viewDirection;
+varying vec2 v_texCoord;
+
+float attenuation(Light light, float distance)
+{
+    if (light.directional)
+        return 1.0;
+    float ratio = clamp(distance / light.radius, 0.0, 1.0);
+    return (1.0 - ratio * ratio) / (1.0 + distance * distance);
+}
+
+vec3 shade(Light light, vec3 normal, vec3 viewDirection, vec3 albedo)
+{
+    vec3 toLight = light.directional ? light.position : light.position - v_worldPosition;
+    float distance = length(toLight);
+    vec3 lightDirection = toLight / distance;
+    vec3 halfVector = normalize(lightDirection + viewDirection);
+
+    float diffuse = max(dot(normal, lightDirection), 0.0);
+    float specular = diffuse > 0.0 ?
+        pow(max(dot(normal, halfVector), 0.0), u_material.shininess) : 0.0;
+
+    vec3 color = albedo * u_material.diffuse * diffuse + u_material.specular * specular;
+    return color * light.color * attenuation(light, distance);
+}
+
+void main()
+{
+    vec3 mapped = texture2D(s_normalMap, v_texCoord).xyz * 2.0 - 1.0;
+    mat3 tangentSpace = mat3(normalize(v_tangent), normalize(v_bitangent), normalize(v_normal));
+    vec3 normal = normalize(tangentSpace * mapped);
+    vec3 viewDirection = normalize(v_viewDirection);
+    vec4 albedo = texture2D(s_diffuseMap, v_texCoord);
+
+    vec3 color = u_ambient * albedo.rgb;
+    for (int i = 0; i < kMaxLights; ++i)
+    {
+        if (i >= u_lightCount)
+            break;
+        color += shade(u_lights[i], normal, viewDirection, albedo.rgb);
+    }
+
+    gl_FragColor = vec4(color, albedo.a);
+}
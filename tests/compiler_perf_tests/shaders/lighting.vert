@@ -0,0 +1,30 @@
+// Per-vertex inputs for per-pixel lighting with several lights.
+attribute vec3 a_position;
+attribute vec3 a_normal;
+attribute vec3 a_tangent;
+attribute vec2 a_texCoord;
+
+uniform mat4 u_modelMatrix;
+uniform mat4 u_viewMatrix;
+uniform mat4 u_projectionMatrix;
+uniform mat3 u_normalMatrix;
+uniform vec3 u_eyePosition;
+
+varying vec3 v_worldPosition;
+varying vec3 v_normal;
+varying vec3 v_tangent;
+varying vec3 v_bitangent;
+varying vec3 v_viewDirection;
+varying vec2 v_texCoord;
+
+void main()
+{
+    vec4 worldPosition = u_modelMatrix * vec4(a_position, 1.0);
+    v_worldPosition = worldPosition.xyz;
+    v_normal = normalize(u_normalMatrix * a_normal);
+    v_tangent = normalize(u_normalMatrix * a_tangent);
+    v_bitangent = cross(v_normal, v_tangent);
+    v_viewDirection = u_eyePosition - worldPosition.xyz;
+    v_texCoord = a_texCoord;
+    gl_Position = u_projectionMatrix * u_viewMatrix * worldPosition;
+}
@@ -0,0 +1,14 @@
+// Rotated, tinted point sprites.
+precision mediump float;
+uniform sampler2D s_sprite;
+varying vec4 v_color;
+varying float v_rotation;
+
+void main()
+{
+    float c = cos(v_rotation);
+    float s = sin(v_rotation);
+    vec2 centered = gl_PointCoord - 0.5;
+    vec2 rotated = mat2(c, s, -s, c) * centered + 0.5;
+    gl_FragColor = texture2D(s_sprite, rotated) * v_color;
+}
@@ -0,0 +1,30 @@
+// Point-sprite particles animated entirely on the GPU.
+attribute vec3 a_origin;
+attribute vec3 a_velocity;
+attribute vec2 a_lifetime;
+attribute float a_seed;
+
+uniform mat4 u_viewProjectionMatrix;
+uniform float u_time;
+uniform vec3 u_gravity;
+uniform float u_pointScale;
+uniform vec4 u_startColor;
+uniform vec4 u_endColor;
+
+varying vec4 v_color;
+varying float v_rotation;
+
+void main()
+{
+    float age = mod(u_time + a_seed * a_lifetime.y, a_lifetime.y);
+    float life = age / a_lifetime.y;
+    vec3 position = a_origin + a_velocity * age + 0.5 * u_gravity * age * age;
+
+    v_color = mix(u_startColor, u_endColor, life);
+    v_color.a *= smoothstep(0.0, 0.1, life) * (1.0 - smoothstep(0.8, 1.0, life));
+    v_rotation = a_seed * 6.2831853 + age;
+
+    vec4 clipPosition = u_viewProjectionMatrix * vec4(position, 1.0);
+    gl_PointSize = u_pointScale * (1.0 + life) / clipPosition.w;
+    gl_Position = clipPosition;
+}
@@ -0,0 +1,62 @@
+// Tone mapping, color grading, vignette and film grain in one pass.
+precision highp float;
+
+uniform sampler2D s_scene;
+uniform sampler2D s_bloom;
+uniform float u_exposure;
+uniform float u_bloomStrength;
+uniform mat3 u_colorMatrix;
+uniform vec3 u_lift;
+uniform vec3 u_gamma;
+uniform vec3 u_gain;
+uniform float u_vignette;
+uniform float u_time;
+uniform vec2 u_resolution;
+varying vec2 v_texCoord;
+
+vec3 filmic(vec3 x)
+{
+    const float A = 0.15;
+    const float B = 0.50;
+    const float C = 0.10;
+    const float D = 0.20;
+    const float E = 0.02;
+    const float F = 0.30;
+    return ((x * (A * x + C * B) + D * E) / (x * (A * x + B) + D * F)) - E / F;
+}
+
+vec3 tonemap(vec3 color)
+{
+    const float kWhitePoint = 11.2;
+    vec3 mapped = filmic(color * u_exposure * 2.0);
+    return mapped / filmic(vec3(kWhitePoint));
+}
+
+vec3 grade(vec3 color)
+{
+    color = u_colorMatrix * color;
+    color = u_gain * (color + u_lift * (1.0 - color));
+    return pow(max(color, vec3(0.0)), 1.0 / u_gamma);
+}
+
+float random(vec2 seed)
+{
+    return fract(sin(dot(seed, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+void main()
+{
+    vec3 hdr = texture2D(s_scene, v_texCoord).rgb;
+    hdr += texture2D(s_bloom, v_texCoord).rgb * u_bloomStrength;
+
+    vec3 color = grade(tonemap(hdr));
+
+    vec2 centered = v_texCoord - 0.5;
+    float vignette = 1.0 - dot(centered, centered) * u_vignette;
+    color *= vignette;
+
+    float grain = random(v_texCoord * u_resolution + u_time) - 0.5;
+    color += grain / 64.0;
+
+    gl_FragColor = vec4(pow(color, vec3(1.0 / 2.2)), 1.0);
+}
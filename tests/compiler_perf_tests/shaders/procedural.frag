@@ -0,0 +1,131 @@
+// Procedural raymarched scene, in the style of shader showcase pages:
+// many small functions, nested loops and heavy arithmetic.
+precision highp float;
+
+uniform vec2 u_resolution;
+uniform float u_time;
+uniform vec3 u_cameraPosition;
+
+const int kMaxSteps = 64;
+const float kMaxDistance = 40.0;
+const float kEpsilon = 0.001;
+
+float hash(vec3 p)
+{
+    p = fract(p * 0.3183099 + 0.1);
+    p *= 17.0;
+    return fract(p.x * p.y * p.z * (p.x + p.y + p.z));
+}
+
+float noise(vec3 x)
+{
+    vec3 i = floor(x);
+    vec3 f = fract(x);
+    f = f * f * (3.0 - 2.0 * f);
+    return mix(mix(mix(hash(i + vec3(0.0, 0.0, 0.0)), hash(i + vec3(1.0, 0.0, 0.0)), f.x),
+                   mix(hash(i + vec3(0.0, 1.0, 0.0)), hash(i + vec3(1.0, 1.0, 0.0)), f.x), f.y),
+               mix(mix(hash(i + vec3(0.0, 0.0, 1.0)), hash(i + vec3(1.0, 0.0, 1.0)), f.x),
+                   mix(hash(i + vec3(0.0, 1.0, 1.0)), hash(i + vec3(1.0, 1.0, 1.0)), f.x), f.y), f.z);
+}
+
+float fbm(vec3 p)
+{
+    float value = 0.0;
+    float amplitude = 0.5;
+    for (int i = 0; i < 5; ++i)
+    {
+        value += amplitude * noise(p);
+        p = p * 2.02 + vec3(1.7, 9.2, 3.1);
+        amplitude *= 0.5;
+    }
+    return value;
+}
+
+float sphere(vec3 p, float radius)
+{
+    return length(p) - radius;
+}
+
+float roundBox(vec3 p, vec3 size, float radius)
+{
+    vec3 q = abs(p) - size;
+    return length(max(q, 0.0)) + min(max(q.x, max(q.y, q.z)), 0.0) - radius;
+}
+
+float smoothUnion(float a, float b, float k)
+{
+    float h = clamp(0.5 + 0.5 * (b - a) / k, 0.0, 1.0);
+    return mix(b, a, h) - k * h * (1.0 - h);
+}
+
+vec2 scene(vec3 p)
+{
+    float ground = p.y + 1.0 + 0.2 * fbm(p * 0.5);
+    vec3 q = p - vec3(sin(u_time) * 1.5, 0.2, 0.0);
+    float blob = smoothUnion(sphere(q, 0.8), roundBox(p - vec3(0.0, -0.3, 0.0), vec3(0.6), 0.1), 0.4);
+    return ground < blob ? vec2(ground, 1.0) : vec2(blob, 2.0);
+}
+
+vec3 normalAt(vec3 p)
+{
+    vec2 e = vec2(kEpsilon, 0.0);
+    return normalize(vec3(scene(p + e.xyy).x - scene(p - e.xyy).x,
+                          scene(p + e.yxy).x - scene(p - e.yxy).x,
+                          scene(p + e.yyx).x - scene(p - e.yyx).x));
+}
+
+vec2 march(vec3 origin, vec3 direction)
+{
+    float distance = 0.0;
+    for (int i = 0; i < kMaxSteps; ++i)
+    {
+        vec2 hit = scene(origin + direction * distance);
+        if (hit.x < kEpsilon)
+            return vec2(distance, hit.y);
+        distance += hit.x;
+        if (distance > kMaxDistance)
+            break;
+    }
+    return vec2(-1.0, 0.0);
+}
+
+float softShadow(vec3 origin, vec3 direction)
+{
+    float result = 1.0;
+    float distance = 0.02;
+    for (int i = 0; i < 24; ++i)
+    {
+        float h = scene(origin + direction * distance).x;
+        result = min(result, 8.0 * h / distance);
+        distance += clamp(h, 0.02, 0.2);
+        if (h < kEpsilon || distance > 10.0)
+            break;
+    }
+    return clamp(result, 0.0, 1.0);
+}
+
+void main()
+{
+    vec2 uv = (gl_FragCoord.xy * 2.0 - u_resolution) / u_resolution.y;
+    vec3 forward = normalize(-u_cameraPosition);
+    vec3 right = normalize(cross(forward, vec3(0.0, 1.0, 0.0)));
+    vec3 up = cross(right, forward);
+    vec3 direction = normalize(uv.x * right + uv.y * up + 1.5 * forward);
+
+    vec3 sky = mix(vec3(0.7, 0.8, 1.0), vec3(0.3, 0.5, 0.9), uv.y * 0.5 + 0.5);
+    vec3 color = sky;
+    vec2 hit = march(u_cameraPosition, direction);
+    if (hit.x > 0.0)
+    {
+        vec3 position = u_cameraPosition + direction * hit.x;
+        vec3 normal = normalAt(position);
+        vec3 light = normalize(vec3(0.6, 0.8, -0.4));
+        vec3 albedo = hit.y < 1.5 ? vec3(0.4, 0.35, 0.3) * (0.6 + 0.4 * fbm(position * 3.0)) :
+                                    vec3(0.9, 0.3, 0.2);
+        float diffuse = max(dot(normal, light), 0.0) * softShadow(position + normal * 0.01, light);
+        float fresnel = pow(1.0 - max(dot(normal, -direction), 0.0), 5.0);
+        color = albedo * (0.15 + diffuse) + sky * fresnel * 0.3;
+        color = mix(color, sky, 1.0 - exp(-0.002 * hit.x * hit.x));
+    }
+    gl_FragColor = vec4(pow(color, vec3(0.4545)), 1.0);
+}
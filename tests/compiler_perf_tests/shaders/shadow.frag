@@ -0,0 +1,47 @@
+// Shadow-mapped directional light with 3x3 percentage-closer filtering
+// over an RGBA-packed depth texture.
+precision highp float;
+
+uniform sampler2D s_shadowMap;
+uniform sampler2D s_albedo;
+uniform vec2 u_shadowMapSize;
+uniform float u_bias;
+uniform vec3 u_lightColor;
+uniform vec3 u_lightDirection;
+
+varying vec4 v_shadowCoord;
+varying vec3 v_normal;
+varying vec2 v_texCoord;
+
+float unpackDepth(vec4 rgba)
+{
+    const vec4 kShifts = vec4(1.0 / (256.0 * 256.0 * 256.0), 1.0 / (256.0 * 256.0), 1.0 / 256.0, 1.0);
+    return dot(rgba, kShifts);
+}
+
+float shadowFactor(vec3 coord)
+{
+    vec2 texel = 1.0 / u_shadowMapSize;
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            vec2 offset = vec2(float(x), float(y)) * texel;
+            float depth = unpackDepth(texture2D(s_shadowMap, coord.xy + offset));
+            lit += coord.z - u_bias > depth ? 0.0 : 1.0;
+        }
+    }
+    return lit / 9.0;
+}
+
+void main()
+{
+    vec3 coord = v_shadowCoord.xyz / v_shadowCoord.w;
+    float inside = step(0.0, coord.x) * step(coord.x, 1.0) * step(0.0, coord.y) * step(coord.y, 1.0);
+    float shadow = mix(1.0, shadowFactor(coord), inside);
+
+    float diffuse = max(dot(normalize(v_normal), -u_lightDirection), 0.0);
+    vec4 albedo = texture2D(s_albedo, v_texCoord);
+    gl_FragColor = vec4(albedo.rgb * u_lightColor * (0.2 + 0.8 * diffuse * shadow), albedo.a);
+}
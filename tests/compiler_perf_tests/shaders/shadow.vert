@@ -0,0 +1,26 @@
+// Projects vertices into the light's clip space for shadow lookups.
+attribute vec3 a_position;
+attribute vec3 a_normal;
+attribute vec2 a_texCoord;
+
+uniform mat4 u_modelMatrix;
+uniform mat4 u_viewProjectionMatrix;
+uniform mat4 u_lightMatrix;
+
+varying vec4 v_shadowCoord;
+varying vec3 v_normal;
+varying vec2 v_texCoord;
+
+const mat4 kBiasMatrix = mat4(0.5, 0.0, 0.0, 0.0,
+                              0.0, 0.5, 0.0, 0.0,
+                              0.0, 0.0, 0.5, 0.0,
+                              0.5, 0.5, 0.5, 1.0);
+
+void main()
+{
+    vec4 worldPosition = u_modelMatrix * vec4(a_position, 1.0);
+    v_shadowCoord = kBiasMatrix * u_lightMatrix * worldPosition;
+    v_normal = mat3(u_modelMatrix[0].xyz, u_modelMatrix[1].xyz, u_modelMatrix[2].xyz) * a_normal;
+    v_texCoord = a_texCoord;
+    gl_Position = u_viewProjectionMatrix * worldPosition;
+}
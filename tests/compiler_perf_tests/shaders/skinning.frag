@@ -0,0 +1,16 @@
+// Lit and fogged skinned mesh, with alpha testing.
+precision mediump float;
+uniform sampler2D s_texture;
+uniform vec3 u_fogColor;
+uniform float u_alphaThreshold;
+varying vec2 v_texCoord;
+varying float v_lighting;
+varying float v_fog;
+
+void main()
+{
+    vec4 color = texture2D(s_texture, v_texCoord);
+    if (color.a < u_alphaThreshold)
+        discard;
+    gl_FragColor = vec4(mix(color.rgb * v_lighting, u_fogColor, v_fog), color.a);
+}
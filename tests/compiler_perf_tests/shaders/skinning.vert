@@ -0,0 +1,38 @@
+// Matrix palette skinning with four influences per vertex and fog.
+attribute vec3 a_position;
+attribute vec3 a_normal;
+attribute vec2 a_texCoord;
+attribute vec4 a_boneIndices;
+attribute vec4 a_boneWeights;
+
+uniform mat4 u_bones[24];
+uniform mat4 u_viewProjectionMatrix;
+uniform vec3 u_lightDirection;
+uniform vec2 u_fogRange;
+uniform vec3 u_eyePosition;
+
+varying vec2 v_texCoord;
+varying float v_lighting;
+varying float v_fog;
+
+mat4 skinMatrix()
+{
+    mat4 matrix = u_bones[int(a_boneIndices.x)] * a_boneWeights.x;
+    matrix += u_bones[int(a_boneIndices.y)] * a_boneWeights.y;
+    matrix += u_bones[int(a_boneIndices.z)] * a_boneWeights.z;
+    matrix += u_bones[int(a_boneIndices.w)] * a_boneWeights.w;
+    return matrix;
+}
+
+void main()
+{
+    mat4 skin = skinMatrix();
+    vec4 position = skin * vec4(a_position, 1.0);
+    vec3 normal = normalize((skin * vec4(a_normal, 0.0)).xyz);
+
+    v_texCoord = a_texCoord;
+    v_lighting = 0.3 + 0.7 * max(dot(normal, -u_lightDirection), 0.0);
+    float distance = length(position.xyz - u_eyePosition);
+    v_fog = clamp((distance - u_fogRange.x) / (u_fogRange.y - u_fogRange.x), 0.0, 1.0);
+    gl_Position = u_viewProjectionMatrix * position;
+}
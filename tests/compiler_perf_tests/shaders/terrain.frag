@@ -0,0 +1,44 @@
+// Terrain splatting across four layers with triplanar cliffs and
+// derivative-based normals.
+#extension GL_OES_standard_derivatives : enable
+precision highp float;
+
+uniform sampler2D s_splatMap;
+uniform sampler2D s_layers[4];
+uniform vec4 u_layerScales;
+uniform sampler2D s_cliff;
+uniform vec3 u_sunDirection;
+uniform vec3 u_sunColor;
+uniform vec3 u_skyColor;
+
+varying vec3 v_worldPosition;
+varying vec2 v_texCoord;
+
+vec3 triplanar(sampler2D texture, vec3 position, vec3 normal, float scale)
+{
+    vec3 weights = abs(normal);
+    weights /= weights.x + weights.y + weights.z;
+    vec3 x = texture2D(texture, position.yz * scale).rgb;
+    vec3 y = texture2D(texture, position.xz * scale).rgb;
+    vec3 z = texture2D(texture, position.xy * scale).rgb;
+    return x * weights.x + y * weights.y + z * weights.z;
+}
+
+void main()
+{
+    vec3 normal = normalize(cross(dFdx(v_worldPosition), dFdy(v_worldPosition)));
+    vec4 splat = texture2D(s_splatMap, v_texCoord);
+    splat /= max(dot(splat, vec4(1.0)), 0.001);
+
+    vec3 albedo = texture2D(s_layers[0], v_texCoord * u_layerScales.x).rgb * splat.x;
+    albedo += texture2D(s_layers[1], v_texCoord * u_layerScales.y).rgb * splat.y;
+    albedo += texture2D(s_layers[2], v_texCoord * u_layerScales.z).rgb * splat.z;
+    albedo += texture2D(s_layers[3], v_texCoord * u_layerScales.w).rgb * splat.w;
+
+    float cliff = smoothstep(0.6, 0.8, 1.0 - normal.y);
+    albedo = mix(albedo, triplanar(s_cliff, v_worldPosition, normal, 0.1), cliff);
+
+    float sun = max(dot(normal, u_sunDirection), 0.0);
+    float sky = 0.5 + 0.5 * normal.y;
+    gl_FragColor = vec4(albedo * (u_sunColor * sun + u_skyColor * sky), 1.0);
+}
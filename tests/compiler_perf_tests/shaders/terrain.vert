@@ -0,0 +1,17 @@
+// Heightfield terrain displaced in the vertex shader.
+attribute vec2 a_gridPosition;
+uniform sampler2D s_heightMap;
+uniform mat4 u_viewProjectionMatrix;
+uniform vec2 u_terrainSize;
+uniform float u_heightScale;
+varying vec3 v_worldPosition;
+varying vec2 v_texCoord;
+
+void main()
+{
+    vec2 texCoord = a_gridPosition / u_terrainSize;
+    float height = texture2DLod(s_heightMap, texCoord, 0.0).r * u_heightScale;
+    v_worldPosition = vec3(a_gridPosition.x, height, a_gridPosition.y);
+    v_texCoord = texCoord;
+    gl_Position = u_viewProjectionMatrix * vec4(v_worldPosition, 1.0);
+}
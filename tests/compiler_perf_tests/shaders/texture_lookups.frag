@@ -0,0 +1,31 @@
+// Every texture lookup of GLSL ES 1.00 in one material: projected decals,
+// a biased detail map and a reflection cube map.
+precision mediump float;
+uniform sampler2D s_albedo;
+uniform sampler2D s_detail;
+uniform sampler2D s_decal;
+uniform samplerCube s_environment;
+uniform samplerCube s_irradiance;
+uniform float u_detailBias;
+varying vec2 v_texCoord;
+varying vec3 v_decalCoord;
+varying vec4 v_shadowCoord;
+varying vec3 v_normal;
+varying vec3 v_reflection;
+
+void main()
+{
+    vec4 albedo = texture2D(s_albedo, v_texCoord);
+    vec4 detail = texture2D(s_detail, v_texCoord * 8.0, u_detailBias);
+    vec4 decal = texture2DProj(s_decal, v_decalCoord);
+    vec4 decalBlurred = texture2DProj(s_decal, v_decalCoord, 2.0);
+    float shadow = texture2DProj(s_decal, v_shadowCoord).r;
+    float shadowBlurred = texture2DProj(s_decal, v_shadowCoord, 1.0).r;
+    vec3 environment = textureCube(s_environment, v_reflection).rgb;
+    vec3 irradiance = textureCube(s_irradiance, v_normal, 4.0).rgb;
+
+    vec3 color = albedo.rgb * (detail.rgb * 2.0);
+    color = mix(color, decal.rgb, decal.a * decalBlurred.a);
+    color = color * irradiance * mix(0.5, 1.0, shadow * shadowBlurred) + environment * 0.1;
+    gl_FragColor = vec4(color, albedo.a);
+}
@@ -0,0 +1,27 @@
+// Vertex texture fetches for a displaced, wind-animated mesh.
+attribute vec4 a_position;
+attribute vec2 a_texCoord;
+uniform mat4 u_mvpMatrix;
+uniform sampler2D s_heightMap;
+uniform sampler2D s_windMap;
+uniform samplerCube s_skyMap;
+uniform vec2 u_windOffset;
+uniform float u_lod;
+varying vec2 v_texCoord;
+varying vec4 v_skyColor;
+
+void main()
+{
+    float height = texture2DLod(s_heightMap, a_texCoord, 0.0).r;
+    vec4 wind = texture2D(s_windMap, a_texCoord + u_windOffset);
+    vec4 gust = texture2DProjLod(s_windMap, vec3(a_texCoord, 2.0), u_lod);
+    vec4 turbulence = texture2DProjLod(s_windMap, vec4(a_texCoord, 0.0, 4.0), u_lod);
+    vec4 sway = texture2DProj(s_windMap, vec4(a_position.xz, 0.0, 8.0));
+    v_skyColor = textureCubeLod(s_skyMap, vec3(0.0, 1.0, 0.0), u_lod) + textureCube(s_skyMap, a_position.xyz);
+
+    vec4 position = a_position;
+    position.y += height;
+    position.xz += (wind.xy + gust.xy + turbulence.xy + sway.xy) * position.y;
+    v_texCoord = a_texCoord;
+    gl_Position = u_mvpMatrix * position;
+}
@@ -0,0 +1,11 @@
+// Premultiplied-alpha texture sampling with a global opacity.
+precision mediump float;
+uniform sampler2D s_texture;
+uniform float u_opacity;
+varying vec2 v_texCoord;
+
+void main()
+{
+    vec4 color = texture2D(s_texture, v_texCoord);
+    gl_FragColor = color * u_opacity;
+}
@@ -0,0 +1,12 @@
+// A textured, transformed quad, as drawn by most 2D WebGL content.
+attribute vec4 a_position;
+attribute vec2 a_texCoord;
+uniform mat4 u_mvpMatrix;
+uniform vec4 u_texTransform;
+varying vec2 v_texCoord;
+
+void main()
+{
+    v_texCoord = a_texCoord * u_texTransform.zw + u_texTransform.xy;
+    gl_Position = u_mvpMatrix * a_position;
+}
@@ -24,3 +24,32 @@ TEST(APITest, CompareShBuiltInResources)
     EXPECT_TRUE(memcmp(&a_resources, &b_resources, sizeof(a_resources)) == 0);
 }
 
+
+TEST(APITest, TakeObjectCode)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                            SH_ESSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "void main() { gl_FragColor = vec4(0.5, -2, 1e20, 0.125); }\n"
+    };
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+    std::string expected = ShGetObjectCode(compiler);
+    EXPECT_NE(std::string::npos,
+              expected.find("vec4(0.5, -2.0, 100000002004087734272.0, 0.125)")) << expected;
+
+    std::string objectCode = "previous contents";
+    ShTakeObjectCode(compiler, &objectCode);
+    EXPECT_EQ(expected, objectCode);
+    EXPECT_TRUE(ShGetObjectCode(compiler).empty());
+
+    // The next compile writes the object code again.
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+    EXPECT_EQ(expected, ShGetObjectCode(compiler));
+
+    ShDestruct(compiler);
+}
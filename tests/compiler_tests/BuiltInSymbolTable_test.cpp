@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BuiltInSymbolTable_test.cpp:
+//   Tests that compilers constructed with the same parameters share their
+//   built-in symbols.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class BuiltInSymbolTableTest : public testing::Test
+{
+  public:
+    BuiltInSymbolTableTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+    }
+
+    const TSymbol *findBuiltIn(TranslatorESSL *translator, const char *name)
+    {
+        return translator->getSymbolTable().findBuiltIn(name, 100);
+    }
+
+    void compile(TranslatorESSL *translator)
+    {
+        const std::string &shaderString =
+            "precision mediump float;\n"
+            "uniform vec4 u;\n"
+            "void main() {\n"
+            "   gl_FragColor = sin(u) + gl_FragCoord;\n"
+            "}\n";
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_TRUE(translator->compile(shaderStrings, 1, SH_OBJECT_CODE));
+    }
+
+    ShBuiltInResources mResources;
+};
+
+TEST_F(BuiltInSymbolTableTest, SameResourcesShareBuiltIns)
+{
+    TranslatorESSL first(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(first.Init(mResources));
+    TranslatorESSL second(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(second.Init(mResources));
+
+    const TSymbol *fragCoord = findBuiltIn(&first, "gl_FragCoord");
+    ASSERT_TRUE(fragCoord != NULL);
+    EXPECT_EQ(fragCoord, findBuiltIn(&second, "gl_FragCoord"));
+
+    // Compiling with one must leave the built-ins intact for the other.
+    compile(&first);
+    compile(&second);
+    EXPECT_EQ(fragCoord, findBuiltIn(&first, "gl_FragCoord"));
+    EXPECT_EQ(fragCoord, findBuiltIn(&second, "gl_FragCoord"));
+}
+
+TEST_F(BuiltInSymbolTableTest, BuiltInsOutliveTheirCreator)
+{
+    TranslatorESSL *first = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(first->Init(mResources));
+    TranslatorESSL second(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(second.Init(mResources));
+    delete first;
+
+    compile(&second);
+    EXPECT_TRUE(findBuiltIn(&second, "gl_FragCoord") != NULL);
+}
+
+TEST_F(BuiltInSymbolTableTest, DifferentParametersDoNotShare)
+{
+    TranslatorESSL fragment(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(fragment.Init(mResources));
+
+    TranslatorESSL otherType(GL_VERTEX_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(otherType.Init(mResources));
+    EXPECT_NE(findBuiltIn(&fragment, "gl_MaxDrawBuffers"),
+              findBuiltIn(&otherType, "gl_MaxDrawBuffers"));
+
+    ShBuiltInResources otherResources = mResources;
+    otherResources.MaxDrawBuffers = 8;
+    TranslatorESSL otherDrawBuffers(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(otherDrawBuffers.Init(otherResources));
+    EXPECT_NE(findBuiltIn(&fragment, "gl_MaxDrawBuffers"),
+              findBuiltIn(&otherDrawBuffers, "gl_MaxDrawBuffers"));
+}
+
+TEST_F(BuiltInSymbolTableTest, LimitsCheckedAtCompileTimeDoNotPreventSharing)
+{
+    TranslatorESSL first(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(first.Init(mResources));
+
+    ShBuiltInResources otherResources = mResources;
+    otherResources.MaxExpressionComplexity = 17;
+    otherResources.MaxCallStackDepth = 3;
+    otherResources.MaxUnrolledLoopSize = 100;
+    otherResources.EXT_draw_buffers = 1;
+    otherResources.NV_draw_buffers = 1;
+    TranslatorESSL second(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(second.Init(otherResources));
+
+    EXPECT_EQ(findBuiltIn(&first, "gl_FragCoord"), findBuiltIn(&second, "gl_FragCoord"));
+}
+
+TEST_F(BuiltInSymbolTableTest, LastCompilerFreesBuiltIns)
+{
+    size_t tableCount = TBuiltInSymbolTable::GetCachedTableCount();
+
+    mResources.MaxVertexAttribs = 12345;
+    TranslatorESSL *first = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(first->Init(mResources));
+    TranslatorESSL *second = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+    ASSERT_TRUE(second->Init(mResources));
+    EXPECT_EQ(tableCount + 1, TBuiltInSymbolTable::GetCachedTableCount());
+
+    delete first;
+    EXPECT_EQ(tableCount + 1, TBuiltInSymbolTable::GetCachedTableCount());
+    delete second;
+    EXPECT_EQ(tableCount, TBuiltInSymbolTable::GetCachedTableCount());
+}
@@ -0,0 +1,221 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CallDAG_test.cpp:
+//   Tests the call DAG that the compiler builds for the passes that follow
+//   validation: its order, depths, node ranges and recursion.
+//
+
+#include <string>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/CallDAG.h"
+#include "compiler/translator/Compiler.h"
+
+namespace
+{
+
+// Keeps what it learns of the call DAG of the shader it compiles, as
+// function name and callee names, since the tree is gone after the compile.
+class CallDAGCompiler : public TCompiler
+{
+  public:
+    CallDAGCompiler()
+        : TCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT)
+    {
+    }
+
+    std::vector<std::string> mNames;
+    std::vector<std::string> mCallees;
+    std::vector<int> mDepths;
+    bool mRecursion;
+
+  protected:
+    virtual void translate(TIntermNode *root, int compileOptions)
+    {
+        const CallDAG &dag = getCallDAG();
+
+        // The walk of its own builds the same DAG as the shared one.
+        CallDAG ownDag;
+        mRecursion = (ownDag.init(root) == CallDAG::INITDAG_RECURSION);
+        ASSERT_EQ(dag.size(), ownDag.size());
+
+        mNames.clear();
+        mCallees.clear();
+        mDepths.clear();
+        for (size_t i = 0; i < dag.size(); ++i)
+        {
+            const CallDAG::Record &record = dag.getRecord(i);
+            const CallDAG::Record &ownRecord = ownDag.getRecord(i);
+            EXPECT_EQ(*record.name, *ownRecord.name);
+            EXPECT_EQ(record.callees, ownRecord.callees);
+            EXPECT_EQ(record.nodeBegin, ownRecord.nodeBegin);
+            EXPECT_EQ(record.depth, ownRecord.depth);
+            EXPECT_EQ(i, dag.findIndex(*record.name));
+
+            std::string callees;
+            for (size_t j = 0; j < record.callees.size(); ++j)
+            {
+                size_t callee = record.callees[j];
+                // Topological order, up to the recursions.
+                if (record.depth != CallDAG::kInfiniteCallDepth)
+                {
+                    EXPECT_LT(callee, i);
+                }
+                callees += dag.getRecord(callee).name->c_str();
+                callees += " ";
+            }
+
+            if (record.node)
+            {
+                TNodeCounter counter;
+                record.node->traverse(&counter);
+                EXPECT_EQ(counter.getNodeCount(), record.nodeEnd - record.nodeBegin);
+            }
+
+            mNames.push_back(record.name->c_str());
+            mCallees.push_back(callees);
+            mDepths.push_back(record.depth);
+        }
+    }
+};
+
+class CallDAGTest : public testing::Test
+{
+  public:
+    CallDAGTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        ASSERT_TRUE(mCompiler.Init(resources));
+    }
+
+    bool compile(const char *source)
+    {
+        const char *shaderStrings[] = { source };
+        return mCompiler.compile(shaderStrings, 1, SH_OBJECT_CODE);
+    }
+
+    size_t indexOf(const std::string &name) const
+    {
+        for (size_t i = 0; i < mCompiler.mNames.size(); ++i)
+        {
+            if (mCompiler.mNames[i] == name)
+                return i;
+        }
+        return CallDAG::InvalidIndex;
+    }
+
+    CallDAGCompiler mCompiler;
+};
+
+}  // namespace
+
+TEST_F(CallDAGTest, OrdersCalleesFirstWithTheLongestChains)
+{
+    // main calls a and b, which both call c; a also calls d, which calls c.
+    const char *shader =
+        "precision mediump float;\n"
+        "float c(float x) { return x * 2.0; }\n"
+        "float d(float x);\n"
+        "float a(float x) { return d(x) + c(x) + d(x); }\n"
+        "float b(float x) { return c(x); }\n"
+        "float d(float x) { return c(x) + 1.0; }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(a(1.0), b(2.0), 0.0, 1.0);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shader)) << mCompiler.getInfoSink().info.c_str();
+    EXPECT_FALSE(mCompiler.mRecursion);
+
+    ASSERT_EQ(5u, mCompiler.mNames.size());
+    size_t main = indexOf("main(");
+    size_t a = indexOf("a(f1;");
+    size_t b = indexOf("b(f1;");
+    size_t c = indexOf("c(f1;");
+    size_t d = indexOf("d(f1;");
+    ASSERT_NE(CallDAG::InvalidIndex, main);
+    ASSERT_NE(CallDAG::InvalidIndex, a);
+    ASSERT_NE(CallDAG::InvalidIndex, b);
+    ASSERT_NE(CallDAG::InvalidIndex, c);
+    ASSERT_NE(CallDAG::InvalidIndex, d);
+
+    // Callees are listed once, in the order of their first call.
+    EXPECT_EQ("d(f1; c(f1; ", mCompiler.mCallees[a]);
+    EXPECT_EQ("a(f1; b(f1; ", mCompiler.mCallees[main]);
+
+    EXPECT_EQ(4, mCompiler.mDepths[main]);
+    EXPECT_EQ(3, mCompiler.mDepths[a]);
+    EXPECT_EQ(2, mCompiler.mDepths[b]);
+    EXPECT_EQ(1, mCompiler.mDepths[c]);
+    EXPECT_EQ(2, mCompiler.mDepths[d]);
+}
+
+TEST_F(CallDAGTest, PutsRecursionsLast)
+{
+    // The recursion is never called by main(), so the shader compiles
+    // without a call stack limit.
+    const char *shader =
+        "precision mediump float;\n"
+        "float leaf(float x) { return x; }\n"
+        "float odd(float x);\n"
+        "float even(float x) { return x > 0.0 ? odd(x - 1.0) : leaf(x); }\n"
+        "float odd(float x) { return x > 0.0 ? even(x - 1.0) : 1.0; }\n"
+        "float unused(float x) { return even(x); }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(leaf(1.0));\n"
+        "}\n";
+    ASSERT_TRUE(compile(shader)) << mCompiler.getInfoSink().info.c_str();
+    EXPECT_TRUE(mCompiler.mRecursion);
+
+    ASSERT_EQ(5u, mCompiler.mNames.size());
+    EXPECT_EQ("leaf(f1;", mCompiler.mNames[0]);
+    EXPECT_EQ("main(", mCompiler.mNames[1]);
+    EXPECT_EQ(1, mCompiler.mDepths[0]);
+    EXPECT_EQ(2, mCompiler.mDepths[1]);
+    for (size_t i = 2; i < mCompiler.mNames.size(); ++i)
+        EXPECT_EQ(CallDAG::kInfiniteCallDepth, mCompiler.mDepths[i]) << mCompiler.mNames[i];
+}
+
+TEST_F(CallDAGTest, CoversTheOnlyDefinition)
+{
+    // main() is the root of the tree when it is the only global.
+    ASSERT_TRUE(compile("void main() { gl_FragColor = vec4(1.0); }\n"))
+        << mCompiler.getInfoSink().info.c_str();
+    ASSERT_EQ(1u, mCompiler.mNames.size());
+    EXPECT_EQ(1, mCompiler.mDepths[0]);
+}
+
+TEST_F(CallDAGTest, ExplainsTooDeepChains)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    resources.MaxCallStackDepth = 3;
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                            SH_ESSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "float c(float x) { return x; }\n"
+        "float b(float x) { return c(x); }\n"
+        "float a(float x) { return x + b(x); }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(a(1.0));\n"
+        "}\n"
+    };
+    EXPECT_FALSE(ShCompile(compiler, shaderStrings, 1,
+                           SH_OBJECT_CODE | SH_LIMIT_CALL_STACK_DEPTH));
+    std::string infoLog = ShGetInfoLog(compiler);
+    EXPECT_NE(std::string::npos, infoLog.find("<-c(f1;<-b(f1;"));
+    EXPECT_NE(std::string::npos, infoLog.find("Function call stack too deep"));
+
+    ShDestruct(compiler);
+}
@@ -7,10 +7,13 @@
 //   Some tests for shader inspection
 //
 
+#include <sstream>
+
 #include "angle_gl.h"
 #include "gtest/gtest.h"
 #include "GLSLANG/ShaderLang.h"
 #include "compiler/translator/TranslatorGLSL.h"
+#include "compiler/translator/VariableInfo.h"
 
 #define EXPECT_GLENUM_EQ(expected, actual) \
     EXPECT_EQ(static_cast<GLenum>(expected), static_cast<GLenum>(actual))
@@ -368,3 +371,67 @@ TEST_F(CollectVertexVariablesTest, VaryingInterpolation)
     EXPECT_EQ("vary", varying->name);
     EXPECT_EQ(sh::INTERPOLATION_CENTROID, varying->interpolation);
 }
+
+TEST_F(CollectVertexVariablesTest, StaticUseOfManyUniforms)
+{
+    const int kUniformCount = 300;
+    std::stringstream shaderStream;
+    shaderStream << "precision mediump float;\n";
+    for (int i = 0; i < kUniformCount; ++i)
+        shaderStream << "uniform float u" << i << ";\n";
+    shaderStream << "void main() {\n"
+                    "   float sum = 0.0;\n";
+    for (int i = 1; i < kUniformCount; i += 2)
+        shaderStream << "   sum += u" << i << ";\n";
+    shaderStream << "   gl_Position = vec4(sum);\n"
+                    "}\n";
+
+    const std::string &shaderString = shaderStream.str();
+    const char *shaderStrings[] = { shaderString.c_str() };
+    ASSERT_TRUE(mTranslator->compile(shaderStrings, 1, SH_VARIABLES));
+
+    const std::vector<sh::Uniform> &uniforms = mTranslator->getUniforms();
+    ASSERT_EQ(static_cast<size_t>(kUniformCount), uniforms.size());
+
+    for (int i = 0; i < kUniformCount; ++i)
+    {
+        std::stringstream name;
+        name << "u" << i;
+        EXPECT_EQ(name.str(), uniforms[i].name);
+        EXPECT_EQ(i % 2 == 1, uniforms[i].staticUse);
+    }
+}
+
+TEST_F(CollectVertexVariablesTest, ExpandStructArrayUniforms)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "struct Inner { float f; vec2 v[2]; };\n"
+        "struct Outer { Inner inner[2]; vec4 c; };\n"
+        "uniform Outer o[2];\n"
+        "void main() {\n"
+        "   gl_Position = o[1].c;\n"
+        "}\n";
+
+    const char *shaderStrings[] = { shaderString.c_str() };
+    ASSERT_TRUE(mTranslator->compile(shaderStrings, 1, SH_VARIABLES));
+
+    std::vector<sh::ShaderVariable> expanded;
+    sh::ExpandUniforms(mTranslator->getUniforms(), &expanded);
+
+    const char *kNames[] = {
+        "o[0].inner[0].f", "o[0].inner[0].v[0]", "o[0].inner[1].f", "o[0].inner[1].v[0]",
+        "o[0].c",
+        "o[1].inner[0].f", "o[1].inner[0].v[0]", "o[1].inner[1].f", "o[1].inner[1].v[0]",
+        "o[1].c",
+    };
+    ASSERT_EQ(ArraySize(kNames), expanded.size());
+    for (size_t i = 0; i < expanded.size(); ++i)
+    {
+        EXPECT_EQ(kNames[i], expanded[i].name);
+        EXPECT_EQ(kNames[i], expanded[i].mappedName);
+        EXPECT_TRUE(expanded[i].staticUse);
+    }
+    EXPECT_GLENUM_EQ(GL_FLOAT_VEC2, expanded[1].type);
+    EXPECT_EQ(2u, expanded[1].arraySize);
+}
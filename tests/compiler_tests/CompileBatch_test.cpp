@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompileBatch_test.cpp:
+//   Tests for compiling shaders and checking programs with ShCompileBatch.
+//
+
+#include <string>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const char *kVertexShader =
+    "attribute vec4 a_position;\n"
+    "uniform mat4 u_mvp;\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    v_uv = a_position.xy;\n"
+    "    v_color = a_position;\n"
+    "    gl_Position = u_mvp * a_position;\n"
+    "}\n";
+
+const char *kFragmentShader =
+    "precision mediump float;\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    gl_FragColor = v_color * v_uv.x;\n"
+    "}\n";
+
+const char *kOtherFragmentShader =
+    "precision mediump float;\n"
+    "uniform vec4 u_tint;\n"
+    "varying vec2 v_uv;\n"
+    "void main() {\n"
+    "    gl_FragColor = u_tint * v_uv.y;\n"
+    "}\n";
+
+const int kCompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+}  // namespace
+
+class CompileBatchTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+    }
+
+    virtual void TearDown()
+    {
+        for (size_t i = 0; i < mHandles.size(); ++i)
+            ShDestruct(mHandles[i]);
+    }
+
+    ShHandle construct(sh::GLenum type, ShShaderOutput output)
+    {
+        ShHandle handle = ShConstructCompiler(type, SH_GLES2_SPEC, output, &mResources);
+        EXPECT_TRUE(handle != NULL);
+        mHandles.push_back(handle);
+        return handle;
+    }
+
+    void addJob(ShHandle handle, const char *const *source)
+    {
+        ShCompileJob job;
+        job.handle = handle;
+        job.shaderStrings = source;
+        job.numStrings = 1;
+        job.compileOptions = kCompileOptions;
+        job.success = false;
+        mJobs.push_back(job);
+    }
+
+    ShProgramJob makeProgram(size_t vertexJob, size_t fragmentJob, int maxVaryingVectors)
+    {
+        ShProgramJob program;
+        program.vertexJob = vertexJob;
+        program.fragmentJob = fragmentJob;
+        program.maxVaryingVectors = maxVaryingVectors;
+        program.success = false;
+        return program;
+    }
+
+    ShBuiltInResources mResources;
+    std::vector<ShHandle> mHandles;
+    std::vector<ShCompileJob> mJobs;
+};
+
+TEST_F(CompileBatchTest, MatchesSequentialCompiles)
+{
+    const ShShaderOutput outputs[] = { SH_ESSL_OUTPUT, SH_GLSL_OUTPUT, SH_HLSL11_OUTPUT };
+    const char *const vertexSource[] = { kVertexShader };
+    const char *const fragmentSource[] = { kFragmentShader };
+    const char *const otherFragmentSource[] = { kOtherFragmentShader };
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        addJob(construct(GL_VERTEX_SHADER, outputs[i]), vertexSource);
+        addJob(construct(GL_FRAGMENT_SHADER, outputs[i]), fragmentSource);
+        // The same handle compiled again: the batch must keep the order.
+        addJob(mJobs.back().handle, otherFragmentSource);
+    }
+
+    std::vector<std::string> expected(mHandles.size());
+    for (size_t i = 0; i < mJobs.size(); ++i)
+    {
+        ASSERT_TRUE(ShCompile(mJobs[i].handle, mJobs[i].shaderStrings, 1, kCompileOptions));
+        for (size_t h = 0; h < mHandles.size(); ++h)
+        {
+            if (mHandles[h] == mJobs[i].handle)
+                expected[h] = ShGetObjectCode(mHandles[h]);
+        }
+    }
+    for (size_t h = 0; h < mHandles.size(); ++h)
+    {
+        // Clear the results, so that they must come from the batch.
+        const char *const empty[] = { "" };
+        ShCompile(mHandles[h], empty, 1, kCompileOptions);
+    }
+
+    ASSERT_TRUE(ShCompileBatch(&mJobs[0], mJobs.size(), NULL, 0, 4));
+    for (size_t i = 0; i < mJobs.size(); ++i)
+        EXPECT_TRUE(mJobs[i].success) << i;
+    for (size_t h = 0; h < mHandles.size(); ++h)
+        EXPECT_EQ(expected[h], ShGetObjectCode(mHandles[h])) << h;
+}
+
+TEST_F(CompileBatchTest, FailedCompileIsReported)
+{
+    const char *const vertexSource[] = { kVertexShader };
+    const char *const brokenSource[] = { "void main() { undeclared = 1.0; }\n" };
+    addJob(construct(GL_VERTEX_SHADER, SH_ESSL_OUTPUT), vertexSource);
+    addJob(construct(GL_FRAGMENT_SHADER, SH_ESSL_OUTPUT), brokenSource);
+
+    ShProgramJob program = makeProgram(0, 1, 8);
+    EXPECT_FALSE(ShCompileBatch(&mJobs[0], mJobs.size(), &program, 1, 2));
+    EXPECT_TRUE(mJobs[0].success);
+    EXPECT_FALSE(mJobs[1].success);
+    EXPECT_NE(std::string::npos, ShGetInfoLog(mJobs[1].handle).find("undeclared"));
+    EXPECT_FALSE(program.success);
+    EXPECT_NE(std::string::npos, program.infoLog.find("failed to compile"));
+}
+
+TEST_F(CompileBatchTest, ProgramVaryingsMustMatch)
+{
+    const char *const vertexSource[] = { kVertexShader };
+    const char *const fragmentSource[] = { kFragmentShader };
+    const char *const undeclaredSource[] = {
+        "precision mediump float;\n"
+        "varying vec2 v_uv;\n"
+        "varying float v_missing;\n"
+        "varying float v_unused;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(v_uv, v_missing, 1.0);\n"
+        "}\n"
+    };
+    const char *const mismatchedSource[] = {
+        "precision mediump float;\n"
+        "varying vec3 v_uv;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(v_uv, 1.0);\n"
+        "}\n"
+    };
+    addJob(construct(GL_VERTEX_SHADER, SH_ESSL_OUTPUT), vertexSource);
+    addJob(construct(GL_FRAGMENT_SHADER, SH_ESSL_OUTPUT), fragmentSource);
+    addJob(construct(GL_FRAGMENT_SHADER, SH_ESSL_OUTPUT), undeclaredSource);
+    addJob(construct(GL_FRAGMENT_SHADER, SH_ESSL_OUTPUT), mismatchedSource);
+
+    std::vector<ShProgramJob> programs;
+    programs.push_back(makeProgram(0, 1, 8));
+    programs.push_back(makeProgram(0, 2, 8));
+    programs.push_back(makeProgram(0, 3, 8));
+    programs.push_back(makeProgram(1, 0, 8));
+    EXPECT_FALSE(ShCompileBatch(&mJobs[0], mJobs.size(), &programs[0], programs.size(), 4));
+
+    EXPECT_TRUE(programs[0].success) << programs[0].infoLog;
+    EXPECT_TRUE(programs[0].infoLog.empty());
+
+    // Only the statically used varyings must be declared by the vertex shader.
+    EXPECT_FALSE(programs[1].success);
+    EXPECT_NE(std::string::npos, programs[1].infoLog.find("'v_missing'"));
+    EXPECT_EQ(std::string::npos, programs[1].infoLog.find("'v_unused'"));
+
+    EXPECT_FALSE(programs[2].success);
+    EXPECT_NE(std::string::npos, programs[2].infoLog.find("'v_uv' does not match"));
+
+    EXPECT_FALSE(programs[3].success);
+    EXPECT_NE(std::string::npos, programs[3].infoLog.find("vertex and a fragment shader"));
+}
+
+TEST_F(CompileBatchTest, ProgramVaryingsMustPack)
+{
+    const char *const vertexSource[] = {
+        "attribute vec4 a_position;\n"
+        "varying vec4 v_a[3];\n"
+        "varying float v_b;\n"
+        "void main() {\n"
+        "    v_a[0] = v_a[1] = v_a[2] = a_position;\n"
+        "    v_b = a_position.x;\n"
+        "    gl_Position = a_position;\n"
+        "}\n"
+    };
+    const char *const fragmentSource[] = {
+        "precision mediump float;\n"
+        "varying vec4 v_a[3];\n"
+        "varying float v_b;\n"
+        "void main() {\n"
+        "    gl_FragColor = v_a[0] + v_a[1] + v_a[2] * v_b;\n"
+        "}\n"
+    };
+    addJob(construct(GL_VERTEX_SHADER, SH_ESSL_OUTPUT), vertexSource);
+    addJob(construct(GL_FRAGMENT_SHADER, SH_ESSL_OUTPUT), fragmentSource);
+
+    std::vector<ShProgramJob> programs;
+    programs.push_back(makeProgram(0, 1, 4));
+    programs.push_back(makeProgram(0, 1, 3));
+    programs.push_back(makeProgram(0, 1, 0));
+    EXPECT_FALSE(ShCompileBatch(&mJobs[0], mJobs.size(), &programs[0], programs.size(), 1));
+
+    EXPECT_TRUE(programs[0].success) << programs[0].infoLog;
+    EXPECT_FALSE(programs[1].success);
+    EXPECT_NE(std::string::npos, programs[1].infoLog.find("do not pack"));
+    // No packing check.
+    EXPECT_TRUE(programs[2].success) << programs[2].infoLog;
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompileStatistics_test.cpp:
+//   Tests for the per-phase statistics of ShGetCompileStatistics.
+//
+
+#include <string>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const char *kShader =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "struct S { float weight; };\n"
+    "float scale(S s, float x) {\n"
+    "    return s.weight * x;\n"
+    "}\n"
+    "void main() {\n"
+    "    S s = S(0.5);\n"
+    "    gl_FragColor = u_color * scale(s, 2.0);\n"
+    "}\n";
+
+}  // namespace
+
+class CompileStatisticsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                        SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const char *source, int compileOptions)
+    {
+        const char *const shaderStrings[] = { source };
+        return ShCompile(mCompiler, shaderStrings, 1, SH_OBJECT_CODE | compileOptions);
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(CompileStatisticsTest, OnlyGivenWithTheOption)
+{
+    ShCompileStatistics statistics;
+    EXPECT_FALSE(ShGetCompileStatistics(mCompiler, &statistics));
+
+    ASSERT_TRUE(compile(kShader, SH_COMPILE_STATISTICS));
+    EXPECT_TRUE(ShGetCompileStatistics(mCompiler, &statistics));
+
+    ASSERT_TRUE(compile(kShader, 0));
+    EXPECT_FALSE(ShGetCompileStatistics(mCompiler, &statistics));
+}
+
+TEST_F(CompileStatisticsTest, PhasesAreTimed)
+{
+    ASSERT_TRUE(compile(kShader, SH_COMPILE_STATISTICS | SH_VARIABLES));
+    ShCompileStatistics statistics;
+    ASSERT_TRUE(ShGetCompileStatistics(mCompiler, &statistics));
+
+    EXPECT_GT(statistics.phaseTimes[SH_COMPILE_PHASE_PREPROCESS], 0u);
+    EXPECT_GT(statistics.phaseTimes[SH_COMPILE_PHASE_PARSE], 0u);
+    EXPECT_GT(statistics.phaseTimes[SH_COMPILE_PHASE_VALIDATE], 0u);
+    EXPECT_GT(statistics.phaseTimes[SH_COMPILE_PHASE_COLLECT_VARIABLES], 0u);
+    EXPECT_GT(statistics.phaseTimes[SH_COMPILE_PHASE_OUTPUT], 0u);
+    // Not asked for.
+    EXPECT_EQ(0u, statistics.phaseTimes[SH_COMPILE_PHASE_UNROLL_LOOPS]);
+    EXPECT_EQ(0u, statistics.phaseTimes[SH_COMPILE_PHASE_PRUNE_UNUSED_DECLARATIONS]);
+
+    khronos_uint64_t phaseTotal = 0;
+    for (int phase = 0; phase < SH_COMPILE_PHASE_COUNT; ++phase)
+        phaseTotal += statistics.phaseTimes[phase];
+    EXPECT_LE(phaseTotal, statistics.totalTime);
+}
+
+TEST_F(CompileStatisticsTest, TreeAndSymbolsAreCounted)
+{
+    ASSERT_TRUE(compile(kShader, SH_COMPILE_STATISTICS));
+    ShCompileStatistics statistics;
+    ASSERT_TRUE(ShGetCompileStatistics(mCompiler, &statistics));
+
+    EXPECT_GT(statistics.symbols, 0u);
+    EXPECT_GT(statistics.treeNodes, 20u);
+    EXPECT_GT(statistics.poolAllocations, 0u);
+    EXPECT_GT(statistics.poolBytesAllocated, statistics.poolAllocations);
+
+    // The same shader gives the same counts again.
+    ASSERT_TRUE(compile(kShader, SH_COMPILE_STATISTICS));
+    ShCompileStatistics again;
+    ASSERT_TRUE(ShGetCompileStatistics(mCompiler, &again));
+    EXPECT_EQ(statistics.symbols, again.symbols);
+    EXPECT_EQ(statistics.treeNodes, again.treeNodes);
+    EXPECT_EQ(statistics.poolAllocations, again.poolAllocations);
+
+    // One more local variable, initialized from a constant.
+    std::string longer(kShader);
+    longer.insert(longer.find("    S s"), "    float unused = 1.0;\n");
+    ASSERT_TRUE(compile(longer.c_str(), SH_COMPILE_STATISTICS));
+    ShCompileStatistics longerStatistics;
+    ASSERT_TRUE(ShGetCompileStatistics(mCompiler, &longerStatistics));
+    EXPECT_EQ(statistics.symbols + 1, longerStatistics.symbols);
+    EXPECT_GT(longerStatistics.treeNodes, statistics.treeNodes);
+}
+
+TEST_F(CompileStatisticsTest, OutputIsUnchanged)
+{
+    ASSERT_TRUE(compile(kShader, 0));
+    std::string expected = ShGetObjectCode(mCompiler);
+    ASSERT_TRUE(compile(kShader, SH_COMPILE_STATISTICS));
+    EXPECT_EQ(expected, ShGetObjectCode(mCompiler));
+}
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompositeTraverser_test.cpp:
+//   Tests that traversers running together in a CompositeTraverser get the
+//   same calls as when each traverses the tree on its own.
+//
+
+#include <sstream>
+#include <string>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/CompositeTraverser.h"
+
+namespace
+{
+
+// Logs every call with its depth and parent. Declines to visit the
+// children of the nodes it is told to skip, either in the pre-visit or in
+// the in-visit.
+class RecordingTraverser : public TIntermTraverser
+{
+  public:
+    RecordingTraverser(TOperator skipOp, Visit skipVisit, bool postVisit)
+        : TIntermTraverser(true, true, postVisit, false),
+          mSkipOp(skipOp),
+          mSkipVisit(skipVisit)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node) { record("symbol", PreVisit, node); }
+    virtual void visitConstantUnion(TIntermConstantUnion *node) { record("constant", PreVisit, node); }
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        return record("binary", visit, node) && !skips(visit, node->getOp());
+    }
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        return record("unary", visit, node) && !skips(visit, node->getOp());
+    }
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        return record("selection", visit, node);
+    }
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        return record("aggregate", visit, node) && !skips(visit, node->getOp());
+    }
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        return record("loop", visit, node);
+    }
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        return record("branch", visit, node);
+    }
+
+    std::string log() const
+    {
+        std::ostringstream log;
+        log << mLog.str() << "max depth " << getMaxDepth() << "\n";
+        return log.str();
+    }
+
+  private:
+    bool record(const char *kind, Visit visit, TIntermNode *node)
+    {
+        mLog << kind << " " << visit << " " << node << " depth " << mDepth
+             << " parent " << getParentNode() << "\n";
+        return true;
+    }
+
+    bool skips(Visit visit, TOperator op) const
+    {
+        return visit == mSkipVisit && op == mSkipOp;
+    }
+
+    TOperator mSkipOp;
+    Visit mSkipVisit;
+    std::ostringstream mLog;
+};
+
+// Compares the traversers on the tree of every shader it compiles.
+class TraversingCompiler : public TCompiler
+{
+  public:
+    TraversingCompiler()
+        : TCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root, int compileOptions)
+    {
+        RecordingTraverser skipFunctions(EOpFunction, PreVisit, true);
+        RecordingTraverser skipSequenceTails(EOpSequence, InVisit, true);
+        RecordingTraverser skipAssignments(EOpAssign, InVisit, false);
+        RecordingTraverser skipAdditions(EOpAdd, PreVisit, false);
+        root->traverse(&skipFunctions);
+        root->traverse(&skipSequenceTails);
+        root->traverse(&skipAssignments);
+        root->traverse(&skipAdditions);
+
+        RecordingTraverser compositeSkipFunctions(EOpFunction, PreVisit, true);
+        RecordingTraverser compositeSkipSequenceTails(EOpSequence, InVisit, true);
+        RecordingTraverser compositeSkipAssignments(EOpAssign, InVisit, false);
+        RecordingTraverser compositeSkipAdditions(EOpAdd, PreVisit, false);
+        std::vector<TIntermTraverser *> members;
+        members.push_back(&compositeSkipFunctions);
+        members.push_back(&compositeSkipSequenceTails);
+        members.push_back(&compositeSkipAssignments);
+        members.push_back(&compositeSkipAdditions);
+        CompositeTraverser composite(members);
+        root->traverse(&composite);
+
+        EXPECT_EQ(skipFunctions.log(), compositeSkipFunctions.log());
+        EXPECT_EQ(skipSequenceTails.log(), compositeSkipSequenceTails.log());
+        EXPECT_EQ(skipAssignments.log(), compositeSkipAssignments.log());
+        EXPECT_EQ(skipAdditions.log(), compositeSkipAdditions.log());
+        EXPECT_NE(std::string::npos, skipAssignments.log().find("loop"));
+    }
+};
+
+}  // namespace
+
+TEST(CompositeTraverserTest, MembersSeeTheirOwnTraversal)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    TraversingCompiler compiler;
+    ASSERT_TRUE(compiler.Init(resources));
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "float f(float x) { return x > 0.0 ? -x : x; }\n"
+        "void main() {\n"
+        "   vec4 color = u;\n"
+        "   for (int i = 0; i < 4; ++i) {\n"
+        "       color.x = f(color.x) + float(i);\n"
+        "       if (color.y > 1.0) { color = -color; } else { color.z += 1.0; }\n"
+        "   }\n"
+        "   gl_FragColor = color;\n"
+        "}\n"
+    };
+    EXPECT_TRUE(compiler.compile(shaderStrings, 1, SH_OBJECT_CODE))
+        << compiler.getInfoSink().info.c_str();
+}
+
+// Branches without an expression have no children, so they don't go down a
+// level. They are the deepest nodes of the shader, so that a wrong depth
+// shows in the maximum depth.
+TEST(CompositeTraverserTest, BranchesWithoutExpressionKeepTheirDepth)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    TraversingCompiler compiler;
+    ASSERT_TRUE(compiler.Init(resources));
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "uniform bool b;\n"
+        "void f() { if (b) { return; } }\n"
+        "void main() {\n"
+        "   if (b) { discard; }\n"
+        "   for (int i = 0; i < 4; ++i) {\n"
+        "       if (b) { break; }\n"
+        "       if (b) { continue; }\n"
+        "   }\n"
+        "   f();\n"
+        "}\n"
+    };
+    EXPECT_TRUE(compiler.compile(shaderStrings, 1, SH_OBJECT_CODE))
+        << compiler.getInfoSink().info.c_str();
+}
+
+TEST(CompositeTraverserTest, InVisitsOnlyIfAMemberWantsThem)
+{
+    TNodeCounter counter;
+    RecordingTraverser recorder(EOpNull, PreVisit, false);
+
+    std::vector<TIntermTraverser *> members(1, &counter);
+    EXPECT_FALSE(CompositeTraverser(members).inVisit);
+    members.push_back(&recorder);
+    EXPECT_TRUE(CompositeTraverser(members).inVisit);
+}
+
+TEST(CompositeTraverserTest, DiscardIsNotTooComplex)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    resources.MaxExpressionComplexity = 5;
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                            &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "void main() {\n"
+        "   if (u > 0.0) { discard; }\n"
+        "}\n"
+    };
+    EXPECT_TRUE(ShCompile(compiler, shaderStrings, 1,
+                          SH_OBJECT_CODE | SH_LIMIT_EXPRESSION_COMPLEXITY))
+        << ShGetInfoLog(compiler);
+
+    ShDestruct(compiler);
+}
+
+TEST(CompositeTraverserTest, ValidationErrorsKeepTheirOrder)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    resources.MaxExpressionComplexity = 4;
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                            &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    // Too complex, and the loop breaks the WebGL limitations: only the
+    // first of the two is reported.
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "void main() {\n"
+        "   float x = 0.0;\n"
+        "   for (int i = 0; i < 4; ++i) { i = 2; }\n"
+        "   gl_FragColor = vec4(((((u + 1.0) * 2.0) + 3.0) * 4.0) + x);\n"
+        "}\n"
+    };
+    EXPECT_FALSE(ShCompile(compiler, shaderStrings, 1,
+                           SH_OBJECT_CODE | SH_LIMIT_EXPRESSION_COMPLEXITY));
+    std::string infoLog = ShGetInfoLog(compiler);
+    EXPECT_NE(std::string::npos, infoLog.find("Expression too complex"));
+    EXPECT_EQ(std::string::npos, infoLog.find("Loop index cannot be statically assigned"));
+
+    EXPECT_FALSE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+    infoLog = ShGetInfoLog(compiler);
+    EXPECT_EQ(std::string::npos, infoLog.find("Expression too complex"));
+    EXPECT_NE(std::string::npos, infoLog.find("Loop index cannot be statically assigned"));
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConcurrentCompile_test.cpp:
+//   Stress test compiling the same shaders on independent handles from
+//   several threads at once, checking the results against a single-threaded
+//   run.
+//
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+template <typename T, size_t N>
+size_t ArraySize(const T (&)[N])
+{
+    return N;
+}
+
+struct CorpusShader
+{
+    sh::GLenum type;
+    ShShaderSpec spec;
+    const char *source;
+};
+
+const CorpusShader kCorpus[] =
+{
+    {
+        GL_VERTEX_SHADER, SH_WEBGL_SPEC,
+        "attribute vec4 a_position;\n"
+        "attribute vec2 a_texCoord;\n"
+        "uniform mat4 u_mvp;\n"
+        "varying vec2 v_texCoord;\n"
+        "void main() {\n"
+        "    v_texCoord = a_texCoord;\n"
+        "    gl_Position = u_mvp * a_position;\n"
+        "}\n"
+    },
+    {
+        GL_FRAGMENT_SHADER, SH_WEBGL_SPEC,
+        "precision mediump float;\n"
+        "struct Light { vec3 dir; vec4 color; };\n"
+        "uniform Light u_lights[4];\n"
+        "uniform sampler2D u_tex;\n"
+        "varying vec2 v_texCoord;\n"
+        "vec4 shade(Light l, vec3 n) {\n"
+        "    return l.color * max(dot(n, l.dir), 0.0);\n"
+        "}\n"
+        "void main() {\n"
+        "    vec4 c = vec4(0.0);\n"
+        "    for (int i = 0; i < 4; ++i) {\n"
+        "        c += shade(u_lights[i], vec3(0.0, 0.0, 1.0));\n"
+        "    }\n"
+        "    gl_FragColor = c * texture2D(u_tex, v_texCoord);\n"
+        "}\n"
+    },
+    {
+        GL_FRAGMENT_SHADER, SH_WEBGL_SPEC,
+        "precision mediump float;\n"
+        "uniform vec4 u_color;\n"
+        "uniform float u_scale;\n"
+        "float f(float x) { return x > 0.5 ? x * u_scale : mod(x, 0.25); }\n"
+        "void main() {\n"
+        "    struct S { float a; vec2 b; } s;\n"
+        "    s.a = f(u_color.x);\n"
+        "    s.b = u_color.yz;\n"
+        "    bool b = s.a > 0.0 && s.b.x < 1.0 || u_color.w == 0.5;\n"
+        "    gl_FragColor = b ? u_color : vec4(s.a, s.b, 1.0);\n"
+        "}\n"
+    },
+    {
+        GL_FRAGMENT_SHADER, SH_GLES3_SPEC,
+        "#version 300 es\n"
+        "precision highp float;\n"
+        "uniform Block { vec4 u_color; mat3 u_rot; };\n"
+        "uniform sampler2D u_tex;\n"
+        "in vec2 v_uv;\n"
+        "out vec4 o_color;\n"
+        "void main() {\n"
+        "    vec4 t = texture(u_tex, v_uv);\n"
+        "    o_color = vec4(u_rot * u_color.xyz, t.x);\n"
+        "}\n"
+    },
+};
+
+const ShShaderOutput kOutputs[] =
+{
+    SH_ESSL_OUTPUT,
+    SH_GLSL_OUTPUT,
+    SH_HLSL11_OUTPUT,
+};
+
+const int kCompileOptions = SH_OBJECT_CODE | SH_VARIABLES | SH_CLAMP_INDIRECT_ARRAY_BOUNDS |
+                            SH_LIMIT_EXPRESSION_COMPLEXITY | SH_LIMIT_CALL_STACK_DEPTH;
+
+const size_t kNumJobs = ArraySize(kCorpus) * ArraySize(kOutputs);
+const int kIterationsPerThread = 8;
+
+struct CompileResult
+{
+    bool success;
+    std::string objectCode;
+    std::string infoLog;
+    size_t numUniforms;
+};
+
+CompileResult CompileJob(size_t job, const ShBuiltInResources &resources)
+{
+    const CorpusShader &shader = kCorpus[job % ArraySize(kCorpus)];
+    ShShaderOutput output = kOutputs[job / ArraySize(kCorpus)];
+
+    CompileResult result;
+    ShHandle compiler = ShConstructCompiler(shader.type, shader.spec, output, &resources);
+    if (!compiler)
+    {
+        result.success = false;
+        result.numUniforms = 0;
+        return result;
+    }
+
+    const char *shaderStrings[] = { shader.source };
+    result.success = ShCompile(compiler, shaderStrings, 1, kCompileOptions);
+    result.objectCode = ShGetObjectCode(compiler);
+    result.infoLog = ShGetInfoLog(compiler);
+    result.numUniforms = ShGetUniforms(compiler)->size();
+    ShDestruct(compiler);
+    return result;
+}
+
+bool operator==(const CompileResult &a, const CompileResult &b)
+{
+    return a.success == b.success && a.objectCode == b.objectCode &&
+           a.infoLog == b.infoLog && a.numUniforms == b.numUniforms;
+}
+
+void CompileCorpus(const ShBuiltInResources *resources,
+                   const std::vector<CompileResult> *expected,
+                   int *mismatches)
+{
+    for (int iteration = 0; iteration < kIterationsPerThread; ++iteration)
+    {
+        for (size_t job = 0; job < kNumJobs; ++job)
+        {
+            if (!(CompileJob(job, *resources) == (*expected)[job]))
+            {
+                ++(*mismatches);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+class ConcurrentCompileTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers = 4;
+        mResources.FragmentPrecisionHigh = 1;
+    }
+
+    ShBuiltInResources mResources;
+};
+
+TEST_F(ConcurrentCompileTest, MatchesSingleThreadedOutput)
+{
+    std::vector<CompileResult> expected;
+    for (size_t job = 0; job < kNumJobs; ++job)
+    {
+        expected.push_back(CompileJob(job, mResources));
+        EXPECT_TRUE(expected.back().success) << expected.back().infoLog;
+    }
+
+    // Recompiling on a single thread must be deterministic too.
+    for (size_t job = 0; job < kNumJobs; ++job)
+    {
+        EXPECT_TRUE(CompileJob(job, mResources) == expected[job]);
+    }
+
+    unsigned int numThreads = std::thread::hardware_concurrency();
+    if (numThreads < 4)
+    {
+        numThreads = 4;
+    }
+
+    std::vector<int> mismatches(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int ii = 0; ii < numThreads; ++ii)
+    {
+        threads.push_back(std::thread(CompileCorpus, &mResources, &expected, &mismatches[ii]));
+    }
+    for (unsigned int ii = 0; ii < numThreads; ++ii)
+    {
+        threads[ii].join();
+        EXPECT_EQ(0, mismatches[ii]) << "thread " << ii;
+    }
+}
+
+TEST_F(ConcurrentCompileTest, ReusedHandleIsDeterministic)
+{
+    // Struct names in the HLSL output depend on symbol ids, so they must not
+    // drift from one compile to the next on the same handle.
+    ShHandle compiler = ShConstructCompiler(kCorpus[1].type, kCorpus[1].spec,
+                                            SH_HLSL11_OUTPUT, &mResources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *shaderStrings[] = { kCorpus[1].source };
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE | SH_VARIABLES));
+    std::string first = ShGetObjectCode(compiler);
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE | SH_VARIABLES));
+    EXPECT_EQ(first, ShGetObjectCode(compiler));
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConstantFolding_test.cpp:
+//   Tests for folding expressions whose operands are constant into their
+//   value.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class ConstantFoldingTest : public testing::Test
+{
+  public:
+    ConstantFoldingTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    // Compiles "gl_FragColor = <expression>;" and keeps the object code.
+    void compile(const std::string &expression)
+    {
+        const std::string shaderString =
+            "precision mediump float;\n"
+            "uniform float u;\n"
+            "void main() {\n"
+            "   gl_FragColor = " + expression + ";\n"
+            "}\n";
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(shaderStrings, 1, SH_OBJECT_CODE);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mObjectCode = infoSink.obj.c_str();
+        if (!compilationSuccess)
+            FAIL() << "Shader compilation failed " << infoSink.info.c_str();
+    }
+
+    bool foundInCode(const char *stringToFind)
+    {
+        return mObjectCode.find(stringToFind) != std::string::npos;
+    }
+
+    void expectFolded(const std::string &expression, const char *value)
+    {
+        compile(expression);
+        EXPECT_TRUE(foundInCode((std::string("(gl_FragColor = ") + value + ");").c_str()))
+            << expression << " was compiled to:\n" << mObjectCode;
+    }
+
+    void expectNotFolded(const std::string &expression, const char *call)
+    {
+        compile(expression);
+        EXPECT_TRUE(foundInCode(call))
+            << expression << " was compiled to:\n" << mObjectCode;
+    }
+
+  private:
+    TranslatorESSL *mTranslator;
+    std::string mObjectCode;
+};
+
+TEST_F(ConstantFoldingTest, SingleArgumentBuiltIns)
+{
+    expectFolded("vec4(sin(0.0))", "vec4(0.0, 0.0, 0.0, 0.0)");
+    expectFolded("vec4(sqrt(vec2(4.0, 9.0)), abs(-2.0), sign(-3.0))",
+                 "vec4(2.0, 3.0, 2.0, -1.0)");
+    expectFolded("vec4(length(vec2(3.0, 4.0)))", "vec4(5.0, 5.0, 5.0, 5.0)");
+    expectFolded("vec4(normalize(vec3(2.0, 0.0, 0.0)), 1.0)", "vec4(1.0, 0.0, 0.0, 1.0)");
+    expectFolded("vec4(float(any(bvec2(false, true))))", "vec4(1.0, 1.0, 1.0, 1.0)");
+}
+
+TEST_F(ConstantFoldingTest, MultipleArgumentBuiltIns)
+{
+    expectFolded("vec4(pow(2.0, 3.0))", "vec4(8.0, 8.0, 8.0, 8.0)");
+    expectFolded("vec4(clamp(vec3(-1.0, 0.5, 2.0), 0.0, 1.0), max(1.0, 2.0))",
+                 "vec4(0.0, 0.5, 1.0, 2.0)");
+    expectFolded("vec4(mix(0.0, 4.0, 0.25), dot(vec2(1.0, 2.0), vec2(3.0, 4.0)), 0.0, 1.0)",
+                 "vec4(1.0, 11.0, 0.0, 1.0)");
+    expectFolded("vec4(cross(vec3(1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0)), 1.0)",
+                 "vec4(0.0, 0.0, 1.0, 1.0)");
+}
+
+TEST_F(ConstantFoldingTest, NestedCallsAndConstructors)
+{
+    expectFolded("vec4(max(sqrt(4.0), 1.0) * 2.0)", "vec4(4.0, 4.0, 4.0, 4.0)");
+    expectFolded("vec4(vec2(pow(2.0, 2.0)), vec2(1.0, 2.0) + vec2(min(1.0, 0.0)))",
+                 "vec4(4.0, 4.0, 1.0, 2.0)");
+}
+
+TEST_F(ConstantFoldingTest, SwizzlesAndIndexing)
+{
+    expectFolded("vec4(1.0, 2.0, 3.0, 4.0).wzyx", "vec4(4.0, 3.0, 2.0, 1.0)");
+    expectFolded("vec4(vec3(max(1.0, 2.0), 3.0, 4.0).zx, 0.0, 0.0)",
+                 "vec4(4.0, 2.0, 0.0, 0.0)");
+    expectFolded("vec4(mat2(pow(1.0, 1.0), 2.0, 3.0, 4.0)[1], 0.0, 0.0)",
+                 "vec4(3.0, 4.0, 0.0, 0.0)");
+    expectFolded("vec4(vec2(abs(-5.0), 6.0)[1])", "vec4(6.0, 6.0, 6.0, 6.0)");
+}
+
+TEST_F(ConstantFoldingTest, SelectionWithConstantCondition)
+{
+    expectFolded("vec4(sqrt(4.0) > 1.0 ? 1.0 : u)", "vec4(1.0, 1.0, 1.0, 1.0)");
+}
+
+TEST_F(ConstantFoldingTest, PowersOfTwoAreExact)
+{
+    expectFolded("vec4(floor(log2(8192.0)))", "vec4(13.0, 13.0, 13.0, 13.0)");
+    expectFolded("vec4(floor(log2(vec2(32768.0, 0.0001220703125))), log2(0.000030517578125), 0.0)",
+                 "vec4(15.0, -13.0, -15.0, 0.0)");
+    expectFolded("vec4(exp2(vec3(13.0, 15.0, -3.0)), 1.0)", "vec4(8192.0, 32768.0, 0.125, 1.0)");
+    expectFolded("vec4(pow(4.0, 3.0), pow(0.5, -2.0), inversesqrt(16.0), 1.0)",
+                 "vec4(64.0, 4.0, 0.25, 1.0)");
+}
+
+TEST_F(ConstantFoldingTest, InexactTranscendentalsAreNotFolded)
+{
+    expectNotFolded("vec4(sin(1.0))", "sin(");
+    expectNotFolded("vec4(log2(3.0))", "log2(");
+    expectNotFolded("vec4(exp2(0.5))", "exp2(");
+    expectNotFolded("vec4(pow(3.0, 0.5))", "pow(");
+}
+
+TEST_F(ConstantFoldingTest, UndefinedResultsAreNotFolded)
+{
+    expectNotFolded("vec4(sqrt(-1.0))", "sqrt(");
+    expectNotFolded("vec4(log(0.0))", "log(");
+    expectNotFolded("vec4(pow(-2.0, 0.5))", "pow(");
+    expectNotFolded("vec4(asin(2.0))", "asin(");
+    expectNotFolded("vec4(normalize(vec2(0.0)), 0.0, 0.0)", "normalize(");
+}
+
+TEST_F(ConstantFoldingTest, NonConstantArgumentsAreNotFolded)
+{
+    expectNotFolded("vec4(pow(u, 2.0))", "pow(u, 2.0)");
+    expectNotFolded("vec4(sin(u))", "sin(u)");
+}
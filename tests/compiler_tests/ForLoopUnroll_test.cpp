@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ForLoopUnroll_test.cpp:
+//   Tests for unrolling the for-loops with an integer index.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class ForLoopUnrollTest : public testing::Test
+{
+  public:
+    ForLoopUnrollTest() {}
+
+  protected:
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    void init(int maxUnrolledLoopSize)
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        resources.MaxUnrolledLoopSize = maxUnrolledLoopSize;
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    bool compile(const std::string &shaderString, int compileOptions)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(
+            shaderStrings, 1, SH_OBJECT_CODE | compileOptions);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mObjectCode = infoSink.obj.c_str();
+        mInfoLog = infoSink.info.c_str();
+        return compilationSuccess;
+    }
+
+    bool foundInCode(const char *stringToFind)
+    {
+        return mObjectCode.find(stringToFind) != std::string::npos;
+    }
+
+    TranslatorESSL *mTranslator;
+    std::string mObjectCode;
+    std::string mInfoLog;
+};
+
+TEST_F(ForLoopUnrollTest, IndexValuesAreFolded)
+{
+    init(1000);
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   float sum = 0.0;\n"
+        "   for (int i = 0; i < 3; ++i) {\n"
+        "      sum += float(i * 2);\n"
+        "   }\n"
+        "   gl_FragColor = vec4(sum);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)) << mInfoLog;
+
+    EXPECT_TRUE(foundInCode("(i < 1)")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("(sum += 0.0)")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("(sum += 2.0)")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("(sum += 4.0)")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("(sum += 6.0)")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("i * 2")) << mObjectCode;
+}
+
+TEST_F(ForLoopUnrollTest, NestedLoops)
+{
+    init(1000);
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   float sum = 0.0;\n"
+        "   for (int i = 0; i < 2; i++) {\n"
+        "      for (int j = 5; j > 3; j -= 1) {\n"
+        "         sum += float(i * 10 + j);\n"
+        "      }\n"
+        "   }\n"
+        "   gl_FragColor = vec4(sum);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)) << mInfoLog;
+
+    const char *kSums[] = { "(sum += 5.0)", "(sum += 4.0)", "(sum += 15.0)", "(sum += 14.0)" };
+    size_t position = 0;
+    for (size_t i = 0; i < ArraySize(kSums); ++i)
+    {
+        size_t found = mObjectCode.find(kSums[i], position);
+        ASSERT_NE(std::string::npos, found) << kSums[i] << " in\n" << mObjectCode;
+        position = found;
+    }
+}
+
+TEST_F(ForLoopUnrollTest, LoopsWithFloatIndexAreNotUnrolled)
+{
+    init(1000);
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   float sum = 0.0;\n"
+        "   for (float f = 0.0; f < 3.0; f += 1.0) {\n"
+        "      sum += f;\n"
+        "   }\n"
+        "   gl_FragColor = vec4(sum);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)) << mInfoLog;
+    EXPECT_TRUE(foundInCode("(sum += f)")) << mObjectCode;
+}
+
+TEST_F(ForLoopUnrollTest, SamplerArrayIndex)
+{
+    init(1000);
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform sampler2D samplers[2];\n"
+        "void main() {\n"
+        "   vec4 color = vec4(0.0);\n"
+        "   for (int i = 0; i < 2; ++i) {\n"
+        "      color += texture2D(samplers[i], vec2(0.0));\n"
+        "   }\n"
+        "   gl_FragColor = color;\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX)) << mInfoLog;
+    EXPECT_TRUE(foundInCode("samplers[0]")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("samplers[1]")) << mObjectCode;
+}
+
+TEST_F(ForLoopUnrollTest, MaxUnrolledSizeExceeded)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   float sum = 0.0;\n"
+        "   for (int i = 0; i < 100; ++i) {\n"
+        "      for (int j = 0; j < 100; ++j) {\n"
+        "         sum += 1.0;\n"
+        "      }\n"
+        "   }\n"
+        "   gl_FragColor = vec4(sum);\n"
+        "}\n";
+
+    // 100 copies of the outer body, each with 100 copies of the inner one.
+    init(1000);
+    EXPECT_FALSE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX));
+    EXPECT_NE(std::string::npos, mInfoLog.find("unrolled loops exceed the maximum size"))
+        << mInfoLog;
+
+    delete mTranslator;
+    init(100000);
+    EXPECT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)) << mInfoLog;
+
+    // The default is no limit.
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    EXPECT_EQ(0, resources.MaxUnrolledLoopSize);
+    delete mTranslator;
+    init(0);
+    EXPECT_TRUE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)) << mInfoLog;
+}
+
+TEST_F(ForLoopUnrollTest, EndlessLoopIsRejected)
+{
+    init(1000);
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   float sum = 0.0;\n"
+        "   for (int i = 0; i != 5; i += 2) {\n"
+        "      sum += 1.0;\n"
+        "   }\n"
+        "   gl_FragColor = vec4(sum);\n"
+        "}\n";
+    EXPECT_FALSE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX));
+    EXPECT_NE(std::string::npos, mInfoLog.find("unrolled loop never ends")) << mInfoLog;
+
+    // Without a limit on the size, the loop is still rejected.
+    delete mTranslator;
+    init(0);
+    EXPECT_FALSE(compile(shaderString, SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX));
+    EXPECT_NE(std::string::npos, mInfoLog.find("unrolled loop never ends")) << mInfoLog;
+}
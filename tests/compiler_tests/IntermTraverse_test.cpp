@@ -0,0 +1,350 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IntermTraverse_test.cpp:
+//   Tests the order of the visits of TIntermNode::traverse, both near the
+//   root and deep in the tree where it no longer recurses, and that it
+//   walks trees far deeper than the thread's stack would allow recursing.
+//   Also translates such trees to HLSL on a thread with a small stack.
+//
+
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PoolAlloc.h"
+
+namespace
+{
+
+const char *VisitName(Visit visit)
+{
+    switch (visit)
+    {
+      case PreVisit: return "pre";
+      case InVisit: return "in";
+      default: return "post";
+    }
+}
+
+// Logs the visits of the nodes, named after their type or symbol, with
+// their depth below the given base depth. Unary nodes are not logged.
+// Returns false from the visits it is told to refuse; EOpNull refuses none.
+class LoggingTraverser : public TIntermTraverser
+{
+  public:
+    LoggingTraverser(bool rightToLeft, TOperator refuseOp, Visit refuseVisit, int baseDepth)
+        : TIntermTraverser(true, true, true, rightToLeft),
+          mRefuseOp(refuseOp),
+          mRefuseVisit(refuseVisit),
+          mBaseDepth(baseDepth)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node) { mLog << node->getSymbol() << " "; }
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        return log(visit, node->getOp(), "binary");
+    }
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        return log(visit, node->getOp(), "aggregate");
+    }
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        return log(visit, EOpNull, "selection");
+    }
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        return log(visit, node->getFlowOp(), "branch");
+    }
+
+    std::string getLog() const { return mLog.str(); }
+
+  private:
+    bool log(Visit visit, TOperator op, const char *name)
+    {
+        mLog << name << ":" << VisitName(visit) << "@" << mDepth - mBaseDepth << " ";
+        return mRefuseOp == EOpNull || op != mRefuseOp || visit != mRefuseVisit;
+    }
+
+    TOperator mRefuseOp;
+    Visit mRefuseVisit;
+    int mBaseDepth;
+    std::ostringstream mLog;
+};
+
+// Counts the nodes and the visits of a traversal.
+class CountingTraverser : public TIntermTraverser
+{
+  public:
+    CountingTraverser()
+        : TIntermTraverser(true, true, true),
+          mSymbols(0),
+          mVisits(0)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *) { ++mSymbols; }
+    virtual bool visitBinary(Visit, TIntermBinary *) { ++mVisits; return true; }
+    virtual bool visitUnary(Visit, TIntermUnary *) { ++mVisits; return true; }
+
+    int mSymbols;
+    int mVisits;
+};
+
+// The default stack size of a thread on Windows.
+const size_t kSmallStackSize = 1024 * 1024;
+
+// Translates a shader to HLSL 11 object code.
+struct Translation
+{
+    std::string source;
+    bool compiled;
+    std::string objectCode;
+    std::string infoLog;
+};
+
+#if defined(_WIN32)
+DWORD WINAPI Translate(void *data)
+#else
+void *Translate(void *data)
+#endif
+{
+    Translation *translation = static_cast<Translation *>(data);
+
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_HLSL11_OUTPUT,
+                                            &resources);
+    const char *shaderStrings[] = { translation->source.c_str() };
+    translation->compiled = ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE);
+    translation->objectCode = ShGetObjectCode(compiler);
+    translation->infoLog = ShGetInfoLog(compiler);
+    ShDestruct(compiler);
+    return 0;
+}
+
+// Runs the translation on a thread with a small stack, as a browser's
+// compiler thread would have. Returns false if the thread can't be started.
+bool TranslateOnSmallStack(Translation *translation)
+{
+#if defined(_WIN32)
+    HANDLE thread = CreateThread(NULL, kSmallStackSize, Translate, translation,
+                                 STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+    if (!thread)
+        return false;
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+    return true;
+#else
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, kSmallStackSize);
+    pthread_t thread;
+    bool started = pthread_create(&thread, &attributes, Translate, translation) == 0;
+    pthread_attr_destroy(&attributes);
+    if (started)
+        pthread_join(thread, NULL);
+    return started;
+#endif
+}
+
+}  // namespace
+
+class IntermTraverseTest : public testing::Test
+{
+  public:
+    IntermTraverseTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        mPreviousAllocator = GetGlobalPoolAllocator();
+        SetGlobalPoolAllocator(&mAllocator);
+        mAllocator.push();
+    }
+
+    virtual void TearDown()
+    {
+        mAllocator.pop();
+        SetGlobalPoolAllocator(mPreviousAllocator);
+    }
+
+    TIntermSymbol *symbol(const char *name)
+    {
+        return new TIntermSymbol(0, name, TType(EbtFloat, EbpHigh, EvqTemporary));
+    }
+
+    TIntermBinary *binary(TOperator op, TIntermTyped *left, TIntermTyped *right)
+    {
+        TIntermBinary *node = new TIntermBinary(op);
+        node->setLeft(left);
+        node->setRight(right);
+        return node;
+    }
+
+    // { a = b + c; if (a) return; else return d; }
+    TIntermAggregate *createTree()
+    {
+        TIntermAggregate *sequence = new TIntermAggregate(EOpSequence);
+        sequence->getSequence()->push_back(
+            binary(EOpAssign, symbol("a"), binary(EOpAdd, symbol("b"), symbol("c"))));
+        sequence->getSequence()->push_back(
+            new TIntermSelection(symbol("a"), new TIntermBranch(EOpReturn, NULL),
+                                 new TIntermBranch(EOpReturn, symbol("d"))));
+        return sequence;
+    }
+
+    // Traverses the tree, nested below a chain of negations.
+    std::string traverse(bool rightToLeft, TOperator refuseOp, Visit refuseVisit, int nesting)
+    {
+        TIntermTyped *root = createTree();
+        for (int i = 0; i < nesting; ++i)
+        {
+            TIntermUnary *negate = new TIntermUnary(EOpNegative);
+            negate->setOperand(root);
+            root = negate;
+        }
+
+        LoggingTraverser traverser(rightToLeft, refuseOp, refuseVisit, nesting);
+        root->traverse(&traverser);
+        EXPECT_EQ(nesting + 3, traverser.getMaxDepth());
+        return traverser.getLog();
+    }
+
+    // Expects the same visits near the root and deeper than the traversal
+    // recurses.
+    void expectVisits(const std::string &expected,
+                      bool rightToLeft, TOperator refuseOp, Visit refuseVisit)
+    {
+        EXPECT_EQ(expected, traverse(rightToLeft, refuseOp, refuseVisit, 0));
+        EXPECT_EQ(expected, traverse(rightToLeft, refuseOp, refuseVisit, 1000));
+    }
+
+    TPoolAllocator mAllocator;
+    TPoolAllocator *mPreviousAllocator;
+};
+
+TEST_F(IntermTraverseTest, VisitOrder)
+{
+    expectVisits("aggregate:pre@0 "
+                 "binary:pre@1 a binary:in@2 binary:pre@2 b binary:in@3 c binary:post@2 "
+                 "binary:post@1 aggregate:in@1 "
+                 "selection:pre@1 a branch:pre@2 branch:post@2 branch:pre@2 d branch:post@2 "
+                 "selection:post@1 "
+                 "aggregate:post@0 ",
+                 false, EOpNull, PreVisit);
+
+    expectVisits("aggregate:pre@0 "
+                 "selection:pre@1 branch:pre@2 d branch:post@2 branch:pre@2 branch:post@2 a "
+                 "selection:post@1 aggregate:in@1 "
+                 "binary:pre@1 binary:pre@2 c binary:in@3 b binary:post@2 binary:in@2 a "
+                 "binary:post@1 "
+                 "aggregate:post@0 ",
+                 true, EOpNull, PreVisit);
+}
+
+TEST_F(IntermTraverseTest, RefusedVisits)
+{
+    // A refused pre-visit skips the subtree.
+    expectVisits("aggregate:pre@0 binary:pre@1 a binary:in@2 binary:pre@2 binary:post@1 "
+                 "aggregate:in@1 selection:pre@1 a branch:pre@2 branch:post@2 "
+                 "branch:pre@2 d branch:post@2 selection:post@1 aggregate:post@0 ",
+                 false, EOpAdd, PreVisit);
+
+    // A refused binary in-visit skips the right child and the post-visit.
+    expectVisits("aggregate:pre@0 binary:pre@1 a binary:in@2 aggregate:in@1 "
+                 "selection:pre@1 a branch:pre@2 branch:post@2 branch:pre@2 d branch:post@2 "
+                 "selection:post@1 aggregate:post@0 ",
+                 false, EOpAssign, InVisit);
+
+    // A refused aggregate in-visit only skips the post-visit.
+    expectVisits("aggregate:pre@0 "
+                 "binary:pre@1 a binary:in@2 binary:pre@2 b binary:in@3 c binary:post@2 "
+                 "binary:post@1 aggregate:in@1 "
+                 "selection:pre@1 a branch:pre@2 branch:post@2 branch:pre@2 d branch:post@2 "
+                 "selection:post@1 ",
+                 false, EOpSequence, InVisit);
+}
+
+TEST_F(IntermTraverseTest, DeepTreesDoNotRecurse)
+{
+    // -(x + -(x + -(x + ... x))), a chain far deeper than the stack allows
+    // recursing through.
+    const int kDepth = 100000;
+    TIntermTyped *node = symbol("x");
+    for (int i = 0; i < kDepth; ++i)
+    {
+        TIntermUnary *negate = new TIntermUnary(EOpNegative);
+        negate->setOperand(binary(EOpAdd, symbol("x"), node));
+        node = negate;
+    }
+
+    CountingTraverser counter;
+    node->traverse(&counter);
+    EXPECT_EQ(kDepth + 1, counter.mSymbols);
+    // Pre, in and post for the binary nodes, pre and post for the unary ones.
+    EXPECT_EQ(5 * kDepth, counter.mVisits);
+    EXPECT_EQ(2 * kDepth, counter.getMaxDepth());
+
+    TMaxDepthTraverser depth(kDepth);
+    node->traverse(&depth);
+    EXPECT_EQ(kDepth, depth.getMaxDepth());
+}
+
+TEST(IntermTraverseHLSLTest, DeepTreesTranslateOnSmallStack)
+{
+    const int kDepth = 100000;
+
+    // u + u + ... + u, which is as deep as it is long.
+    Translation sum;
+    std::ostringstream sumSource;
+    sumSource << "precision mediump float;\n"
+              << "uniform float u;\n"
+              << "void main() {\n"
+              << "    float sum = u";
+    for (int i = 0; i < kDepth; ++i)
+        sumSource << " + u";
+    sumSource << ";\n"
+              << "    gl_FragColor = vec4(sum);\n"
+              << "}\n";
+    sum.source = sumSource.str();
+
+    ASSERT_TRUE(TranslateOnSmallStack(&sum));
+    EXPECT_TRUE(sum.compiled) << sum.infoLog;
+    EXPECT_NE(std::string::npos, sum.objectCode.find("((_u + _u) + _u)"));
+
+    // b || v++ > 0.0 || ..., whose operators are all unfolded into if
+    // statements, since their right operands have side effects.
+    Translation unfolded;
+    std::ostringstream unfoldedSource;
+    unfoldedSource << "precision mediump float;\n"
+                   << "uniform bool b;\n"
+                   << "void main() {\n"
+                   << "    float v = 0.0;\n"
+                   << "    bool c = b";
+    for (int i = 0; i < kDepth; ++i)
+        unfoldedSource << " || v++ > 0.0";
+    unfoldedSource << ";\n"
+                   << "    gl_FragColor = vec4(c);\n"
+                   << "}\n";
+    unfolded.source = unfoldedSource.str();
+
+    ASSERT_TRUE(TranslateOnSmallStack(&unfolded));
+    EXPECT_TRUE(unfolded.compiled) << unfolded.infoLog;
+    std::ostringstream lastTemporary;
+    lastTemporary << "bool s" << kDepth - 1 << ";";
+    EXPECT_NE(std::string::npos, unfolded.objectCode.find(lastTemporary.str()));
+}
@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Keywords_test.cpp:
+//   Tests how the tokens of the preprocessor are classified into keywords,
+//   reserved words, identifiers and constants for each shader version.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class KeywordsTest : public testing::Test
+{
+  public:
+    KeywordsTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES3_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    bool compile(const std::string& shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(shaderStrings, 1, SH_INTERMEDIATE_TREE);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mInfoLog = infoSink.info.c_str();
+        return compilationSuccess;
+    }
+
+    bool foundInInfoLog(const char* stringToFind)
+    {
+        return mInfoLog.find(stringToFind) != std::string::npos;
+    }
+
+    std::string mInfoLog;
+
+  private:
+    TranslatorESSL *mTranslator;
+};
+
+TEST_F(KeywordsTest, ES3KeywordsAreIdentifiersInES2)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "float case;\n"
+        "float smooth;\n"
+        "float uint;\n"
+        "float layout;\n"
+        "float active;\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(case + smooth + uint + layout + active);\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString)) << mInfoLog;
+}
+
+TEST_F(KeywordsTest, ES3KeywordsAreKeywordsInES3)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "layout(location = 0) out vec4 color;\n"
+        "flat in int index;\n"
+        "uniform mat2x3 m;\n"
+        "void main() {\n"
+        "   uint u = 3u;\n"
+        "   color = vec4(float(u) * 1.0f) + vec4(m[0], float(index));\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString)) << mInfoLog;
+}
+
+TEST_F(KeywordsTest, ReservedWordsPerVersion)
+{
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { float switch = 1.0; }\n"));
+    EXPECT_TRUE(foundInInfoLog("ERROR: 0:2: 'switch' : Illegal use of reserved word"));
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { float packed = 1.0; }\n"));
+    EXPECT_TRUE(foundInInfoLog("'packed' : Illegal use of reserved word"));
+
+    EXPECT_FALSE(compile(
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "void main() { float varying = 1.0; }\n"));
+    EXPECT_TRUE(foundInInfoLog("ERROR: 0:3: 'varying' : Illegal use of reserved word"));
+
+    EXPECT_FALSE(compile(
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "void main() { float active = 1.0; }\n"));
+    EXPECT_TRUE(foundInInfoLog("'active' : Illegal use of reserved word"));
+
+    EXPECT_TRUE(compile(
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 color;\n"
+        "void main() { float packed = 1.0; color = vec4(packed); }\n")) << mInfoLog;
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { float goto = 1.0; }\n"));
+    EXPECT_TRUE(foundInInfoLog("'goto' : Illegal use of reserved word"));
+}
+
+TEST_F(KeywordsTest, ES3ConstantsAreErrorsInES2)
+{
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { int i = 3u; }\n"));
+    EXPECT_TRUE(foundInInfoLog("'3u' : Unsigned integers are unsupported prior to GLSL ES 3.00"));
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { float f = 3.0f; }\n"));
+    EXPECT_TRUE(foundInInfoLog("'3.0f' : Floating-point suffix unsupported prior to GLSL ES 3.00"));
+}
+
+TEST_F(KeywordsTest, StructNamesAreTypeNames)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "struct S { float x; };\n"
+        "void main() {\n"
+        "   S s = S(1.0);\n"
+        "   gl_FragColor = vec4(s.x, true ? 1.0 : 0.0, false ? 1.0 : 0.0, 1.0);\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString)) << mInfoLog;
+}
+
+TEST_F(KeywordsTest, SyntaxErrorsReportTheOffendingToken)
+{
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(1.0) + ;\n"
+        "}\n"));
+    EXPECT_TRUE(foundInInfoLog("ERROR: 0:3: ';' : syntax error"));
+
+    // A truncated shader points at the end of the input.
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(1.0);\n"
+        "\n"));
+    EXPECT_TRUE(foundInInfoLog("ERROR: 0:5: '' : syntax error"));
+}
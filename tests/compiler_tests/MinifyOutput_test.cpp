@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput_test.cpp:
+//   Tests for the minified ESSL output.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class MinifyOutputTest : public testing::Test
+{
+  public:
+    MinifyOutputTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    bool compile(const std::string &shaderString, int compileOptions)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(
+            shaderStrings, 1, SH_OBJECT_CODE | compileOptions);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mObjectCode = infoSink.obj.c_str();
+        mInfoLog = infoSink.info.c_str();
+        return compilationSuccess;
+    }
+
+    bool foundInCode(const char *stringToFind)
+    {
+        return mObjectCode.find(stringToFind) != std::string::npos;
+    }
+
+    TranslatorESSL *mTranslator;
+    std::string mObjectCode;
+    std::string mInfoLog;
+};
+
+TEST_F(MinifyOutputTest, ParenthesesFollowPrecedence)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float a, b, c;\n"
+        "uniform bool p, q;\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(a - (b - c), (a * b) + c, a * (b + c), (p || q) && p ? a : b);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_MINIFY_OUTPUT)) << mInfoLog;
+
+    EXPECT_TRUE(foundInCode("gl_FragColor=vec4(a-(b-c),a*b+c,a*(b+c),(p||q)&&p?a:b);"))
+        << mObjectCode;
+    EXPECT_EQ(std::string::npos, mObjectCode.find('\n')) << mObjectCode;
+}
+
+TEST_F(MinifyOutputTest, SignsAreNotJoined)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float a, b;\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(a - -b, a + +b, -(-a), a - -1.0);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_MINIFY_OUTPUT)) << mInfoLog;
+
+    EXPECT_TRUE(foundInCode("vec4(a-(-b),a+(+b),-(-a),a-(-1.0))")) << mObjectCode;
+}
+
+TEST_F(MinifyOutputTest, LocalsAndFunctionsGetShortNames)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float uValue;\n"
+        "float scaleValue(float value) {\n"
+        "   float scaled = value * 2.0;\n"
+        "   return scaled * scaled;\n"
+        "}\n"
+        "void main() {\n"
+        "   float result = scaleValue(uValue);\n"
+        "   gl_FragColor = vec4(result);\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_MINIFY_OUTPUT)) << mInfoLog;
+
+    EXPECT_FALSE(foundInCode("scaleValue")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("scaled")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("result")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("uniform mediump float uValue;")) << mObjectCode;
+
+    // The most used name gets the shortest one, and the name map has them.
+    const NameMap &nameMap = mTranslator->getNameMap();
+    ASSERT_EQ(1u, nameMap.count("scaled"));
+    EXPECT_EQ("A", nameMap.find("scaled")->second);
+    ASSERT_EQ(1u, nameMap.count("scaleValue"));
+    EXPECT_TRUE(foundInCode((nameMap.find("scaleValue")->second + "(uValue)").c_str()))
+        << mObjectCode;
+}
+
+TEST_F(MinifyOutputTest, NamesSharedWithTheInterfaceAreKept)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float color;\n"
+        "struct S { float weight; };\n"
+        "float f(S s) {\n"
+        "   float color = s.weight;\n"
+        "   float weight = color;\n"
+        "   return weight;\n"
+        "}\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(f(S(color)));\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_MINIFY_OUTPUT)) << mInfoLog;
+
+    EXPECT_TRUE(foundInCode("mediump float color=")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("mediump float weight=color;")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("struct S{mediump float weight;}")) << mObjectCode;
+}
+
+TEST_F(MinifyOutputTest, OutputCompilesAgain)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u[4];\n"
+        "uniform int n;\n"
+        "void main() {\n"
+        "   vec4 sum = vec4(0.0);\n"
+        "   int i = 0;\n"
+        "   for (int j = 0; j < 4; ++j) {\n"
+        "      if (j == n) continue;\n"
+        "      else if (j > n) { sum -= u[j]; }\n"
+        "      else sum += u[j] * (j > 1 ? -1.0 : 1.0);\n"
+        "   }\n"
+        "   do { i++; sum.x -= -float(i--) - float(--i); } while (i < n);\n"
+        "   if (sum.x < 0.0) return;\n"
+        "   gl_FragColor = sum;\n"
+        "}\n";
+    ASSERT_TRUE(compile(shaderString, SH_MINIFY_OUTPUT)) << mInfoLog;
+
+    std::string minified = mObjectCode;
+    EXPECT_TRUE(compile(minified, 0)) << mInfoLog << minified;
+}
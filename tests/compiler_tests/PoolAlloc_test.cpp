@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAlloc_test.cpp:
+//   Tests that the pool allocator re-uses the pages it frees, within its
+//   limits, and reports its usage.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+
+namespace
+{
+
+const size_t kPageSize = 8 * 1024;
+
+void AllocateSmall(TPoolAllocator *allocator, size_t bytes)
+{
+    for (size_t allocated = 0; allocated < bytes; allocated += 64)
+    {
+        ASSERT_TRUE(allocator->allocate(64) != NULL);
+    }
+}
+
+}  // namespace
+
+TEST(PoolAllocatorTest, PoppedPagesAreReused)
+{
+    TPoolAllocator allocator(kPageSize);
+
+    allocator.push();
+    AllocateSmall(&allocator, 4 * kPageSize);
+    ASSERT_TRUE(allocator.allocate(3 * kPageSize) != NULL);
+    allocator.pop();
+
+    const TPoolAllocator::Statistics &statistics = allocator.getStatistics();
+    const size_t osAllocations = statistics.osAllocations;
+    EXPECT_EQ(0u, statistics.pagesInUse);
+    EXPECT_EQ(osAllocations, statistics.pagesRetained);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        allocator.push();
+        AllocateSmall(&allocator, 4 * kPageSize);
+        ASSERT_TRUE(allocator.allocate(3 * kPageSize) != NULL);
+        allocator.pop();
+    }
+    EXPECT_EQ(osAllocations, statistics.osAllocations);
+    EXPECT_EQ(4u * (4 * kPageSize / 64 + 1), statistics.allocations);
+}
+
+TEST(PoolAllocatorTest, RetainedBytesAreBounded)
+{
+    TPoolAllocator allocator(kPageSize);
+    allocator.setMaxRetainedBytes(2 * kPageSize);
+
+    allocator.push();
+    AllocateSmall(&allocator, 8 * kPageSize);
+    allocator.pop();
+
+    const TPoolAllocator::Statistics &statistics = allocator.getStatistics();
+    EXPECT_EQ(2u, statistics.pagesRetained);
+    EXPECT_EQ(2 * kPageSize, statistics.bytesRetained);
+
+    allocator.setMaxRetainedBytes(0);
+    EXPECT_EQ(0u, statistics.pagesRetained);
+    EXPECT_EQ(0u, statistics.bytesRetained);
+}
+
+TEST(PoolAllocatorTest, LargeAllocationsKeepTheCurrentPage)
+{
+    TPoolAllocator allocator(kPageSize);
+    allocator.push();
+
+    char *first = static_cast<char *>(allocator.allocate(64));
+    ASSERT_TRUE(allocator.allocate(2 * kPageSize) != NULL);
+    char *second = static_cast<char *>(allocator.allocate(64));
+    EXPECT_EQ(first + 64, second);
+    EXPECT_EQ(2u, allocator.getStatistics().pagesInUse);
+
+    allocator.pop();
+    EXPECT_EQ(0u, allocator.getStatistics().pagesInUse);
+}
+
+TEST(PoolAllocatorTest, PagesGrowUpToTheMaximum)
+{
+    TPoolAllocator allocator(kPageSize);
+    allocator.setMaxBlockSize(4 * kPageSize);
+    allocator.push();
+
+    AllocateSmall(&allocator, 32 * kPageSize);
+    const TPoolAllocator::Statistics &statistics = allocator.getStatistics();
+    EXPECT_GE(statistics.bytesInUse, 32 * kPageSize);
+    // 1 + 1 + 2 pages, then pages of 4.
+    EXPECT_GT(16u, statistics.pagesInUse);
+    EXPECT_EQ(statistics.pagesInUse, statistics.osAllocations);
+    EXPECT_EQ(statistics.bytesInUse, statistics.peakBytesInUse);
+
+    allocator.pop();
+}
+
+TEST(PoolAllocatorTest, HandleReportsItsPool)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT,
+                                            &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    ShPoolAllocatorOptions options;
+    ShInitPoolAllocatorOptions(&options);
+    options.maxPageSize = 8 * options.pageSize;
+    ShSetPoolAllocatorOptions(compiler, &options);
+
+    const char *shaderStrings[] = {
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main() {\n"
+        "   gl_FragColor = sin(u) + gl_FragCoord;\n"
+        "}\n"
+    };
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+
+    ShPoolAllocatorStatistics first;
+    ShGetPoolAllocatorStatistics(compiler, &first);
+    EXPECT_LT(0u, first.allocations);
+    EXPECT_LE(first.bytesInUse, first.peakBytesInUse);
+    EXPECT_LT(0u, first.pagesRetained);
+
+    // A second compile runs in the pages freed by the first.
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+    ShPoolAllocatorStatistics second;
+    ShGetPoolAllocatorStatistics(compiler, &second);
+    EXPECT_LT(first.allocations, second.allocations);
+    EXPECT_EQ(first.osAllocations, second.osAllocations);
+    EXPECT_EQ(first.peakBytesInUse, second.peakBytesInUse);
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Preprocess_test.cpp:
+//   Tests that ShPreprocess gives the same canonical form for sources that
+//   differ only in what the preprocessor discards, and a different one
+//   otherwise.
+//
+
+#include <string>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+class PreprocessTest : public testing::Test
+{
+  public:
+    PreprocessTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        resources.OES_standard_derivatives = 1;
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                        SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    std::string preprocess(const char *source, int compileOptions = 0)
+    {
+        const char *shaderStrings[] = { source };
+        std::string output;
+        EXPECT_TRUE(ShPreprocess(mCompiler, shaderStrings, 1, compileOptions, &output))
+            << ShGetInfoLog(mCompiler);
+        return output;
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(PreprocessTest, TokensAreSeparatedOnlyWhereNeeded)
+{
+    EXPECT_EQ("void main(){gl_FragColor=vec4(a . x+ +b,-1.0,0xE -1);}",
+              preprocess("void main() {\n"
+                         "    gl_FragColor = vec4(a.x + +b, -1.0, 0xE - 1);\n"
+                         "}\n"));
+}
+
+TEST_F(PreprocessTest, IgnoresCommentsWhitespaceAndInactiveGroups)
+{
+    const char *source =
+        "precision mediump float;\n"
+        "uniform vec4 u_color;\n"
+        "void main() {\n"
+        "    gl_FragColor = u_color;\n"
+        "}\n";
+    const char *equivalentSource =
+        "// A comment.\n"
+        "precision   mediump float;  /* Another\n"
+        "                               one. */\n"
+        "#define COLOR u_color\n"
+        "uniform vec4 u_color;\n"
+        "#ifdef UNDEFINED\n"
+        "uniform vec4 u_unused;\n"
+        "#endif\n"
+        "void main()\n"
+        "{\n"
+        "\tgl_FragColor=COLOR;\n"
+        "}";
+
+    std::string output = preprocess(source);
+    EXPECT_FALSE(output.empty());
+    EXPECT_EQ(output, preprocess(equivalentSource));
+    EXPECT_NE(output, preprocess("precision mediump float;\n"
+                                 "uniform vec4 u_colour;\n"
+                                 "void main() {\n"
+                                 "    gl_FragColor = u_colour;\n"
+                                 "}\n"));
+}
+
+TEST_F(PreprocessTest, IncludesDirectiveState)
+{
+    const char *body =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(dFdx(gl_FragCoord.x));\n"
+        "}\n";
+
+    std::string plain = preprocess(body);
+    std::string enabled =
+        preprocess(("#extension GL_OES_standard_derivatives : enable\n" + std::string(body)).c_str());
+    std::string disabled =
+        preprocess(("#extension GL_OES_standard_derivatives : disable\n" + std::string(body)).c_str());
+    std::string pragma = preprocess(("#pragma optimize(off)\n" + std::string(body)).c_str());
+    std::string version = preprocess(("#version 100\n" + std::string(body)).c_str());
+
+    EXPECT_EQ(0u, enabled.find("#extension GL_OES_standard_derivatives : enable\n"));
+    EXPECT_EQ(0u, pragma.find("#pragma optimize(off)\n"));
+    EXPECT_EQ(0u, version.find("#version 100\n"));
+
+    EXPECT_NE(plain, enabled);
+    EXPECT_NE(enabled, disabled);
+    EXPECT_NE(plain, pragma);
+    EXPECT_NE(plain, version);
+}
+
+TEST_F(PreprocessTest, KeepsLinesForLineDirectives)
+{
+    const char *source = "void main() {}\n";
+    const char *movedSource = "\n\nvoid main() {}\n";
+
+    EXPECT_EQ(preprocess(source), preprocess(movedSource));
+    EXPECT_NE(preprocess(source, SH_LINE_DIRECTIVES),
+              preprocess(movedSource, SH_LINE_DIRECTIVES));
+}
+
+TEST_F(PreprocessTest, ReportsErrors)
+{
+    const char *shaderStrings[] = { "#error stop\nvoid main() {}\n" };
+    std::string output;
+    EXPECT_FALSE(ShPreprocess(mCompiler, shaderStrings, 1, 0, &output));
+    EXPECT_NE(std::string::npos, ShGetInfoLog(mCompiler).find("stop"));
+}
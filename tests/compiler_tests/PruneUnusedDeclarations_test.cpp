@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PruneUnusedDeclarations_test.cpp:
+//   Tests for removing the functions, structs and globals that main()
+//   doesn't reach.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class PruneUnusedDeclarationsTest : public testing::Test
+{
+  public:
+    PruneUnusedDeclarationsTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    void compile(const std::string &shaderString, int compileOptions)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(
+            shaderStrings, 1, SH_OBJECT_CODE | compileOptions);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mObjectCode = infoSink.obj.c_str();
+        EXPECT_TRUE(compilationSuccess) << infoSink.info.c_str();
+    }
+
+    bool foundInCode(const char *stringToFind)
+    {
+        return mObjectCode.find(stringToFind) != std::string::npos;
+    }
+
+    TranslatorESSL *mTranslator;
+    std::string mObjectCode;
+};
+
+TEST_F(PruneUnusedDeclarationsTest, UnreachableFunctionsAreRemoved)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "float used(float x);\n"
+        "float unused(float x);\n"
+        "float helper() { return 1.0; }\n"
+        "float unused(float x) { return used(x) * 2.0; }\n"
+        "float used(float x) { return helper() + x; }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(used(0.5));\n"
+        "}\n";
+
+    compile(shaderString, 0);
+    EXPECT_TRUE(foundInCode("unused(")) << mObjectCode;
+
+    compile(shaderString, SH_PRUNE_UNUSED_DECLARATIONS);
+    EXPECT_FALSE(foundInCode("unused(")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("helper(")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("mediump float used(in mediump float x);")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("return (helper() + x);")) << mObjectCode;
+}
+
+TEST_F(PruneUnusedDeclarationsTest, UnusedGlobalsAreRemoved)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float uUnused;\n"
+        "float gUsed;\n"
+        "float gUnused;\n"
+        "float gFromDeadCode;\n"
+        "void dead() { gFromDeadCode = 1.0; }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(gUsed);\n"
+        "}\n";
+
+    compile(shaderString, SH_PRUNE_UNUSED_DECLARATIONS);
+    EXPECT_TRUE(foundInCode("uniform mediump float uUnused;")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("gUsed")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("gUnused")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("gFromDeadCode")) << mObjectCode;
+}
+
+TEST_F(PruneUnusedDeclarationsTest, StructsAreKeptWhereReferenced)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "struct Inner { float f; };\n"
+        "struct Outer { Inner inner; };\n"
+        "struct Unused { float f; };\n"
+        "Unused gUnused;\n"
+        "float get(Outer o) { return o.inner.f; }\n"
+        "void main() {\n"
+        "   Outer o;\n"
+        "   o.inner.f = 1.0;\n"
+        "   gl_FragColor = vec4(get(o));\n"
+        "}\n";
+
+    compile(shaderString, SH_PRUNE_UNUSED_DECLARATIONS);
+    EXPECT_TRUE(foundInCode("struct Inner")) << mObjectCode;
+    EXPECT_TRUE(foundInCode("struct Outer")) << mObjectCode;
+    EXPECT_FALSE(foundInCode("Unused")) << mObjectCode;
+}
+
+TEST_F(PruneUnusedDeclarationsTest, StaticUseIsUnchanged)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform float uDead;\n"
+        "float dead() { return uDead; }\n"
+        "void main() {\n"
+        "   gl_FragColor = vec4(1.0);\n"
+        "}\n";
+
+    compile(shaderString, SH_VARIABLES | SH_PRUNE_UNUSED_DECLARATIONS);
+    EXPECT_FALSE(foundInCode("dead(")) << mObjectCode;
+
+    const std::vector<sh::Uniform> &uniforms = mTranslator->getUniforms();
+    ASSERT_EQ(1u, uniforms.size());
+    EXPECT_EQ("uDead", uniforms[0].name);
+    EXPECT_TRUE(uniforms[0].staticUse);
+}
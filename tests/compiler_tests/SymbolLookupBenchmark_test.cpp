@@ -0,0 +1,407 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolLookupBenchmark_test.cpp:
+//   Measures the symbol table work in the parse of shaders that call many
+//   built-ins, with the levels looked up by atom and with the levels as
+//   they were before: maps from mangled name to symbol, searched by string.
+//   The operations of a real compile are recorded, then replayed on both.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Initialize.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+namespace
+{
+
+typedef std::vector<TSymbolTableOperation> SymbolTableLog;
+
+// The levels of a symbol table as they were before atoms.
+class StringKeyedSymbolTable
+{
+  public:
+    StringKeyedSymbolTable() {}
+
+    ~StringKeyedSymbolTable()
+    {
+        while (!mLevels.empty())
+            pop();
+    }
+
+    void push()
+    {
+        mLevels.push_back(new Level);
+    }
+
+    void pop()
+    {
+        delete mLevels.back();
+        mLevels.pop_back();
+    }
+
+    bool insert(int level, TSymbol *symbol)
+    {
+        return mLevels[level]->insert(Level::value_type(symbol->getMangledName(), symbol)).second;
+    }
+
+    TSymbol *find(const TString &name, int shaderVersion) const
+    {
+        int level = static_cast<int>(mLevels.size()) - 1;
+        TSymbol *symbol = 0;
+        do
+        {
+            if (level == ESSL3_BUILTINS && shaderVersion != 300)
+                level--;
+            if (level == ESSL1_BUILTINS && shaderVersion != 100)
+                level--;
+
+            symbol = findAt(level, name);
+        }
+        while (symbol == 0 && --level >= 0);
+        return symbol;
+    }
+
+    TSymbol *findBuiltIn(const TString &name, int shaderVersion) const
+    {
+        for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
+        {
+            if (level == ESSL3_BUILTINS && shaderVersion != 300)
+                level--;
+            if (level == ESSL1_BUILTINS && shaderVersion != 100)
+                level--;
+
+            TSymbol *symbol = findAt(level, name);
+            if (symbol)
+                return symbol;
+        }
+        return 0;
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(StringKeyedSymbolTable);
+
+    typedef TMap<TString, TSymbol *> Level;
+
+    TSymbol *findAt(int level, const TString &name) const
+    {
+        Level::const_iterator it = mLevels[level]->find(name);
+        return it == mLevels[level]->end() ? 0 : it->second;
+    }
+
+    std::vector<Level *> mLevels;
+};
+
+// Replays a log on a table. The names are the log's, already copied into
+// the pool, so that the replay costs what the table costs. Appends the
+// name of the symbol that each lookup found, or an empty string, to
+// |found| if it isn't NULL.
+template <typename Table>
+void Replay(const SymbolTableLog &log, const std::vector<const TString *> &names, Table *table,
+            std::vector<TString> *found)
+{
+    for (size_t i = 0; i < log.size(); ++i)
+    {
+        const TSymbolTableOperation &operation = log[i];
+        TSymbol *symbol = 0;
+        switch (operation.kind)
+        {
+          case TSymbolTableOperation::Push:
+            table->push();
+            break;
+          case TSymbolTableOperation::Pop:
+            table->pop();
+            break;
+          case TSymbolTableOperation::Insert:
+            table->insert(operation.argument, new TVariable(names[i], TType(EbtFloat)));
+            break;
+          case TSymbolTableOperation::Find:
+            symbol = table->find(*names[i], operation.argument);
+            break;
+          case TSymbolTableOperation::FindBuiltIn:
+            symbol = table->findBuiltIn(*names[i], operation.argument);
+            break;
+        }
+        if (found && (operation.kind == TSymbolTableOperation::Find ||
+                      operation.kind == TSymbolTableOperation::FindBuiltIn))
+        {
+            found->push_back(symbol ? symbol->getMangledName() : TString());
+        }
+    }
+}
+
+// A chain of calls, each on the variable declared by the call before it,
+// with a new scope every 50 calls, so that the lookups of the variables
+// and of the built-ins go through more and more levels.
+std::string GenerateChainedCalls(size_t numCalls)
+{
+    static const char *const kUnaryFunctions[] =
+    {
+        "sin", "cos", "abs", "fract", "normalize", "floor", "sign", "exp2"
+    };
+    static const char *const kBinaryFunctions[] =
+    {
+        "max", "min", "pow", "step", "mod", "reflect"
+    };
+
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "uniform vec4 u;\n"
+           << "void main() {\n"
+           << "    vec4 v0 = u;\n";
+
+    size_t scopes = 0;
+    for (size_t i = 1; i <= numCalls; ++i)
+    {
+        if (i % 50 == 0)
+        {
+            shader << "    {\n";
+            ++scopes;
+        }
+        shader << "    vec4 v" << i << " = ";
+        if (i % 2 == 0)
+            shader << kUnaryFunctions[(i / 2) % ArraySize(kUnaryFunctions)] << "(v" << i - 1 << ");\n";
+        else
+            shader << kBinaryFunctions[(i / 2) % ArraySize(kBinaryFunctions)] << "(v" << i - 1 << ", u);\n";
+    }
+
+    shader << "    gl_FragColor = v" << numCalls << ";\n";
+    for (size_t i = 0; i < scopes; ++i)
+        shader << "    }\n";
+    shader << "}\n";
+    return shader.str();
+}
+
+// Many small functions at global scope, each calling heavily overloaded
+// built-ins on its float, vec2 and vec3 parameters, and a main that calls
+// them all. Most lookups are of mangled names, at the global and built-in
+// levels.
+std::string GenerateOverloadedCalls(size_t numFunctions)
+{
+    std::ostringstream shader;
+    shader << "precision mediump float;\n"
+           << "uniform sampler2D s;\n"
+           << "uniform vec3 light;\n"
+           << "varying vec2 uv;\n";
+
+    for (size_t i = 0; i < numFunctions; ++i)
+    {
+        shader << "vec3 f" << i << "(float a, vec2 b, vec3 c) {\n"
+               << "    vec4 t = texture2D(s, b * a);\n"
+               << "    float d = dot(normalize(c), light) + length(b);\n"
+               << "    vec3 m = mix(c, t.rgb, clamp(d, 0.0, 1.0));\n"
+               << "    return max(m, vec3(smoothstep(0.0, a, distance(b, uv))));\n"
+               << "}\n";
+    }
+
+    shader << "void main() {\n"
+           << "    vec3 color = vec3(0.0);\n";
+    for (size_t i = 0; i < numFunctions; ++i)
+        shader << "    color += f" << i << "(" << i << ".0, uv, color);\n";
+    shader << "    gl_FragColor = vec4(color, 1.0);\n"
+           << "}\n";
+    return shader.str();
+}
+
+class SymbolLookupBenchmarkTest : public testing::Test
+{
+  public:
+    SymbolLookupBenchmarkTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(mResources));
+
+        mPreviousAllocator = GetGlobalPoolAllocator();
+        SetGlobalPoolAllocator(&mAllocator);
+        mAllocator.push();
+    }
+
+    virtual void TearDown()
+    {
+        mAllocator.pop();
+        SetGlobalPoolAllocator(mPreviousAllocator);
+        delete mTranslator;
+    }
+
+    // Records what the translator's table does to set up the built-ins,
+    // as it is done once for all the compilers that share them.
+    void recordBuiltIns(SymbolTableLog *log)
+    {
+        TSymbolTable builtIns;
+        builtIns.setLog(log);
+        builtIns.push();   // COMMON_BUILTINS
+        builtIns.push();   // ESSL1_BUILTINS
+        builtIns.push();   // ESSL3_BUILTINS
+        InsertBuiltInFunctions(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, mResources, builtIns);
+        IdentifyBuiltIns(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, mResources, builtIns);
+        builtIns.setLog(NULL);
+    }
+
+    // Compiles the shader, recording the operations on the symbol table,
+    // and returns the fastest of a few parse times in microseconds.
+    double compile(const std::string &shaderString, SymbolTableLog *log)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        TSymbolTable &symbolTable = mTranslator->getSymbolTable();
+        symbolTable.setLog(log);
+        bool compiled = mTranslator->compile(shaderStrings, 1, 0);
+        symbolTable.setLog(NULL);
+        EXPECT_TRUE(compiled) << mTranslator->getInfoSink().info.c_str();
+
+        khronos_uint64_t parseTime = ~static_cast<khronos_uint64_t>(0);
+        for (int run = 0; run < 10; ++run)
+        {
+            mTranslator->compile(shaderStrings, 1, SH_COMPILE_STATISTICS);
+            parseTime = std::min(parseTime,
+                                 mTranslator->getStatistics()->phaseTimes[SH_COMPILE_PHASE_PARSE]);
+        }
+
+        // The allocator of the translator was current during the compiles.
+        SetGlobalPoolAllocator(&mAllocator);
+        return 1e-3 * parseTime;
+    }
+
+    // Returns the fastest of a few mean times of a replay, in microseconds.
+    template <typename Function>
+    double measure(Function replay)
+    {
+        typedef std::chrono::steady_clock Clock;
+        double best = 0.0;
+        for (int round = 0; round < 3; ++round)
+        {
+            size_t runs = 0;
+            Clock::time_point start = Clock::now();
+            Clock::time_point now = start;
+            while (now - start < std::chrono::milliseconds(50))
+            {
+                mAllocator.push();
+                replay();
+                mAllocator.pop();
+                ++runs;
+                now = Clock::now();
+            }
+            double mean = 1e6 * std::chrono::duration<double>(now - start).count() / runs;
+            if (round == 0 || mean < best)
+                best = mean;
+        }
+        return best;
+    }
+
+    void run(const char *name, const std::string &shaderString);
+
+    ShBuiltInResources mResources;
+    TranslatorESSL *mTranslator;
+    TPoolAllocator mAllocator;
+    TPoolAllocator *mPreviousAllocator;
+};
+
+std::vector<const TString *> PoolNames(const SymbolTableLog &log)
+{
+    std::vector<const TString *> names;
+    for (size_t i = 0; i < log.size(); ++i)
+        names.push_back(NewPoolTString(log[i].name.c_str()));
+    return names;
+}
+
+// The atom table replays the compile on a table of its own that shares
+// the built-in levels, as a compiler's table does.
+struct AtomReplay
+{
+    const SymbolTableLog *log;
+    const std::vector<const TString *> *names;
+    const TSymbolTable *builtIns;
+    std::vector<TString> *found;
+
+    void operator()() const
+    {
+        TSymbolTable table;
+        table.shareBuiltInLevels(*builtIns);
+        Replay(*log, *names, &table, found);
+    }
+};
+
+// The string-keyed table was shared the same way, which makes no
+// difference to a lookup in it, so the compile is replayed on top of the
+// built-in levels, which it leaves as they were.
+struct StringKeyedReplay
+{
+    const SymbolTableLog *log;
+    const std::vector<const TString *> *names;
+    StringKeyedSymbolTable *table;
+    std::vector<TString> *found;
+
+    void operator()() const
+    {
+        Replay(*log, *names, table, found);
+    }
+};
+
+void SymbolLookupBenchmarkTest::run(const char *name, const std::string &shaderString)
+{
+    SymbolTableLog builtInLog;
+    recordBuiltIns(&builtInLog);
+    SymbolTableLog compileLog;
+    double parseTime = compile(shaderString, &compileLog);
+
+    std::vector<const TString *> builtInNames = PoolNames(builtInLog);
+    std::vector<const TString *> compileNames = PoolNames(compileLog);
+
+    TSymbolTable atomBuiltIns;
+    Replay(builtInLog, builtInNames, &atomBuiltIns, static_cast<std::vector<TString> *>(NULL));
+    StringKeyedSymbolTable stringKeyed;
+    Replay(builtInLog, builtInNames, &stringKeyed, static_cast<std::vector<TString> *>(NULL));
+
+    // Both tables find the same symbols.
+    std::vector<TString> atomFound;
+    std::vector<TString> stringKeyedFound;
+    AtomReplay atomReplay = { &compileLog, &compileNames, &atomBuiltIns, &atomFound };
+    StringKeyedReplay stringKeyedReplay = { &compileLog, &compileNames, &stringKeyed,
+                                            &stringKeyedFound };
+    atomReplay();
+    stringKeyedReplay();
+    ASSERT_EQ(stringKeyedFound, atomFound);
+
+    size_t lookups = atomFound.size();
+    atomReplay.found = NULL;
+    stringKeyedReplay.found = NULL;
+    double atomTime = measure(atomReplay);
+    double stringKeyedTime = measure(stringKeyedReplay);
+
+    // The rest of the parse is the same with either table.
+    double parseTimeBefore = parseTime - atomTime + stringKeyedTime;
+    std::cout << "symbol_lookup_" << name << ": " << lookups << " lookups, "
+              << compileLog.size() - lookups << " other operations\n"
+              << "  symbol table time: " << stringKeyedTime << " us by string, "
+              << atomTime << " us by atom\n"
+              << "  parse time: " << parseTimeBefore << " us by string, "
+              << parseTime << " us by atom ("
+              << parseTimeBefore / parseTime << "x)" << std::endl;
+}
+
+}  // namespace
+
+TEST_F(SymbolLookupBenchmarkTest, ChainedBuiltInCalls)
+{
+    run("chained_calls_1500", GenerateChainedCalls(1500));
+}
+
+TEST_F(SymbolLookupBenchmarkTest, OverloadedBuiltInCalls)
+{
+    run("overloaded_calls_100_functions", GenerateOverloadedCalls(100));
+}
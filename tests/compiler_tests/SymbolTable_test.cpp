@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolTable_test.cpp:
+//   Tests the atoms of the symbol table and the scoping of lookups by atom.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+class AtomTableTest : public testing::Test
+{
+  public:
+    AtomTableTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        mPreviousAllocator = GetGlobalPoolAllocator();
+        SetGlobalPoolAllocator(&mAllocator);
+    }
+
+    virtual void TearDown()
+    {
+        SetGlobalPoolAllocator(mPreviousAllocator);
+    }
+
+    TPoolAllocator mAllocator;
+    TPoolAllocator *mPreviousAllocator;
+};
+
+TEST_F(AtomTableTest, InternIsIdempotent)
+{
+    TAtomTable atoms;
+    int sin = atoms.intern("sin(f1;");
+    int cos = atoms.intern("cos(f1;");
+    EXPECT_NE(sin, cos);
+    EXPECT_EQ(sin, atoms.intern("sin(f1;"));
+    EXPECT_EQ(sin, atoms.find("sin(f1;"));
+    EXPECT_EQ(-1, atoms.find("sin(f2;"));
+    EXPECT_EQ(2u, atoms.size());
+
+    // Enough names to rehash several times.
+    for (int i = 0; i < 1000; ++i)
+    {
+        TStringStream name;
+        name << "name" << i;
+        int expected = static_cast<int>(atoms.size());
+        EXPECT_EQ(expected, atoms.intern(name.str()));
+    }
+    EXPECT_EQ(sin, atoms.find("sin(f1;"));
+    EXPECT_EQ(cos, atoms.find("cos(f1;"));
+}
+
+TEST_F(AtomTableTest, ChildSharesTheAtomsOfItsParent)
+{
+    TAtomTable parent;
+    int sin = parent.intern("sin(f1;");
+
+    TAtomTable child;
+    child.setParent(&parent);
+    EXPECT_EQ(sin, child.intern("sin(f1;"));
+    EXPECT_EQ(1u, child.size());
+
+    int color = child.intern("color");
+    EXPECT_EQ(1, color);
+    EXPECT_EQ(-1, parent.find("color"));
+
+    child.truncate(1);
+    EXPECT_EQ(-1, child.find("color"));
+    EXPECT_EQ(sin, child.find("sin(f1;"));
+    EXPECT_EQ(color, child.intern("other"));
+}
+
+class SymbolTableTest : public testing::Test
+{
+  public:
+    SymbolTableTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mTranslator = new TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+    }
+
+    virtual void TearDown()
+    {
+        delete mTranslator;
+    }
+
+    bool compile(const std::string& shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compilationSuccess = mTranslator->compile(shaderStrings, 1, SH_OBJECT_CODE);
+        TInfoSink &infoSink = mTranslator->getInfoSink();
+        mInfoLog = infoSink.info.c_str();
+        return compilationSuccess;
+    }
+
+    bool foundInInfoLog(const char* stringToFind)
+    {
+        return mInfoLog.find(stringToFind) != std::string::npos;
+    }
+
+    std::string mInfoLog;
+    TranslatorESSL *mTranslator;
+};
+
+TEST_F(SymbolTableTest, InnerScopesShadowOuterOnes)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "float x = 1.0;\n"
+        "void main() {\n"
+        "   bool x = true;\n"
+        "   {\n"
+        "       int x = 2;\n"
+        "       x += 1;\n"
+        "   }\n"
+        "   gl_FragColor = vec4(x ? 1.0 : 0.0);\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString)) << mInfoLog;
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() {\n"
+        "   { float y = 1.0; }\n"
+        "   gl_FragColor = vec4(y);\n"
+        "}\n"));
+    EXPECT_TRUE(foundInInfoLog("'y' : undeclared identifier"));
+}
+
+TEST_F(SymbolTableTest, BuiltInOverloadsResolve)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform sampler2D s;\n"
+        "uniform samplerCube c;\n"
+        "varying vec2 uv;\n"
+        "void main() {\n"
+        "   vec4 color = texture2D(s, uv) + textureCube(c, vec3(uv, 1.0));\n"
+        "   float f = sin(uv.x) + dot(uv, uv) + length(vec3(uv, 1.0));\n"
+        "   vec2 v = clamp(uv, 0.0, 1.0) + clamp(uv, vec2(0.0), vec2(1.0));\n"
+        "   gl_FragColor = color * f * mix(v.x, v.y, 0.5) + gl_FragCoord;\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString)) << mInfoLog;
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { gl_FragColor = vec4(sin(1.0, 2.0)); }\n"));
+    EXPECT_TRUE(foundInInfoLog("'sin' : no matching overloaded function found"));
+}
+
+TEST_F(SymbolTableTest, UserSymbolsDoNotOutliveTheCompile)
+{
+    EXPECT_TRUE(compile(
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "float f(float a) { return a * u; }\n"
+        "void main() { gl_FragColor = vec4(f(1.0)); }\n")) << mInfoLog;
+
+    EXPECT_FALSE(compile(
+        "precision mediump float;\n"
+        "void main() { gl_FragColor = vec4(f(u)); }\n"));
+    EXPECT_TRUE(foundInInfoLog("'f' : no matching overloaded function found"));
+
+    // The built-ins are still found through the shared atoms.
+    const TSymbolTable &symbolTable = mTranslator->getSymbolTable();
+    EXPECT_TRUE(symbolTable.findBuiltIn("gl_FragCoord", 100) != NULL);
+    EXPECT_TRUE(symbolTable.findBuiltIn("u", 100) == NULL);
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TimingRestrictions_test.cpp:
+//   Tests the restrictions against timing attacks, which are enforced on the
+//   dependency graph of fragment shaders.
+//
+
+#include <string>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+class TimingRestrictionsTest : public testing::Test
+{
+  public:
+    TimingRestrictionsTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        resources.MaxExpressionComplexity = 32;
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                        &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const char *shaderString, int compileOptions)
+    {
+        const char *shaderStrings[] = { shaderString };
+        bool compilationSuccess = ShCompile(mCompiler, shaderStrings, 1, compileOptions);
+        mInfoLog = ShGetInfoLog(mCompiler);
+        return compilationSuccess;
+    }
+
+    bool foundInInfoLog(const char *stringToFind)
+    {
+        return mInfoLog.find(stringToFind) != std::string::npos;
+    }
+
+    ShHandle mCompiler;
+    std::string mInfoLog;
+};
+
+namespace
+{
+
+const char *kSamplerDependentBranch =
+    "precision mediump float;\n"
+    "uniform sampler2D s;\n"
+    "float luminance(vec4 color) { return dot(color.rgb, vec3(0.3, 0.6, 0.1)); }\n"
+    "void main() {\n"
+    "   vec4 color = texture2D(s, vec2(0.5));\n"
+    "   if (luminance(color) > 0.5) { color = vec4(1.0); }\n"
+    "   gl_FragColor = color;\n"
+    "}\n";
+
+}  // namespace
+
+TEST_F(TimingRestrictionsTest, SamplerDependentControlFlowIsRejected)
+{
+    const int options = SH_OBJECT_CODE | SH_LIMIT_EXPRESSION_COMPLEXITY;
+    EXPECT_TRUE(compile(kSamplerDependentBranch, options)) << mInfoLog;
+
+    EXPECT_FALSE(compile(kSamplerDependentBranch, options | SH_TIMING_RESTRICTIONS));
+    EXPECT_TRUE(foundInInfoLog("An expression dependent on a sampler is not permitted"));
+    EXPECT_FALSE(foundInInfoLog("argument 0 of call to luminance"));
+}
+
+TEST_F(TimingRestrictionsTest, DependencyGraphFollowsTheErrors)
+{
+    EXPECT_FALSE(compile(kSamplerDependentBranch,
+                         SH_OBJECT_CODE | SH_TIMING_RESTRICTIONS | SH_DEPENDENCY_GRAPH));
+    size_t error = mInfoLog.find("An expression dependent on a sampler is not permitted");
+    size_t graph = mInfoLog.find("argument 0 of call to luminance");
+    ASSERT_NE(std::string::npos, error);
+    ASSERT_NE(std::string::npos, graph);
+    EXPECT_LT(error, graph);
+
+    // Each compile builds the graph of its own tree.
+    EXPECT_TRUE(compile(
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main() { gl_FragColor = u.x > 0.5 ? u : vec4(0.0); }\n",
+        SH_OBJECT_CODE | SH_TIMING_RESTRICTIONS | SH_DEPENDENCY_GRAPH)) << mInfoLog;
+    EXPECT_FALSE(foundInInfoLog("luminance"));
+}
@@ -0,0 +1,279 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslationCache_test.cpp:
+//   Tests that ShCompile serves repeated compiles from the translation cache
+//   with the same results as translating them.
+//
+
+#include <map>
+#include <string>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const char *kFragmentShader =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "uniform sampler2D u_tex;\n"
+    "varying vec2 v_uv;\n"
+    "void main() {\n"
+    "    gl_FragColor = u_color * texture2D(u_tex, v_uv);\n"
+    "}\n";
+
+const char *kOtherFragmentShader =
+    "precision mediump float;\n"
+    "uniform float u_scale;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(u_scale);\n"
+    "}\n";
+
+const char *kInvalidFragmentShader =
+    "precision mediump float;\n"
+    "void main() {\n"
+    "    gl_FragColor = undeclared;\n"
+    "}\n";
+
+typedef std::map<std::string, std::string> BackingStore;
+
+bool GetFromStore(void *userData, const std::string &key, std::string *value)
+{
+    BackingStore *store = static_cast<BackingStore *>(userData);
+    BackingStore::const_iterator iter = store->find(key);
+    if (iter == store->end())
+        return false;
+    *value = iter->second;
+    return true;
+}
+
+void PutToStore(void *userData, const std::string &key, const std::string &value)
+{
+    BackingStore *store = static_cast<BackingStore *>(userData);
+    (*store)[key] = value;
+}
+
+}  // namespace
+
+class TranslationCacheTest : public testing::Test
+{
+  public:
+    TranslationCacheTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        ShClearTranslationCache();
+        ShSetTranslationCacheSize(1024 * 1024);
+    }
+
+    virtual void TearDown()
+    {
+        ShSetTranslationCacheSize(0);
+        ShSetTranslationCacheBackingStore(NULL, NULL, NULL);
+        ShClearTranslationCache();
+    }
+
+    ShHandle construct(ShShaderOutput output)
+    {
+        ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, output,
+                                                &mResources);
+        EXPECT_TRUE(compiler != NULL);
+        return compiler;
+    }
+
+    bool compile(ShHandle compiler, const char *source, int compileOptions)
+    {
+        const char *shaderStrings[] = { source };
+        return ShCompile(compiler, shaderStrings, 1, compileOptions);
+    }
+
+    ShTranslationCacheStatistics statistics()
+    {
+        ShTranslationCacheStatistics statistics;
+        ShGetTranslationCacheStatistics(&statistics);
+        return statistics;
+    }
+
+    ShBuiltInResources mResources;
+};
+
+TEST_F(TranslationCacheTest, HitReturnsTranslatedResults)
+{
+    const int options = SH_OBJECT_CODE | SH_VARIABLES;
+
+    ShHandle first = construct(SH_HLSL11_OUTPUT);
+    ASSERT_TRUE(compile(first, kFragmentShader, options));
+    EXPECT_EQ(0u, statistics().hits);
+    EXPECT_EQ(1u, statistics().misses);
+
+    ShHandle second = construct(SH_HLSL11_OUTPUT);
+    ASSERT_TRUE(compile(second, kFragmentShader, options));
+    EXPECT_EQ(1u, statistics().hits);
+    EXPECT_EQ(1u, statistics().misses);
+
+    EXPECT_EQ(ShGetObjectCode(first), ShGetObjectCode(second));
+    EXPECT_EQ(ShGetInfoLog(first), ShGetInfoLog(second));
+    EXPECT_EQ(ShGetShaderVersion(first), ShGetShaderVersion(second));
+
+    const std::vector<sh::Uniform> &uniforms = *ShGetUniforms(first);
+    ASSERT_EQ(uniforms.size(), ShGetUniforms(second)->size());
+    ASSERT_EQ(1u, ShGetVaryings(second)->size());
+    EXPECT_EQ("v_uv", (*ShGetVaryings(second))[0].name);
+    for (size_t ii = 0; ii < uniforms.size(); ++ii)
+    {
+        EXPECT_TRUE(uniforms[ii] == (*ShGetUniforms(second))[ii]);
+
+        unsigned int firstRegister = 0;
+        unsigned int secondRegister = 0;
+        ASSERT_TRUE(ShGetUniformRegister(first, uniforms[ii].name, &firstRegister));
+        ASSERT_TRUE(ShGetUniformRegister(second, uniforms[ii].name, &secondRegister));
+        EXPECT_EQ(firstRegister, secondRegister);
+    }
+
+    ShDestruct(first);
+    ShDestruct(second);
+}
+
+TEST_F(TranslationCacheTest, KeyCoversSourceOptionsAndOutput)
+{
+    ShHandle essl = construct(SH_ESSL_OUTPUT);
+    ShHandle glsl = construct(SH_GLSL_OUTPUT);
+
+    ASSERT_TRUE(compile(essl, kFragmentShader, SH_OBJECT_CODE));
+    ASSERT_TRUE(compile(essl, kOtherFragmentShader, SH_OBJECT_CODE));
+    ASSERT_TRUE(compile(essl, kFragmentShader, SH_OBJECT_CODE | SH_VARIABLES));
+    ASSERT_TRUE(compile(glsl, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(0u, statistics().hits);
+    EXPECT_EQ(4u, statistics().misses);
+    EXPECT_EQ(4u, statistics().entries);
+
+    ASSERT_TRUE(compile(glsl, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(1u, statistics().hits);
+
+    // Other resources are another key, even on the same handle type.
+    mResources.MaxDrawBuffers = 2;
+    ShHandle otherResources = construct(SH_GLSL_OUTPUT);
+    ASSERT_TRUE(compile(otherResources, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(1u, statistics().hits);
+    EXPECT_EQ(5u, statistics().misses);
+
+    ShDestruct(essl);
+    ShDestruct(glsl);
+    ShDestruct(otherResources);
+}
+
+TEST_F(TranslationCacheTest, FailedCompilesAreCached)
+{
+    ShHandle first = construct(SH_ESSL_OUTPUT);
+    EXPECT_FALSE(compile(first, kInvalidFragmentShader, SH_OBJECT_CODE));
+
+    ShHandle second = construct(SH_ESSL_OUTPUT);
+    EXPECT_FALSE(compile(second, kInvalidFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(1u, statistics().hits);
+    EXPECT_NE(std::string::npos, ShGetInfoLog(second).find("undeclared"));
+    EXPECT_EQ(ShGetInfoLog(first), ShGetInfoLog(second));
+
+    ShDestruct(first);
+    ShDestruct(second);
+}
+
+TEST_F(TranslationCacheTest, EvictsLeastRecentlyUsed)
+{
+    ShHandle compiler = construct(SH_ESSL_OUTPUT);
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    ASSERT_TRUE(compile(compiler, kOtherFragmentShader, SH_OBJECT_CODE));
+    // Touch the first entry, leaving the second least recently used.
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(1u, statistics().hits);
+    EXPECT_EQ(2u, statistics().entries);
+
+    ShSetTranslationCacheSize(statistics().size - 1);
+    EXPECT_EQ(1u, statistics().entries);
+    EXPECT_EQ(1u, statistics().evictions);
+
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(2u, statistics().hits);
+    ASSERT_TRUE(compile(compiler, kOtherFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(2u, statistics().hits);
+    EXPECT_EQ(3u, statistics().misses);
+    EXPECT_LE(statistics().size, statistics().maxSize);
+
+    ShDestruct(compiler);
+}
+
+TEST_F(TranslationCacheTest, DisabledCacheIsBypassed)
+{
+    ShSetTranslationCacheSize(0);
+
+    ShHandle compiler = construct(SH_ESSL_OUTPUT);
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(0u, statistics().hits);
+    EXPECT_EQ(0u, statistics().misses);
+    EXPECT_EQ(0u, statistics().entries);
+
+    ShDestruct(compiler);
+}
+
+TEST_F(TranslationCacheTest, BackingStoreRoundTrip)
+{
+    BackingStore store;
+    ShSetTranslationCacheBackingStore(GetFromStore, PutToStore, &store);
+
+    const int options = SH_OBJECT_CODE | SH_VARIABLES;
+    ShHandle first = construct(SH_HLSL11_OUTPUT);
+    ASSERT_TRUE(compile(first, kFragmentShader, options));
+    ASSERT_EQ(1u, store.size());
+
+    // Forget the in-memory entry, as a new process would.
+    ShClearTranslationCache();
+
+    ShHandle second = construct(SH_HLSL11_OUTPUT);
+    ASSERT_TRUE(compile(second, kFragmentShader, options));
+    EXPECT_EQ(1u, statistics().backingStoreHits);
+    EXPECT_EQ(0u, statistics().misses);
+    EXPECT_EQ(ShGetObjectCode(first), ShGetObjectCode(second));
+    EXPECT_EQ(ShGetInfoLog(first), ShGetInfoLog(second));
+    EXPECT_TRUE(*ShGetUniforms(first) == *ShGetUniforms(second));
+
+    unsigned int firstRegister = 0;
+    unsigned int secondRegister = 0;
+    ASSERT_TRUE(ShGetUniformRegister(first, "u_tex", &firstRegister));
+    ASSERT_TRUE(ShGetUniformRegister(second, "u_tex", &secondRegister));
+    EXPECT_EQ(firstRegister, secondRegister);
+
+    // The entry is back in memory.
+    ASSERT_TRUE(compile(second, kFragmentShader, options));
+    EXPECT_EQ(1u, statistics().hits);
+
+    ShDestruct(first);
+    ShDestruct(second);
+}
+
+TEST_F(TranslationCacheTest, CorruptBackingStoreEntryIsAMiss)
+{
+    BackingStore store;
+    ShSetTranslationCacheBackingStore(GetFromStore, PutToStore, &store);
+
+    ShHandle compiler = construct(SH_ESSL_OUTPUT);
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    const std::string objectCode = ShGetObjectCode(compiler);
+    ASSERT_EQ(1u, store.size());
+    std::string &value = store.begin()->second;
+    value.resize(value.size() / 2);
+
+    ShClearTranslationCache();
+    ASSERT_TRUE(compile(compiler, kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(0u, statistics().backingStoreHits);
+    EXPECT_EQ(1u, statistics().misses);
+    EXPECT_EQ(objectCode, ShGetObjectCode(compiler));
+
+    ShDestruct(compiler);
+}
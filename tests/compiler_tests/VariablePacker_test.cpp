@@ -170,3 +170,275 @@ TEST(VariablePacking, NonSquareMats) {
     EXPECT_FALSE(packer.CheckVariablesWithinPackingLimits(squareSize, vars));
   }
 }
+
+namespace {
+
+// The packer as it was before it tracked one run of free rows per column:
+// it keeps the occupied columns of every row, and searches them row by row
+// for the smallest run that holds each single column variable.
+class ReferencePacker {
+ public:
+  bool CheckVariablesWithinPackingLimits(
+      unsigned int maxVectors, const std::vector<sh::ShaderVariable> &in_variables) {
+    maxRows_ = maxVectors;
+    topNonFullRow_ = 0;
+    bottomNonFullRow_ = maxRows_ - 1;
+    std::vector<sh::ShaderVariable> variables(in_variables);
+
+    for (size_t i = 0; i < variables.size(); i++) {
+      if (variables[i].elementCount() >
+          maxVectors / VariablePacker::GetNumRows(variables[i].type)) {
+        return false;
+      }
+    }
+
+    std::stable_sort(variables.begin(), variables.end(), Comparer());
+    rows_.clear();
+    rows_.resize(maxVectors, 0);
+
+    size_t ii = 0;
+    for (; ii < variables.size() && NumComponents(variables[ii]) == 4; ++ii) {
+      topNonFullRow_ += NumRows(variables[ii]);
+    }
+    if (topNonFullRow_ > maxRows_) {
+      return false;
+    }
+
+    int num3ColumnRows = 0;
+    for (; ii < variables.size() && NumComponents(variables[ii]) == 3; ++ii) {
+      num3ColumnRows += NumRows(variables[ii]);
+    }
+    if (topNonFullRow_ + num3ColumnRows > maxRows_) {
+      return false;
+    }
+    fillColumns(topNonFullRow_, num3ColumnRows, 0, 3);
+
+    int top2ColumnRow = topNonFullRow_ + num3ColumnRows;
+    int twoColumnRowsAvailable = maxRows_ - top2ColumnRow;
+    int rowsAvailableInColumns01 = twoColumnRowsAvailable;
+    int rowsAvailableInColumns23 = twoColumnRowsAvailable;
+    for (; ii < variables.size() && NumComponents(variables[ii]) == 2; ++ii) {
+      int numRows = NumRows(variables[ii]);
+      if (numRows <= rowsAvailableInColumns01) {
+        rowsAvailableInColumns01 -= numRows;
+      } else if (numRows <= rowsAvailableInColumns23) {
+        rowsAvailableInColumns23 -= numRows;
+      } else {
+        return false;
+      }
+    }
+    int numRowsUsedInColumns01 = twoColumnRowsAvailable - rowsAvailableInColumns01;
+    int numRowsUsedInColumns23 = twoColumnRowsAvailable - rowsAvailableInColumns23;
+    fillColumns(top2ColumnRow, numRowsUsedInColumns01, 0, 2);
+    fillColumns(maxRows_ - numRowsUsedInColumns23, numRowsUsedInColumns23, 2, 2);
+
+    for (; ii < variables.size(); ++ii) {
+      int numRows = NumRows(variables[ii]);
+      int smallestColumn = -1;
+      int smallestSize = maxRows_ + 1;
+      int topRow = -1;
+      for (int column = 0; column < kNumColumns; ++column) {
+        int row = 0;
+        int size = 0;
+        if (searchColumn(column, numRows, &row, &size) && size < smallestSize) {
+          smallestSize = size;
+          smallestColumn = column;
+          topRow = row;
+        }
+      }
+      if (smallestColumn < 0) {
+        return false;
+      }
+      fillColumns(topRow, numRows, smallestColumn, 1);
+    }
+    return true;
+  }
+
+ private:
+  static const int kNumColumns = 4;
+  static const unsigned kColumnMask = (1 << kNumColumns) - 1;
+
+  struct Comparer {
+    bool operator()(const sh::ShaderVariable &lhs, const sh::ShaderVariable &rhs) const {
+      int lhsSortOrder = gl::VariableSortOrder(lhs.type);
+      int rhsSortOrder = gl::VariableSortOrder(rhs.type);
+      if (lhsSortOrder != rhsSortOrder) {
+        return lhsSortOrder < rhsSortOrder;
+      }
+      return lhs.arraySize > rhs.arraySize;
+    }
+  };
+
+  static int NumComponents(const sh::ShaderVariable &variable) {
+    return VariablePacker::GetNumComponentsPerRow(variable.type);
+  }
+  static int NumRows(const sh::ShaderVariable &variable) {
+    return VariablePacker::GetNumRows(variable.type) * variable.elementCount();
+  }
+
+  unsigned makeColumnFlags(int column, int numComponentsPerRow) {
+    return ((kColumnMask << (kNumColumns - numComponentsPerRow)) & kColumnMask) >> column;
+  }
+
+  void fillColumns(int topRow, int numRows, int column, int numComponentsPerRow) {
+    unsigned columnFlags = makeColumnFlags(column, numComponentsPerRow);
+    for (int r = 0; r < numRows; ++r) {
+      rows_[topRow + r] |= columnFlags;
+    }
+  }
+
+  bool searchColumn(int column, int numRows, int *destRow, int *destSize) {
+    for (; topNonFullRow_ < maxRows_ && rows_[topNonFullRow_] == kColumnMask;
+         ++topNonFullRow_) {
+    }
+    for (; bottomNonFullRow_ >= 0 && rows_[bottomNonFullRow_] == kColumnMask;
+         --bottomNonFullRow_) {
+    }
+    if (bottomNonFullRow_ - topNonFullRow_ + 1 < numRows) {
+      return false;
+    }
+
+    unsigned columnFlags = makeColumnFlags(column, 1);
+    int topGoodRow = 0;
+    int smallestGoodTop = -1;
+    int smallestGoodSize = maxRows_ + 1;
+    int bottomRow = bottomNonFullRow_ + 1;
+    bool found = false;
+    for (int row = topNonFullRow_; row <= bottomRow; ++row) {
+      bool rowEmpty = row < bottomRow ? ((rows_[row] & columnFlags) == 0) : false;
+      if (rowEmpty) {
+        if (!found) {
+          topGoodRow = row;
+          found = true;
+        }
+      } else {
+        if (found) {
+          int size = row - topGoodRow;
+          if (size >= numRows && size < smallestGoodSize) {
+            smallestGoodSize = size;
+            smallestGoodTop = topGoodRow;
+          }
+        }
+        found = false;
+      }
+    }
+    if (smallestGoodTop < 0) {
+      return false;
+    }
+    *destRow = smallestGoodTop;
+    *destSize = smallestGoodSize;
+    return true;
+  }
+
+  int topNonFullRow_;
+  int bottomNonFullRow_;
+  int maxRows_;
+  std::vector<unsigned> rows_;
+};
+
+// One type of each shape that packs differently.
+sh::GLenum shapeTypes[] = {
+  GL_FLOAT_MAT4,
+  GL_FLOAT_MAT2,
+  GL_FLOAT_VEC4,
+  GL_FLOAT_MAT3,
+  GL_FLOAT_VEC3,
+  GL_FLOAT_VEC2,
+  GL_FLOAT,
+};
+
+unsigned int shapeArraySizes[] = { 0, 2, 3 };
+
+// Packs the variables with both packers, expects the same result, and checks
+// that the placements are in range and don't overlap.
+void CrossCheck(unsigned int maxVectors, const std::vector<sh::ShaderVariable> &vars) {
+  ReferencePacker reference;
+  bool expected = reference.CheckVariablesWithinPackingLimits(maxVectors, vars);
+
+  VariablePacker packer;
+  EXPECT_EQ(expected, packer.CheckVariablesWithinPackingLimits(maxVectors, vars));
+
+  std::vector<VariablePacker::Placement> placements;
+  ASSERT_EQ(expected, packer.PackVariables(maxVectors, vars, &placements));
+  if (!expected) {
+    return;
+  }
+
+  ASSERT_EQ(vars.size(), placements.size());
+  std::vector<unsigned> rows(maxVectors, 0);
+  for (size_t ii = 0; ii < vars.size(); ++ii) {
+    int numComponents = VariablePacker::GetNumComponentsPerRow(vars[ii].type);
+    int numRows = VariablePacker::GetNumRows(vars[ii].type) * vars[ii].elementCount();
+    const VariablePacker::Placement &placement = placements[ii];
+    ASSERT_GE(placement.row, 0);
+    ASSERT_LE(placement.row + numRows, static_cast<int>(maxVectors));
+    ASSERT_GE(placement.column, 0);
+    ASSERT_LE(placement.column + numComponents, 4);
+
+    unsigned columns = ((1u << numComponents) - 1) << placement.column;
+    for (int row = placement.row; row < placement.row + numRows; ++row) {
+      EXPECT_EQ(0u, rows[row] & columns);
+      rows[row] |= columns;
+    }
+  }
+}
+
+}  // namespace
+
+// Every set of up to three variables of the shapes above, in every number
+// of vectors up to 12.
+TEST(VariablePacking, CrossCheckSmallSets) {
+  std::vector<sh::ShaderVariable> shapes;
+  for (size_t tt = 0; tt < ArraySize(shapeTypes); ++tt) {
+    for (size_t ss = 0; ss < ArraySize(shapeArraySizes); ++ss) {
+      shapes.push_back(sh::ShaderVariable(shapeTypes[tt], shapeArraySizes[ss]));
+    }
+  }
+
+  for (unsigned int maxVectors = 1; maxVectors <= 12; ++maxVectors) {
+    std::vector<sh::ShaderVariable> vars;
+    CrossCheck(maxVectors, vars);
+    for (size_t a = 0; a < shapes.size(); ++a) {
+      vars.assign(1, shapes[a]);
+      CrossCheck(maxVectors, vars);
+      for (size_t b = a; b < shapes.size(); ++b) {
+        vars.resize(1);
+        vars.push_back(shapes[b]);
+        CrossCheck(maxVectors, vars);
+        for (size_t c = b; c < shapes.size(); ++c) {
+          vars.resize(2);
+          vars.push_back(shapes[c]);
+          CrossCheck(maxVectors, vars);
+        }
+      }
+    }
+  }
+}
+
+// Random sets of variables that about fill the vectors, so that whether
+// they pack depends on where the single column variables go.
+TEST(VariablePacking, CrossCheckRandomSets) {
+  unsigned int seed = 1;
+  for (int iteration = 0; iteration < 20000; ++iteration) {
+    seed = seed * 1103515245u + 12345u;
+    unsigned int maxVectors = 1 + (seed >> 16) % 16;
+
+    std::vector<sh::ShaderVariable> vars;
+    unsigned int components = 0;
+    while (components < 4 * maxVectors) {
+      seed = seed * 1103515245u + 12345u;
+      unsigned int random = seed >> 16;
+      sh::GLenum type = (random % 4 == 0) ? shapeTypes[(random / 4) % ArraySize(shapeTypes)]
+                                          : GL_FLOAT;
+      unsigned int arraySize = (random / 64) % 2 == 0 ? (random / 128) % 7 : 0;
+      sh::ShaderVariable var(type, arraySize);
+      vars.push_back(var);
+      components += VariablePacker::GetNumComponentsPerRow(type) *
+                    VariablePacker::GetNumRows(type) * var.elementCount();
+    }
+    // Both with the last variable, which may not fit, and without it.
+    CrossCheck(maxVectors, vars);
+    vars.pop_back();
+    CrossCheck(maxVectors, vars);
+  }
+}
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include <chrono>
+#include <iostream>
+
+#include "PreprocessorTest.h"
+#include "Token.h"
+#include "Tokenizer.h"
+
+// Lexes a large source many times over and prints the tokens per second,
+// both from the tokenizer alone and through the whole preprocessor, and
+// expands nested function-like macros, like an unrolled math library does.
+// The tokenizer also reports megabytes per second, on the same source and on
+// one that is mostly comments, indentation and long names.
+class ThroughputTest : public PreprocessorTest
+{
+  protected:
+    static const int kRepeats = 2000;
+
+    virtual void SetUp()
+    {
+        mSource =
+            "#define PI 3.14159265\n"
+            "#define SQUARE(x) ((x) * (x))\n"
+            "#define LERP(a, b, t) ((a) + ((b) - (a)) * (t))\n";
+        for (int i = 0; i < kRepeats; ++i)
+        {
+            mSource +=
+                "// Attenuates a light by its distance from the surface.\n"
+                "highp float attenuateLight(in highp vec3 lightPosition, highp vec3 surfacePosition)\n"
+                "{\n"
+                "    highp vec3 toLight = lightPosition - surfacePosition;\n"
+                "    highp float distanceSquared = dot(toLight, toLight);\n"
+                "    return 1.0 / (1.0 + SQUARE(distanceSquared) * 0.05e-1);\n"
+                "}\n"
+                "/* The angle of the spotlight cone,\n"
+                "   in radians. */\n"
+                "mediump float coneAngle = LERP(PI / 8.0, PI / 4.0, uniformConeBlend);\n"
+                "int index = 0x1F >> 2; index += 017;\n";
+        }
+    }
+
+    // Returns the tokens per second of the best of a few passes, and the
+    // number of tokens in a pass.
+    template <typename LexerT>
+    double measure(LexerT *(*create)(MockDiagnostics *, MockDirectiveHandler *, const char *const *),
+                   size_t *tokenCount)
+    {
+        typedef std::chrono::steady_clock Clock;
+        double best = 0.0;
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            const char *source = mSource.c_str();
+            LexerT *lexer = create(&mDiagnostics, &mDirectiveHandler, &source);
+            pp::Token token;
+            size_t count = 0;
+            Clock::time_point start = Clock::now();
+            do
+            {
+                lexer->lex(&token);
+                ++count;
+            } while (token.type != pp::Token::LAST);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            delete lexer;
+
+            *tokenCount = count;
+            best = std::max(best, count / seconds);
+        }
+        return best;
+    }
+
+    static pp::Tokenizer *CreateTokenizer(MockDiagnostics *diagnostics,
+                                          MockDirectiveHandler *, const char *const *source)
+    {
+        pp::Tokenizer *tokenizer = new pp::Tokenizer(diagnostics);
+        tokenizer->setMaxTokenSize(1024);
+        EXPECT_TRUE(tokenizer->init(1, source, NULL));
+        return tokenizer;
+    }
+
+    static pp::Preprocessor *CreatePreprocessor(MockDiagnostics *diagnostics,
+                                                MockDirectiveHandler *directiveHandler,
+                                                const char *const *source)
+    {
+        pp::Preprocessor *preprocessor = new pp::Preprocessor(diagnostics, directiveHandler);
+        EXPECT_TRUE(preprocessor->init(1, source, NULL));
+        return preprocessor;
+    }
+
+    std::string mSource;
+};
+
+TEST_F(ThroughputTest, Tokenizer)
+{
+    EXPECT_CALL(mDiagnostics, print(testing::_, testing::_, testing::_)).Times(0);
+
+    size_t tokenCount = 0;
+    double tokensPerSecond = measure(CreateTokenizer, &tokenCount);
+    // 51 tokens in the definitions, and 86 in each repeat, newlines included.
+    EXPECT_EQ(51u + kRepeats * 86u + 1u, tokenCount);
+
+    std::cout << "[ RESULT   ] tokenizer: " << static_cast<size_t>(tokensPerSecond)
+              << " tokens/second over " << mSource.size() << " bytes" << std::endl;
+    std::cout << "[ RESULT   ] tokenizer: "
+              << tokensPerSecond / tokenCount * mSource.size() / 1e6 << " MB/second" << std::endl;
+}
+
+TEST_F(ThroughputTest, TokenizerCommentsAndIndentation)
+{
+    EXPECT_CALL(mDiagnostics, print(testing::_, testing::_, testing::_)).Times(0);
+
+    mSource.clear();
+    for (int i = 0; i < kRepeats; ++i)
+    {
+        mSource +=
+            "/*\n"
+            " * Blends the ambient, diffuse and specular terms of every light that\n"
+            " * reaches the surface, weighted by the material of the surface.\n"
+            " */\n"
+            "                // The accumulated specular contribution of all lights.\n"
+            "                highp vec3 accumulatedSpecularContribution = computeSpecularContribution(\n"
+            "                    surfaceNormalInViewSpace, directionTowardsTheViewer);\n";
+    }
+
+    size_t tokenCount = 0;
+    double tokensPerSecond = measure(CreateTokenizer, &tokenCount);
+    // 15 tokens in each repeat, newlines included.
+    EXPECT_EQ(kRepeats * 15u + 1u, tokenCount);
+
+    std::cout << "[ RESULT   ] tokenizer, comments and indentation: "
+              << tokensPerSecond / tokenCount * mSource.size() / 1e6 << " MB/second over "
+              << mSource.size() << " bytes" << std::endl;
+}
+
+TEST_F(ThroughputTest, Preprocessor)
+{
+    EXPECT_CALL(mDiagnostics, print(testing::_, testing::_, testing::_)).Times(0);
+
+    size_t tokenCount = 0;
+    double tokensPerSecond = measure(CreatePreprocessor, &tokenCount);
+    // The directives and the newlines are gone, and the macros expand to 19
+    // more tokens in each repeat.
+    EXPECT_EQ(kRepeats * (75u + 19u) + 1u, tokenCount);
+
+    std::cout << "[ RESULT   ] preprocessor: " << static_cast<size_t>(tokensPerSecond)
+              << " tokens/second over " << mSource.size() << " bytes" << std::endl;
+}
+
+TEST_F(ThroughputTest, NestedMacroExpansion)
+{
+    EXPECT_CALL(mDiagnostics, print(testing::_, testing::_, testing::_)).Times(0);
+
+    mSource =
+        "#define ADD(a, b) ((a) + (b))\n"
+        "#define MUL(a, b) ((a) * (b))\n"
+        "#define MAD(a, b, c) ADD(MUL(a, b), c)\n"
+        "#define DOT3(u, v) MAD(u.x, v.x, MAD(u.y, v.y, MUL(u.z, v.z)))\n"
+        "#define LENGTH_SQUARED(v) DOT3(v, v)\n"
+        "#define HORNER3(x, c0, c1, c2, c3) MAD(MAD(MAD(c3, x, c2), x, c1), x, c0)\n";
+    for (int i = 0; i < kRepeats / 10; ++i)
+    {
+        mSource +=
+            "r = HORNER3(LENGTH_SQUARED(normal), 0.1, 0.2, 0.3, 0.4) +\n"
+            "    DOT3(normal, lightDirection) * MAD(attenuation, intensity, ambient);\n";
+    }
+
+    size_t tokenCount = 0;
+    double tokensPerSecond = measure(CreatePreprocessor, &tokenCount);
+    EXPECT_EQ(kRepeats / 10 * 280u + 1u, tokenCount);
+
+    std::cout << "[ RESULT   ] nested macro expansion: " << static_cast<size_t>(tokensPerSecond)
+              << " tokens/second over " << mSource.size() << " bytes" << std::endl;
+}
@@ -88,3 +88,33 @@ TEST(TokenTest, Write)
     EXPECT_TRUE(out2.good());
     EXPECT_EQ(" foo", out2.str());
 }
+
+TEST(TokenTest, TextView)
+{
+    const char source[] = "foo bar";
+    pp::Token token;
+    token.text.setView(source + 4, 3);
+    EXPECT_EQ("bar", token.text);
+
+    // Copies refer to the same characters.
+    pp::Token copy = token;
+    EXPECT_EQ(source + 4, copy.text.data());
+    EXPECT_EQ(3u, copy.text.size());
+}
+
+TEST(TokenTest, TextOwned)
+{
+    pp::Token copy;
+    {
+        pp::Token token;
+        std::string text = "foo";
+        token.text.assign(text.c_str());
+        text[0] = 'b';
+        EXPECT_EQ("foo", token.text);
+
+        // Copies have their own characters.
+        copy = token;
+        EXPECT_NE(token.text.data(), copy.text.data());
+    }
+    EXPECT_EQ("foo", copy.text);
+}
@@ -128,6 +128,75 @@
                 },
             },
         },
+        {
+            'target_name': 'compiler_perf_tests',
+            'type': 'executable',
+            'includes': [ '../build/common_defines.gypi', ],
+            'dependencies':
+            [
+                '../src/angle.gyp:translator_static',
+            ],
+            'include_dirs':
+            [
+                '../include',
+                '../src',
+                '../util',
+                'perf_tests',
+            ],
+            'sources':
+            [
+                'compiler_perf_tests/BenchmarkUtils.cpp',
+                'compiler_perf_tests/BenchmarkUtils.h',
+                'compiler_perf_tests/CompilerBenchmark.cpp',
+                'compiler_perf_tests/CompilerBenchmark.h',
+                'compiler_perf_tests/CompilerBenchmarks.cpp',
+                'compiler_perf_tests/CompilerConstructionBenchmark.cpp',
+                'compiler_perf_tests/CompilerConstructionBenchmark.h',
+                'compiler_perf_tests/DeepTreeBenchmark.cpp',
+                'compiler_perf_tests/DeepTreeBenchmark.h',
+                'compiler_perf_tests/DependencyGraphBenchmark.cpp',
+                'compiler_perf_tests/DependencyGraphBenchmark.h',
+                'compiler_perf_tests/DependencyGraphWork.cpp',
+                'compiler_perf_tests/DependencyGraphWork.h',
+                'compiler_perf_tests/LegacyPoolAllocator.cpp',
+                'compiler_perf_tests/LegacyPoolAllocator.h',
+                'compiler_perf_tests/LegacyVariableInfo.cpp',
+                'compiler_perf_tests/LegacyVariableInfo.h',
+                'compiler_perf_tests/PackingBenchmark.cpp',
+                'compiler_perf_tests/PackingBenchmark.h',
+                'compiler_perf_tests/PoolAllocationLog.cpp',
+                'compiler_perf_tests/PoolAllocationLog.h',
+                'compiler_perf_tests/PoolAllocatorBenchmark.cpp',
+                'compiler_perf_tests/PoolAllocatorBenchmark.h',
+                'compiler_perf_tests/UniformsBenchmark.cpp',
+                'compiler_perf_tests/UniformsBenchmark.h',
+                'compiler_perf_tests/ValidationWalkBenchmark.cpp',
+                'compiler_perf_tests/ValidationWalkBenchmark.h',
+                'compiler_perf_tests/ValidationWalks.cpp',
+                'compiler_perf_tests/ValidationWalks.h',
+                'compiler_perf_tests/VariableCollection.cpp',
+                'compiler_perf_tests/VariableCollection.h',
+                'perf_tests/third_party/perf/perf_test.cc',
+                'perf_tests/third_party/perf/perf_test.h',
+            ],
+            'msvs_settings':
+            {
+                'VCLinkerTool':
+                {
+                    'AdditionalDependencies':
+                    [
+                        'psapi.lib',
+                    ]
+                }
+            },
+            'copies':
+            [
+                {
+                    'destination': '<(PRODUCT_DIR)/compiler_perf_shaders',
+                    'files': [ '<!@(python <(angle_path)/enumerate_files.py compiler_perf_tests/shaders -types *.vert *.frag)' ],
+                },
+            ],
+        },
     ],
 
     'conditions':